@@ -1,47 +1,67 @@
 #include <Arduino.h>
+#include "obd_parser.h"
+#include "telemetry_link.h"
 
-// Shared State
-volatile int g_rpm = 0;
-volatile int g_speed = 0;
+// Shared State (seqlock: control-plane path publishes, protocol path
+// reads consistent snapshots)
+obd::SharedVehicleState g_state;
+
+// OBD receive path: the UART callback only moves bytes into the ring;
+// tokenizing and replying happen in loop(), heap-free throughout
+static obd::ByteRing<256> g_obd_rx;
+
+static void obdSink(const char* line, void*) {
+    if (line[0] == '>' && line[1] == '\0') {
+        Serial.print(">"); // Prompt
+    } else {
+        Serial.println(line);
+    }
+}
+
+static obd::CommandParser g_parser(g_state, obdSink, nullptr);
+
+// Control-plane receive path mirrors the OBD one: callback fills a
+// ring, loop() drains it through the binary frame decoder
+static obd::ByteRing<512> g_ctrl_rx;
+
+static void applySample(const obd::TelemetrySample& s, void*) {
+    obd::VehicleState next;
+    next.speed = s.speed;
+    next.rpm = s.rpm;
+    next.temp = s.temp;
+    g_state.publish(next);
+}
+
+static obd::TelemetryDecoder g_telemetry(applySample, nullptr);
+
+static void onObdReceive() {
+    while (Serial.available()) {
+        g_obd_rx.push(static_cast<uint8_t>(Serial.read()));
+    }
+}
+
+static void onCtrlReceive() {
+    while (Serial2.available()) {
+        g_ctrl_rx.push(static_cast<uint8_t>(Serial2.read()));
+    }
+}
 
 void setup() {
     Serial.begin(38400); // OBD Scanner connection (Bluetooth/USB)
+    Serial.onReceive(onObdReceive);
     Serial2.begin(115200); // Upstream Link to RPi/Ubuntu (Control Plane)
+    Serial2.onReceive(onCtrlReceive);
 }
 
 void loop() {
     // THREAD 1: FAST PROTOCOL HANDLING (The "ELM327")
-    if (Serial.available()) {
-        String cmd = Serial.readStringUntil('\r');
-        cmd.trim();
-        
-        if (cmd == "ATZ") { 
-            Serial.println("ELM327 v1.5"); 
-        }
-        else if (cmd == "010C") { // Request RPM
-            // 1/4 RPM per bit. Value = RPM * 4
-            int val = g_rpm * 4;
-            byte A = (val >> 8) & 0xFF;
-            byte B = val & 0xFF;
-            char buf[10];
-            sprintf(buf, "41 0C %02X %02X", A, B);
-            Serial.println(buf);
-        }
-        else if (cmd == "010D") { // Request Speed
-            char buf[10];
-            sprintf(buf, "41 0D %02X", g_speed);
-            Serial.println(buf);
-        }
-        else {
-            Serial.println("?"); // Standard ELM error
-        }
-        Serial.print(">"); // Prompt
+    uint8_t b;
+    while (g_obd_rx.pop(b)) {
+        g_parser.feed(b);
     }
 
-    // THREAD 2: STATE UPDATES FROM PYTHON
-    if (Serial2.available()) {
-        // Format: "S:800:25" (Speed:RPM:Temp)
-        String update = Serial2.readStringUntil('\n');
-        // ... fast parse logic to update g_rpm/g_speed ...
+    // THREAD 2: STATE UPDATES FROM PYTHON (batched binary frames)
+    while (g_ctrl_rx.pop(b)) {
+        g_telemetry.feed(b);
     }
 }
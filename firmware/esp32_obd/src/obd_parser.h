@@ -0,0 +1,209 @@
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Heap-free protocol path for the ELM327 emulation.
+//
+// The old loop() used Arduino String and readStringUntil('\r'), which
+// heap-allocates per command and blocks until the terminator arrives —
+// bursts from the scanner dropped polls. The receive callback now feeds
+// a fixed ring buffer, loop() drains it through an in-place tokenizer
+// over a fixed command buffer, and dispatch walks a static response
+// table. No allocation anywhere, and the worst-case path (tokenize +
+// table walk + snprintf into a stack buffer) stays well under 1ms.
+namespace obd {
+
+// Single-producer single-consumer byte ring: the UART receive callback
+// pushes, loop() pops. Power-of-two capacity so the indices wrap with a
+// mask; one slot is sacrificed to distinguish full from empty.
+template <size_t N>
+class ByteRing {
+    static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    bool push(uint8_t b) {
+        const uint16_t head = head_;
+        const uint16_t next = (head + 1) & (N - 1);
+        if (next == tail_) return false; // full: drop, parser resyncs on '\r'
+        buf_[head] = b;
+        head_ = next;
+        return true;
+    }
+
+    bool pop(uint8_t& b) {
+        const uint16_t tail = tail_;
+        if (tail == head_) return false;
+        b = buf_[tail];
+        tail_ = (tail + 1) & (N - 1);
+        return true;
+    }
+
+    bool empty() const { return head_ == tail_; }
+
+private:
+    uint8_t buf_[N];
+    volatile uint16_t head_ = 0;
+    volatile uint16_t tail_ = 0;
+};
+
+// Live values the control-plane link keeps updated; the responders read
+// them at reply time
+struct VehicleState {
+    uint16_t rpm = 0;
+    uint8_t speed = 0;
+    int8_t temp = 0;
+};
+
+// Seqlock publication of the telemetry struct. Individual volatile
+// fields were fine with two values, but a responder formatting mid-
+// update could mix fields from different samples once the struct grows
+// toward 20+ PIDs. The writer (control-plane path) bumps the sequence
+// to odd, copies, bumps to even; readers retry the copy until they see
+// a stable even sequence. No interrupts disabled, the reader never
+// blocks the writer, and the retry window is a 4-byte struct copy.
+class SharedVehicleState {
+public:
+    void publish(const VehicleState& s) {
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        state_ = s;
+        std::atomic_thread_fence(std::memory_order_release);
+        seq_.store(seq + 2, std::memory_order_relaxed);
+    }
+
+    VehicleState read() const {
+        for (;;) {
+            const uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) continue; // write in flight
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // The copy may race the writer (seqlock idiom); a torn copy
+            // fails the sequence recheck below and is discarded
+            VehicleState copy = state_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) return copy;
+        }
+    }
+
+private:
+    std::atomic<uint32_t> seq_{0};
+    VehicleState state_;
+};
+
+// Formats one response line into a caller-provided buffer. Entries live
+// in a static table; adding a PID is one line there.
+struct Command {
+    const char* name;
+    void (*respond)(const VehicleState& state, char* out, size_t cap);
+};
+
+inline void respondReset(const VehicleState&, char* out, size_t cap) {
+    snprintf(out, cap, "ELM327 v1.5");
+}
+
+inline void respondRpm(const VehicleState& state, char* out, size_t cap) {
+    // 1/4 RPM per bit. Value = RPM * 4
+    const uint16_t val = static_cast<uint16_t>(state.rpm * 4);
+    snprintf(out, cap, "41 0C %02X %02X", (val >> 8) & 0xFF, val & 0xFF);
+}
+
+inline void respondSpeed(const VehicleState& state, char* out, size_t cap) {
+    snprintf(out, cap, "41 0D %02X", state.speed);
+}
+
+inline constexpr Command kCommands[] = {
+    {"ATZ", respondReset},
+    {"010C", respondRpm},
+    {"010D", respondSpeed},
+};
+
+// In-place tokenizer and dispatcher. feed() consumes raw bytes: spaces
+// are stripped and letters uppercased as they arrive (ELM327 commands
+// are case- and whitespace-insensitive), '\r' terminates a command, and
+// an overlong command is discarded until the next terminator.
+class CommandParser {
+public:
+    // Called once per output line ("ELM327 v1.5", "?", the ">" prompt)
+    using Sink = void (*)(const char* line, void* ctx);
+
+    CommandParser(const SharedVehicleState& state, Sink sink, void* ctx)
+        : state_(state), sink_(sink), ctx_(ctx) {}
+
+    void feed(uint8_t b) {
+        if (b == '\r' || b == '\n') {
+            if (overflow_) {
+                // Overlong input is garbage by definition; answer like
+                // any unknown command
+                sink_("?", ctx_);
+                sink_(">", ctx_);
+            } else if (len_ > 0) {
+                cmd_[len_] = '\0';
+                dispatch();
+            }
+            len_ = 0;
+            overflow_ = false;
+            return;
+        }
+        if (overflow_) return; // discard until terminator
+        if (b == ' ') return;
+        if (len_ >= kMaxCommand) {
+            overflow_ = true;
+            len_ = 0;
+            return;
+        }
+        cmd_[len_++] = (b >= 'a' && b <= 'z') ? static_cast<char>(b - 'a' + 'A')
+                                              : static_cast<char>(b);
+    }
+
+private:
+    static constexpr size_t kMaxCommand = 15;
+    static constexpr size_t kCommandCount = sizeof(kCommands) / sizeof(kCommands[0]);
+
+    // Scanners poll PIDs at 20Hz while the values change at ~2Hz, so
+    // each table entry keeps its formatted line plus the state it was
+    // formatted from; the sprintf only reruns when a field changed
+    struct CachedResponse {
+        char line[24];
+        bool valid = false;
+        uint16_t rpm;
+        uint8_t speed;
+        int8_t temp;
+    };
+
+    void dispatch() {
+        for (size_t i = 0; i < kCommandCount; i++) {
+            if (strcmp(cmd_, kCommands[i].name) != 0) continue;
+            // Consistent snapshot via the seqlock; the cache compares
+            // against exactly what it formatted
+            const VehicleState snapshot = state_.read();
+
+            CachedResponse& cached = cache_[i];
+            if (!cached.valid || cached.rpm != snapshot.rpm ||
+                cached.speed != snapshot.speed || cached.temp != snapshot.temp) {
+                kCommands[i].respond(snapshot, cached.line, sizeof(cached.line));
+                cached.rpm = snapshot.rpm;
+                cached.speed = snapshot.speed;
+                cached.temp = snapshot.temp;
+                cached.valid = true;
+            }
+            sink_(cached.line, ctx_);
+            sink_(">", ctx_);
+            return;
+        }
+        sink_("?", ctx_); // Standard ELM error
+        sink_(">", ctx_);
+    }
+
+    const SharedVehicleState& state_;
+    Sink sink_;
+    void* ctx_;
+    char cmd_[kMaxCommand + 1];
+    size_t len_ = 0;
+    bool overflow_ = false;
+    CachedResponse cache_[kCommandCount];
+};
+
+} // namespace obd
@@ -0,0 +1,116 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Binary control-plane frames for the upstream (RPi -> ESP32) link.
+//
+// The Serial2 path parsed newline-delimited text ("S:800:25") per
+// update, one String allocation and integer parse each — too much loop
+// budget at 100Hz. A frame now carries a batch of fixed-layout samples:
+//
+//   [0xAA sync][count u8][count x sample][checksum u8]
+//   sample: speed u8, rpm u16 little-endian, temp i8   (4 bytes)
+//   checksum: XOR of the count byte and every sample byte
+//
+// The decoder is a byte-fed state machine: it resynchronizes on the
+// sync byte after a bad checksum or a torn frame, allocates nothing,
+// and invokes the sample callback for each sample in a valid frame.
+namespace obd {
+
+struct TelemetrySample {
+    uint8_t speed;
+    uint16_t rpm;
+    int8_t temp;
+};
+
+class TelemetryDecoder {
+public:
+    static constexpr uint8_t kSync = 0xAA;
+    static constexpr size_t kMaxSamplesPerFrame = 16;
+    static constexpr size_t kSampleBytes = 4;
+
+    using SampleFn = void (*)(const TelemetrySample& sample, void* ctx);
+
+    TelemetryDecoder(SampleFn onSample, void* ctx)
+        : on_sample_(onSample), ctx_(ctx) {}
+
+    void feed(uint8_t b) {
+        switch (state_) {
+        case State::Sync:
+            if (b == kSync) state_ = State::Count;
+            break;
+        case State::Count:
+            if (b == 0 || b > kMaxSamplesPerFrame) {
+                state_ = State::Sync; // implausible count: resync
+                break;
+            }
+            count_ = b;
+            received_ = 0;
+            checksum_ = b;
+            state_ = State::Payload;
+            break;
+        case State::Payload:
+            payload_[received_++] = b;
+            checksum_ ^= b;
+            if (received_ == static_cast<size_t>(count_) * kSampleBytes) {
+                state_ = State::Checksum;
+            }
+            break;
+        case State::Checksum:
+            if (b == checksum_) {
+                deliver();
+            }
+            // Either way the frame is consumed; a corrupt one is
+            // dropped and the next sync byte starts over
+            state_ = State::Sync;
+            break;
+        }
+    }
+
+private:
+    enum class State { Sync, Count, Payload, Checksum };
+
+    void deliver() {
+        for (size_t i = 0; i < count_; i++) {
+            const uint8_t* p = payload_ + i * kSampleBytes;
+            TelemetrySample s;
+            s.speed = p[0];
+            s.rpm = static_cast<uint16_t>(p[1] | (p[2] << 8));
+            s.temp = static_cast<int8_t>(p[3]);
+            on_sample_(s, ctx_);
+        }
+    }
+
+    SampleFn on_sample_;
+    void* ctx_;
+    State state_ = State::Sync;
+    uint8_t count_ = 0;
+    size_t received_ = 0;
+    uint8_t checksum_ = 0;
+    uint8_t payload_[kMaxSamplesPerFrame * kSampleBytes];
+};
+
+// Sender-side helper (and test double): packs up to
+// kMaxSamplesPerFrame samples into out. Returns the frame length, or 0
+// if the batch or buffer does not fit.
+inline size_t encodeTelemetryFrame(const TelemetrySample* samples, size_t n,
+                                   uint8_t* out, size_t cap) {
+    if (n == 0 || n > TelemetryDecoder::kMaxSamplesPerFrame) return 0;
+    const size_t len = 3 + n * TelemetryDecoder::kSampleBytes;
+    if (cap < len) return 0;
+    out[0] = TelemetryDecoder::kSync;
+    out[1] = static_cast<uint8_t>(n);
+    uint8_t checksum = out[1];
+    for (size_t i = 0; i < n; i++) {
+        uint8_t* p = out + 2 + i * TelemetryDecoder::kSampleBytes;
+        p[0] = samples[i].speed;
+        p[1] = samples[i].rpm & 0xFF;
+        p[2] = (samples[i].rpm >> 8) & 0xFF;
+        p[3] = static_cast<uint8_t>(samples[i].temp);
+        checksum ^= p[0] ^ p[1] ^ p[2] ^ p[3];
+    }
+    out[len - 1] = checksum;
+    return len;
+}
+
+} // namespace obd
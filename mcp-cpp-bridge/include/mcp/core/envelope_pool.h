@@ -0,0 +1,130 @@
+#pragma once
+
+#include "mcp/core/protocol.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcp {
+
+/**
+ * Per-worker slab pool for message envelopes and serialization buffers.
+ *
+ * Every message through the bridge used to allocate fresh Request and
+ * Response structs plus the std::string the serialized reply was built
+ * in; massif attributes a sizeable slice of bridge CPU to that
+ * allocator traffic. EnvelopePool::local() hands each worker thread its
+ * own free lists — no locks, no sharing — and leases hand envelopes
+ * back automatically after a reset that keeps the underlying string
+ * capacity, so a warmed-up worker processes messages with no envelope
+ * or buffer allocations at all.
+ *
+ *   auto req = EnvelopePool::local().acquireRequest();
+ *   req->method = "tools/call";
+ *   ...
+ *   auto buf = EnvelopePool::local().acquireBuffer();
+ *   *buf += Protocol::serialize(msg);   // reuses the buffer's capacity
+ *   // both return to this worker's pool at scope exit
+ *
+ * Json::Value members are reset by assignment (jsoncpp frees the tree);
+ * the win there is the envelope and string churn around the tree, not
+ * the tree nodes themselves.
+ */
+class EnvelopePool {
+public:
+    // Free-list depth per worker; beyond this, released objects are
+    // simply destroyed so an ephemeral burst cannot pin memory
+    static constexpr size_t kMaxPerWorker = 64;
+
+    /** This worker's pool; create/destroy follows the thread */
+    static EnvelopePool& local() {
+        static thread_local EnvelopePool pool;
+        return pool;
+    }
+
+    template<typename T, void (*Reset)(T&)>
+    class Lease {
+    public:
+        Lease(std::unique_ptr<T> object, std::vector<std::unique_ptr<T>>* freeList)
+            : object_(std::move(object)), freeList_(freeList) {}
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease() {
+            if (object_ && freeList_ && freeList_->size() < kMaxPerWorker) {
+                Reset(*object_);
+                freeList_->push_back(std::move(object_));
+            }
+        }
+
+        T& operator*() { return *object_; }
+        T* operator->() { return object_.get(); }
+        T* get() { return object_.get(); }
+
+    private:
+        std::unique_ptr<T> object_;
+        std::vector<std::unique_ptr<T>>* freeList_;
+    };
+
+    static void resetRequest(Protocol::Request& req) {
+        req.jsonrpc = "2.0";
+        req.method.clear(); // keeps capacity
+        req.params.reset();
+        req.id.reset();
+    }
+
+    static void resetResponse(Protocol::Response& resp) {
+        resp.jsonrpc = "2.0";
+        resp.result.reset();
+        resp.error.reset();
+        resp.id = Protocol::Id{};
+    }
+
+    static void resetBuffer(std::string& buffer) {
+        buffer.clear(); // capacity survives for the next serialization
+    }
+
+    using RequestLease = Lease<Protocol::Request, &EnvelopePool::resetRequest>;
+    using ResponseLease = Lease<Protocol::Response, &EnvelopePool::resetResponse>;
+    using BufferLease = Lease<std::string, &EnvelopePool::resetBuffer>;
+
+    RequestLease acquireRequest() {
+        return RequestLease(take(requests_), &requests_);
+    }
+
+    ResponseLease acquireResponse() {
+        return ResponseLease(take(responses_), &responses_);
+    }
+
+    BufferLease acquireBuffer() {
+        return BufferLease(take(buffers_), &buffers_);
+    }
+
+    /** Pooled objects currently idle (diagnostics) */
+    size_t idleCount() const {
+        return requests_.size() + responses_.size() + buffers_.size();
+    }
+
+private:
+    EnvelopePool() = default;
+
+    template<typename T>
+    static std::unique_ptr<T> take(std::vector<std::unique_ptr<T>>& freeList) {
+        if (freeList.empty()) {
+            return std::make_unique<T>();
+        }
+        std::unique_ptr<T> object = std::move(freeList.back());
+        freeList.pop_back();
+        return object;
+    }
+
+    std::vector<std::unique_ptr<Protocol::Request>> requests_;
+    std::vector<std::unique_ptr<Protocol::Response>> responses_;
+    std::vector<std::unique_ptr<std::string>> buffers_;
+};
+
+} // namespace mcp
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <variant>
 #include <optional>
 #include <vector>
@@ -73,15 +74,33 @@ public:
     // MCP-specific message types
     using Message = std::variant<Request, Response, Notification>;
     
-    // Parse raw JSON into MCP message
-    static std::optional<Message> parse(const std::string& jsonStr);
+    // Parse raw JSON into MCP message. Takes a view so transports can
+    // hand spans of their receive buffers straight in; nothing is
+    // retained past the call.
+    static std::optional<Message> parse(std::string_view jsonStr);
     static std::optional<Message> parse(const Json::Value& json);
-    
+
     // Serialize MCP message to JSON
     static std::string serialize(const Message& msg);
     static Json::Value toJson(const Message& msg);
+
+    // JSON-RPC 2.0 batch support. A top-level array parses into one
+    // Message per element so a client can ship many tool calls in a
+    // single transport round trip; per the spec, an element that fails
+    // to parse yields a Response carrying ParseError/InvalidRequest in
+    // its place. An empty array is itself invalid and returns nullopt.
+    static std::optional<std::vector<Message>> parseBatch(std::string_view jsonStr);
+    static std::optional<std::vector<Message>> parseBatch(const Json::Value& json);
+
+    // Serializes responses back as one JSON array (or "" for an
+    // all-notification batch, which expects no reply).
+    static std::string serializeBatch(const std::vector<Message>& msgs);
 };
 
+namespace server {
+class ToolResultStream;
+}
+
 /**
  * MCP Tool definition
  */
@@ -89,11 +108,20 @@ struct Tool {
     std::string name;
     std::string description;
     Json::Value inputSchema;
-    
+
     // Tool execution handler
     using Handler = std::function<Json::Value(const Json::Value& params)>;
     Handler handler;
-    
+
+    // Streaming variant, preferred over handler when set: the tool
+    // writes chunks into the stream as it produces them (see
+    // mcp/server/stream_result.h) instead of returning one buffered
+    // result, so large outputs flow with constant memory
+    using StreamingHandler =
+        std::function<void(const Json::Value& params,
+                           server::ToolResultStream& stream)>;
+    StreamingHandler streamingHandler;
+
     Json::Value toJson() const;
 };
 
@@ -8,7 +8,9 @@
 
 // Our extensions
 #include "mcp/core/protocol.h"
+#include "mcp/server/server.h"
 #include <json/json.h>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -32,7 +34,7 @@ public:
     /**
      * Create a TinyMCP server with our configuration
      */
-    static std::unique_ptr<tinymcp::Server> createServer(const Server::Config& config);
+    static std::unique_ptr<tinymcp::Server> createServer(const server::Server::Config& config);
     
     /**
      * Create a TinyMCP client with our configuration  
@@ -50,7 +52,7 @@ private:
  */
 class ExtendedMCPServer : public tinymcp::Server {
 public:
-    ExtendedMCPServer(const Server::Config& config);
+    ExtendedMCPServer(const server::Server::Config& config);
     ~ExtendedMCPServer() override;
     
     // Additional functionality beyond TinyMCP
@@ -61,6 +63,18 @@ public:
     // Performance optimizations
     void setThreadPool(size_t numThreads);
     void enableCaching(size_t maxCacheSize);
+
+    /**
+     * Runs handler(request) on the worker pool, taking the parsed
+     * envelope by move instead of copying payload strings into the
+     * task. Task objects come from a slab pool with reset-and-reuse,
+     * so a warmed-up server pays neither the payload copy nor a
+     * new/delete per bridged call. Requires a thread pool (configured
+     * via Config::workerThreads or setThreadPool); returns false when
+     * none is running.
+     */
+    using TaskHandler = std::function<void(Protocol::Request& request)>;
+    bool submitTask(Protocol::Request request, TaskHandler handler);
     
 private:
     class Impl;
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mcp {
+namespace server {
+
+/**
+ * HDR-style log-bucketed latency histogram in microseconds.
+ *
+ * Values are bucketed by their power of two with 16 linear sub-buckets
+ * per power, giving ~6% relative precision across the full uint64
+ * range with a fixed 1024-slot table. record() is a single relaxed
+ * atomic increment, cheap enough for the processMessage hot path;
+ * percentile queries walk a snapshot of the counts and never block
+ * recorders.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4; // 16 sub-buckets per power of two
+    static constexpr size_t kBucketCount = 64u << kSubBucketBits;
+
+    void record(uint64_t micros) {
+        buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (micros > seen &&
+               !max_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    struct Percentiles {
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+        uint64_t count = 0;
+    };
+
+    Percentiles percentiles() const {
+        std::array<uint64_t, kBucketCount> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_acquire);
+            total += counts[i];
+        }
+
+        Percentiles out;
+        out.count = total;
+        out.max = max_.load(std::memory_order_acquire);
+        if (total == 0) {
+            return out;
+        }
+        out.p50 = valueAtRank(counts, (total * 50 + 99) / 100);
+        out.p90 = valueAtRank(counts, (total * 90 + 99) / 100);
+        out.p99 = valueAtRank(counts, (total * 99 + 99) / 100);
+        return out;
+    }
+
+private:
+    static size_t bucketIndex(uint64_t micros) {
+        if (micros < (1u << kSubBucketBits)) {
+            return static_cast<size_t>(micros);
+        }
+        int msb = 63 - __builtin_clzll(micros);
+        int shift = msb - kSubBucketBits;
+        size_t sub = static_cast<size_t>((micros >> shift) & ((1u << kSubBucketBits) - 1));
+        return (static_cast<size_t>(msb - kSubBucketBits + 1) << kSubBucketBits) | sub;
+    }
+
+    // Representative (upper-bound) value for a bucket.
+    static uint64_t bucketValue(size_t index) {
+        if (index < (1u << kSubBucketBits)) {
+            return index;
+        }
+        uint64_t power = (index >> kSubBucketBits) + kSubBucketBits - 1;
+        uint64_t sub = index & ((1u << kSubBucketBits) - 1);
+        uint64_t base = uint64_t{1} << power;
+        return base + ((sub + 1) << (power - kSubBucketBits));
+    }
+
+    static uint64_t valueAtRank(const std::array<uint64_t, kBucketCount>& counts,
+                                uint64_t rank) {
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return bucketValue(i);
+            }
+        }
+        return bucketValue(kBucketCount - 1);
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * Per-method latency recorders keyed by JSON-RPC method name
+ * (tools/call, resources/read, ...). Histograms are created on a
+ * method's first request under the registration mutex and looked up
+ * lock-free afterwards through the stable node pointers of std::map.
+ */
+class MethodLatencyRecorder {
+public:
+    LatencyHistogram& histogramFor(const std::string& method) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = histograms_.find(method);
+            if (it != histograms_.end()) {
+                return it->second;
+            }
+            return histograms_[method];
+        }
+    }
+
+    struct MethodPercentiles {
+        std::string method;
+        LatencyHistogram::Percentiles latency;
+    };
+
+    std::vector<MethodPercentiles> snapshot() const {
+        std::vector<MethodPercentiles> out;
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.reserve(histograms_.size());
+        for (const auto& [method, histogram] : histograms_) {
+            out.push_back({method, histogram.percentiles()});
+        }
+        return out;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, LatencyHistogram> histograms_;
+};
+
+} // namespace server
+} // namespace mcp
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <json/json.h>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Cached pre-serialized result payload for the list endpoints.
+ *
+ * tools/list and resources/list re-serialized the full registry on
+ * every request, and clients call them on every connect; with a couple
+ * hundred registered tools that is milliseconds of Json::Value
+ * traversal per call. This caches the serialized result object (the
+ * `{"tools":[...]}` / `{"resources":[...]}` text) so a list call
+ * splices a ready buffer into the response envelope — effectively a
+ * memcpy. The registry mutators (registerTool/unregisterTool and the
+ * resource/prompt equivalents) call invalidate(); the next list request
+ * rebuilds once.
+ *
+ * get() hands out a shared_ptr so a response being written out keeps
+ * its buffer alive across a concurrent invalidation. The builder runs
+ * under the cache mutex, which is fine: registry changes are rare and
+ * list rebuilds must not stampede.
+ */
+class ListSnapshot {
+public:
+    /** Produces the result object from the live registry */
+    using Builder = std::function<Json::Value()>;
+
+    explicit ListSnapshot(Builder builder) : builder_(std::move(builder)) {}
+
+    /** Returns the serialized result payload, rebuilding if stale */
+    std::shared_ptr<const std::string> get() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!serialized_) {
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            serialized_ = std::make_shared<const std::string>(
+                Json::writeString(writer, builder_()));
+        }
+        return serialized_;
+    }
+
+    /** Drops the cached buffer; called by registry mutators */
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        serialized_.reset();
+    }
+
+private:
+    Builder builder_;
+    std::mutex mutex_;
+    std::shared_ptr<const std::string> serialized_;
+};
+
+} // namespace server
+} // namespace mcp
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Compile-time method dispatch for the fixed MCP method set.
+ *
+ * processMessage routed methods through a chain of string comparisons;
+ * at bridge rates (tens of thousands of requests per second on stdio)
+ * the repeated strcmp walk is measurable. The method set is fixed by
+ * the protocol, so the name -> handler mapping is a perfect hash built
+ * at compile time: one FNV-1a pass over the name, one masked index
+ * into a constexpr table, one string compare to confirm. Unknown
+ * methods fall out as Method::Unknown and only then hit the server's
+ * dynamic fallback (MethodNotFound or an extension registry).
+ *
+ * The table is validated at compile time: a collision between protocol
+ * methods fails the build, so growing the set just means adding a line
+ * here (and bumping kTableSize if the compiler complains).
+ */
+enum class Method : uint8_t {
+    Initialize,
+    Initialized,
+    Shutdown,
+    ToolsList,
+    ToolsCall,
+    ResourcesList,
+    ResourcesRead,
+    ResourcesSubscribe,
+    PromptsList,
+    PromptsGet,
+    LoggingSetLevel,
+    Unknown,
+};
+
+namespace detail {
+
+inline constexpr std::pair<std::string_view, Method> kMethodNames[] = {
+    {"initialize", Method::Initialize},
+    {"notifications/initialized", Method::Initialized},
+    {"shutdown", Method::Shutdown},
+    {"tools/list", Method::ToolsList},
+    {"tools/call", Method::ToolsCall},
+    {"resources/list", Method::ResourcesList},
+    {"resources/read", Method::ResourcesRead},
+    {"resources/subscribe", Method::ResourcesSubscribe},
+    {"prompts/list", Method::PromptsList},
+    {"prompts/get", Method::PromptsGet},
+    {"logging/setLevel", Method::LoggingSetLevel},
+};
+
+constexpr uint64_t fnv1a(std::string_view s) {
+    uint64_t hash = 1469598103934665603ull;
+    for (char c : s) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Power of two so the modulo is a mask; sized for a collision-free
+// placement of the current method set
+inline constexpr size_t kTableSize = 64;
+
+struct Slot {
+    std::string_view name;
+    Method method = Method::Unknown;
+};
+
+consteval std::array<Slot, kTableSize> buildMethodTable() {
+    std::array<Slot, kTableSize> table{};
+    for (const auto& [name, method] : kMethodNames) {
+        const size_t index = fnv1a(name) & (kTableSize - 1);
+        if (!table[index].name.empty()) {
+            // Forces a compile error on hash collision; enlarge
+            // kTableSize when this fires
+            throw "method hash collision";
+        }
+        table[index] = {name, method};
+    }
+    return table;
+}
+
+inline constexpr auto kMethodTable = buildMethodTable();
+
+} // namespace detail
+
+/** One hash, one index, one confirming compare */
+constexpr Method methodFromName(std::string_view name) {
+    const detail::Slot& slot =
+        detail::kMethodTable[detail::fnv1a(name) & (detail::kTableSize - 1)];
+    return slot.name == name ? slot.method : Method::Unknown;
+}
+
+static_assert(methodFromName("tools/call") == Method::ToolsCall);
+static_assert(methodFromName("resources/read") == Method::ResourcesRead);
+static_assert(methodFromName("tools/cal") == Method::Unknown);
+static_assert(methodFromName("") == Method::Unknown);
+
+} // namespace server
+} // namespace mcp
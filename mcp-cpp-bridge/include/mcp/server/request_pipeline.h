@@ -0,0 +1,113 @@
+#pragma once
+
+#include "mcp/core/protocol.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Per-transport request pipelining.
+ *
+ * processMessage used to run one request per transport to completion
+ * before the next was looked at, so a slow tools/call blocked a cheap
+ * resources/list arriving behind it on the same stdio/TCP connection.
+ * A RequestPipeline instead admits up to maxConcurrent requests at
+ * once: each runs on the supplied executor (the server's worker pool)
+ * and its response is handed to the sink the moment it completes.
+ * JSON-RPC responses carry their request id, so the client matches
+ * out-of-order completions and introspection calls never queue behind
+ * heavy tool executions.
+ *
+ * Admission is bounded: submit() returns false at the limit (the
+ * server answers with a busy error rather than reading the transport
+ * dry into an unbounded backlog) and duplicate in-flight ids are
+ * rejected as InvalidRequest per spec.
+ */
+class RequestPipeline {
+public:
+    /** Runs a task, typically by queueing it on a worker pool */
+    using Executor = std::function<void(std::function<void()> task)>;
+    /** Delivers a completed response back to this transport */
+    using ResponseSink = std::function<void(Protocol::Response&&)>;
+    /** Computes the response for one request; runs on the executor */
+    using Handler = std::function<Protocol::Response(const Protocol::Request&)>;
+
+    RequestPipeline(size_t maxConcurrent, Executor executor, ResponseSink sink)
+        : maxConcurrent_(maxConcurrent == 0 ? 1 : maxConcurrent)
+        , executor_(std::move(executor))
+        , sink_(std::move(sink)) {}
+
+    RequestPipeline(const RequestPipeline&) = delete;
+    RequestPipeline& operator=(const RequestPipeline&) = delete;
+
+    /**
+     * Admits a request for concurrent execution. Returns false when the
+     * transport already has maxConcurrent requests in flight or the id
+     * duplicates one of them; the caller replies with an error and does
+     * not execute the handler.
+     */
+    bool submit(Protocol::Request req, Handler handler) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (inFlight_ >= maxConcurrent_) {
+                return false;
+            }
+            if (req.id && !inFlightIds_.insert(*req.id).second) {
+                return false; // duplicate in-flight id
+            }
+            ++inFlight_;
+        }
+
+        executor_([this, req = std::move(req),
+                   handler = std::move(handler)]() mutable {
+            Protocol::Response resp = handler(req);
+            if (req.id) {
+                resp.id = *req.id;
+            }
+            // Completion order is arrival order of results, not of
+            // requests; the id ties each response to its request
+            sink_(std::move(resp));
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (req.id) {
+                    inFlightIds_.erase(*req.id);
+                }
+                --inFlight_;
+            }
+            idle_.notify_all();
+        });
+        return true;
+    }
+
+    [[nodiscard]] size_t inFlight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inFlight_;
+    }
+
+    /** Blocks until every admitted request has completed (shutdown) */
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return inFlight_ == 0; });
+    }
+
+private:
+    const size_t maxConcurrent_;
+    Executor executor_;
+    ResponseSink sink_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    size_t inFlight_ = 0;
+    std::set<Protocol::Id> inFlightIds_;
+};
+
+} // namespace server
+} // namespace mcp
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "mcp/core/protocol.h"
+#include "mcp/server/latency_histogram.h"
+#include "mcp/server/list_snapshot.h"
+#include "mcp/server/method_table.h"
+#include "mcp/server/request_pipeline.h"
+#include "mcp/server/stream_result.h"
+#include "mcp/server/subscription_hub.h"
+#include "mcp/server/worker_stats.h"
 #include "mcp/transport/transport.h"
 #include <memory>
 #include <unordered_map>
@@ -33,15 +40,26 @@ public:
         size_t workerThreads = 4;
         size_t maxConcurrentRequests = 100;
         std::chrono::milliseconds requestTimeout{30000};
+
+        // Coalescing window for resources/updated notifications; all
+        // changes to a subscriber's resources inside one window flush
+        // as a single (possibly batch) frame. See subscription_hub.h.
+        std::chrono::milliseconds subscriptionCoalesceWindow{50};
         
         // Logging
         int logLevel = 2; // Info level
     };
     
-    explicit Server(Config config = {});
+    // Overload pair rather than a defaulted argument: GCC cannot use a
+    // nested class with member initializers as a default inside the
+    // enclosing class
+    Server() : Server(Config()) {}
+    explicit Server(Config config);
     ~Server();
     
-    // Tool management
+    // Tool management. Mutators invalidate the ListSnapshot backing
+    // tools/list, so the next list request rebuilds the serialized
+    // payload once instead of every call doing so.
     void registerTool(Tool tool);
     void unregisterTool(const std::string& name);
     
@@ -68,8 +86,24 @@ public:
         uint64_t requestsFailed = 0;
         uint64_t notificationsReceived = 0;
         std::chrono::milliseconds avgResponseTime{0};
+
+        // Per-method latency distribution (microseconds), recorded
+        // with a steady_clock delta on the processMessage path; the
+        // average above hides the p99 spikes these expose.
+        struct MethodLatency {
+            std::string method;
+            uint64_t p50Micros = 0;
+            uint64_t p90Micros = 0;
+            uint64_t p99Micros = 0;
+            uint64_t maxMicros = 0;
+            uint64_t samples = 0;
+        };
+        std::vector<MethodLatency> methodLatencies;
     };
-    
+
+    // Aggregates the per-worker WorkerStatsRegistry slots lazily;
+    // sampling never blocks the request path (workers only touch their
+    // own padded counters, see worker_stats.h).
     Stats getStats() const;
     
 private:
@@ -81,11 +115,24 @@ private:
     void handleInitialized(const Protocol::Notification& notif);
     void handleShutdown(const Protocol::Request& req);
     
+    // Serves the pre-serialized ListSnapshot payload (see
+    // list_snapshot.h); resources/list and prompts/list do the same
     void handleToolsList(const Protocol::Request& req);
     void handleToolsCall(const Protocol::Request& req);
+
+    // Streaming tools/call: when the tool has a streamingHandler, its
+    // chunks are forwarded as partialResult notifications while it runs
+    // (ToolResultStream, bounded by transport acknowledgements) and the
+    // closing response carries no payload. Buffered tools are untouched.
+    void handleToolsCallStreaming(const Protocol::Request& req,
+                                  std::shared_ptr<transport::Transport> transport);
     
     void handleResourcesList(const Protocol::Request& req);
     void handleResourcesRead(const Protocol::Request& req);
+
+    // Registers the (transport, uri) pair with the SubscriptionHub;
+    // change notifications are coalesced per subscriber within
+    // Config::subscriptionCoalesceWindow instead of sent per change
     void handleResourcesSubscribe(const Protocol::Request& req);
     
     void handlePromptsList(const Protocol::Request& req);
@@ -93,8 +140,16 @@ private:
     
     void handleLoggingSetLevel(const Protocol::Request& req);
     
-    // Internal message processing
-    void processMessage(const Protocol::Message& msg, 
+    // Internal message processing. Methods dispatch through the
+    // compile-time perfect hash in method_table.h (one hash, one index,
+    // one confirming compare) rather than a string comparison chain;
+    // only Method::Unknown reaches the dynamic fallback.
+    // Requests are admitted to the
+    // transport's RequestPipeline (bounded by
+    // Config::maxConcurrentRequests) and execute concurrently on the
+    // worker pool; responses go out as they complete, keyed by JSON-RPC
+    // id, so a slow tools/call no longer serializes the transport.
+    void processMessage(const Protocol::Message& msg,
                        std::shared_ptr<transport::Transport> transport);
     void sendResponse(const Protocol::Response& resp,
                      std::shared_ptr<transport::Transport> transport);
@@ -113,6 +168,7 @@ public:
     ServerBuilder& withWorkerThreads(size_t count);
     ServerBuilder& withMaxConcurrentRequests(size_t max);
     ServerBuilder& withRequestTimeout(std::chrono::milliseconds timeout);
+    ServerBuilder& withSubscriptionCoalesceWindow(std::chrono::milliseconds window);
     ServerBuilder& withLogLevel(int level);
     
     ServerBuilder& addTool(Tool tool);
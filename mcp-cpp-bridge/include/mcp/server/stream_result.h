@@ -0,0 +1,144 @@
+#pragma once
+
+#include "mcp/core/protocol.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Streaming result channel for tool calls.
+ *
+ * handleToolsCall used to buffer the complete tool result before
+ * sendResponse, so a tool tailing a 100MB log made the client wait for
+ * the whole payload while the server held it in RAM. A streaming tool
+ * writes chunks into a ToolResultStream instead: each chunk goes out
+ * immediately as a "notifications/tools/partialResult" notification
+ * carrying the originating request id and a sequence number, and the
+ * final (empty-result) response only marks completion. First-byte
+ * latency is one chunk, not one payload.
+ *
+ * Memory stays constant through producer-side backpressure: write()
+ * blocks while more than maxInFlightBytes of chunks are unacknowledged.
+ * The transport layer calls acknowledge() as writes drain; a slow
+ * client therefore throttles the tool instead of growing a buffer.
+ *
+ * The sink is whatever delivers a notification to this request's
+ * transport (the server binds sendNotification); it may be called from
+ * the tool's worker thread only.
+ */
+class ToolResultStream {
+public:
+    using ChunkSink = std::function<void(Protocol::Notification&&)>;
+
+    static constexpr size_t kDefaultMaxInFlightBytes = 256 * 1024;
+
+    ToolResultStream(Protocol::Id requestId, ChunkSink sink,
+                     size_t maxInFlightBytes = kDefaultMaxInFlightBytes)
+        : requestId_(std::move(requestId))
+        , sink_(std::move(sink))
+        , maxInFlightBytes_(maxInFlightBytes) {}
+
+    ToolResultStream(const ToolResultStream&) = delete;
+    ToolResultStream& operator=(const ToolResultStream&) = delete;
+
+    /**
+     * Emits one result chunk; blocks while the transport is more than
+     * maxInFlightBytes behind. Returns false once the stream is closed
+     * (e.g. client went away) so tools can stop producing.
+     */
+    bool write(std::string chunk) {
+        const size_t bytes = chunk.size();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            drained_.wait(lock, [this, bytes] {
+                return closed_ || inFlightBytes_ + bytes <= maxInFlightBytes_;
+            });
+            if (closed_) {
+                return false;
+            }
+            inFlightBytes_ += bytes;
+        }
+
+        Protocol::Notification notif;
+        notif.method = "notifications/tools/partialResult";
+        Json::Value params;
+        params["requestId"] = idToJson();
+        params["seq"] = static_cast<Json::UInt64>(sequence_++);
+        params["chunk"] = std::move(chunk);
+        notif.params = std::move(params);
+        sink_(std::move(notif));
+        return true;
+    }
+
+    /**
+     * Transport-side: credits bytes back once their chunk notification
+     * has been written out, releasing any blocked writer
+     */
+    void acknowledge(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlightBytes_ = bytes < inFlightBytes_ ? inFlightBytes_ - bytes : 0;
+        }
+        drained_.notify_all();
+    }
+
+    /**
+     * Ends the stream: a final notification with "done" set tells the
+     * client no more chunks follow. Idempotent; also used by the server
+     * to abort a stream whose transport disappeared, in which case
+     * pending write() calls return false.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            closed_ = true;
+        }
+        drained_.notify_all();
+
+        Protocol::Notification notif;
+        notif.method = "notifications/tools/partialResult";
+        Json::Value params;
+        params["requestId"] = idToJson();
+        params["seq"] = static_cast<Json::UInt64>(sequence_++);
+        params["done"] = true;
+        notif.params = std::move(params);
+        sink_(std::move(notif));
+    }
+
+    [[nodiscard]] const Protocol::Id& requestId() const { return requestId_; }
+    [[nodiscard]] uint64_t chunksWritten() const { return sequence_; }
+
+private:
+    Json::Value idToJson() const {
+        if (const auto* num = std::get_if<int64_t>(&requestId_)) {
+            return Json::Value(static_cast<Json::Int64>(*num));
+        }
+        if (const auto* str = std::get_if<std::string>(&requestId_)) {
+            return Json::Value(*str);
+        }
+        return Json::Value();
+    }
+
+    Protocol::Id requestId_;
+    ChunkSink sink_;
+    size_t maxInFlightBytes_;
+
+    std::mutex mutex_;
+    std::condition_variable drained_;
+    size_t inFlightBytes_ = 0;
+    bool closed_ = false;
+    uint64_t sequence_ = 0;
+};
+
+} // namespace server
+} // namespace mcp
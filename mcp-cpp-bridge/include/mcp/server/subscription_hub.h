@@ -0,0 +1,244 @@
+#pragma once
+
+#include "mcp/core/protocol.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Coalesced resource-change notifications for resources/subscribe.
+ *
+ * A naive implementation emits one notifications/resources/updated per
+ * change per subscriber, so a log-tail resource mutating hundreds of
+ * times a second multiplies change rate by subscriber count into wire
+ * traffic. The hub instead marks the URI dirty in the subscriber's
+ * pending set and arms a coalescing window (default 50ms) the first
+ * time; further changes inside the window collapse into that entry —
+ * latest-value-wins, which for resources/updated (the notification
+ * carries only the URI, the client re-reads) means pure deduplication.
+ *
+ * When a subscriber's window expires its pending URIs flush as a single
+ * frame: one serialized notification, or one JSON-RPC batch array when
+ * several resources changed together, so a burst costs each subscriber
+ * one write per window regardless of change rate.
+ *
+ * The server registers one subscriber per transport session (the sink
+ * binds transport->send) and maps resources/subscribe requests onto
+ * subscribe(). Frames are built and the sink invoked on the hub's
+ * flusher thread, off the request path; sinks must tolerate that.
+ */
+class SubscriptionHub {
+public:
+    /** Writes one serialized frame to the subscriber's transport */
+    using FrameSink = std::function<void(std::string&&)>;
+
+    explicit SubscriptionHub(
+        std::chrono::milliseconds window = std::chrono::milliseconds(50))
+        : window_(window.count() < 1 ? std::chrono::milliseconds(1) : window) {
+        flusher_ = std::thread([this] { flushLoop(); });
+    }
+
+    ~SubscriptionHub() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (flusher_.joinable()) {
+            flusher_.join();
+        }
+    }
+
+    SubscriptionHub(const SubscriptionHub&) = delete;
+    SubscriptionHub& operator=(const SubscriptionHub&) = delete;
+
+    /** Registers a transport session; the token scopes its subscriptions */
+    uint64_t addSubscriber(FrameSink sink) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t token = nextToken_++;
+        subscribers_.emplace(token, Subscriber{std::move(sink), {}, {}});
+        return token;
+    }
+
+    /** Drops the session and everything it subscribed to (disconnect) */
+    void removeSubscriber(uint64_t token) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(token);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        for (const auto& uri : it->second.uris) {
+            auto watchers = watchers_.find(uri);
+            if (watchers != watchers_.end()) {
+                watchers->second.erase(token);
+                if (watchers->second.empty()) {
+                    watchers_.erase(watchers);
+                }
+            }
+        }
+        subscribers_.erase(it);
+    }
+
+    void subscribe(uint64_t token, const std::string& uri) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(token);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        it->second.uris.insert(uri);
+        watchers_[uri].insert(token);
+    }
+
+    void unsubscribe(uint64_t token, const std::string& uri) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(token);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        it->second.uris.erase(uri);
+        it->second.pending.erase(uri);
+        auto watchers = watchers_.find(uri);
+        if (watchers != watchers_.end()) {
+            watchers->second.erase(token);
+            if (watchers->second.empty()) {
+                watchers_.erase(watchers);
+            }
+        }
+    }
+
+    /**
+     * Records that the resource changed. Cheap by design — the caller
+     * may invoke it hundreds of times per second: each watcher's
+     * pending set absorbs the duplicate and only a subscriber going
+     * from clean to dirty arms a deadline and wakes the flusher.
+     */
+    void publish(const std::string& uri) {
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto watchers = watchers_.find(uri);
+            if (watchers == watchers_.end()) {
+                return;
+            }
+            const auto due = std::chrono::steady_clock::now() + window_;
+            for (uint64_t token : watchers->second) {
+                Subscriber& sub = subscribers_[token];
+                if (sub.pending.empty()) {
+                    sub.due = due;
+                    wake = true;
+                }
+                sub.pending.insert(uri);
+            }
+        }
+        if (wake) {
+            wake_.notify_all();
+        }
+    }
+
+    /** Pending URIs across all subscribers (stats/introspection) */
+    [[nodiscard]] size_t pendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t total = 0;
+        for (const auto& entry : subscribers_) {
+            total += entry.second.pending.size();
+        }
+        return total;
+    }
+
+private:
+    struct Subscriber {
+        FrameSink sink;
+        std::set<std::string> uris;    // everything subscribed
+        std::set<std::string> pending; // dirty within the open window
+        std::chrono::steady_clock::time_point due{};
+    };
+
+    static Protocol::Notification makeUpdated(const std::string& uri) {
+        Protocol::Notification notif;
+        notif.method = "notifications/resources/updated";
+        Json::Value params;
+        params["uri"] = uri;
+        notif.params = std::move(params);
+        return notif;
+    }
+
+    void flushLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            // Sleep until the earliest armed deadline (or a new one)
+            auto next = std::chrono::steady_clock::time_point::max();
+            for (const auto& entry : subscribers_) {
+                if (!entry.second.pending.empty() && entry.second.due < next) {
+                    next = entry.second.due;
+                }
+            }
+            if (next == std::chrono::steady_clock::time_point::max()) {
+                wake_.wait(lock);
+            } else {
+                wake_.wait_until(lock, next);
+            }
+            if (stopping_) {
+                break;
+            }
+
+            // Collect every due subscriber's frame, then send outside
+            // the lock so a slow transport cannot stall publish()
+            const auto now = std::chrono::steady_clock::now();
+            std::vector<std::pair<FrameSink, std::string>> out;
+            for (auto& entry : subscribers_) {
+                Subscriber& sub = entry.second;
+                if (sub.pending.empty() || sub.due > now) {
+                    continue;
+                }
+                std::string frame;
+                if (sub.pending.size() == 1) {
+                    frame = Protocol::serialize(
+                        Protocol::Message{makeUpdated(*sub.pending.begin())});
+                } else {
+                    std::vector<Protocol::Message> batch;
+                    batch.reserve(sub.pending.size());
+                    for (const auto& uri : sub.pending) {
+                        batch.emplace_back(makeUpdated(uri));
+                    }
+                    frame = Protocol::serializeBatch(batch);
+                }
+                sub.pending.clear();
+                out.emplace_back(sub.sink, std::move(frame));
+            }
+
+            if (!out.empty()) {
+                lock.unlock();
+                for (auto& item : out) {
+                    item.first(std::move(item.second));
+                }
+                lock.lock();
+            }
+        }
+    }
+
+    const std::chrono::milliseconds window_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::map<uint64_t, Subscriber> subscribers_;
+    std::unordered_map<std::string, std::set<uint64_t>> watchers_;
+    uint64_t nextToken_ = 1;
+    bool stopping_ = false;
+    std::thread flusher_;
+};
+
+} // namespace server
+} // namespace mcp
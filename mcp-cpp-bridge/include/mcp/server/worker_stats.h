@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mcp {
+namespace server {
+
+/**
+ * Per-worker-thread request counters, padded to a cache line so workers
+ * never false-share. Each worker only ever writes its own slot with
+ * relaxed stores, making the request-path instrumentation wait-free;
+ * readers (getStats) sum across all slots lazily.
+ */
+struct alignas(64) WorkerCounters {
+    std::atomic<uint64_t> requestsReceived{0};
+    std::atomic<uint64_t> requestsProcessed{0};
+    std::atomic<uint64_t> requestsFailed{0};
+    std::atomic<uint64_t> notificationsReceived{0};
+    // Sum of response times in microseconds; divided by
+    // requestsProcessed at aggregation time to recover the average.
+    std::atomic<uint64_t> responseTimeMicrosTotal{0};
+
+    void recordReceived() {
+        requestsReceived.fetch_add(1, std::memory_order_relaxed);
+    }
+    void recordProcessed(uint64_t responseMicros) {
+        requestsProcessed.fetch_add(1, std::memory_order_relaxed);
+        responseTimeMicrosTotal.fetch_add(responseMicros, std::memory_order_relaxed);
+    }
+    void recordFailed() {
+        requestsFailed.fetch_add(1, std::memory_order_relaxed);
+    }
+    void recordNotification() {
+        notificationsReceived.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Registry handing each worker thread its own WorkerCounters slot.
+ *
+ * local() takes the registration mutex only on a thread's first call;
+ * afterwards the slot reference is cached in a thread_local and the
+ * request path touches no shared state. aggregate() walks the slots
+ * with acquire loads, so sampling from a metrics exporter never stalls
+ * request processing.
+ */
+class WorkerStatsRegistry {
+public:
+    struct Totals {
+        uint64_t requestsReceived = 0;
+        uint64_t requestsProcessed = 0;
+        uint64_t requestsFailed = 0;
+        uint64_t notificationsReceived = 0;
+        uint64_t responseTimeMicrosTotal = 0;
+    };
+
+    WorkerCounters& local() {
+        thread_local WorkerCounters* slot = nullptr;
+        if (!slot) {
+            std::lock_guard<std::mutex> lock(registerMutex_);
+            slots_.push_back(std::make_unique<WorkerCounters>());
+            slot = slots_.back().get();
+        }
+        return *slot;
+    }
+
+    Totals aggregate() const {
+        Totals totals;
+        std::lock_guard<std::mutex> lock(registerMutex_);
+        for (const auto& slot : slots_) {
+            totals.requestsReceived +=
+                slot->requestsReceived.load(std::memory_order_acquire);
+            totals.requestsProcessed +=
+                slot->requestsProcessed.load(std::memory_order_acquire);
+            totals.requestsFailed +=
+                slot->requestsFailed.load(std::memory_order_acquire);
+            totals.notificationsReceived +=
+                slot->notificationsReceived.load(std::memory_order_acquire);
+            totals.responseTimeMicrosTotal +=
+                slot->responseTimeMicrosTotal.load(std::memory_order_acquire);
+        }
+        return totals;
+    }
+
+private:
+    // Guards slot registration and the aggregation walk, never the
+    // per-request increments.
+    mutable std::mutex registerMutex_;
+    std::vector<std::unique_ptr<WorkerCounters>> slots_;
+};
+
+} // namespace server
+} // namespace mcp
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "mcp/transport/transport.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace mcp {
+namespace transport {
+
+/**
+ * Stdio transport: newline-delimited JSON-RPC over a pipe pair, the
+ * framing the Python modules speak and the highest-traffic path into
+ * the bridge.
+ *
+ * The transport owns one fixed receive buffer. read() appends into it,
+ * frame boundaries are tracked by index, and every complete line is
+ * handed to the callback as a contiguous view into that buffer — no
+ * per-message string is ever built. When everything read so far has
+ * been consumed the indexes rewind to zero for free; only when a
+ * partial frame is stranded at the end of the buffer is it compacted
+ * to the front with one memmove. Steady state is therefore
+ * allocation-free and copies nothing beyond the read() itself.
+ *
+ * A single frame larger than the buffer can never be delivered, so it
+ * ends the stream rather than silently truncating; kBufferBytes is a
+ * megabyte, far beyond any envelope the bridge exchanges.
+ */
+class StdioTransport : public Transport {
+public:
+    // Upper bound on one frame including its newline
+    static constexpr size_t kBufferBytes = 1u << 20;
+
+    explicit StdioTransport(int inFd = 0, int outFd = 1)
+        : inFd_(inFd), outFd_(outFd), buffer_(kBufferBytes) {}
+
+    ~StdioTransport() override { stop(); }
+
+    StdioTransport(const StdioTransport&) = delete;
+    StdioTransport& operator=(const StdioTransport&) = delete;
+
+    void start(MessageCallback onMessage) override {
+        if (running_.exchange(true)) {
+            return;
+        }
+        reader_ = std::thread([this, onMessage = std::move(onMessage)] {
+            readLoop(onMessage);
+        });
+    }
+
+    void stop() override {
+        if (!running_.exchange(false)) {
+            if (reader_.joinable()) {
+                reader_.join();
+            }
+            return;
+        }
+        if (reader_.joinable()) {
+            reader_.join();
+        }
+    }
+
+    bool send(const std::string& message) override {
+        // One gathered write per frame so payload and terminator cannot
+        // interleave with another sender's output
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        char newline = '\n';
+        size_t sent = 0;
+        const size_t total = message.size() + 1;
+        while (sent < total) {
+            struct iovec iov[2];
+            int iovcnt = 0;
+            if (sent < message.size()) {
+                iov[iovcnt].iov_base =
+                    const_cast<char*>(message.data()) + sent;
+                iov[iovcnt].iov_len = message.size() - sent;
+                ++iovcnt;
+            }
+            iov[iovcnt].iov_base = &newline;
+            iov[iovcnt].iov_len = 1;
+            ++iovcnt;
+            const ssize_t n = ::writev(outFd_, iov, iovcnt);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    std::string name() const override { return "stdio"; }
+
+private:
+    void readLoop(const MessageCallback& onMessage) {
+        size_t frameStart = 0; // first byte of the oldest unconsumed frame
+        size_t fill = 0;       // one past the last byte read
+        size_t scanned = 0;    // newline search resumes here
+        while (running_.load(std::memory_order_acquire)) {
+            // Bounded poll keeps stop() prompt without a signal channel
+            struct pollfd pfd{};
+            pfd.fd = inFd_;
+            pfd.events = POLLIN;
+            const int ready = ::poll(&pfd, 1, 100);
+            if (ready <= 0) {
+                continue; // timeout or EINTR; re-check running_
+            }
+            if (fill == buffer_.size()) {
+                if (frameStart == 0) {
+                    // Oversized frame: it can never complete in-buffer
+                    break;
+                }
+                // Wrap: move the stranded partial frame to the front
+                std::memmove(buffer_.data(), buffer_.data() + frameStart,
+                             fill - frameStart);
+                fill -= frameStart;
+                scanned -= frameStart;
+                frameStart = 0;
+            }
+            const ssize_t n =
+                ::read(inFd_, buffer_.data() + fill, buffer_.size() - fill);
+            if (n == 0) {
+                break; // EOF: peer closed its end
+            }
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            fill += static_cast<size_t>(n);
+            // Deliver every complete line now in the buffer
+            for (;;) {
+                const void* nl = std::memchr(buffer_.data() + scanned, '\n',
+                                             fill - scanned);
+                if (nl == nullptr) {
+                    scanned = fill;
+                    break;
+                }
+                const size_t nlPos =
+                    static_cast<size_t>(static_cast<const char*>(nl) -
+                                        buffer_.data());
+                size_t frameEnd = nlPos;
+                if (frameEnd > frameStart && buffer_[frameEnd - 1] == '\r') {
+                    --frameEnd; // tolerate CRLF peers
+                }
+                if (frameEnd > frameStart) {
+                    onMessage(std::string_view(buffer_.data() + frameStart,
+                                               frameEnd - frameStart));
+                }
+                frameStart = nlPos + 1;
+                scanned = frameStart;
+            }
+            if (frameStart == fill) {
+                // Everything consumed: rewind without copying
+                frameStart = fill = scanned = 0;
+            }
+        }
+        running_.store(false, std::memory_order_release);
+    }
+
+    int inFd_;
+    int outFd_;
+    std::vector<char> buffer_;
+    std::atomic<bool> running_{false};
+    std::thread reader_;
+    std::mutex sendMutex_;
+};
+
+} // namespace transport
+} // namespace mcp
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace mcp {
+namespace transport {
+
+/**
+ * Message transport abstraction used by mcp::server::Server.
+ *
+ * A transport moves opaque serialized messages (JSON-RPC text) between
+ * the server and one peer. The server owns registered transports via
+ * addTransport and drives their lifecycle; incoming messages are
+ * delivered on the transport's own reader thread through the callback
+ * handed to start().
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * Delivers one inbound serialized message. The view aliases the
+     * transport's receive buffer and is valid only for the duration of
+     * the callback — the next read reuses those bytes. A handler that
+     * defers work must copy what it keeps; one that parses inline
+     * (Protocol::parse) never pays a per-message string.
+     */
+    using MessageCallback = std::function<void(std::string_view message)>;
+
+    /** Begins reading; onMessage fires on the transport's thread */
+    virtual void start(MessageCallback onMessage) = 0;
+
+    /** Stops reading and releases the channel; idempotent */
+    virtual void stop() = 0;
+
+    /** Writes one serialized message to the peer */
+    virtual bool send(const std::string& message) = 0;
+
+    /** Short identifier for logs and stats ("stdio", "tcp", "shm") */
+    virtual std::string name() const = 0;
+};
+
+} // namespace transport
+} // namespace mcp
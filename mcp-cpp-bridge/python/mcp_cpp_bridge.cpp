@@ -17,12 +17,43 @@ using namespace mcp;
 
 // JSON conversion helpers for jsoncpp
 namespace {
+    // Payloads at or above this size cross into Python as memoryview
+    // objects over C++-owned storage instead of copied str objects.
+    constexpr size_t kZeroCopyThreshold = 64 * 1024;
+
+    // Owns a large payload on the C++ side and exposes it through the
+    // buffer protocol; Python sees a read-only memoryview and the
+    // bytes are never copied into the interpreter heap.
+    class ResultBuffer {
+    public:
+        explicit ResultBuffer(std::string data) : data_(std::move(data)) {}
+
+        const char* data() const { return data_.data(); }
+        size_t size() const { return data_.size(); }
+
+    private:
+        std::string data_;
+    };
+
+    py::object wrap_payload(std::string data) {
+        // The memoryview holds a reference to the cast ResultBuffer
+        // object, which keeps the storage alive.
+        py::object owner = py::cast(ResultBuffer(std::move(data)));
+        return py::memoryview(owner);
+    }
+
     py::object json_to_python(const Json::Value& j) {
         if (j.isNull()) return py::none();
         if (j.isBool()) return py::bool_(j.asBool());
         if (j.isInt()) return py::int_(j.asInt64());
         if (j.isDouble()) return py::float_(j.asDouble());
-        if (j.isString()) return py::str(j.asString());
+        if (j.isString()) {
+            std::string s = j.asString();
+            if (s.size() >= kZeroCopyThreshold) {
+                return wrap_payload(std::move(s));
+            }
+            return py::str(s);
+        }
         
         if (j.isArray()) {
             py::list lst;
@@ -66,6 +97,17 @@ namespace {
             return result;
         }
         
+        if (py::isinstance<py::bytes>(obj) || py::isinstance<py::bytearray>(obj) ||
+            py::isinstance<py::memoryview>(obj)) {
+            // Accept buffer objects coming back from handlers; the copy
+            // is unavoidable here because jsoncpp owns its strings.
+            py::buffer buf = py::reinterpret_borrow<py::buffer>(obj);
+            py::buffer_info info = buf.request();
+            result = std::string(static_cast<const char*>(info.ptr),
+                                 static_cast<size_t>(info.size) * info.itemsize);
+            return result;
+        }
+
         if (py::isinstance<py::list>(obj) || py::isinstance<py::tuple>(obj)) {
             result = Json::Value(Json::arrayValue);
             for (const auto& item : obj) {
@@ -92,6 +134,19 @@ PYBIND11_MODULE(mcp_cpp_bridge, m) {
     // Protocol module
     auto protocol = m.def_submodule("protocol", "MCP Protocol definitions");
     
+    py::class_<ResultBuffer>(protocol, "ResultBuffer", py::buffer_protocol())
+        .def_buffer([](ResultBuffer& b) -> py::buffer_info {
+            return py::buffer_info(
+                const_cast<char*>(b.data()), sizeof(char),
+                py::format_descriptor<char>::format(), 1,
+                {b.size()}, {sizeof(char)}, /*readonly=*/true);
+        })
+        .def("__len__", &ResultBuffer::size)
+        .def("to_bytes", [](const ResultBuffer& b) {
+            // Explicit copy for callers that need an owned bytes object
+            return py::bytes(b.data(), b.size());
+        });
+
     py::enum_<Protocol::ErrorCode>(protocol, "ErrorCode")
         .value("ParseError", Protocol::ErrorCode::ParseError)
         .value("InvalidRequest", Protocol::ErrorCode::InvalidRequest)
@@ -165,10 +220,15 @@ PYBIND11_MODULE(mcp_cpp_bridge, m) {
         .def("unregister_resource", &server::Server::unregister_resource)
         .def("register_prompt", &server::Server::register_prompt)
         .def("unregister_prompt", &server::Server::unregister_prompt)
-        .def("start", &server::Server::start)
-        .def("stop", &server::Server::stop)
+        // Lifecycle and stats calls block in C++; release the GIL so
+        // other Python threads keep running while they do.
+        .def("start", &server::Server::start,
+            py::call_guard<py::gil_scoped_release>())
+        .def("stop", &server::Server::stop,
+            py::call_guard<py::gil_scoped_release>())
         .def("is_running", &server::Server::is_running)
-        .def("get_stats", &server::Server::get_stats);
+        .def("get_stats", &server::Server::get_stats,
+            py::call_guard<py::gil_scoped_release>());
     
     py::class_<server::ServerBuilder>(server_module, "ServerBuilder")
         .def(py::init<>())
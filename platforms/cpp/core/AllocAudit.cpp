@@ -0,0 +1,152 @@
+#include "AllocAudit.h"
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#ifdef WEBGRAB_ALLOC_AUDIT
+#include <malloc.h>
+#endif
+
+namespace {
+
+const char* TagLabel(size_t tag) {
+    switch (static_cast<AllocTag>(tag)) {
+    case AllocTag::NLP: return "nlp";
+    case AllocTag::Context: return "context";
+    case AllocTag::Serialization: return "serialization";
+    case AllocTag::Networking: return "networking";
+    default: return "general";
+    }
+}
+
+} // namespace
+
+AllocAudit& AllocAudit::instance() {
+    // Leaked deliberately (the hooks fire during static destruction),
+    // and built with raw malloc so constructing the recorder never
+    // re-enters the replaced operator new
+    static AllocAudit* audit = new (std::malloc(sizeof(AllocAudit))) AllocAudit();
+    return *audit;
+}
+
+AllocAudit::Shard& AllocAudit::localShard() {
+    // Raw pointer: trivially destructible, so it stays valid for frees
+    // that happen after this thread's other thread_locals are torn
+    // down. The shard itself is owned by the leaked registry.
+    thread_local Shard* shard = [this] {
+        auto s = std::make_shared<Shard>();
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        shards_.push_back(s);
+        return s.get();
+    }();
+    return *shard;
+}
+
+void AllocAudit::recordAlloc(AllocTag tag, size_t bytes) {
+    Shard& shard = localShard();
+    const size_t t = static_cast<size_t>(tag);
+    shard.allocs[t].fetch_add(1, std::memory_order_relaxed);
+    shard.allocBytes[t].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocAudit::recordFree(AllocTag tag, size_t bytes) {
+    Shard& shard = localShard();
+    const size_t t = static_cast<size_t>(tag);
+    shard.frees[t].fetch_add(1, std::memory_order_relaxed);
+    shard.freeBytes[t].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+std::string AllocAudit::report() {
+    uint64_t allocs[kTagCount] = {};
+    uint64_t allocBytes[kTagCount] = {};
+    uint64_t frees[kTagCount] = {};
+    uint64_t freeBytes[kTagCount] = {};
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (const auto& shard : shards_) {
+            for (size_t t = 0; t < kTagCount; t++) {
+                allocs[t] += shard->allocs[t].load(std::memory_order_relaxed);
+                allocBytes[t] += shard->allocBytes[t].load(std::memory_order_relaxed);
+                frees[t] += shard->frees[t].load(std::memory_order_relaxed);
+                freeBytes[t] += shard->freeBytes[t].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::ostringstream out;
+    out << "allocation audit"
+#ifndef WEBGRAB_ALLOC_AUDIT
+        << " (WEBGRAB_ALLOC_AUDIT off; counters inactive)"
+#endif
+        << ":\n";
+    for (size_t t = 0; t < kTagCount; t++) {
+        out << "  " << TagLabel(t) << ": " << allocs[t] << " allocs ("
+            << allocBytes[t] << " B), " << frees[t] << " frees ("
+            << freeBytes[t] << " B)\n";
+    }
+    return out.str();
+}
+
+#ifdef WEBGRAB_ALLOC_AUDIT
+
+namespace {
+
+// The recorder itself allocates (shard registration); the guard keeps
+// those internal allocations from re-entering the hooks
+bool& InHook() {
+    thread_local bool inHook = false;
+    return inHook;
+}
+
+void* AuditedAlloc(size_t size) {
+    void* ptr = std::malloc(size);
+    if (ptr && !InHook()) {
+        InHook() = true;
+        AllocAudit::instance().recordAlloc(AllocScope::current(),
+                                           malloc_usable_size(ptr));
+        InHook() = false;
+    }
+    return ptr;
+}
+
+void AuditedFree(void* ptr) {
+    if (ptr && !InHook()) {
+        InHook() = true;
+        AllocAudit::instance().recordFree(AllocScope::current(),
+                                          malloc_usable_size(ptr));
+        InHook() = false;
+    }
+    std::free(ptr);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* ptr = AuditedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    void* ptr = AuditedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return AuditedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return AuditedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept { AuditedFree(ptr); }
+void operator delete[](void* ptr) noexcept { AuditedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { AuditedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { AuditedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { AuditedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { AuditedFree(ptr); }
+
+#endif // WEBGRAB_ALLOC_AUDIT
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Allocation audit mode for webgrab_lib.
+ *
+ * Built with -DWEBGRAB_ALLOC_AUDIT=ON, global operator new/delete are
+ * wrapped (AllocAudit.cpp) and every allocation is charged to the
+ * subsystem tag active on the calling thread. Subsystem entry points
+ * open an AllocScope; nested scopes restore the outer tag on exit, so
+ * a serialization call made from the NLP path bills serialization.
+ *
+ * Counters use the same wait-free per-thread shard pattern as
+ * HardwareMetrics: the owning thread does relaxed adds, report() sums
+ * the shards. With the option OFF, AllocScope compiles to nothing and
+ * the operators are not replaced — zero overhead.
+ *
+ * This attributes allocations/sec to code regions, which whole-process
+ * tools like massif cannot do, and verifies that arena/pool work
+ * actually removes churn from the tagged paths.
+ */
+enum class AllocTag : uint8_t {
+    General = 0,    // anything outside a tagged scope
+    NLP,
+    Context,
+    Serialization,
+    Networking,
+    kCount,
+};
+
+class AllocAudit {
+public:
+    static AllocAudit& instance();
+
+    // Called from the operator new/delete wrappers; wait-free
+    void recordAlloc(AllocTag tag, size_t bytes);
+    void recordFree(AllocTag tag, size_t bytes);
+
+    // Per-tag allocation count, bytes, and free count; zeros when the
+    // audit build option is off
+    std::string report();
+
+private:
+    AllocAudit() = default;
+
+    static constexpr size_t kTagCount = static_cast<size_t>(AllocTag::kCount);
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> allocs[kTagCount]{};
+        std::atomic<uint64_t> allocBytes[kTagCount]{};
+        std::atomic<uint64_t> frees[kTagCount]{};
+        std::atomic<uint64_t> freeBytes[kTagCount]{};
+    };
+
+    Shard& localShard();
+
+    std::mutex registryMutex_;
+    // Shards live as long as the (deliberately leaked) registry, so a
+    // thread's counters stay summable after it exits and the hooks
+    // stay safe during static destruction
+    std::vector<std::shared_ptr<Shard>> shards_;
+};
+
+#ifdef WEBGRAB_ALLOC_AUDIT
+
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag) : prev_(current()) { current() = tag; }
+    ~AllocScope() { current() = prev_; }
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    static AllocTag& current() {
+        thread_local AllocTag tag = AllocTag::General;
+        return tag;
+    }
+
+private:
+    AllocTag prev_;
+};
+
+#else
+
+// Audit disabled: scopes vanish, no operators are replaced
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag) {}
+};
+
+#endif // WEBGRAB_ALLOC_AUDIT
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Size-classed receive-buffer pool with thread-local free lists
+ *
+ * The accept path allocated a fresh receive buffer per message; at
+ * steady state those were the last per-request allocations left on
+ * ingestion. acquire() hands out a vector whose capacity is rounded up
+ * to a size class (1K to 64K) from the calling thread's free list, and
+ * release() returns it there — no locks and no cross-thread traffic,
+ * since each connection is served by one thread. Requests above the
+ * largest class pass through unpooled but otherwise behave the same.
+ *
+ * Buffers are plain std::vector<uint8_t>, so they flow by move through
+ * the existing receive() and reader interfaces unchanged.
+ */
+class BufferPool {
+public:
+    static constexpr size_t kDefaultReceiveSize = 4096;
+
+    static std::vector<uint8_t> acquire(size_t size) {
+        const int cls = classFor(size);
+        if (cls >= 0) {
+            auto& list = local().byClass[static_cast<size_t>(cls)];
+            if (!list.empty()) {
+                std::vector<uint8_t> buffer = std::move(list.back());
+                list.pop_back();
+                buffer.clear();
+                return buffer;
+            }
+            std::vector<uint8_t> buffer;
+            buffer.reserve(kClassSizes[static_cast<size_t>(cls)]);
+            return buffer;
+        }
+        std::vector<uint8_t> buffer;
+        buffer.reserve(size);
+        return buffer;
+    }
+
+    // Accepts any buffer; only class-sized capacities are kept, and each
+    // class holds at most kMaxPerClass so an idle thread pins a bounded
+    // amount of memory (~680K worst case). Everything else just frees.
+    static void release(std::vector<uint8_t>&& buffer) {
+        for (size_t i = 0; i < kClassCount; ++i) {
+            if (buffer.capacity() == kClassSizes[i]) {
+                auto& list = local().byClass[i];
+                if (list.size() < kMaxPerClass) {
+                    list.push_back(std::move(buffer));
+                }
+                return;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kClassCount = 4;
+    static constexpr std::array<size_t, kClassCount> kClassSizes = {1024, 4096, 16384,
+                                                                   65536};
+    static constexpr size_t kMaxPerClass = 8;
+
+    struct FreeLists {
+        std::array<std::vector<std::vector<uint8_t>>, kClassCount> byClass;
+    };
+
+    static int classFor(size_t size) {
+        for (size_t i = 0; i < kClassCount; ++i) {
+            if (size <= kClassSizes[i]) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    static FreeLists& local() {
+        thread_local FreeLists lists;
+        return lists;
+    }
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+// Cooperative cancellation shared between the abort path and a download
+// job. AbortTask used to reach only jobs that were already transferring,
+// and even those noticed at the next progress event; a token is created
+// when the job registers, so cancel() works in every state:
+//   - still queued: execute() sees the flag and drops the job before it
+//     touches the network
+//   - transferring: the registered hook aborts the in-flight engine
+//     transfer, which curl's progress callback turns into an immediate
+//     CURLE_ABORTED_BY_CALLBACK
+// cancelled() is a relaxed atomic read, safe to poll from any thread.
+class CancellationToken {
+public:
+    // Idempotent; runs the registered hook (once) outside the lock
+    void cancel() {
+        std::function<void()> hook;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (cancelled_.exchange(true)) {
+                return;
+            }
+            hook = std::move(hook_);
+            hook_ = nullptr;
+        }
+        if (hook) {
+            hook();
+        }
+    }
+
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+    // Registers the action that cancels the in-flight work (e.g. an
+    // engine abort). Fires immediately when the token is already
+    // cancelled, so registration after cancel cannot miss the signal.
+    void onCancel(std::function<void()> hook) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!cancelled_.load()) {
+                hook_ = std::move(hook);
+                return;
+            }
+        }
+        if (hook) {
+            hook();
+        }
+    }
+
+private:
+    std::atomic<bool> cancelled_{false};
+    std::mutex mutex_;
+    std::function<void()> hook_;
+};
@@ -0,0 +1,88 @@
+#include "ClientSendQueue.h"
+#include "TcpSocket.h"
+#include <algorithm>
+
+ClientSendQueue::ClientSendQueue(std::shared_ptr<TcpSocket> socket)
+    : socket_(std::move(socket)), flusher_(&ClientSendQueue::flushLoop, this) {}
+
+ClientSendQueue::~ClientSendQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+}
+
+bool ClientSendQueue::enqueue(std::vector<uint8_t>&& frame, FrameClass frameClass) {
+    const size_t size = frame.size();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_ || !socket_ || !socket_->isConnected()) return false;
+
+    // Evict oldest Status frames until the new frame fits the budget
+    auto it = frames_.begin();
+    while (queuedBytes_ + size > kMaxQueuedBytes && it != frames_.end()) {
+        if (it->frameClass == FrameClass::Status) {
+            queuedBytes_ -= it->bytes.size();
+            ++droppedStatusFrames_;
+            it = frames_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (queuedBytes_ + size > kMaxQueuedBytes) {
+        if (frameClass == FrameClass::Status) {
+            // Only Result frames remain queued; this status is stale by
+            // the time they drain, so shedding it loses nothing
+            ++droppedStatusFrames_;
+            return false;
+        }
+        if (queuedBytes_ + size > kHardCapBytes) {
+            // A megabyte of undroppable results means the client stopped
+            // reading; closing beats growing without bound. shutdown (not
+            // close) so a send the flusher is blocked in just errors out.
+            socket_->shutdownNow();
+            stopping_ = true;
+            frames_.clear();
+            queuedBytes_ = 0;
+            lock.unlock();
+            cv_.notify_all();
+            return false;
+        }
+    }
+
+    queuedBytes_ += size;
+    frames_.push_back(Frame{std::move(frame), frameClass});
+    lock.unlock();
+    cv_.notify_one();
+    return true;
+}
+
+size_t ClientSendQueue::queuedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queuedBytes_;
+}
+
+void ClientSendQueue::flushLoop() {
+    for (;;) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !frames_.empty(); });
+            if (frames_.empty()) return;  // stopping with nothing left to drain
+            frame = std::move(frames_.front());
+            frames_.pop_front();
+            queuedBytes_ -= frame.bytes.size();
+        }
+        // The blocking send happens here, off the producer's thread; a
+        // stalled peer backs up this loop only
+        if (!socket_->send(frame.bytes.data(), frame.bytes.size())) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            frames_.clear();
+            queuedBytes_ = 0;
+            return;
+        }
+    }
+}
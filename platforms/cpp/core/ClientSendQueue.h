@@ -0,0 +1,67 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TcpSocket;
+
+/**
+ * @brief Bounded per-connection send queue with a dedicated flusher
+ *
+ * Response writes used to go out inline on the thread that produced
+ * them, so one slow consumer on a congested link blocked the worker
+ * serving it. enqueue() copies the frame under a byte budget and
+ * returns immediately; the queue's flusher thread owns the blocking
+ * sends, so producers never wait on the peer's receive window.
+ *
+ * Overflow policy is per frame class: Status frames are drop-oldest
+ * (a stale status is worthless once a newer one exists), Result frames
+ * are never discarded — if results alone push a client past the hard
+ * cap, the connection is declared dead and closed rather than letting
+ * the queue grow without bound.
+ */
+class ClientSendQueue {
+public:
+    enum class FrameClass : uint8_t {
+        Status,  // droppable: oldest evicted first under pressure
+        Result   // never dropped; hard cap disconnects instead
+    };
+
+    explicit ClientSendQueue(std::shared_ptr<TcpSocket> socket);
+    // Stops the flusher after it has drained whatever is queued
+    ~ClientSendQueue();
+
+    // Takes ownership of the frame and wakes the flusher. Returns false
+    // when the frame was refused: a Status frame that still does not fit
+    // after evictions, or any frame once the connection is dead.
+    bool enqueue(std::vector<uint8_t>&& frame, FrameClass frameClass);
+
+    size_t queuedBytes() const;
+
+private:
+    // Soft budget: evictions keep the queue under this. Hard cap: a
+    // Result-only backlog beyond it means the client stopped reading.
+    static constexpr size_t kMaxQueuedBytes = 256 * 1024;
+    static constexpr size_t kHardCapBytes = 1024 * 1024;
+
+    struct Frame {
+        std::vector<uint8_t> bytes;
+        FrameClass frameClass;
+    };
+
+    void flushLoop();
+
+    std::shared_ptr<TcpSocket> socket_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Frame> frames_;
+    size_t queuedBytes_ = 0;
+    size_t droppedStatusFrames_ = 0;
+    bool stopping_ = false;
+    std::thread flusher_;
+};
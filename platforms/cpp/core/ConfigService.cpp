@@ -0,0 +1,118 @@
+#include "ConfigService.h"
+
+#include "Utils/TimerWheel.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <json/json.h>
+
+namespace {
+
+// How often the wheel checks whether a SIGHUP asked for a reload
+constexpr std::chrono::milliseconds kReloadPoll{1000};
+
+std::atomic<bool> g_reloadRequested{false};
+
+void onSighup(int) {
+    // Async-signal-safe: just flag it; the TimerWheel task reloads
+    g_reloadRequested.store(true, std::memory_order_relaxed);
+}
+
+} // namespace
+
+ConfigService& ConfigService::instance() {
+    static ConfigService service;
+    return service;
+}
+
+void ConfigService::initialize(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!path.empty()) {
+        configPath_ = path;
+    } else if (const char* env = std::getenv("WEBGRAB_CONFIG")) {
+        configPath_ = env;
+    }
+    rebuildLocked();
+}
+
+void ConfigService::applyOverride(std::function<void(ConfigSnapshot&)> mutate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    overrides_.push_back(std::move(mutate));
+    auto fresh = std::make_shared<ConfigSnapshot>(*current_);
+    overrides_.back()(*fresh);
+    current_ = std::move(fresh);
+}
+
+bool ConfigService::reload() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (configPath_.empty()) {
+        return false;
+    }
+    return rebuildLocked();
+}
+
+bool ConfigService::rebuildLocked() {
+    auto fresh = std::make_shared<ConfigSnapshot>();
+    bool fileOk = true;
+    if (!configPath_.empty()) {
+        fileOk = parseFile(configPath_, *fresh);
+        if (!fileOk) {
+            std::cerr << "ConfigService: ignoring unreadable config "
+                      << configPath_ << std::endl;
+        }
+    }
+    if (!fileOk) {
+        // Keep the published snapshot; a broken edit must not revert a
+        // running process to defaults
+        return false;
+    }
+    for (const auto& mutate : overrides_) {
+        mutate(*fresh);
+    }
+    current_ = std::move(fresh);
+    return true;
+}
+
+bool ConfigService::parseFile(const std::string& path, ConfigSnapshot& out) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    std::string errors;
+    if (!Json::parseFromStream(builder, in, &root, &errors) || !root.isObject()) {
+        return false;
+    }
+    if (root.isMember("orchestratorPort"))
+        out.orchestratorPort = static_cast<uint16_t>(root["orchestratorPort"].asUInt());
+    if (root.isMember("listenAddress")) out.listenAddress = root["listenAddress"].asString();
+    if (root.isMember("workingDir")) out.workingDir = root["workingDir"].asString();
+    if (root.isMember("hardwarePort")) out.hardwarePort = root["hardwarePort"].asInt();
+    if (root.isMember("metricsPort")) out.metricsPort = root["metricsPort"].asInt();
+    if (root.isMember("webUiPort"))
+        out.webUiPort = static_cast<uint16_t>(root["webUiPort"].asUInt());
+    if (root.isMember("mqttHost")) out.mqttHost = root["mqttHost"].asString();
+    if (root.isMember("mqttPort")) out.mqttPort = root["mqttPort"].asInt();
+    return true;
+}
+
+void ConfigService::installReloadOnSighup() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (reloadTimer_ != 0) {
+        return;
+    }
+    std::signal(SIGHUP, onSighup);
+    reloadTimer_ = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+        kReloadPoll, [this] {
+            if (g_reloadRequested.exchange(false, std::memory_order_relaxed)) {
+                if (reload()) {
+                    std::cout << "ConfigService: configuration reloaded from "
+                              << configPath_ << std::endl;
+                }
+            }
+        });
+}
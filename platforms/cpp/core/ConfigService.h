@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Immutable process configuration snapshot
+ *
+ * The defaults match the hardcoded fallbacks the entry points used to
+ * carry individually, so a deployment with no config file behaves
+ * exactly as before.
+ */
+struct ConfigSnapshot {
+    uint16_t orchestratorPort = 8080;
+    // "unix:<path>" selects an AF_UNIX listener for same-host modules;
+    // empty means TCP on orchestratorPort
+    std::string listenAddress;
+    std::string workingDir = "/tmp/webgrab";
+    int hardwarePort = 8081;
+    // Prometheus scrape endpoint of the hardware server; 0 disables it
+    int metricsPort = 9091;
+    uint16_t webUiPort = 8082;
+    std::string mqttHost = "localhost";
+    int mqttPort = 1883;
+};
+
+/**
+ * @brief Shared immutable config service for webgrab_lib consumers
+ *
+ * Ports, working dirs and MQTT hosts were re-read from argv/env by
+ * each entry point separately. The service parses once at startup —
+ * defaults, then the optional JSON file named by initialize() or
+ * $WEBGRAB_CONFIG, then any startup overrides (argv wins over file) —
+ * into an immutable snapshot published as a shared_ptr swap (the same
+ * snapshot shape as JobTable). Subsystems call snapshot() and read
+ * plain fields with no file I/O; a reader keeps a consistent view of
+ * the snapshot it holds however long it works with it.
+ *
+ * reload() re-parses the file and swaps the pointer, so reconfiguring
+ * a running process is a pointer swap instead of a restart; overrides
+ * are reapplied on top so argv keeps winning. Subsystems that read
+ * their values once at construction (listener ports) pick changes up
+ * on their next restart, periodic readers on their next snapshot().
+ */
+class ConfigService {
+public:
+    static ConfigService& instance();
+
+    // Parses defaults plus the optional JSON config file; an empty path
+    // falls back to $WEBGRAB_CONFIG. Call once before starting
+    // subsystems; a missing or invalid file logs and leaves defaults.
+    void initialize(const std::string& path = {});
+
+    // Current immutable snapshot: a lock and one shared_ptr copy
+    std::shared_ptr<const ConfigSnapshot> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_;
+    }
+
+    // Registers a startup override (typically parsed argv) and applies
+    // it; overrides are reapplied after every reload so they outrank
+    // the file permanently
+    void applyOverride(std::function<void(ConfigSnapshot&)> mutate);
+
+    // Re-parses the config file and swaps in the new snapshot. Returns
+    // false — keeping the current snapshot — when no file is configured
+    // or it fails to parse.
+    bool reload();
+
+    // SIGHUP -> reload. The handler only sets a flag (async-signal
+    // safe); the shared TimerWheel notices and performs the reload off
+    // the signal context. Idempotent.
+    void installReloadOnSighup();
+
+private:
+    ConfigService() = default;
+
+    // Rebuilds defaults -> file -> overrides under mutex_ and publishes
+    bool rebuildLocked();
+    static bool parseFile(const std::string& path, ConfigSnapshot& out);
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const ConfigSnapshot> current_ =
+        std::make_shared<const ConfigSnapshot>();
+    std::string configPath_;
+    std::vector<std::function<void(ConfigSnapshot&)>> overrides_;
+    uint64_t reloadTimer_ = 0;
+};
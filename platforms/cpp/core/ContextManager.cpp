@@ -1,13 +1,21 @@
 #include "ContextManager.h"
+#include "AllocAudit.h"
+#include "StringInterner.h"
+#include "Utils/HugePages.hpp"
 
 // Standard library includes
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <cstring>
 #include <random>
 #include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace WebGrab {
 
@@ -120,6 +128,32 @@ bool FileContextPersistence::deleteDeviceContext(const std::string& deviceId) {
     return remove(filename.c_str()) == 0;
 }
 
+namespace {
+
+// Ids are the stems of the backend's per-entity JSON files
+bool listJsonStems(const std::string& dir, std::vector<std::string>& out) {
+    out.clear();
+    std::error_code ec;
+    std::filesystem::directory_iterator it(dir, ec);
+    if (ec) return false;
+    for (const auto& entry : it) {
+        if (entry.path().extension() == ".json") {
+            out.push_back(entry.path().stem().string());
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool FileContextPersistence::listSessionIds(std::vector<std::string>& out) {
+    return listJsonStems(sessionsDir, out);
+}
+
+bool FileContextPersistence::listUserIds(std::vector<std::string>& out) {
+    return listJsonStems(usersDir, out);
+}
+
 std::string FileContextPersistence::serializeUserContext(const UserContext& context) {
     std::ostringstream oss;
     oss << "{\n";
@@ -246,37 +280,562 @@ bool FileContextPersistence::deserializeDeviceContext(const std::string& data, D
     return true;
 }
 
+// MappedContextPersistence implementation
+namespace {
+
+// Cursor helpers for the per-slot session blob: length-prefixed strings
+// and counted maps, no allocation on the write path
+bool packString(char*& cursor, size_t& remaining, const std::string& value) {
+    if (remaining < sizeof(uint32_t) + value.size()) return false;
+    uint32_t size = static_cast<uint32_t>(value.size());
+    std::memcpy(cursor, &size, sizeof(size));
+    cursor += sizeof(size);
+    std::memcpy(cursor, value.data(), value.size());
+    cursor += value.size();
+    remaining -= sizeof(size) + value.size();
+    return true;
+}
+
+bool unpackString(const char*& cursor, size_t& remaining, std::string& value) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t size = 0;
+    std::memcpy(&size, cursor, sizeof(size));
+    cursor += sizeof(size);
+    remaining -= sizeof(size);
+    if (remaining < size) return false;
+    value.assign(cursor, size);
+    cursor += size;
+    remaining -= size;
+    return true;
+}
+
+bool packStringList(char*& cursor, size_t& remaining, const std::vector<std::string>& list) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = static_cast<uint32_t>(list.size());
+    std::memcpy(cursor, &count, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    for (const std::string& entry : list) {
+        if (!packString(cursor, remaining, entry)) return false;
+    }
+    return true;
+}
+
+bool packStringList(char*& cursor, size_t& remaining, const HistoryRing& ring) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = static_cast<uint32_t>(ring.size());
+    std::memcpy(cursor, &count, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    for (size_t i = 0; i < ring.size(); ++i) {
+        if (!packString(cursor, remaining, ring[i])) return false;
+    }
+    return true;
+}
+
+bool unpackStringList(const char*& cursor, size_t& remaining, std::vector<std::string>& list) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = 0;
+    std::memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    list.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string entry;
+        if (!unpackString(cursor, remaining, entry)) return false;
+        list.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool unpackStringList(const char*& cursor, size_t& remaining, HistoryRing& ring) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = 0;
+    std::memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    ring.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string entry;
+        if (!unpackString(cursor, remaining, entry)) return false;
+        ring.push(std::move(entry));
+    }
+    return true;
+}
+
+bool packStringMap(char*& cursor, size_t& remaining,
+                   const std::unordered_map<std::string, std::string>& map) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = static_cast<uint32_t>(map.size());
+    std::memcpy(cursor, &count, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    for (const auto& [key, value] : map) {
+        if (!packString(cursor, remaining, key)) return false;
+        if (!packString(cursor, remaining, value)) return false;
+    }
+    return true;
+}
+
+bool unpackStringMap(const char*& cursor, size_t& remaining,
+                     std::unordered_map<std::string, std::string>& map) {
+    if (remaining < sizeof(uint32_t)) return false;
+    uint32_t count = 0;
+    std::memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    remaining -= sizeof(count);
+    map.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string key, value;
+        if (!unpackString(cursor, remaining, key)) return false;
+        if (!unpackString(cursor, remaining, value)) return false;
+        map.emplace(std::move(key), std::move(value));
+    }
+    return true;
+}
+
+} // namespace
+
+MappedContextPersistence::MappedContextPersistence(const std::string& dataDirectory)
+    : filePersistence(dataDirectory)
+    , storePath(dataDirectory + "/sessions.bin") {
+    if (!openStore()) {
+        std::cerr << "Failed to open session store: " << storePath << std::endl;
+    }
+}
+
+MappedContextPersistence::~MappedContextPersistence() {
+    closeStore();
+}
+
+bool MappedContextPersistence::openStore() {
+    storeFd = open(storePath.c_str(), O_RDWR | O_CREAT, 0600);
+    if (storeFd < 0) return false;
+
+    mappingSize = sizeof(StoreHeader) + kMaxSessions * sizeof(SessionSlot);
+    if (ftruncate(storeFd, static_cast<off_t>(mappingSize)) != 0) {
+        close(storeFd);
+        storeFd = -1;
+        return false;
+    }
+
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, storeFd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        close(storeFd);
+        storeFd = -1;
+        return false;
+    }
+
+    // The store is walked on every lookup; ask THP to back it with huge
+    // pages (falls through to normal pages where the kernel declines)
+    TinyMCP::Utils::HugePages::instance().adviseMapping("session-store",
+                                                        mapping, mappingSize);
+
+    auto* header = static_cast<StoreHeader*>(mapping);
+    if (header->magic != kMagic || header->version != kVersion) {
+        // Fresh, foreign, or older-layout file: initialize header and
+        // clear the slots (sessions are 30-minute state; a format bump
+        // is not worth a migration path)
+        std::memset(mapping, 0, mappingSize);
+        header->magic = kMagic;
+        header->version = kVersion;
+        header->slotCount = kMaxSessions;
+    }
+
+    return true;
+}
+
+void MappedContextPersistence::closeStore() {
+    if (mapping) {
+        msync(mapping, mappingSize, MS_SYNC);
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+    if (storeFd >= 0) {
+        close(storeFd);
+        storeFd = -1;
+    }
+}
+
+MappedContextPersistence::SessionSlot* MappedContextPersistence::slots() {
+    if (!mapping) return nullptr;
+    return reinterpret_cast<SessionSlot*>(static_cast<char*>(mapping) + sizeof(StoreHeader));
+}
+
+MappedContextPersistence::SessionSlot* MappedContextPersistence::findSlot(const std::string& sessionId) {
+    SessionSlot* base = slots();
+    if (!base || sessionId.size() >= kSessionIdCapacity) return nullptr;
+    for (size_t i = 0; i < kMaxSessions; ++i) {
+        if (base[i].state == 1 && sessionId == base[i].sessionId) {
+            return &base[i];
+        }
+    }
+    return nullptr;
+}
+
+MappedContextPersistence::SessionSlot* MappedContextPersistence::findFreeSlot() {
+    SessionSlot* base = slots();
+    if (!base) return nullptr;
+    for (size_t i = 0; i < kMaxSessions; ++i) {
+        if (base[i].state == 0) {
+            return &base[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t MappedContextPersistence::packSessionBlob(const SessionContext& context,
+                                                 char* blob, size_t capacity) {
+    char* cursor = blob;
+    size_t remaining = capacity;
+
+    bool ok = packString(cursor, remaining, context.userId) &&
+              packString(cursor, remaining, context.interfaceType) &&
+              packString(cursor, remaining, context.lastIntent) &&
+              packString(cursor, remaining, context.lastUsedService) &&
+              packStringList(cursor, remaining, context.commandHistory) &&
+              packStringList(cursor, remaining, context.responseHistory) &&
+              packStringMap(cursor, remaining, context.variables) &&
+              packStringMap(cursor, remaining, context.lastParameters) &&
+              packStringMap(cursor, remaining, context.serviceState);
+
+    return ok ? static_cast<size_t>(cursor - blob) : 0;
+}
+
+void MappedContextPersistence::unpackSessionBlob(const char* blob, size_t size,
+                                                  SessionContext& context) {
+    const char* cursor = blob;
+    size_t remaining = size;
+
+    unpackString(cursor, remaining, context.userId);
+    unpackString(cursor, remaining, context.interfaceType);
+    unpackString(cursor, remaining, context.lastIntent);
+    unpackString(cursor, remaining, context.lastUsedService);
+    unpackStringList(cursor, remaining, context.commandHistory);
+    unpackStringList(cursor, remaining, context.responseHistory);
+    unpackStringMap(cursor, remaining, context.variables);
+    unpackStringMap(cursor, remaining, context.lastParameters);
+    unpackStringMap(cursor, remaining, context.serviceState);
+}
+
+size_t MappedContextPersistence::packSessionDelta(const SessionContext& context,
+                                                  uint32_t dirtyFields,
+                                                  char* out, size_t capacity) {
+    char* cursor = out;
+    size_t remaining = capacity;
+
+    for (uint8_t fieldId = 0; (1u << fieldId) <= SessionContext::kFieldServiceState; ++fieldId) {
+        if (!(dirtyFields & (1u << fieldId))) continue;
+        if (remaining < sizeof(fieldId)) return 0;
+        std::memcpy(cursor, &fieldId, sizeof(fieldId));
+        cursor += sizeof(fieldId);
+        remaining -= sizeof(fieldId);
+
+        bool ok = false;
+        switch (1u << fieldId) {
+            case SessionContext::kFieldUserId:
+                ok = packString(cursor, remaining, context.userId);
+                break;
+            case SessionContext::kFieldInterfaceType:
+                ok = packString(cursor, remaining, context.interfaceType);
+                break;
+            case SessionContext::kFieldLastIntent:
+                ok = packString(cursor, remaining, context.lastIntent);
+                break;
+            case SessionContext::kFieldLastService:
+                ok = packString(cursor, remaining, context.lastUsedService);
+                break;
+            case SessionContext::kFieldCommandHistory:
+                ok = packStringList(cursor, remaining, context.commandHistory);
+                break;
+            case SessionContext::kFieldResponseHistory:
+                ok = packStringList(cursor, remaining, context.responseHistory);
+                break;
+            case SessionContext::kFieldVariables:
+                ok = packStringMap(cursor, remaining, context.variables);
+                break;
+            case SessionContext::kFieldLastParameters:
+                ok = packStringMap(cursor, remaining, context.lastParameters);
+                break;
+            case SessionContext::kFieldServiceState:
+                ok = packStringMap(cursor, remaining, context.serviceState);
+                break;
+        }
+        if (!ok) return 0;
+    }
+    return static_cast<size_t>(cursor - out);
+}
+
+bool MappedContextPersistence::applySessionDelta(const char* data, size_t size,
+                                                 SessionContext& context) {
+    const char* cursor = data;
+    size_t remaining = size;
+
+    while (remaining > 0) {
+        uint8_t fieldId = 0;
+        std::memcpy(&fieldId, cursor, sizeof(fieldId));
+        cursor += sizeof(fieldId);
+        remaining -= sizeof(fieldId);
+
+        bool ok = false;
+        switch (1u << fieldId) {
+            case SessionContext::kFieldUserId:
+                ok = unpackString(cursor, remaining, context.userId);
+                break;
+            case SessionContext::kFieldInterfaceType:
+                ok = unpackString(cursor, remaining, context.interfaceType);
+                break;
+            case SessionContext::kFieldLastIntent:
+                ok = unpackString(cursor, remaining, context.lastIntent);
+                break;
+            case SessionContext::kFieldLastService:
+                ok = unpackString(cursor, remaining, context.lastUsedService);
+                break;
+            case SessionContext::kFieldCommandHistory:
+                ok = unpackStringList(cursor, remaining, context.commandHistory);
+                break;
+            case SessionContext::kFieldResponseHistory:
+                ok = unpackStringList(cursor, remaining, context.responseHistory);
+                break;
+            case SessionContext::kFieldVariables:
+                ok = unpackStringMap(cursor, remaining, context.variables);
+                break;
+            case SessionContext::kFieldLastParameters:
+                ok = unpackStringMap(cursor, remaining, context.lastParameters);
+                break;
+            case SessionContext::kFieldServiceState:
+                ok = unpackStringMap(cursor, remaining, context.serviceState);
+                break;
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool MappedContextPersistence::saveSessionContext(const SessionContext& context) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    if (context.sessionId.size() >= kSessionIdCapacity) return false;
+
+    SessionSlot* slot = findSlot(context.sessionId);
+    uint32_t dirty = context.dirtyFields & SessionContext::kFieldAll;
+
+    if (slot) {
+        // The slot already holds every clean field, so a partial mask
+        // only has to append the changed ones as delta records behind
+        // the base blob — a flush that touched one variable writes tens
+        // of bytes instead of re-packing the whole session
+        if (dirty == 0) {
+            slot->lastAccessed = context.lastAccessed.time_since_epoch().count();
+            return true;
+        }
+        if (dirty != SessionContext::kFieldAll && slot->deltaCount < kMaxDeltaBatches) {
+            size_t used = slot->blobSize + slot->deltaSize;
+            if (used < kSlotBlobCapacity) {
+                size_t wrote = packSessionDelta(context, dirty, slot->blob + used,
+                                                kSlotBlobCapacity - used);
+                if (wrote > 0) {
+                    slot->deltaSize += static_cast<uint32_t>(wrote);
+                    ++slot->deltaCount;
+                    slot->lastAccessed = context.lastAccessed.time_since_epoch().count();
+                    return true;
+                }
+            }
+            // No room for another delta: fall through and compact
+        }
+    } else {
+        slot = findFreeSlot();
+        if (!slot) return false; // store full; cleanupExpiredSessions frees slots
+    }
+
+    size_t blobSize = packSessionBlob(context, slot->blob, kSlotBlobCapacity);
+    if (blobSize == 0) {
+        // Histories too large for the slot: trim to the newest entries and retry
+        SessionContext trimmed = context;
+        if (trimmed.commandHistory.size() > 10) {
+            trimmed.commandHistory.keepLast(10);
+            trimmed.responseHistory.keepLast(10);
+        }
+        blobSize = packSessionBlob(trimmed, slot->blob, kSlotBlobCapacity);
+        if (blobSize == 0) return false;
+    }
+
+    std::strncpy(slot->sessionId, context.sessionId.c_str(), kSessionIdCapacity);
+    slot->createdAt = context.createdAt.time_since_epoch().count();
+    slot->lastAccessed = context.lastAccessed.time_since_epoch().count();
+    slot->blobSize = static_cast<uint32_t>(blobSize);
+    slot->deltaSize = 0;
+    slot->deltaCount = 0;
+    slot->state = 1;
+    return true;
+}
+
+bool MappedContextPersistence::loadSessionContext(const std::string& sessionId,
+                                                  SessionContext& context) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    SessionSlot* slot = findSlot(sessionId);
+    if (!slot) return false;
+
+    context.sessionId = slot->sessionId;
+    context.createdAt = std::chrono::system_clock::time_point(
+        std::chrono::system_clock::duration(slot->createdAt));
+    context.lastAccessed = std::chrono::system_clock::time_point(
+        std::chrono::system_clock::duration(slot->lastAccessed));
+    unpackSessionBlob(slot->blob, slot->blobSize, context);
+    if (slot->deltaSize > 0) {
+        applySessionDelta(slot->blob + slot->blobSize, slot->deltaSize, context);
+    }
+    return true;
+}
+
+bool MappedContextPersistence::deleteSessionContext(const std::string& sessionId) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    SessionSlot* slot = findSlot(sessionId);
+    if (!slot) return false;
+
+    slot->state = 0;
+    slot->sessionId[0] = '\0';
+    slot->blobSize = 0;
+    slot->deltaSize = 0;
+    slot->deltaCount = 0;
+    return true;
+}
+
+bool MappedContextPersistence::touchSessionContext(const std::string& sessionId,
+                                                    std::chrono::system_clock::time_point lastAccessed) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+
+    SessionSlot* slot = findSlot(sessionId);
+    if (!slot) return false;
+
+    // The whole point of the mapped store: a touch is one word write, the
+    // kernel writes the dirty page back on its own schedule
+    slot->lastAccessed = lastAccessed.time_since_epoch().count();
+    return true;
+}
+
+bool MappedContextPersistence::saveUserContext(const UserContext& context) {
+    return filePersistence.saveUserContext(context);
+}
+
+bool MappedContextPersistence::loadUserContext(const std::string& userId, UserContext& context) {
+    return filePersistence.loadUserContext(userId, context);
+}
+
+bool MappedContextPersistence::deleteUserContext(const std::string& userId) {
+    return filePersistence.deleteUserContext(userId);
+}
+
+bool MappedContextPersistence::saveDeviceContext(const DeviceContext& context) {
+    return filePersistence.saveDeviceContext(context);
+}
+
+bool MappedContextPersistence::loadDeviceContext(const std::string& deviceId, DeviceContext& context) {
+    return filePersistence.loadDeviceContext(deviceId, context);
+}
+
+bool MappedContextPersistence::deleteDeviceContext(const std::string& deviceId) {
+    return filePersistence.deleteDeviceContext(deviceId);
+}
+
+bool MappedContextPersistence::listSessionIds(std::vector<std::string>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(storeMutex);
+    if (!mapping) return false;
+    SessionSlot* slot_array = slots();
+    for (size_t i = 0; i < kMaxSessions; ++i) {
+        if (slot_array[i].state == 1) {
+            out.emplace_back(slot_array[i].sessionId,
+                             ::strnlen(slot_array[i].sessionId, kSessionIdCapacity));
+        }
+    }
+    return true;
+}
+
+bool MappedContextPersistence::listUserIds(std::vector<std::string>& out) {
+    return filePersistence.listUserIds(out);
+}
+
 // ContextManager implementation
 ContextManager::ContextManager(std::unique_ptr<IContextPersistence> persistence)
     : persistence(std::move(persistence)) {
-    
+
+    // Entries pushed out of a full shard are written through to
+    // persistence so eviction never loses state
+    usersCache.setEvictionHandler([this](const UserContext& context) {
+        this->persistence->saveUserContext(context);
+    });
+    sessionsCache.setEvictionHandler([this](const SessionContext& context) {
+        // Evicted entries leave the cache, so their pending write-behind
+        // state must be persisted now and the dirty mark dropped
+        this->persistence->saveSessionContext(context);
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        dirtySessions.erase(context.sessionId);
+    });
+    devicesCache.setEvictionHandler([this](const DeviceContext& context) {
+        this->persistence->saveDeviceContext(context);
+    });
+
+    // Seed the negative-lookup filters from the backend's full id
+    // enumeration; a backend that cannot enumerate leaves them unseeded
+    // and lookups keep probing persistence
+    std::vector<std::string> ids;
+    if (this->persistence->listSessionIds(ids)) {
+        sessionIdFilter.assign(ids);
+    }
+    if (this->persistence->listUserIds(ids)) {
+        userIdFilter.assign(ids);
+    }
+
+    flusherRunning = true;
+    flusherThread = std::thread(&ContextManager::flusherLoop, this);
+
+    // Expired sessions are swept from the shared timing wheel rather
+    // than a thread of their own
+    cleanupTimer = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+        kCleanupInterval, [this] { cleanupExpiredSessions(); });
+
     std::cout << "ContextManager initialized" << std::endl;
 }
 
-ContextManager::~ContextManager() = default;
+ContextManager::~ContextManager() {
+    // Disarm the sweep before tearing anything down; cancel() returns
+    // only once any in-flight callback has finished
+    if (cleanupTimer != 0) {
+        TinyMCP::Utils::TimerWheel::instance().cancel(cleanupTimer);
+        cleanupTimer = 0;
+    }
+
+    flusherRunning = false;
+    dirtyCv.notify_all();
+    if (flusherThread.joinable()) {
+        flusherThread.join();
+    }
+    flush();
+}
 
 bool ContextManager::createUser(const std::string& userId, const UserContext& context) {
     if (!isValidUserId(userId)) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(usersMutex);
-    
     // Save to persistence
     if (!persistence->saveUserContext(context)) {
         return false;
     }
     
     // Cache the context
+    userIdFilter.add(userId);
     cacheUserContext(context);
-    
+
     std::cout << "Created user context: " << userId << std::endl;
     return true;
 }
 
 bool ContextManager::updateUser(const std::string& userId, const UserContext& context) {
-    std::lock_guard<std::mutex> lock(usersMutex);
-    
     if (!persistence->saveUserContext(context)) {
         return false;
     }
@@ -286,30 +845,34 @@ bool ContextManager::updateUser(const std::string& userId, const UserContext& co
 }
 
 bool ContextManager::getUserContext(const std::string& userId, UserContext& context) {
-    std::lock_guard<std::mutex> lock(usersMutex);
-    
     // Try cache first
     if (getCachedUserContext(userId, context)) {
         return true;
     }
-    
+
+    // An id the filter rejects certainly is not persisted; skip the
+    // disk probe
+    if (userIdFilter.ready() && !userIdFilter.mayContain(userId)) {
+        return false;
+    }
+
     // Load from persistence
     if (persistence->loadUserContext(userId, context)) {
+        userIdFilter.add(userId);
         cacheUserContext(context);
         return true;
     }
-    
+
     return false;
 }
 
 bool ContextManager::deleteUser(const std::string& userId) {
-    std::lock_guard<std::mutex> lock(usersMutex);
-    
     removeCachedUserContext(userId);
     return persistence->deleteUserContext(userId);
 }
 
 std::string ContextManager::createSession(const std::string& userId, const std::string& interfaceType) {
+    AllocScope allocs(AllocTag::Context);
     std::string sessionId = generateSessionId();
     
     SessionContext context;
@@ -319,9 +882,8 @@ std::string ContextManager::createSession(const std::string& userId, const std::
     context.createdAt = std::chrono::system_clock::now();
     context.lastAccessed = context.createdAt;
     
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
     if (persistence->saveSessionContext(context)) {
+        sessionIdFilter.add(sessionId);
         cacheSessionContext(context);
         std::cout << "Created session: " << sessionId << " for user: " << userId << std::endl;
         return sessionId;
@@ -331,63 +893,120 @@ std::string ContextManager::createSession(const std::string& userId, const std::
 }
 
 bool ContextManager::updateSession(const std::string& sessionId, const SessionContext& context) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    if (!persistence->saveSessionContext(context)) {
-        return false;
-    }
-    
-    cacheSessionContext(context);
+    // Full replacement: any field may differ from what the backend
+    // holds, so the next flush rewrites the record instead of appending
+    SessionContext replaced = context;
+    replaced.dirtyFields = SessionContext::kFieldAll;
+    cacheSessionContext(replaced);
+    markSessionDirty(sessionId);
     return true;
 }
 
 bool ContextManager::getSessionContext(const std::string& sessionId, SessionContext& context) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
+    AllocScope allocs(AllocTag::Context);
     // Try cache first
     if (getCachedSessionContext(sessionId, context)) {
         touchSession(sessionId);
         return true;
     }
-    
+
+    // Bad or expired ids from stale clients land here on every retry;
+    // the filter answers "definitely not persisted" without a disk probe
+    if (sessionIdFilter.ready() && !sessionIdFilter.mayContain(sessionId)) {
+        return false;
+    }
+
     // Load from persistence
     if (persistence->loadSessionContext(sessionId, context)) {
+        sessionIdFilter.add(sessionId);
         cacheSessionContext(context);
         touchSession(sessionId);
         return true;
     }
-    
+
+    return false;
+}
+
+bool ContextManager::withSession(const std::string& sessionId,
+                                 const std::function<void(const SessionContext&)>& reader) {
+    AllocScope allocs(AllocTag::Context);
+    if (sessionsCache.readEntry(sessionId, reader)) {
+        touchSession(sessionId);
+        return true;
+    }
+
+    if (sessionIdFilter.ready() && !sessionIdFilter.mayContain(sessionId)) {
+        return false;
+    }
+
+    // Cache miss: load once, cache, and run the reader against the
+    // loaded copy before it goes out of scope
+    SessionContext context;
+    if (persistence->loadSessionContext(sessionId, context)) {
+        sessionIdFilter.add(sessionId);
+        cacheSessionContext(context);
+        touchSession(sessionId);
+        reader(context);
+        return true;
+    }
+
     return false;
 }
 
+std::string ContextManager::getLastIntent(const std::string& sessionId) {
+    std::string intent;
+    withSession(sessionId, [&](const SessionContext& context) { intent = context.lastIntent; });
+    return intent;
+}
+
+std::string ContextManager::getLastUsedService(const std::string& sessionId) {
+    std::string service;
+    withSession(sessionId,
+                [&](const SessionContext& context) { service = context.lastUsedService; });
+    return service;
+}
+
 bool ContextManager::deleteSession(const std::string& sessionId) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        dirtySessions.erase(sessionId);
+    }
     removeCachedSessionContext(sessionId);
     return persistence->deleteSessionContext(sessionId);
 }
 
 void ContextManager::cleanupExpiredSessions() {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
     std::vector<std::string> expiredSessions;
-    
-    for (const auto& [sessionId, context] : sessionsCache) {
+
+    sessionsCache.forEach([&expiredSessions](const std::string& sessionId, const SessionContext& context) {
         if (!context.isActive()) {
             expiredSessions.push_back(sessionId);
         }
-    }
-    
+    });
+
+
     for (const std::string& sessionId : expiredSessions) {
+        {
+            std::lock_guard<std::mutex> lock(dirtyMutex);
+            dirtySessions.erase(sessionId);
+        }
         removeCachedSessionContext(sessionId);
         persistence->deleteSessionContext(sessionId);
         std::cout << "Cleaned up expired session: " << sessionId << std::endl;
     }
+
+    // Deletions cannot clear bloom bits individually; rebuild the
+    // filter from a fresh enumeration so expired ids go back to being
+    // fast negatives
+    if (!expiredSessions.empty()) {
+        std::vector<std::string> ids;
+        if (persistence->listSessionIds(ids)) {
+            sessionIdFilter.assign(ids);
+        }
+    }
 }
 
 bool ContextManager::registerDevice(const std::string& deviceId, const DeviceContext& context) {
-    std::lock_guard<std::mutex> lock(devicesMutex);
-    
     if (!persistence->saveDeviceContext(context)) {
         return false;
     }
@@ -398,8 +1017,6 @@ bool ContextManager::registerDevice(const std::string& deviceId, const DeviceCon
 }
 
 bool ContextManager::updateDevice(const std::string& deviceId, const DeviceContext& context) {
-    std::lock_guard<std::mutex> lock(devicesMutex);
-    
     if (!persistence->saveDeviceContext(context)) {
         return false;
     }
@@ -409,8 +1026,6 @@ bool ContextManager::updateDevice(const std::string& deviceId, const DeviceConte
 }
 
 bool ContextManager::getDeviceContext(const std::string& deviceId, DeviceContext& context) {
-    std::lock_guard<std::mutex> lock(devicesMutex);
-    
     // Try cache first
     if (getCachedDeviceContext(deviceId, context)) {
         return true;
@@ -426,102 +1041,256 @@ bool ContextManager::getDeviceContext(const std::string& deviceId, DeviceContext
 }
 
 bool ContextManager::deleteDevice(const std::string& deviceId) {
-    std::lock_guard<std::mutex> lock(devicesMutex);
-    
     removeCachedDeviceContext(deviceId);
     return persistence->deleteDeviceContext(deviceId);
 }
 
 void ContextManager::addCommandToHistory(const std::string& sessionId, const std::string& command, const std::string& response) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        SessionContext& context = it->second;
-        
-        // Add to history (keep last 50 commands)
-        context.commandHistory.push_back(command);
-        context.responseHistory.push_back(response);
-        
-        if (context.commandHistory.size() > 50) {
-            context.commandHistory.erase(context.commandHistory.begin());
-            context.responseHistory.erase(context.responseHistory.begin());
-        }
-        
+    AllocScope allocs(AllocTag::Context);
+    sessionsCache.withEntry(sessionId, [&](SessionContext& context) {
+        // The ring overwrites its oldest entry once full, so no
+        // explicit trim is needed
+        context.commandHistory.push(command);
+        context.responseHistory.push(response);
+
         context.lastAccessed = std::chrono::system_clock::now();
-        
-        // Save to persistence
-        persistence->saveSessionContext(context);
-    }
+        context.dirtyFields |= SessionContext::kFieldCommandHistory |
+                               SessionContext::kFieldResponseHistory;
+    });
+    markSessionDirty(sessionId);
 }
 
 void ContextManager::setSessionVariable(const std::string& sessionId, const std::string& key, const std::string& value) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        it->second.variables[key] = value;
-        it->second.lastAccessed = std::chrono::system_clock::now();
-        persistence->saveSessionContext(it->second);
-    }
+    sessionsCache.withEntry(sessionId, [&](SessionContext& context) {
+        context.variables[key] = value;
+        context.lastAccessed = std::chrono::system_clock::now();
+        context.dirtyFields |= SessionContext::kFieldVariables;
+        rebuildMergedContext(context);
+    });
+    markSessionDirty(sessionId);
 }
 
 std::string ContextManager::getSessionVariable(const std::string& sessionId, const std::string& key) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        auto varIt = it->second.variables.find(key);
-        if (varIt != it->second.variables.end()) {
-            return varIt->second;
+    std::string value;
+    sessionsCache.readEntry(sessionId, [&](const SessionContext& context) {
+        auto varIt = context.variables.find(key);
+        if (varIt != context.variables.end()) {
+            value = varIt->second;
         }
-    }
-    
-    return "";
+    });
+    return value;
 }
 
 void ContextManager::updateLastIntent(const std::string& sessionId, const std::string& intent, 
                                     const std::unordered_map<std::string, std::string>& parameters) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        it->second.lastIntent = intent;
-        it->second.lastParameters = parameters;
-        it->second.lastAccessed = std::chrono::system_clock::now();
-        persistence->saveSessionContext(it->second);
-    }
+    // Interned once per update; follow-up routing compares the id
+    uint32_t intentId = StringInterner::instance().intern(intent);
+    sessionsCache.withEntry(sessionId, [&](SessionContext& context) {
+        context.lastIntent = intent;
+        context.lastIntentId = intentId;
+        context.lastParameters = parameters;
+        context.lastAccessed = std::chrono::system_clock::now();
+        context.dirtyFields |= SessionContext::kFieldLastIntent |
+                               SessionContext::kFieldLastParameters;
+        rebuildMergedContext(context);
+    });
+    markSessionDirty(sessionId);
 }
 
 void ContextManager::updateServiceState(const std::string& sessionId, const std::string& serviceName,
                                        const std::unordered_map<std::string, std::string>& state) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        it->second.lastUsedService = serviceName;
-        
+    sessionsCache.withEntry(sessionId, [&](SessionContext& context) {
+        context.lastUsedService = serviceName;
+
         // Update service state (simplified - in practice you might want separate service states)
         for (const auto& [key, value] : state) {
-            it->second.serviceState[serviceName + "." + key] = value;
+            context.serviceState[serviceName + "." + key] = value;
+        }
+
+        context.lastAccessed = std::chrono::system_clock::now();
+        context.dirtyFields |= SessionContext::kFieldLastService |
+                               SessionContext::kFieldServiceState;
+    });
+    markSessionDirty(sessionId);
+}
+
+bool ContextManager::lookupUserPreferences(const std::string& userId,
+                                           std::unordered_map<std::string, std::string>& out) {
+    out.clear();
+    // Cache-only on purpose: this runs inside session mutators, and a
+    // disk probe there would put persistence back on the command path.
+    // An uncached user just contributes no preferences until the next
+    // getUserContext pulls them in.
+    return usersCache.readEntry(
+        userId, [&](const UserContext& user) { out = user.preferences; });
+}
+
+void ContextManager::rebuildMergedContext(SessionContext& context) {
+    // Precedence: last intent's parameters over session variables over
+    // user preferences
+    std::unordered_map<std::string, std::string> prefs;
+    lookupUserPreferences(context.userId, prefs);
+
+    context.mergedContext = std::move(prefs);
+    for (const auto& [key, value] : context.variables) {
+        context.mergedContext[key] = value;
+    }
+    for (const auto& [key, value] : context.lastParameters) {
+        context.mergedContext[key] = value;
+    }
+    ++context.mergedContextVersion;
+    context.mergedPrefsEpoch = prefsEpoch.load();
+}
+
+void ContextManager::setUserPreference(const std::string& userId, const std::string& key, const std::string& value) {
+    bool cached = usersCache.withEntry(userId, [&](UserContext& user) {
+        user.preferences[key] = value;
+        user.lastActivity = std::chrono::system_clock::now();
+    });
+
+    UserContext user;
+    if (!cached && persistence->loadUserContext(userId, user)) {
+        user.preferences[key] = value;
+        user.lastActivity = std::chrono::system_clock::now();
+        cacheUserContext(user);
+        cached = true;
+    }
+    if (!cached) {
+        return;
+    }
+
+    UserContext snapshot;
+    if (getCachedUserContext(userId, snapshot)) {
+        persistence->saveUserContext(snapshot);
+    }
+    // Stale merged views notice the epoch change and rebuild lazily
+    prefsEpoch.fetch_add(1);
+}
+
+std::string ContextManager::getUserPreference(const std::string& userId, const std::string& key) {
+    std::string value;
+    usersCache.readEntry(userId, [&](const UserContext& user) {
+        auto it = user.preferences.find(key);
+        if (it != user.preferences.end()) {
+            value = it->second;
         }
-        
-        it->second.lastAccessed = std::chrono::system_clock::now();
-        persistence->saveSessionContext(it->second);
+    });
+    return value;
+}
+
+std::unordered_map<std::string, std::string> ContextManager::getContextualParameters(
+    const std::string& sessionId, const std::string& intent) {
+    AllocScope allocs(AllocTag::Context);
+    std::unordered_map<std::string, std::string> params;
+
+    const uint64_t epoch = prefsEpoch.load();
+    auto read = [&](SessionContext& context) {
+        if (context.mergedContextVersion == 0 || context.mergedPrefsEpoch != epoch) {
+            // First read after a reload, or preferences changed since
+            // the view was built
+            rebuildMergedContext(context);
+        }
+        if (intent.empty() || intent == context.lastIntent) {
+            params = context.mergedContext;
+            return;
+        }
+        // Different intent: the last parameters do not apply; merge
+        // without them (rare — follow-ups reuse the last intent)
+        lookupUserPreferences(context.userId, params);
+        for (const auto& [key, value] : context.variables) {
+            params[key] = value;
+        }
+    };
+
+    if (!sessionsCache.withEntry(sessionId, read)) {
+        // Pull the session into the cache, then read the ready view
+        SessionContext loaded;
+        if (getSessionContext(sessionId, loaded)) {
+            sessionsCache.withEntry(sessionId, read);
+        }
+    }
+    return params;
+}
+
+void ContextManager::markSessionDirty(const std::string& sessionId) {
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    dirtySessions.insert(sessionId);
+    if (++pendingMutations >= kFlushMutationThreshold) {
+        dirtyCv.notify_one();
+    }
+}
+
+bool ContextManager::persistDirtySession(const std::string& sessionId) {
+    // Copy the session and claim its dirty mask under the shard lock;
+    // a mutation racing with the save sets fresh bits on the live entry
+    // and re-marks the session, so nothing falls through the gap
+    SessionContext context;
+    bool cached = sessionsCache.withEntry(sessionId, [&](SessionContext& live) {
+        context = live;
+        live.dirtyFields = 0;
+    });
+    if (!cached) {
+        return false;
+    }
+    if (!persistence->saveSessionContext(context)) {
+        // Failed save: give the bits back so the next flush retries
+        sessionsCache.withEntry(sessionId, [&](SessionContext& live) {
+            live.dirtyFields |= context.dirtyFields;
+        });
+        return false;
+    }
+    return true;
+}
+
+void ContextManager::flusherLoop() {
+    std::unique_lock<std::mutex> lock(dirtyMutex);
+    while (flusherRunning) {
+        // Wake early when a mutation burst crosses the threshold;
+        // otherwise flush on the interval
+        dirtyCv.wait_for(lock, kFlushInterval, [this] {
+            return !flusherRunning || pendingMutations >= kFlushMutationThreshold;
+        });
+        if (dirtySessions.empty()) {
+            continue;
+        }
+
+        std::unordered_set<std::string> batch;
+        batch.swap(dirtySessions);
+        pendingMutations = 0;
+
+        // Persist outside the dirty lock so mutators never wait on disk
+        lock.unlock();
+        for (const std::string& sessionId : batch) {
+            persistDirtySession(sessionId);
+        }
+        lock.lock();
+    }
+}
+
+void ContextManager::flush() {
+    std::unordered_set<std::string> batch;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        batch.swap(dirtySessions);
+        pendingMutations = 0;
+    }
+    for (const std::string& sessionId : batch) {
+        persistDirtySession(sessionId);
     }
 }
 
 std::vector<std::string> ContextManager::getRecentCommands(const std::string& sessionId, size_t count) {
-    std::lock_guard<std::mutex> lock(sessionsMutex);
-    
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        const auto& history = it->second.commandHistory;
+    std::vector<std::string> recent;
+    sessionsCache.readEntry(sessionId, [&](const SessionContext& context) {
+        // By-reference access into the ring; only the requested tail is copied
+        const HistoryRing& history = context.commandHistory;
         size_t start = (history.size() > count) ? history.size() - count : 0;
-        return std::vector<std::string>(history.begin() + start, history.end());
-    }
-    
-    return {};
+        recent.reserve(history.size() - start);
+        for (size_t i = start; i < history.size(); ++i) {
+            recent.push_back(history[i]);
+        }
+    });
+    return recent;
 }
 
 std::string ContextManager::generateSessionId() {
@@ -540,14 +1309,21 @@ std::string ContextManager::generateSessionId() {
 }
 
 void ContextManager::touchSession(const std::string& sessionId) {
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        it->second.lastAccessed = std::chrono::system_clock::now();
-    }
+    sessionsCache.withEntry(sessionId, [&](SessionContext& context) {
+        context.lastAccessed = std::chrono::system_clock::now();
+        // In-place update where the backend supports it (mapped store);
+        // the fallback returns false and the next full save catches up
+        persistence->touchSessionContext(sessionId, context.lastAccessed);
+    });
 }
 
 bool ContextManager::isValidSessionId(const std::string& sessionId) {
-    return !sessionId.empty() && sessionId.length() > 5;
+    if (sessionId.empty() || sessionId.length() <= 5) {
+        return false;
+    }
+    // Syntactically fine ids from stale clients still get rejected here
+    // when the filter knows they cannot exist
+    return !sessionIdFilter.ready() || sessionIdFilter.mayContain(sessionId);
 }
 
 bool ContextManager::isValidUserId(const std::string& userId) {
@@ -555,42 +1331,27 @@ bool ContextManager::isValidUserId(const std::string& userId) {
 }
 
 void ContextManager::cacheUserContext(const UserContext& context) {
-    usersCache[context.userId] = context;
+    usersCache.put(context.userId, context);
 }
 
 void ContextManager::cacheSessionContext(const SessionContext& context) {
-    sessionsCache[context.sessionId] = context;
+    sessionsCache.put(context.sessionId, context);
 }
 
 void ContextManager::cacheDeviceContext(const DeviceContext& context) {
-    devicesCache[context.deviceId] = context;
+    devicesCache.put(context.deviceId, context);
 }
 
 bool ContextManager::getCachedUserContext(const std::string& userId, UserContext& context) {
-    auto it = usersCache.find(userId);
-    if (it != usersCache.end()) {
-        context = it->second;
-        return true;
-    }
-    return false;
+    return usersCache.get(userId, context);
 }
 
 bool ContextManager::getCachedSessionContext(const std::string& sessionId, SessionContext& context) {
-    auto it = sessionsCache.find(sessionId);
-    if (it != sessionsCache.end()) {
-        context = it->second;
-        return true;
-    }
-    return false;
+    return sessionsCache.get(sessionId, context);
 }
 
 bool ContextManager::getCachedDeviceContext(const std::string& deviceId, DeviceContext& context) {
-    auto it = devicesCache.find(deviceId);
-    if (it != devicesCache.end()) {
-        context = it->second;
-        return true;
-    }
-    return false;
+    return devicesCache.get(deviceId, context);
 }
 
 void ContextManager::removeCachedUserContext(const std::string& userId) {
@@ -1,11 +1,23 @@
 #pragma once
 
+// Local includes
+#include "IdBloomFilter.h"
+#include "Utils/TimerWheel.hpp"
+
 // Standard library includes
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace WebGrab {
@@ -22,6 +34,63 @@ struct UserContext {
     std::chrono::system_clock::time_point lastActivity;
 };
 
+/**
+ * @brief Fixed-capacity ring buffer for conversation history
+ *
+ * Bounds per-session history memory: once full, the oldest entry is
+ * overwritten in place, so history never grows with session age and
+ * copying a SessionContext stays O(capacity). Index 0 is the oldest
+ * retained entry.
+ */
+class HistoryRing {
+public:
+    static constexpr size_t kDefaultCapacity = 32;
+
+    explicit HistoryRing(size_t capacity = kDefaultCapacity)
+        : buffer(capacity), head(0), count(0) {}
+
+    void push(std::string entry) {
+        if (count < buffer.size()) {
+            buffer[(head + count) % buffer.size()] = std::move(entry);
+            ++count;
+        } else {
+            buffer[head] = std::move(entry);
+            head = (head + 1) % buffer.size();
+        }
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return buffer.size(); }
+    bool empty() const { return count == 0; }
+
+    const std::string& operator[](size_t index) const {
+        return buffer[(head + index) % buffer.size()];
+    }
+
+    /**
+     * @brief Drop all but the newest n entries, releasing their storage
+     */
+    void keepLast(size_t n) {
+        while (count > n) {
+            buffer[head].clear();
+            buffer[head].shrink_to_fit();
+            head = (head + 1) % buffer.size();
+            --count;
+        }
+    }
+
+    void clear() {
+        buffer.assign(buffer.size(), std::string());
+        head = 0;
+        count = 0;
+    }
+
+private:
+    std::vector<std::string> buffer;
+    size_t head;   // index of the oldest entry
+    size_t count;
+};
+
 /**
  * @brief Session context for maintaining conversation state
  */
@@ -32,21 +101,56 @@ struct SessionContext {
     std::chrono::system_clock::time_point createdAt;
     std::chrono::system_clock::time_point lastAccessed;
     
-    // Conversation history
-    std::vector<std::string> commandHistory;
-    std::vector<std::string> responseHistory;
+    // Conversation history, capped at HistoryRing::kDefaultCapacity entries
+    HistoryRing commandHistory;
+    HistoryRing responseHistory;
     
     // Current context variables
     std::unordered_map<std::string, std::string> variables;
     
-    // Intent context for follow-up commands
+    // Intent context for follow-up commands. lastIntentId is the
+    // interned id of lastIntent (StringInterner): derived in
+    // updateLastIntent, compared as an integer on the follow-up path,
+    // and not persisted (recomputed on the next intent update).
     std::string lastIntent;
+    uint32_t lastIntentId = 0;
     std::unordered_map<std::string, std::string> lastParameters;
     
     // Service context
     std::string lastUsedService;
     std::unordered_map<std::string, std::string> serviceState;
-    
+
+    // Field-level dirty bits for the persistence write path. Mutators
+    // set the bit for each field they change; a delta-capable backend
+    // (MappedContextPersistence) then writes just those fields instead
+    // of re-serializing the whole session — between flushes the
+    // touch-dominated workload typically changes one variable or the
+    // intent, not the histories and every map. The flusher claims the
+    // mask when it copies the session out for persistence. Not
+    // persisted itself.
+    enum DirtyField : uint32_t {
+        kFieldUserId          = 1u << 0,
+        kFieldInterfaceType   = 1u << 1,
+        kFieldLastIntent      = 1u << 2,
+        kFieldLastService     = 1u << 3,
+        kFieldCommandHistory  = 1u << 4,
+        kFieldResponseHistory = 1u << 5,
+        kFieldVariables       = 1u << 6,
+        kFieldLastParameters  = 1u << 7,
+        kFieldServiceState    = 1u << 8,
+        kFieldAll             = (1u << 9) - 1,
+    };
+    uint32_t dirtyFields = 0;
+
+    // Derived, not persisted: merged contextual-parameter view
+    // (lastParameters over variables over user preferences), rebuilt by
+    // the mutators and invalidated by mergedPrefsEpoch when preferences
+    // change, so getContextualParameters reads a ready map instead of
+    // merging three maps per command. Recomputed lazily after a reload.
+    std::unordered_map<std::string, std::string> mergedContext;
+    uint64_t mergedContextVersion = 0;
+    uint64_t mergedPrefsEpoch = 0;
+
     bool isActive() const {
         auto now = std::chrono::system_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::minutes>(now - lastAccessed);
@@ -87,7 +191,36 @@ public:
     virtual bool saveSessionContext(const SessionContext& context) = 0;
     virtual bool loadSessionContext(const std::string& sessionId, SessionContext& context) = 0;
     virtual bool deleteSessionContext(const std::string& sessionId) = 0;
-    
+
+    /**
+     * @brief Fast path for session touch; default falls back to full save
+     *
+     * Backends that can update lastAccessed in place override this so a
+     * touch does not rewrite the whole record.
+     */
+    virtual bool touchSessionContext(const std::string& sessionId,
+                                     std::chrono::system_clock::time_point lastAccessed) {
+        (void)sessionId;
+        (void)lastAccessed;
+        return false;
+    }
+
+    /**
+     * @brief Enumerate persisted ids; default says "cannot enumerate"
+     *
+     * Used to seed and rebuild the negative-lookup bloom filters. A
+     * backend that returns false leaves the filter unseeded, and
+     * lookups keep falling through to persistence.
+     */
+    virtual bool listSessionIds(std::vector<std::string>& out) {
+        out.clear();
+        return false;
+    }
+    virtual bool listUserIds(std::vector<std::string>& out) {
+        out.clear();
+        return false;
+    }
+
     virtual bool saveDeviceContext(const DeviceContext& context) = 0;
     virtual bool loadDeviceContext(const std::string& deviceId, DeviceContext& context) = 0;
     virtual bool deleteDeviceContext(const std::string& deviceId) = 0;
@@ -113,6 +246,9 @@ public:
     bool loadDeviceContext(const std::string& deviceId, DeviceContext& context) override;
     bool deleteDeviceContext(const std::string& deviceId) override;
 
+    bool listSessionIds(std::vector<std::string>& out) override;
+    bool listUserIds(std::vector<std::string>& out) override;
+
 private:
     std::string dataDirectory;
     std::string usersDir;
@@ -129,6 +265,238 @@ private:
     bool deserializeDeviceContext(const std::string& data, DeviceContext& context);
 };
 
+/**
+ * @brief Memory-mapped binary session store
+ *
+ * Sessions live in fixed-size slots inside one mmap'd file: hot fields
+ * (sessionId, createdAt, lastAccessed) sit at fixed offsets so a session
+ * touch is a single in-place word write instead of serialize+open+write+
+ * close per command — the main source of SD-card wear on the Pi. The
+ * variable-length remainder of each session is packed into a per-slot
+ * blob. Saves carrying a partial dirty-field mask append just the
+ * changed fields as tagged delta records behind the base blob, merged
+ * over it on load; the slot compacts back into one blob when the delta
+ * log fills, so a flush that changed one variable rewrites tens of
+ * bytes, not the whole record. User and device contexts, which change
+ * rarely, stay on the JSON-file backend.
+ */
+class MappedContextPersistence : public IContextPersistence {
+public:
+    MappedContextPersistence(const std::string& dataDirectory);
+    ~MappedContextPersistence() override;
+
+    bool saveUserContext(const UserContext& context) override;
+    bool loadUserContext(const std::string& userId, UserContext& context) override;
+    bool deleteUserContext(const std::string& userId) override;
+
+    bool saveSessionContext(const SessionContext& context) override;
+    bool loadSessionContext(const std::string& sessionId, SessionContext& context) override;
+    bool deleteSessionContext(const std::string& sessionId) override;
+    bool touchSessionContext(const std::string& sessionId,
+                             std::chrono::system_clock::time_point lastAccessed) override;
+
+    bool saveDeviceContext(const DeviceContext& context) override;
+    bool loadDeviceContext(const std::string& deviceId, DeviceContext& context) override;
+    bool deleteDeviceContext(const std::string& deviceId) override;
+
+    bool listSessionIds(std::vector<std::string>& out) override;
+    bool listUserIds(std::vector<std::string>& out) override;
+
+private:
+    static constexpr uint32_t kMagic = 0x4D494153;   // "MIAS"
+    static constexpr uint32_t kVersion = 2;          // v2: per-slot delta log
+    static constexpr size_t kMaxSessions = 256;
+    static constexpr size_t kSessionIdCapacity = 64;
+    static constexpr size_t kSlotBlobCapacity = 4096;
+    // A slot compacts (full re-pack, delta log reset) after this many
+    // appended delta batches even when space remains, bounding what a
+    // load has to replay
+    static constexpr uint32_t kMaxDeltaBatches = 64;
+
+    struct StoreHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t reserved;
+    };
+
+    struct SessionSlot {
+        uint32_t state;                       // 0 = free, 1 = in use
+        char sessionId[kSessionIdCapacity];
+        int64_t createdAt;                    // system_clock ticks
+        int64_t lastAccessed;                 // updated in place on touch
+        uint32_t blobSize;
+        uint32_t deltaSize;                   // bytes of delta records after the base blob
+        uint32_t deltaCount;                  // batches appended since the last compaction
+        char blob[kSlotBlobCapacity];
+    };
+
+    // Cold paths (users/devices) reuse the JSON file backend
+    FileContextPersistence filePersistence;
+
+    std::string storePath;
+    int storeFd = -1;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    mutable std::mutex storeMutex;
+
+    bool openStore();
+    void closeStore();
+    SessionSlot* slots();
+    SessionSlot* findSlot(const std::string& sessionId);
+    SessionSlot* findFreeSlot();
+
+    static size_t packSessionBlob(const SessionContext& context, char* blob, size_t capacity);
+    static void unpackSessionBlob(const char* blob, size_t size, SessionContext& context);
+
+    // Delta records: [uint8_t fieldId][field payload] for each dirty
+    // field, appended behind the base blob. applySessionDelta replays
+    // them in order, so the latest record for a field wins.
+    static size_t packSessionDelta(const SessionContext& context, uint32_t dirtyFields,
+                                   char* out, size_t capacity);
+    static bool applySessionDelta(const char* data, size_t size, SessionContext& context);
+};
+
+/**
+ * @brief Sharded, size-capped LRU cache for context objects
+ *
+ * Keys hash to one of 16 shards, each with its own mutex, so concurrent
+ * commands on different sessions no longer serialize on a single lock.
+ * Each shard keeps a recency list; inserting into a full shard evicts
+ * the least recently used entry through the eviction handler (which
+ * writes it to persistence), keeping resident memory flat regardless of
+ * uptime.
+ */
+template <typename Context>
+class ShardedContextCache {
+public:
+    static constexpr size_t kShardCount = 16;
+    using EvictionHandler = std::function<void(const Context&)>;
+
+    explicit ShardedContextCache(size_t maxEntriesPerShard = 64)
+        : maxEntriesPerShard(maxEntriesPerShard) {}
+
+    void setEvictionHandler(EvictionHandler handler) {
+        onEvict = std::move(handler);
+    }
+
+    void put(const std::string& key, const Context& context) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = context;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+
+        if (shard.lru.size() >= maxEntriesPerShard) {
+            auto& victim = shard.lru.back();
+            if (onEvict) {
+                onEvict(victim.second);
+            }
+            shard.index.erase(victim.first);
+            shard.lru.pop_back();
+        }
+
+        shard.lru.emplace_front(key, context);
+        shard.index[key] = shard.lru.begin();
+    }
+
+    bool get(const std::string& key, Context& context) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        context = it->second->second;
+        return true;
+    }
+
+    /**
+     * @brief Mutate an entry in place under its shard lock
+     * @return false if the key is not cached
+     */
+    bool withEntry(const std::string& key, const std::function<void(Context&)>& fn) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        fn(it->second->second);
+        return true;
+    }
+
+    /**
+     * @brief Run a reader against an entry in place under its shard lock
+     *
+     * Read-only counterpart of withEntry: the lambda sees the cached
+     * object directly, so nothing is copied — get() on a session drags
+     * its whole history and maps through a temporary. Refreshes LRU
+     * recency like any other access.
+     * @return false if the key is not cached
+     */
+    bool readEntry(const std::string& key, const std::function<void(const Context&)>& fn) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        fn(it->second->second);
+        return true;
+    }
+
+    void erase(const std::string& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+
+    /**
+     * @brief Visit every cached entry, one shard lock at a time
+     */
+    void forEach(const std::function<void(const std::string&, const Context&)>& fn) {
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [key, context] : shard.lru) {
+                fn(key, context);
+            }
+        }
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        // front = most recently used
+        std::list<std::pair<std::string, Context>> lru;
+        std::unordered_map<std::string,
+                           typename std::list<std::pair<std::string, Context>>::iterator> index;
+    };
+
+    Shard& shardFor(const std::string& key) {
+        return shards[std::hash<std::string>{}(key) % kShardCount];
+    }
+
+    std::array<Shard, kShardCount> shards;
+    size_t maxEntriesPerShard;
+    EvictionHandler onEvict;
+};
+
 /**
  * @brief Context Manager for managing user, session, and device contexts
  */
@@ -147,6 +515,23 @@ public:
     std::string createSession(const std::string& userId, const std::string& interfaceType);
     bool updateSession(const std::string& sessionId, const SessionContext& context);
     bool getSessionContext(const std::string& sessionId, SessionContext& context);
+
+    /**
+     * @brief Run a read-only visitor against the cached session in place
+     *
+     * Copy-free counterpart of getSessionContext: the visitor runs under
+     * the shard lock against the cached object, so reading a field or
+     * two does not drag the whole context — histories, maps and all —
+     * through a temporary. Falls back to loading from persistence on a
+     * cache miss. Keep visitors short; they hold the shard lock.
+     * @return false when the session does not exist
+     */
+    bool withSession(const std::string& sessionId,
+                     const std::function<void(const SessionContext&)>& reader);
+
+    // Hot-field views built on withSession; no full-context copy
+    std::string getLastIntent(const std::string& sessionId);
+    std::string getLastUsedService(const std::string& sessionId);
     bool deleteSession(const std::string& sessionId);
     void cleanupExpiredSessions();
     
@@ -180,19 +565,69 @@ public:
     bool shouldUseContextForCommand(const std::string& sessionId, const std::string& command);
     std::unordered_map<std::string, std::string> getContextualParameters(const std::string& sessionId, const std::string& intent);
 
+    /**
+     * @brief Synchronously persist every dirty session
+     *
+     * Called by the flusher thread on its schedule; call it explicitly
+     * before shutdown so no write-behind state is lost.
+     */
+    void flush();
+
 private:
     std::unique_ptr<IContextPersistence> persistence;
-    
-    // In-memory caches for performance
-    mutable std::mutex usersMutex;
-    std::unordered_map<std::string, UserContext> usersCache;
-    
-    mutable std::mutex sessionsMutex;
-    std::unordered_map<std::string, SessionContext> sessionsCache;
-    
-    mutable std::mutex devicesMutex;
-    std::unordered_map<std::string, DeviceContext> devicesCache;
-    
+
+    // In-memory caches: sharded locks for contention, capped LRU with
+    // write-through eviction for flat memory
+    ShardedContextCache<UserContext> usersCache;
+    ShardedContextCache<SessionContext> sessionsCache;
+    ShardedContextCache<DeviceContext> devicesCache;
+
+    // Write-behind: session mutators mark the entry dirty and return;
+    // the flusher thread batches dirty sessions to persistence every
+    // kFlushInterval or after kFlushMutationThreshold mutations, so
+    // command latency never includes a disk write. Eviction from the
+    // cache still writes through synchronously (the dirty copy would
+    // otherwise be lost).
+    static constexpr std::chrono::milliseconds kFlushInterval{250};
+    static constexpr size_t kFlushMutationThreshold = 64;
+
+    // Bumped by setUserPreference; sessions compare it against their
+    // mergedPrefsEpoch to notice that their merged view went stale
+    std::atomic<uint64_t> prefsEpoch{1};
+
+    // Negative-lookup filters seeded from the backend's id enumeration
+    // at construction, updated on create, rebuilt after the expiry
+    // sweep. A cache miss for an id the filter rejects returns without
+    // touching persistence, so stale clients retrying dead session ids
+    // stop causing disk probes.
+    IdBloomFilter sessionIdFilter;
+    IdBloomFilter userIdFilter;
+
+    std::unordered_set<std::string> dirtySessions;
+    size_t pendingMutations = 0;
+    std::mutex dirtyMutex;
+    std::condition_variable dirtyCv;
+    std::thread flusherThread;
+    std::atomic<bool> flusherRunning{false};
+
+    void markSessionDirty(const std::string& sessionId);
+    // Copies the session and claims its dirty-field mask under the
+    // shard lock, then hands the copy to persistence (which writes only
+    // the masked fields on a delta-capable backend). Used by the
+    // flusher and flush().
+    bool persistDirtySession(const std::string& sessionId);
+    void flusherLoop();
+
+    // Expired-session sweep registered on the shared TimerWheel in the
+    // constructor; no dedicated cleanup thread
+    static constexpr std::chrono::seconds kCleanupInterval{60};
+    TinyMCP::Utils::TimerWheel::TimerId cleanupTimer = 0;
+
+    // Merged-context maintenance (called under the session shard lock)
+    void rebuildMergedContext(SessionContext& context);
+    bool lookupUserPreferences(const std::string& userId,
+                               std::unordered_map<std::string, std::string>& out);
+
     // Helper methods
     std::string generateSessionId();
     void touchSession(const std::string& sessionId);
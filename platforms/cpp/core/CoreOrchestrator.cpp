@@ -5,126 +5,420 @@
 #include "TcpSocket.h"
 #include "FlatBuffersRequestReader.h"
 #include "FlatBuffersResponseWriter.h"
+#include "AllocAudit.h"
+#include "IdleGovernor.h"
+#include "ThreadHeartbeat.h"
+#include "TraceRecorder.h"
+#include "Utils/HostResolverCache.hpp"
+#include "Utils/HugePages.hpp"
 
 // Standard library includes
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <utility>
 
 // Third-party includes
 #include <curl/curl.h>
+#include <json/json.h>
 
 namespace WebGrab {
 
+// KeywordAutomaton implementation
+size_t KeywordAutomaton::addPattern(std::string_view keyword) {
+    int32_t current = 0;
+    for (unsigned char c : keyword) {
+        if (nodes[current].next[c] < 0) {
+            nodes[current].next[c] = static_cast<int32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        current = nodes[current].next[c];
+    }
+    nodes[current].output.push_back(patterns);
+    return patterns++;
+}
+
+void KeywordAutomaton::build() {
+    // Standard BFS construction of failure links; unset transitions are
+    // rewired to the failure target so matching is a pure table walk.
+    std::vector<int32_t> queue;
+    queue.reserve(nodes.size());
+
+    for (int32_t c = 0; c < 256; ++c) {
+        int32_t child = nodes[0].next[c];
+        if (child < 0) {
+            nodes[0].next[c] = 0;
+        } else {
+            nodes[child].fail = 0;
+            queue.push_back(child);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t current = queue[head];
+        const auto& failOutput = nodes[nodes[current].fail].output;
+        nodes[current].output.insert(nodes[current].output.end(),
+                                     failOutput.begin(), failOutput.end());
+
+        for (int32_t c = 0; c < 256; ++c) {
+            int32_t child = nodes[current].next[c];
+            if (child < 0) {
+                nodes[current].next[c] = nodes[nodes[current].fail].next[c];
+            } else {
+                nodes[child].fail = nodes[nodes[current].fail].next[c];
+                queue.push_back(child);
+            }
+        }
+    }
+
+    built = true;
+}
+
+void KeywordAutomaton::match(std::string_view textLower,
+                             const std::function<void(size_t, size_t)>& onMatch) const {
+    if (!built) {
+        return;
+    }
+
+    int32_t state = 0;
+    for (size_t i = 0; i < textLower.size(); ++i) {
+        state = nodes[state].next[static_cast<unsigned char>(textLower[i])];
+        for (size_t patternId : nodes[state].output) {
+            onMatch(patternId, i + 1);
+        }
+    }
+}
+
+// CommandTokenizer implementation
+void CommandTokenizer::tokenize(std::string_view text) {
+    length_ = std::min(text.size(), kMaxText);
+    count_ = 0;
+
+    // SWAR lowercase: per 8-byte lane, set bit 5 on bytes in ['A','Z'].
+    // Stripping to heptets keeps the range adds from carrying across
+    // lanes, and & ~v excludes non-ASCII bytes from the mask.
+    const char* src = text.data();
+    size_t i = 0;
+    for (; i + 8 <= length_; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, src + i, sizeof v);
+        const uint64_t heptets = v & 0x7F7F7F7F7F7F7F7FULL;
+        const uint64_t geA = heptets + 0x3F3F3F3F3F3F3F3FULL;  // >= 'A'
+        const uint64_t gtZ = heptets + 0x2525252525252525ULL;  // >  'Z'
+        const uint64_t upper = geA & ~gtZ & ~v & 0x8080808080808080ULL;
+        v |= upper >> 2;  // 0x80 >> 2 == 0x20
+        std::memcpy(buffer_.data() + i, &v, sizeof v);
+    }
+    for (; i < length_; ++i) {
+        const char c = src[i];
+        buffer_[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+    }
+
+    // Slice tokens on any byte <= ' ', the same separator set the old
+    // istringstream >> split used
+    constexpr size_t kNoToken = ~size_t{0};
+    size_t start = kNoToken;
+    for (size_t p = 0; p <= length_; ++p) {
+        const bool sep = p == length_ || static_cast<unsigned char>(buffer_[p]) <= ' ';
+        if (!sep) {
+            if (start == kNoToken) {
+                start = p;
+            }
+        } else if (start != kNoToken) {
+            if (count_ < kMaxTokens) {
+                tokens_[count_++] = {buffer_.data() + start, p - start};
+            }
+            start = kNoToken;
+        }
+    }
+}
+
+namespace {
+
+// Default intent vocabulary, expressed as constexpr string_view arrays:
+// the literals compile into .rodata, so the tables are shareable
+// read-only pages across multi-process deployments and startup builds
+// the automata straight from them instead of first materializing a map
+// of heap strings.
+struct IntentPattern {
+    std::string_view intent;
+    std::span<const std::string_view> keywords;
+};
+
+// Audio and music control
+constexpr std::string_view kPlayMusicKeywords[] = {
+    "play", "music", "song", "track", "album", "artist", "spotify", "youtube"};
+constexpr std::string_view kControlVolumeKeywords[] = {
+    "volume", "loud", "quiet", "mute", "unmute", "louder", "quieter"};
+constexpr std::string_view kSwitchAudioKeywords[] = {
+    "switch", "change", "output", "headphones", "speakers", "bluetooth", "rtsp"};
+// System control
+constexpr std::string_view kSystemControlKeywords[] = {
+    "open", "close", "launch", "run", "execute", "kill", "start", "stop"};
+constexpr std::string_view kFileOperationKeywords[] = {
+    "download", "upload", "copy", "move", "delete", "create", "save"};
+// Smart home
+constexpr std::string_view kSmartHomeKeywords[] = {
+    "lights", "temperature", "thermostat", "lock", "unlock", "dim", "brightness"};
+// Communication
+constexpr std::string_view kCommunicationKeywords[] = {
+    "send", "call", "message", "text", "email", "whatsapp", "telegram"};
+// Navigation
+constexpr std::string_view kNavigationKeywords[] = {
+    "directions", "navigate", "route", "map", "location", "traffic", "gps"};
+// Hardware control
+constexpr std::string_view kHardwareControlKeywords[] = {
+    "gpio", "pin", "sensor", "led", "relay", "pwm", "analog", "digital"};
+
+constexpr IntentPattern kDefaultIntentPatterns[] = {
+    {"play_music", kPlayMusicKeywords},
+    {"control_volume", kControlVolumeKeywords},
+    {"switch_audio", kSwitchAudioKeywords},
+    {"system_control", kSystemControlKeywords},
+    {"file_operation", kFileOperationKeywords},
+    {"smart_home", kSmartHomeKeywords},
+    {"communication", kCommunicationKeywords},
+    {"navigation", kNavigationKeywords},
+    {"hardware_control", kHardwareControlKeywords},
+};
+
+// Extraction vocabulary defaults, same treatment
+struct VocabTable {
+    std::string_view intent;
+    std::string_view param;
+    bool wholeWord;
+    std::span<const std::string_view> values;
+};
+
+constexpr std::string_view kGenreValues[] = {
+    "jazz", "rock", "classical", "pop", "electronic", "ambient", "folk", "metal"};
+constexpr std::string_view kVolumeActionValues[] = {
+    "up", "down", "high", "low", "max", "min", "mute", "unmute"};
+constexpr std::string_view kAudioDeviceValues[] = {
+    "headphones", "speakers", "bluetooth", "rtsp", "hdmi", "usb"};
+constexpr std::string_view kGpioActionValues[] = {
+    "on", "off", "high", "low", "toggle", "read", "write"};
+
+constexpr VocabTable kDefaultVocab[] = {
+    {"play_music", "genre", false, kGenreValues},
+    {"control_volume", "action", true, kVolumeActionValues},
+    {"switch_audio", "device", false, kAudioDeviceValues},
+    {"hardware_control", "action", true, kGpioActionValues},
+};
+
+} // namespace
+
 // NLPProcessor implementation
 NLPProcessor::NLPProcessor() {
     initializePatterns();
 }
 
 void NLPProcessor::initializePatterns() {
-    // Audio and music control
-    intentPatterns["play_music"] = {"play", "music", "song", "track", "album", "artist", "spotify", "youtube"};
-    intentPatterns["control_volume"] = {"volume", "loud", "quiet", "mute", "unmute", "louder", "quieter"};
-    intentPatterns["switch_audio"] = {"switch", "change", "output", "headphones", "speakers", "bluetooth", "rtsp"};
-    
-    // System control
-    intentPatterns["system_control"] = {"open", "close", "launch", "run", "execute", "kill", "start", "stop"};
-    intentPatterns["file_operation"] = {"download", "upload", "copy", "move", "delete", "create", "save"};
-    
-    // Smart home
-    intentPatterns["smart_home"] = {"lights", "temperature", "thermostat", "lock", "unlock", "dim", "brightness"};
-    
-    // Communication
-    intentPatterns["communication"] = {"send", "call", "message", "text", "email", "whatsapp", "telegram"};
-    
-    // Navigation
-    intentPatterns["navigation"] = {"directions", "navigate", "route", "map", "location", "traffic", "gps"};
-    
-    // Hardware control
-    intentPatterns["hardware_control"] = {"gpio", "pin", "sensor", "led", "relay", "pwm", "analog", "digital"};
+    // Optional runtime overlay: WEBGRAB_INTENT_PATTERNS names a JSON
+    // file mapping intent -> keyword array. A listed intent replaces
+    // its built-in keyword list, a new name adds an intent, and
+    // everything else keeps the compiled-in defaults. Deployments
+    // without the variable never touch the filesystem.
+    std::unordered_map<std::string, std::vector<std::string>> overlay;
+    if (const char* path = std::getenv("WEBGRAB_INTENT_PATTERNS")) {
+        std::ifstream in(path);
+        Json::Value root;
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        if (in && Json::parseFromStream(builder, in, &root, &errors) && root.isObject()) {
+            for (const std::string& intent : root.getMemberNames()) {
+                const Json::Value& list = root[intent];
+                if (!list.isArray()) continue;
+                auto& keywords = overlay[intent];
+                for (const Json::Value& keyword : list) {
+                    if (keyword.isString()) keywords.push_back(keyword.asString());
+                }
+            }
+        } else {
+            std::cerr << "NLPProcessor: ignoring unreadable intent pattern overlay "
+                      << path << std::endl;
+        }
+    }
+
+    // Compile all keywords into one automaton so parseCommand matches every
+    // intent in a single pass over the input instead of per-keyword find().
+    // Intent names are interned up front; scoring and routing then work
+    // on integer ids only.
+    auto addIntent = [this](std::string_view intent, const auto& keywords) {
+        const uint32_t intentId = StringInterner::instance().intern(intent);
+        for (const auto& keyword : keywords) {
+            // addPattern returns sequential ids, so patternIntentIds[id] works
+            keywordMatcher.addPattern(keyword);
+            patternIntentIds.push_back(intentId);
+        }
+    };
+    for (const IntentPattern& entry : kDefaultIntentPatterns) {
+        if (overlay.count(std::string(entry.intent))) {
+            continue; // replaced by the overlay entry below
+        }
+        addIntent(entry.intent, entry.keywords);
+    }
+    for (const auto& [intent, keywords] : overlay) {
+        addIntent(intent, keywords);
+    }
+    keywordMatcher.build();
+
+    // Extraction vocabularies, compiled the same way: every intent's
+    // value list goes into one automaton, and extractParameters pays a
+    // single pass however large the lists grow. Entries gated on the
+    // winning intent's id, so shared words ("high" is both a volume
+    // action and a GPIO level) land on the right parameter.
+    for (const VocabTable& table : kDefaultVocab) {
+        const uint32_t intentId = StringInterner::instance().intern(table.intent);
+        for (std::string_view value : table.values) {
+            vocabMatcher.addPattern(value);
+            vocabEntries.push_back({intentId, std::string(table.param),
+                                    std::string(value), table.wholeWord});
+        }
+    }
+    vocabMatcher.build();
+
+    // Parses cached before this point reflect the old rules
+    invalidateIntentCache();
 }
 
-IntentResult NLPProcessor::parseCommand(const std::string& text) const {
+IntentResult NLPProcessor::parseCommand(std::string_view text) const {
+    TraceSpan span("parseCommand");
+    AllocScope allocs(AllocTag::NLP);
     IntentResult result;
-    result.originalText = text;
+    result.originalText = std::string(text);
     result.confidence = 0.0f;
-    
-    // Convert to lowercase for processing
-    std::string textLower = text;
-    std::transform(textLower.begin(), textLower.end(), textLower.begin(), ::tolower);
-    
-    // Split into words
-    std::vector<std::string> words;
-    std::istringstream iss(textLower);
-    std::string word;
-    while (iss >> word) {
-        words.push_back(word);
-    }
-    
+
+    // One allocation-free pass: lowercase into the tokenizer's stack
+    // buffer and slice word views out of it
+    CommandTokenizer tokenizer;
+    tokenizer.tokenize(text);
+    const std::string_view textLower = tokenizer.lowered();
+    const std::span<const std::string_view> words = tokenizer.tokens();
+
     if (words.empty()) {
         result.intent = "unknown";
+        result.intentId = StringInterner::instance().intern("unknown");
         return result;
     }
-    
-    // Calculate intent scores
-    std::unordered_map<std::string, int> intentScores;
-    for (const auto& [intent, keywords] : intentPatterns) {
-        int score = 0;
-        for (const std::string& keyword : keywords) {
-            if (textLower.find(keyword) != std::string::npos) {
-                score++;
-            }
-        }
-        if (score > 0) {
-            intentScores[intent] = score;
+
+    // Normalized key: tokens joined by single blanks, so spacing and
+    // case variants of the same command share a cache entry
+    std::string normalized;
+    normalized.reserve(textLower.size());
+    for (std::string_view word : words) {
+        if (!normalized.empty()) normalized += ' ';
+        normalized += word;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(intentCacheMutex);
+        auto it = intentCacheIndex.find(normalized);
+        if (it != intentCacheIndex.end()) {
+            intentCacheLru.splice(intentCacheLru.begin(), intentCacheLru, it->second);
+            result = it->second->second;
+            result.originalText = std::string(text);
+            return result;
         }
     }
-    
+
+    // Calculate intent scores: one automaton pass reports every keyword hit,
+    // deduplicated so each keyword counts once as with the old find() loop.
+    // Scores are keyed by interned id, so no string is hashed per hit.
+    std::unordered_map<uint32_t, int> intentScores;
+    std::vector<bool> seenPattern(keywordMatcher.patternCount(), false);
+    keywordMatcher.match(textLower, [&](size_t patternId, size_t /*endPos*/) {
+        if (!seenPattern[patternId]) {
+            seenPattern[patternId] = true;
+            intentScores[patternIntentIds[patternId]]++;
+        }
+    });
+
     if (intentScores.empty()) {
         result.intent = "unknown";
-        return result;
+        result.intentId = StringInterner::instance().intern("unknown");
+    } else {
+        // Find best intent
+        auto bestIntent = std::max_element(intentScores.begin(), intentScores.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+
+        result.intentId = bestIntent->first;
+        result.intent = std::string(StringInterner::instance().lookup(result.intentId));
+        result.confidence = static_cast<float>(bestIntent->second) / static_cast<float>(words.size());
+        result.parameters = extractParameters(textLower, result.intent, result.intentId, words);
     }
-    
-    // Find best intent
-    auto bestIntent = std::max_element(intentScores.begin(), intentScores.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
-    
-    result.intent = bestIntent->first;
-    result.confidence = static_cast<float>(bestIntent->second) / static_cast<float>(words.size());
-    result.parameters = extractParameters(textLower, result.intent, words);
-    
+
+    // Cache the parse (unknowns too — a repeated unrecognized command is
+    // just as hot), evicting the least recently used entry at capacity
+    {
+        std::lock_guard<std::mutex> lock(intentCacheMutex);
+        if (intentCacheIndex.find(normalized) == intentCacheIndex.end()) {
+            if (intentCacheLru.size() >= kIntentCacheCapacity) {
+                intentCacheIndex.erase(intentCacheLru.back().first);
+                intentCacheLru.pop_back();
+            }
+            intentCacheLru.emplace_front(std::move(normalized), result);
+            intentCacheIndex[intentCacheLru.front().first] = intentCacheLru.begin();
+        }
+    }
+
     return result;
 }
 
+void NLPProcessor::invalidateIntentCache() {
+    std::lock_guard<std::mutex> lock(intentCacheMutex);
+    intentCacheLru.clear();
+    intentCacheIndex.clear();
+}
+
 std::unordered_map<std::string, std::string> NLPProcessor::extractParameters(
-    const std::string& text, 
+    std::string_view text,
     const std::string& intent,
-    const std::vector<std::string>& words) const {
-    
+    uint32_t intentId,
+    std::span<const std::string_view> words) const {
+
     std::unordered_map<std::string, std::string> params;
-    
+
+    // Vocabulary capture: one automaton pass over the text fires every
+    // compiled entry; only those gated on the winning intent are kept,
+    // first occurrence in the text wins per parameter. wholeWord entries
+    // must align to token boundaries, preserving the old word-equality
+    // semantics for short values like "on" and "up".
+    vocabMatcher.match(text, [&](size_t patternId, size_t endPos) {
+        const VocabEntry& entry = vocabEntries[patternId];
+        if (entry.intentId != intentId || params.count(entry.param)) {
+            return;
+        }
+        if (entry.wholeWord) {
+            const size_t start = endPos - entry.value.size();
+            const bool boundedLeft =
+                start == 0 || static_cast<unsigned char>(text[start - 1]) <= ' ';
+            const bool boundedRight =
+                endPos == text.size() || static_cast<unsigned char>(text[endPos]) <= ' ';
+            if (!boundedLeft || !boundedRight) {
+                return;
+            }
+        }
+        params[entry.param] = entry.value;
+    });
+
+    // Positional rules stay hand-written: they capture ranges relative
+    // to an anchor rather than fixed vocabulary
     if (intent == "play_music") {
         // Look for artist patterns
         auto byPos = text.find(" by ");
-        if (byPos != std::string::npos) {
-            params["artist"] = text.substr(byPos + 4);
+        if (byPos != std::string_view::npos) {
+            params["artist"] = std::string(text.substr(byPos + 4));
         }
-        
-        // Genre detection
-        std::vector<std::string> genres = {"jazz", "rock", "classical", "pop", "electronic", "ambient", "folk", "metal"};
-        for (const std::string& genre : genres) {
-            if (text.find(genre) != std::string::npos) {
-                params["genre"] = genre;
-                break;
-            }
-        }
-        
+
         // Default query extraction
         if (params.empty()) {
             std::string query;
-            for (const std::string& word : words) {
+            for (std::string_view word : words) {
                 if (word != "play" && word != "music" && word != "song") {
                     if (!query.empty()) query += " ";
                     query += word;
@@ -136,28 +430,10 @@ std::unordered_map<std::string, std::string> NLPProcessor::extractParameters(
         }
     }
     else if (intent == "control_volume") {
-        // Volume level extraction
-        std::vector<std::string> volumeActions = {"up", "down", "high", "low", "max", "min", "mute", "unmute"};
-        for (const std::string& action : volumeActions) {
-            if (std::find(words.begin(), words.end(), action) != words.end()) {
-                params["action"] = action;
-                break;
-            }
-        }
-        
         // Numeric volume
-        for (const std::string& word : words) {
+        for (std::string_view word : words) {
             if (std::all_of(word.begin(), word.end(), ::isdigit)) {
-                params["level"] = word;
-                break;
-            }
-        }
-    }
-    else if (intent == "switch_audio") {
-        std::vector<std::string> devices = {"headphones", "speakers", "bluetooth", "rtsp", "hdmi", "usb"};
-        for (const std::string& device : devices) {
-            if (text.find(device) != std::string::npos) {
-                params["device"] = device;
+                params["level"] = std::string(word);
                 break;
             }
         }
@@ -167,7 +443,7 @@ std::unordered_map<std::string, std::string> NLPProcessor::extractParameters(
         std::vector<std::string> actions = {"open", "close", "launch", "run", "execute", "kill", "start", "stop"};
         for (size_t i = 0; i < words.size(); ++i) {
             if (std::find(actions.begin(), actions.end(), words[i]) != actions.end()) {
-                params["action"] = words[i];
+                params["action"] = std::string(words[i]);
                 if (i + 1 < words.size()) {
                     std::string target;
                     for (size_t j = i + 1; j < words.size(); ++j) {
@@ -182,26 +458,18 @@ std::unordered_map<std::string, std::string> NLPProcessor::extractParameters(
     }
     else if (intent == "hardware_control") {
         // GPIO pin extraction
-        for (const std::string& word : words) {
-            if (word.find("pin") != std::string::npos || word.find("gpio") != std::string::npos) {
+        for (std::string_view word : words) {
+            if (word.find("pin") != std::string_view::npos ||
+                word.find("gpio") != std::string_view::npos) {
                 // Look for number after pin/gpio
                 size_t pos = word.find_first_of("0123456789");
-                if (pos != std::string::npos) {
-                    params["pin"] = word.substr(pos);
+                if (pos != std::string_view::npos) {
+                    params["pin"] = std::string(word.substr(pos));
                 }
             }
         }
-        
-        // Action extraction
-        std::vector<std::string> gpioActions = {"on", "off", "high", "low", "toggle", "read", "write"};
-        for (const std::string& action : gpioActions) {
-            if (std::find(words.begin(), words.end(), action) != words.end()) {
-                params["action"] = action;
-                break;
-            }
-        }
     }
-    
+
     return params;
 }
 
@@ -211,8 +479,8 @@ CommandProcessingJob::CommandProcessingJob(const std::string& command,
                                           uint32_t sessionId,
                                           IResponseWriter* responseWriter,
                                           CoreOrchestrator* orchestrator)
-    : command(command)
-    , context(context)
+    : command(arena.intern(command))
+    , context(arena.intern(context))
     , sessionId(sessionId)
     , responseWriter(responseWriter)
     , orchestrator(orchestrator) {
@@ -220,15 +488,34 @@ CommandProcessingJob::CommandProcessingJob(const std::string& command,
 
 void CommandProcessingJob::execute() {
     std::cout << "Processing command: " << command << " (session " << sessionId << ")" << std::endl;
-    
+
     try {
-        std::string result = orchestrator->processVoiceCommand(command, context);
-        
+        // The parse and the session-context fetch have independent
+        // inputs and meet again at routing, so they run overlapped —
+        // the same std::async lane the callService fan-out uses. On a
+        // cold session the fetch goes to persistence and would
+        // otherwise serialize behind the parse.
+        std::future<std::string> contextFetch = std::async(std::launch::async,
+            [this] { return orchestrator->fetchSessionContext(sessionId); });
+
+        IntentResult intent = orchestrator->parseCommand(command);
+
+        std::string sessionContext = contextFetch.get();
+        if (sessionContext.empty()) {
+            // Nothing stored for this session; use what the client sent
+            sessionContext = std::string(context);
+        }
+
+        std::string result = orchestrator->routeCommand(intent, sessionContext);
+
         // Send success response
         StatusResponse response;
         response.sessionId = sessionId;
         response.message = result;
-        responseWriter->write(response);
+        {
+            TraceSpan span("writeResponse");
+            responseWriter->write(response);
+        }
         
     } catch (const std::exception& e) {
         std::cout << "Error processing command: " << e.what() << std::endl;
@@ -242,15 +529,34 @@ void CommandProcessingJob::execute() {
 }
 
 // CoreOrchestrator implementation
-CoreOrchestrator::CoreOrchestrator(uint16_t port, const std::string& workingDir)
+CoreOrchestrator::CoreOrchestrator(uint16_t port, const std::string& workingDir,
+                                   const std::string& listenAddress)
     : serverPort(port)
     , workingDirectory(workingDir)
+    , listenAddress(listenAddress)
     , running(false) {
     
     messageProcessor = std::make_unique<MessageQueueProcessor>(workingDir);
     nlpProcessor = std::make_unique<NLPProcessor>();
-    
-    std::cout << "CoreOrchestrator initialized on port " << port 
+    contextManager = std::make_unique<ContextManager>(
+        std::make_unique<MappedContextPersistence>(workingDir + "/context"));
+    servicesSnapshot.store(std::make_shared<const ServiceMap>());
+    intentRoutes.store(std::make_shared<const IntentRouteTable>());
+
+    // Built-in routes; services can extend the table at registration
+    // time via "intent:..." capabilities
+    registerIntentRoute("play_music", "ai-audio-assistant", "play_music",
+                        "Music command processed: ", "Audio service not available");
+    registerIntentRoute("control_volume", "ai-audio-assistant", "set_volume",
+                        "Volume command processed: ", "Audio service not available");
+    registerIntentRoute("switch_audio", "ai-audio-assistant", "switch_output",
+                        "Audio output switched: ", "Audio service not available");
+    registerIntentRoute("system_control", "ai-platform-linux", "execute_command",
+                        "System command executed: ", "Platform service not available");
+    registerIntentRoute("hardware_control", "hardware-bridge", "gpio_control",
+                        "Hardware command executed: ", "Hardware service not available");
+
+    std::cout << "CoreOrchestrator initialized on port " << port
               << ", working dir: " << workingDir << std::endl;
 }
 
@@ -264,22 +570,62 @@ bool CoreOrchestrator::start() {
     }
     
     try {
-        // Create TCP listener
-        tcpListener = std::make_unique<TcpListener>(serverPort);
+        // Create listener: unix-domain when a "unix:" address is
+        // configured, TCP otherwise
+        if (!listenAddress.empty()) {
+            tcpListener = std::make_unique<TcpListener>(listenAddress);
+        } else {
+            tcpListener = std::make_unique<TcpListener>(serverPort);
+        }
         if (!tcpListener->start()) {
             std::cerr << "Failed to start TCP listener on port " << serverPort << std::endl;
             return false;
         }
         
         running.store(true);
-        
-        // Start accept thread
-        acceptThread = std::thread(&CoreOrchestrator::acceptLoop, this);
-        
+
+        // Start the epoll event loop: all client sockets are multiplexed
+        // on a small fixed pool instead of one thread per connection
+        if (!tcpListener->startEventLoop(kEventLoopThreads,
+                [this](TcpSocket& client) { return onClientReady(client); })) {
+            std::cerr << "Failed to start event loop on port " << serverPort << std::endl;
+            running.store(false);
+            return false;
+        }
+
         // Start worker threads for command processing
         const size_t numWorkers = std::thread::hardware_concurrency();
         workerThreads.reserve(numWorkers);
-        
+
+        // Warm restart: replay the persisted registry before the first
+        // command arrives. Entries come back stale-until-probed; the
+        // health sweep below re-validates them asynchronously.
+        restoreWarmState();
+
+        // Periodic health sweep rides the shared timing wheel instead of
+        // owning a thread
+        healthCheckTimer = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+            kHealthCheckInterval, [this] { periodicHealthCheck(); });
+
+        snapshotTimer = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+            kSnapshotInterval, [this] { persistWarmState(); });
+
+        // Parked-vehicle idle mode: after a quiet period the governor
+        // stretches the periodic timers; the first command snaps them
+        // back (see onClientReady)
+        idleListener = IdleGovernor::instance().addListener(
+            [this](bool idle) { applyIdleCadence(idle); });
+        IdleGovernor::instance().start();
+
+        // Self-probe: the registered loop heartbeats are checked every
+        // few seconds and the systemd watchdog is petted only while
+        // they all advance, so a wedged thread gets us restarted
+        ThreadHeartbeat::instance().startWatchdog();
+
+        // Flight recorder: any span over the threshold dumps the recent
+        // per-thread trace rings so a p99 spike can be attributed
+        TraceRecorder::instance().setLatencyTrigger(std::chrono::milliseconds(250));
+
         std::cout << "CoreOrchestrator started successfully on port " << serverPort << std::endl;
         std::cout << "Started " << numWorkers << " worker threads" << std::endl;
         
@@ -298,7 +644,45 @@ void CoreOrchestrator::stop() {
     }
     
     running.store(false);
-    
+
+    // Unhook from the idle governor before touching the timers it
+    // reschedules; its listener captures this
+    if (idleListener != 0) {
+        IdleGovernor::instance().removeListener(idleListener);
+        idleListener = 0;
+    }
+    IdleGovernor::instance().stop();
+    ThreadHeartbeat::instance().stopWatchdog();
+
+    // Disarm the health sweep first; cancel() returns only once any
+    // in-flight callback has finished
+    {
+        std::lock_guard<std::mutex> idleLock(idleTimerMutex);
+        if (healthCheckTimer != 0) {
+            TinyMCP::Utils::TimerWheel::instance().cancel(healthCheckTimer);
+            healthCheckTimer = 0;
+        }
+
+        if (snapshotTimer != 0) {
+            TinyMCP::Utils::TimerWheel::instance().cancel(snapshotTimer);
+            snapshotTimer = 0;
+        }
+    }
+    // Final snapshot so a clean shutdown restarts just as warm
+    persistWarmState();
+
+#ifdef WEBGRAB_ALLOC_AUDIT
+    std::cout << AllocAudit::instance().report();
+#endif
+    std::cout << TinyMCP::Utils::HugePages::instance().report();
+
+    // Probe threads capture this; wait for any in-flight ones (bounded
+    // by the probe timeout) before members start going away
+    {
+        std::unique_lock<std::mutex> lock(probeMutex);
+        probesDrained.wait(lock, [this] { return inFlightProbes.load() == 0; });
+    }
+
     // Stop TCP listener
     if (tcpListener) {
         tcpListener->stop();
@@ -306,12 +690,7 @@ void CoreOrchestrator::stop() {
     
     // Signal all waiting threads
     stateCondition.notify_all();
-    
-    // Join accept thread
-    if (acceptThread.joinable()) {
-        acceptThread.join();
-    }
-    
+
     // Join worker threads
     for (std::thread& worker : workerThreads) {
         if (worker.joinable()) {
@@ -322,12 +701,10 @@ void CoreOrchestrator::stop() {
     std::cout << "CoreOrchestrator stopped" << std::endl;
 }
 
-bool CoreOrchestrator::registerService(const std::string& name, 
-                                     const std::string& host, 
+bool CoreOrchestrator::registerService(const std::string& name,
+                                     const std::string& host,
                                      uint16_t port,
                                      const std::vector<std::string>& capabilities) {
-    std::lock_guard<std::mutex> lock(servicesMutex);
-    
     ServiceInfo service;
     service.name = name;
     service.host = host;
@@ -335,46 +712,255 @@ bool CoreOrchestrator::registerService(const std::string& name,
     service.capabilities = capabilities;
     service.healthStatus = "registered";
     service.lastSeen = std::chrono::system_clock::now();
-    
-    services[name] = std::move(service);
-    
+    service.health = std::make_shared<ServiceHealthState>();
+    service.health->lastSeenTicks.store(service.lastSeen.time_since_epoch().count());
+
+    {
+        // Copy-on-update: readers keep using the old snapshot until the
+        // new one is published
+        std::lock_guard<std::mutex> lock(servicesWriteMutex);
+        auto updated = std::make_shared<ServiceMap>(*servicesView());
+        (*updated)[name] = std::move(service);
+        servicesSnapshot.store(std::move(updated), std::memory_order_release);
+    }
+
+    // "intent:<intent>[:<tool>]" capabilities compile straight into the
+    // routing table, so a new module claims its intents here instead of
+    // in routeCommand
+    for (const std::string& cap : capabilities) {
+        if (cap.rfind("intent:", 0) != 0) {
+            continue;
+        }
+        std::string spec = cap.substr(7);
+        size_t sep = spec.find(':');
+        std::string intent = spec.substr(0, sep);
+        std::string tool = sep == std::string::npos ? intent : spec.substr(sep + 1);
+        if (!intent.empty()) {
+            registerIntentRoute(intent, name, tool);
+        }
+    }
+
     std::cout << "Registered service: " << name << " at " << host << ":" << port << std::endl;
     std::cout << "Capabilities: ";
     for (const std::string& cap : capabilities) {
         std::cout << cap << " ";
     }
     std::cout << std::endl;
-    
+
     return true;
 }
 
+void CoreOrchestrator::persistWarmState() {
+    // Runs on the TimerWheel thread; the snapshot view makes the walk
+    // lock-free against routing and registration
+    auto snapshot = servicesView();
+    std::vector<SnapshotServiceEntry> entries;
+    entries.reserve(snapshot->size());
+    for (const auto& [name, service] : *snapshot) {
+        SnapshotServiceEntry entry;
+        entry.name = service.name;
+        entry.host = service.host;
+        entry.port = service.port;
+        entry.capabilities = service.capabilities;
+        entry.lastSeenTicks = service.health
+            ? service.health->lastSeenTicks.load(std::memory_order_relaxed)
+            : service.lastSeen.time_since_epoch().count();
+        entries.push_back(std::move(entry));
+    }
+    WarmStateSnapshot(snapshotPath()).save(entries);
+}
+
+void CoreOrchestrator::restoreWarmState() {
+    std::vector<SnapshotServiceEntry> entries;
+    if (!WarmStateSnapshot(snapshotPath()).load(entries)) {
+        return;
+    }
+    // Replaying through registerService rebuilds everything a live
+    // registration would: the registry entry, the capability-derived
+    // intent routes, and thereby the interned intent ids — so no
+    // separate intern-table persistence is needed. Entries restore in
+    // the Registered ("stale-until-probed") health state.
+    for (const SnapshotServiceEntry& entry : entries) {
+        registerService(entry.name, entry.host, entry.port, entry.capabilities);
+    }
+    std::cout << "Restored " << entries.size()
+              << " services from warm-state snapshot (stale until probed)" << std::endl;
+}
+
+void CoreOrchestrator::registerIntentRoute(const std::string& intent,
+                                           const std::string& serviceName,
+                                           const std::string& toolName,
+                                           const std::string& successPrefix,
+                                           const std::string& failureMessage) {
+    uint32_t intentId = StringInterner::instance().intern(intent);
+
+    // Copy-on-update, same as the service registry: routeCommand keeps
+    // indexing the old table until the new one is published
+    std::lock_guard<std::mutex> lock(routesWriteMutex);
+    auto updated = std::make_shared<IntentRouteTable>(*intentRoutesView());
+    if (updated->size() <= intentId) {
+        updated->resize(intentId + 1);
+    }
+    (*updated)[intentId] = {serviceName, toolName, successPrefix, failureMessage};
+    intentRoutes.store(std::move(updated), std::memory_order_release);
+}
+
 bool CoreOrchestrator::unregisterService(const std::string& name) {
-    std::lock_guard<std::mutex> lock(servicesMutex);
-    
-    auto it = services.find(name);
-    if (it != services.end()) {
-        services.erase(it);
-        std::cout << "Unregistered service: " << name << std::endl;
-        return true;
+    std::lock_guard<std::mutex> lock(servicesWriteMutex);
+
+    auto current = servicesView();
+    if (current->find(name) == current->end()) {
+        return false;
     }
-    
-    return false;
+
+    auto updated = std::make_shared<ServiceMap>(*current);
+    updated->erase(name);
+    servicesSnapshot.store(std::move(updated), std::memory_order_release);
+
+    std::cout << "Unregistered service: " << name << std::endl;
+    return true;
 }
 
 std::vector<ServiceInfo> CoreOrchestrator::listServices() const {
-    std::lock_guard<std::mutex> lock(servicesMutex);
-    
+    auto snapshot = servicesView();
+
     std::vector<ServiceInfo> result;
-    result.reserve(services.size());
-    
-    for (const auto& [name, service] : services) {
+    result.reserve(snapshot->size());
+
+    for (const auto& [name, service] : *snapshot) {
         result.push_back(service);
+        // Reflect the live health state in the copied-out entry
+        if (service.health) {
+            result.back().healthStatus =
+                ServiceHealthState::toString(service.health->status.load());
+            result.back().lastSeen = std::chrono::system_clock::time_point(
+                std::chrono::system_clock::duration(service.health->lastSeenTicks.load()));
+        }
     }
-    
+
     return result;
 }
 
-std::string CoreOrchestrator::processVoiceCommand(const std::string& text, const std::string& context) {
+bool CoreOrchestrator::checkServiceHealth(const std::string& name) {
+    auto snapshot = servicesView();
+    auto it = snapshot->find(name);
+    if (it == snapshot->end()) {
+        return false;
+    }
+
+    const ServiceInfo& service = it->second;
+    const bool healthy = validateServiceConnection(service);
+
+    // Atomic stores on the shared state; no snapshot republish
+    if (service.health) {
+        service.health->status.store(healthy ? ServiceHealthState::Healthy
+                                             : ServiceHealthState::Error);
+        if (healthy) {
+            service.health->lastSeenTicks.store(
+                std::chrono::system_clock::now().time_since_epoch().count());
+        }
+    }
+    return healthy;
+}
+
+bool CoreOrchestrator::validateServiceConnection(const ServiceInfo& service) {
+    // Reachable means the module's /health endpoint answers within the
+    // probe budget; a health probe never waits out the full call timeout
+    const long timeout = static_cast<long>(kHealthProbeDeadline.count()) + 1;
+    return !callHttpService(service.host, service.port, "/health", "{}", timeout)
+                .empty();
+}
+
+void CoreOrchestrator::periodicHealthCheck() {
+    // Runs on the TimerWheel thread every kHealthCheckInterval. Probes
+    // fan out to one thread per service so the sweep costs the slowest
+    // probe, not the sum; this callback itself returns immediately and
+    // deadline enforcement is a one-shot wheel timer.
+    if (!running.load()) {
+        return;
+    }
+
+    auto snapshot = servicesView();
+    if (snapshot->empty()) {
+        return;
+    }
+
+    // Shared with the probe threads and the deadline timer, so a probe
+    // outliving the sweep (or the orchestrator's teardown racing a
+    // straggler) still has valid state to write
+    struct ProbeState {
+        std::string name;
+        std::shared_ptr<ServiceHealthState> health;
+        std::atomic<bool> done{false};
+    };
+    auto probes = std::make_shared<std::vector<ProbeState>>(snapshot->size());
+
+    size_t index = 0;
+    for (const auto& [name, service] : *snapshot) {
+        (*probes)[index].name = name;
+        (*probes)[index].health = service.health;
+
+        const ServiceInfo* info = &service;
+        inFlightProbes.fetch_add(1);
+        std::thread([this, snapshot, info, probes, index] {
+            const bool healthy = validateServiceConnection(*info);
+
+            ProbeState& probe = (*probes)[index];
+            if (probe.health) {
+                probe.health->status.store(healthy ? ServiceHealthState::Healthy
+                                                   : ServiceHealthState::Error);
+                if (healthy) {
+                    probe.health->lastSeenTicks.store(
+                        std::chrono::system_clock::now().time_since_epoch().count());
+                }
+            }
+            probe.done.store(true, std::memory_order_release);
+            if (!healthy) {
+                std::cout << "Health check failed for service: " << probe.name
+                          << std::endl;
+            }
+
+            // stop() drains in-flight probes before the orchestrator dies
+            if (inFlightProbes.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(probeMutex);
+                probesDrained.notify_all();
+            }
+        }).detach();
+        ++index;
+    }
+
+    // Anything unanswered at the deadline is marked unhealthy now; a
+    // straggler that eventually responds flips itself back on completion
+    TinyMCP::Utils::TimerWheel::instance().scheduleAfter(
+        kHealthProbeDeadline, [probes] {
+            for (ProbeState& probe : *probes) {
+                if (!probe.done.load(std::memory_order_acquire) && probe.health) {
+                    probe.health->status.store(ServiceHealthState::Error);
+                    std::cout << "Health probe deadline exceeded for service: "
+                              << probe.name << std::endl;
+                }
+            }
+        });
+}
+
+std::string CoreOrchestrator::fetchSessionContext(uint32_t sessionId) {
+    // Small flat JSON object: the last intent for follow-up commands
+    // plus the session variables. Built under the shard lock against
+    // the cached session — only two fields are read, so no full
+    // SessionContext copy.
+    std::string out;
+    bool found = contextManager->withSession(
+        "tcp-" + std::to_string(sessionId), [&](const SessionContext& session) {
+            out = "{\"lastIntent\":\"" + session.lastIntent + "\"";
+            for (const auto& [key, value] : session.variables) {
+                out += ",\"" + key + "\":\"" + value + "\"";
+            }
+            out += "}";
+        });
+    return found ? out : std::string{};
+}
+
+std::string CoreOrchestrator::processVoiceCommand(std::string_view text, std::string_view context) {
     std::cout << "Processing voice command: " << text << std::endl;
     
     // Parse the command
@@ -387,50 +973,37 @@ std::string CoreOrchestrator::processVoiceCommand(const std::string& text, const
     return routeCommand(intent, context);
 }
 
-IntentResult CoreOrchestrator::parseCommand(const std::string& text) const {
+IntentResult CoreOrchestrator::parseCommand(std::string_view text) const {
     return nlpProcessor->parseCommand(text);
 }
 
-std::string CoreOrchestrator::routeCommand(const IntentResult& intent, const std::string& context) {
+std::string CoreOrchestrator::routeCommand(const IntentResult& intent, std::string_view context) {
+    TraceSpan span("routeCommand");
     if (intent.confidence < 0.1f) {
         return "Sorry, I couldn't understand the command. Please try again.";
     }
-    
-    std::string result;
-    
-    if (intent.intent == "play_music") {
-        if (callService("ai-audio-assistant", "play_music", intent.parameters, result)) {
-            return "Music command processed: " + result;
-        }
-        return "Audio service not available";
-    }
-    else if (intent.intent == "control_volume") {
-        if (callService("ai-audio-assistant", "set_volume", intent.parameters, result)) {
-            return "Volume command processed: " + result;
-        }
-        return "Audio service not available";
-    }
-    else if (intent.intent == "switch_audio") {
-        if (callService("ai-audio-assistant", "switch_output", intent.parameters, result)) {
-            return "Audio output switched: " + result;
-        }
-        return "Audio service not available";
-    }
-    else if (intent.intent == "system_control") {
-        // Determine platform service
-        std::string serviceName = "ai-platform-linux"; // Default to Linux
-        if (callService(serviceName, "execute_command", intent.parameters, result)) {
-            return "System command executed: " + result;
-        }
-        return "Platform service not available";
+
+    // Callers that fill only the string field (hand-built IntentResult)
+    // still route correctly via a single intern on entry
+    uint32_t intentId = intent.intentId;
+    if (intentId == StringInterner::kInvalidId && !intent.intent.empty()) {
+        intentId = StringInterner::instance().intern(intent.intent);
     }
-    else if (intent.intent == "hardware_control") {
-        if (callService("hardware-bridge", "gpio_control", intent.parameters, result)) {
-            return "Hardware command executed: " + result;
+
+    // Compiled dispatch: one array index into the published table
+    auto routes = intentRoutesView();
+    if (intentId < routes->size() && !(*routes)[intentId].serviceName.empty()) {
+        const IntentRoute& route = (*routes)[intentId];
+        std::string result;
+        if (callService(route.serviceName, route.toolName, intent.parameters, result)) {
+            return route.successPrefix + result;
         }
-        return "Hardware service not available";
+        return route.failureMessage;
     }
-    else if (intent.intent == "file_operation") {
+
+    // file_operation has no backing service; it feeds the download path
+    static const uint32_t kFileOperation = StringInterner::instance().intern("file_operation");
+    if (intentId == kFileOperation) {
         // Use existing WebGrab functionality for downloads
         if (intent.parameters.find("url") != intent.parameters.end()) {
             // Process as download request
@@ -438,24 +1011,27 @@ std::string CoreOrchestrator::routeCommand(const IntentResult& intent, const std
         }
         return "File operation not supported";
     }
-    
+
     return "Unknown command intent: " + intent.intent;
 }
 
-bool CoreOrchestrator::callService(const std::string& serviceName, 
+bool CoreOrchestrator::callService(const std::string& serviceName,
                                  const std::string& toolName,
                                  const std::unordered_map<std::string, std::string>& parameters,
                                  std::string& result) {
-    std::lock_guard<std::mutex> lock(servicesMutex);
-    
-    auto it = services.find(serviceName);
-    if (it == services.end()) {
+    TraceSpan span("callService");
+    // Wait-free lookup on the routing hot path: grab the current snapshot
+    // and keep it alive for the duration of the call
+    auto snapshot = servicesView();
+
+    auto it = snapshot->find(serviceName);
+    if (it == snapshot->end()) {
         std::cout << "Service not found: " << serviceName << std::endl;
         return false;
     }
-    
+
     const ServiceInfo& service = it->second;
-    
+
     try {
         // Build JSON payload for MCP call
         std::string payload = R"({"method": "tools/call", "params": {"name": ")" + toolName + R"(", "arguments": {)";
@@ -471,38 +1047,80 @@ bool CoreOrchestrator::callService(const std::string& serviceName,
         // Call HTTP service
         result = callHttpService(service.host, service.port, "/mcp", payload);
         
-        // Update service health
-        const_cast<ServiceInfo&>(service).healthStatus = "healthy";
-        const_cast<ServiceInfo&>(service).lastSeen = std::chrono::system_clock::now();
-        
-        std::cout << "Called service " << serviceName << "::" << toolName 
+        // Update the shared health state with atomic stores; no snapshot
+        // republish needed for per-call bookkeeping
+        if (service.health) {
+            service.health->status.store(ServiceHealthState::Healthy);
+            service.health->lastSeenTicks.store(
+                std::chrono::system_clock::now().time_since_epoch().count());
+        }
+
+        std::cout << "Called service " << serviceName << "::" << toolName
                   << " -> " << result << std::endl;
-        
+
         return true;
-        
+
     } catch (const std::exception& e) {
         std::cout << "Error calling service " << serviceName << ": " << e.what() << std::endl;
-        const_cast<ServiceInfo&>(service).healthStatus = "error";
+        if (service.health) {
+            service.health->status.store(ServiceHealthState::Error);
+        }
         return false;
     }
 }
 
-std::string CoreOrchestrator::callHttpService(const std::string& host, 
+std::future<CoreOrchestrator::ServiceCallResult> CoreOrchestrator::callServiceAsync(
+    const std::string& serviceName,
+    const std::string& toolName,
+    const std::unordered_map<std::string, std::string>& parameters) {
+    // Each in-flight call gets its own connection from httpPool, so
+    // parallel calls to different services do not contend
+    return std::async(std::launch::async,
+        [this, serviceName, toolName, parameters]() {
+            ServiceCallResult out;
+            out.success = callService(serviceName, toolName, parameters, out.result);
+            return out;
+        });
+}
+
+std::vector<CoreOrchestrator::ServiceCallResult> CoreOrchestrator::whenAll(
+    std::vector<std::future<ServiceCallResult>> calls) {
+    std::vector<ServiceCallResult> results;
+    results.reserve(calls.size());
+    for (auto& call : calls) {
+        results.push_back(call.get());
+    }
+    return results;
+}
+
+std::string CoreOrchestrator::callHttpService(const std::string& host,
                                             uint16_t port,
                                             const std::string& endpoint,
-                                            const std::string& payload) {
-    CURL* curl = curl_easy_init();
+                                            const std::string& payload,
+                                            long timeoutSeconds) {
+    // Pooled keep-alive handle: a warm call reuses the open connection to
+    // the module service instead of paying a fresh TCP handshake
+    CURL* curl = httpPool.acquire(host, port);
     if (!curl) {
         std::cerr << "Failed to initialize CURL" << std::endl;
         return "";
     }
-    
+
     std::string response_data;
     std::string url = "http://" + host + ":" + std::to_string(port) + endpoint;
-    
+
     struct curl_slist* headers = nullptr;
     headers = curl_slist_append(headers, "Content-Type: application/json");
-    
+
+    // Pre-resolved address from the shared cache: a DNS hiccup serves
+    // the stale entry instead of hanging the command for the resolver
+    // timeout. Unknown hosts fall back to curl's own resolver.
+    struct curl_slist* resolveList =
+        TinyMCP::Utils::HostResolverCache::instance().resolveListFor(host, port);
+    if (resolveList) {
+        curl_easy_setopt(curl, CURLOPT_RESOLVE, resolveList);
+    }
+
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.c_str());
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
@@ -511,8 +1129,8 @@ std::string CoreOrchestrator::callHttpService(const std::string& host,
         return size * nmemb;
     });
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_data);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeoutSeconds);
+
     CURLcode res = curl_easy_perform(curl);
     long response_code = 0;
     if (res == CURLE_OK) {
@@ -520,48 +1138,74 @@ std::string CoreOrchestrator::callHttpService(const std::string& host,
     } else {
         std::cerr << "CURL error: " << curl_easy_strerror(res) << std::endl;
     }
-    
+
     curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    
+    if (resolveList) {
+        curl_slist_free_all(resolveList);
+    }
+
+    if (res == CURLE_OK) {
+        httpPool.release(host, port, curl);
+    } else {
+        // Do not return a handle whose connection state is suspect
+        httpPool.discard(curl);
+    }
+
     if (res != CURLE_OK || response_code != 200) {
         return "";
     }
-    
+
     return response_data;
 }
 
-void CoreOrchestrator::acceptLoop() {
-    std::cout << "Accept loop started" << std::endl;
-    
-    while (running.load()) {
-        try {
-            auto clientSocket = tcpListener->accept();
-            if (clientSocket && running.load()) {
-                // Handle client in separate thread
-                std::thread clientThread(&CoreOrchestrator::handleClient, this, std::move(clientSocket));
-                clientThread.detach();
-            }
-        } catch (const std::exception& e) {
-            if (running.load()) {
-                std::cerr << "Error in accept loop: " << e.what() << std::endl;
-            }
-        }
+void CoreOrchestrator::applyIdleCadence(bool idle) {
+    // Listener on the IdleGovernor: entering idle runs on the wheel
+    // thread, leaving it on the event thread that saw the command
+    std::lock_guard<std::mutex> lock(idleTimerMutex);
+    if (!running.load()) {
+        return;
+    }
+    auto& wheel = TinyMCP::Utils::TimerWheel::instance();
+    const int mult = idle ? kIdleIntervalMultiplier : 1;
+    if (healthCheckTimer != 0) {
+        wheel.cancel(healthCheckTimer);
+        healthCheckTimer = wheel.scheduleEvery(kHealthCheckInterval * mult,
+                                               [this] { periodicHealthCheck(); });
+    }
+    if (snapshotTimer != 0) {
+        wheel.cancel(snapshotTimer);
+        snapshotTimer = wheel.scheduleEvery(kSnapshotInterval * mult,
+                                            [this] { persistWarmState(); });
     }
-    
-    std::cout << "Accept loop stopped" << std::endl;
 }
 
-void CoreOrchestrator::handleClient(std::unique_ptr<TcpSocket> clientSocket) {
+bool CoreOrchestrator::onClientReady(TcpSocket& clientSocket) {
+    // Invoked from a TcpListener event-loop thread when the socket has
+    // data; drains the pending requests and returns to the epoll wait.
+    // Returning false closes the connection.
+    if (!running.load()) {
+        return false;
+    }
+
+    // A command arrived: leave idle mode (inline, so full cadence is
+    // back before this request finishes) and restamp the quiet clock
+    IdleGovernor::instance().noteActivity();
+
     try {
-        auto reader = std::make_unique<FlatBuffersRequestReader>(clientSocket.get());
-        auto writer = std::make_unique<FlatBuffersResponseWriter>(clientSocket.get());
-        
+        // Root span of the command path: covers read, parse, route and
+        // response write, so the latency trigger fires on it
+        TraceSpan span("handleClient");
+        auto reader = std::make_unique<FlatBuffersRequestReader>(&clientSocket);
+        auto writer = std::make_unique<FlatBuffersResponseWriter>(&clientSocket);
+
         processClientRequest(std::move(reader), writer.get());
-        
+
     } catch (const std::exception& e) {
         std::cerr << "Error handling client: " << e.what() << std::endl;
+        return false;
     }
+
+    return clientSocket.isConnected();
 }
 
 void CoreOrchestrator::processClientRequest(std::unique_ptr<IRequestReader> reader, 
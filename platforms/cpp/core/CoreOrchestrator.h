@@ -1,17 +1,29 @@
 #pragma once
 
 // Local includes
+#include "ContextManager.h"
 #include "IJob.h"
 #include "IRequestReader.h"
 #include "IResponseWriter.h"
 #include "MessageQueueProcessor.h"
+#include "StringInterner.h"
+#include "WarmStateSnapshot.h"
+#include "Utils/HttpConnectionPool.hpp"
+#include "Utils/MonotonicArena.hpp"
+#include "Utils/TimerWheel.hpp"
 
 // Standard library includes
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -22,6 +34,27 @@ class TcpSocket;
 
 namespace WebGrab {
 
+/**
+ * @brief Mutable health state shared by all snapshots of a service entry
+ *
+ * Kept behind a shared_ptr so the hot routing path can update health
+ * with plain atomic stores instead of republishing the registry.
+ */
+struct ServiceHealthState {
+    enum Status : uint8_t { Registered, Healthy, Error };
+
+    std::atomic<Status> status{Registered};
+    std::atomic<int64_t> lastSeenTicks{0};
+
+    static const char* toString(Status s) {
+        switch (s) {
+        case Healthy: return "healthy";
+        case Error: return "error";
+        default: return "registered";
+        }
+    }
+};
+
 /**
  * @brief Service information for registered modules
  */
@@ -32,6 +65,7 @@ struct ServiceInfo {
     std::vector<std::string> capabilities;
     std::string healthStatus;
     std::chrono::system_clock::time_point lastSeen;
+    std::shared_ptr<ServiceHealthState> health;
 };
 
 /**
@@ -39,11 +73,97 @@ struct ServiceInfo {
  */
 struct IntentResult {
     std::string intent;
+    // Interned id of intent (StringInterner); routeCommand dispatches on
+    // this instead of comparing strings. kInvalidId when unset.
+    uint32_t intentId = StringInterner::kInvalidId;
     float confidence;
     std::unordered_map<std::string, std::string> parameters;
     std::string originalText;
 };
 
+/**
+ * @brief Aho-Corasick automaton for multi-keyword substring matching
+ *
+ * Compiled once from the intent keyword lists so a single pass over the
+ * input text reports every keyword occurrence, instead of one
+ * std::string::find per keyword per intent on the hot voice path.
+ */
+class KeywordAutomaton {
+public:
+    /**
+     * @brief Add a keyword before build(); returns the pattern id
+     */
+    size_t addPattern(std::string_view keyword);
+
+    /**
+     * @brief Compile goto/failure links; call once after all addPattern calls
+     */
+    void build();
+
+    /**
+     * @brief Scan lowercase text, invoking onMatch(patternId, endPos) per
+     * occurrence; endPos is the index one past the match, so the matched
+     * range is [endPos - patternLength, endPos)
+     */
+    void match(std::string_view textLower,
+               const std::function<void(size_t, size_t)>& onMatch) const;
+
+    [[nodiscard]] size_t patternCount() const { return patterns; }
+
+private:
+    struct Node {
+        std::array<int32_t, 256> next;
+        int32_t fail = 0;
+        std::vector<size_t> output;
+
+        Node() { next.fill(-1); }
+    };
+
+    std::vector<Node> nodes{1};
+    size_t patterns = 0;
+    bool built = false;
+};
+
+/**
+ * @brief Allocation-free lowercase + whitespace tokenizer
+ *
+ * Replaces the per-command std::transform(::tolower) plus istringstream
+ * split that allocated a vector of std::string words on the hot voice
+ * path. One pass lowercases ASCII into a fixed internal buffer — eight
+ * bytes per step with SWAR arithmetic, which the compiler widens to
+ * NEON/SSE on the targets we build for — and slices whitespace-separated
+ * tokens as views into that buffer.
+ *
+ * Token views stay valid for the tokenizer's lifetime; stack-allocate it
+ * next to the parse. Input beyond kMaxText bytes is dropped and tokens
+ * beyond kMaxTokens are ignored (voice commands are short).
+ */
+class CommandTokenizer {
+public:
+    static constexpr size_t kMaxText = 256;
+    static constexpr size_t kMaxTokens = 32;
+
+    void tokenize(std::string_view text);
+
+    /**
+     * @brief Full lowercased text, for substring matching
+     */
+    [[nodiscard]] std::string_view lowered() const { return {buffer_.data(), length_}; }
+
+    /**
+     * @brief Whitespace-separated tokens, in order
+     */
+    [[nodiscard]] std::span<const std::string_view> tokens() const {
+        return {tokens_.data(), count_};
+    }
+
+private:
+    std::array<char, kMaxText> buffer_;
+    std::array<std::string_view, kMaxTokens> tokens_;
+    size_t length_ = 0;
+    size_t count_ = 0;
+};
+
 /**
  * @brief Natural Language Processing engine for intent recognition
  */
@@ -55,16 +175,63 @@ public:
     /**
      * @brief Parse natural language command into intent and parameters
      */
-    IntentResult parseCommand(const std::string& text) const;
+    IntentResult parseCommand(std::string_view text) const;
+
+    /**
+     * @brief Drop every cached parse; call after changing any pattern
+     * or vocabulary so stale results cannot outlive the rules that
+     * produced them
+     */
+    void invalidateIntentCache();
 
 private:
-    std::unordered_map<std::string, std::vector<std::string>> intentPatterns;
-    
+    // The default intent vocabulary lives in constexpr tables in the
+    // translation unit (kDefaultIntentPatterns), not in a member map:
+    // the literals stay in read-only pages and startup compiles the
+    // automata straight from them. WEBGRAB_INTENT_PATTERNS may name a
+    // JSON file overlaying per-intent keyword lists at startup.
+
+    // Compiled keyword matcher: pattern id -> interned owning intent id
+    KeywordAutomaton keywordMatcher;
+    std::vector<uint32_t> patternIntentIds;
+
+    // Compiled extraction vocabulary. Each entry captures one parameter
+    // value for one intent; all entries across all intents live in a
+    // single automaton, so extractParameters costs one pass over the
+    // text regardless of vocabulary size — growing a device list grows
+    // the automaton, not the per-command scan. wholeWord entries only
+    // fire on token boundaries, matching the old word-equality loops;
+    // the rest keep the old substring semantics.
+    struct VocabEntry {
+        uint32_t intentId;
+        std::string param;
+        std::string value;
+        bool wholeWord;
+    };
+    KeywordAutomaton vocabMatcher;
+    std::vector<VocabEntry> vocabEntries;  // indexed by vocab pattern id
+
+    // Bounded LRU from normalized command text to its parse. Users
+    // repeat the same few dozen commands thousands of times a day, so
+    // the common case becomes one hash lookup instead of the automaton
+    // and extraction passes. The key is the tokenizer's lowered,
+    // whitespace-collapsed text, so "Turn ON the  lights" and "turn on
+    // the lights" share an entry. Same list-plus-index shape as
+    // ShardedContextCache, unsharded: a hit is a find and a splice, far
+    // too short to contend at voice-command rates.
+    static constexpr size_t kIntentCacheCapacity = 128;
+    mutable std::mutex intentCacheMutex;
+    mutable std::list<std::pair<std::string, IntentResult>> intentCacheLru;
+    mutable std::unordered_map<std::string,
+                               std::list<std::pair<std::string, IntentResult>>::iterator>
+        intentCacheIndex;
+
     void initializePatterns();
     std::unordered_map<std::string, std::string> extractParameters(
-        const std::string& text, 
+        std::string_view text,
         const std::string& intent,
-        const std::vector<std::string>& words) const;
+        uint32_t intentId,
+        std::span<const std::string_view> words) const;
 };
 
 /**
@@ -79,12 +246,19 @@ public:
                         class CoreOrchestrator* orchestrator);
     
     void execute() override;
-    
+
+    // A user is waiting on the reply; keep it off the bulk workers
+    JobClass jobClass() const override { return JobClass::Interactive; }
+
     [[nodiscard]] uint32_t getSessionId() const { return sessionId; }
 
 private:
-    std::string command;
-    std::string context;
+    // Request-scoped strings are interned into the job's arena: one
+    // block allocation backs both instead of a heap string each, and
+    // everything is released together when the job is destroyed
+    TinyMCP::Utils::MonotonicArena arena;
+    std::string_view command;
+    std::string_view context;
     uint32_t sessionId;
     IResponseWriter* responseWriter;
     CoreOrchestrator* orchestrator;
@@ -98,7 +272,10 @@ private:
  */
 class CoreOrchestrator {
 public:
-    CoreOrchestrator(uint16_t port, const std::string& workingDir);
+    // listenAddress of the form "unix:<path>" makes the orchestrator
+    // listen on an AF_UNIX socket instead of TCP port
+    CoreOrchestrator(uint16_t port, const std::string& workingDir,
+                     const std::string& listenAddress = "");
     ~CoreOrchestrator();
 
     bool start();
@@ -114,50 +291,184 @@ public:
     std::vector<ServiceInfo> listServices() const;
     bool checkServiceHealth(const std::string& name);
 
-    // Command processing
-    std::string processVoiceCommand(const std::string& text, const std::string& context = "");
-    IntentResult parseCommand(const std::string& text) const;
-    std::string routeCommand(const IntentResult& intent, const std::string& context);
+    /**
+     * @brief Bind an intent to a service tool in the routing table
+     *
+     * The intent name is interned and the entry stored at its id, so
+     * routeCommand dispatches with one array index instead of a string
+     * compare chain. Services can also self-register routes through
+     * registerService capabilities of the form
+     * "intent:<intent>[:<tool>]" (tool defaults to the intent name),
+     * so new modules claim intents without code edits here.
+     */
+    void registerIntentRoute(const std::string& intent,
+                             const std::string& serviceName,
+                             const std::string& toolName,
+                             const std::string& successPrefix = "Command processed: ",
+                             const std::string& failureMessage = "Service not available");
+
+    // Command processing; string_view parameters let callers pass
+    // arena-backed text without materializing std::string copies
+    std::string processVoiceCommand(std::string_view text, std::string_view context = {});
+    IntentResult parseCommand(std::string_view text) const;
+    std::string routeCommand(const IntentResult& intent, std::string_view context);
+
+    /**
+     * @brief Stored context for a protocol session, serialized for routing
+     *
+     * Returns "" when the session has nothing stored; callers fall back
+     * to whatever context the client supplied. May hit persistence on a
+     * cold session, which is why CommandProcessingJob overlaps this
+     * fetch with the NLP parse instead of running it afterwards.
+     */
+    std::string fetchSessionContext(uint32_t sessionId);
 
     // MCP integration
-    bool callService(const std::string& serviceName, 
+    bool callService(const std::string& serviceName,
                     const std::string& toolName,
                     const std::unordered_map<std::string, std::string>& parameters,
                     std::string& result);
 
+    /**
+     * @brief Result of one asynchronous service call
+     */
+    struct ServiceCallResult {
+        bool success = false;
+        std::string result;
+    };
+
+    /**
+     * @brief Asynchronous variant of callService
+     *
+     * Issues the call on its own task so independent calls can be
+     * launched back to back and awaited together with whenAll; a
+     * composite command touching hardware-bridge and ai-audio-assistant
+     * then pays the slower of the two latencies instead of their sum:
+     *
+     *   std::vector<std::future<ServiceCallResult>> calls;
+     *   calls.push_back(callServiceAsync("hardware-bridge", "gpio_control", params));
+     *   calls.push_back(callServiceAsync("ai-audio-assistant", "play_music", params));
+     *   auto results = whenAll(std::move(calls));
+     */
+    std::future<ServiceCallResult> callServiceAsync(
+        const std::string& serviceName,
+        const std::string& toolName,
+        const std::unordered_map<std::string, std::string>& parameters);
+
+    /**
+     * @brief Wait for a set of in-flight service calls
+     * @return results in submission order
+     */
+    static std::vector<ServiceCallResult> whenAll(
+        std::vector<std::future<ServiceCallResult>> calls);
+
 private:
     // Core components
     std::unique_ptr<MessageQueueProcessor> messageProcessor;
     std::unique_ptr<TcpListener> tcpListener;
     std::unique_ptr<NLPProcessor> nlpProcessor;
+    std::unique_ptr<ContextManager> contextManager;
     
-    // Service registry
-    mutable std::mutex servicesMutex;
-    std::unordered_map<std::string, ServiceInfo> services;
-    
+    // Service registry: RCU-style read-mostly snapshot. Readers load the
+    // current shared_ptr without locking; updates copy the map under
+    // servicesWriteMutex and publish a new snapshot atomically, so health
+    // checking and registration never stall command routing.
+    using ServiceMap = std::unordered_map<std::string, ServiceInfo>;
+    std::atomic<std::shared_ptr<const ServiceMap>> servicesSnapshot;
+    std::mutex servicesWriteMutex;
+
+    [[nodiscard]] std::shared_ptr<const ServiceMap> servicesView() const {
+        return servicesSnapshot.load(std::memory_order_acquire);
+    }
+
+
+    /**
+     * @brief One compiled routing entry, indexed by interned intent id
+     */
+    struct IntentRoute {
+        std::string serviceName;   // empty = intent not routed
+        std::string toolName;
+        std::string successPrefix;
+        std::string failureMessage;
+    };
+
+    // Routing table: same RCU snapshot idiom as the service registry.
+    // routeCommand loads the snapshot and indexes by intent id;
+    // registration copies and republishes under routesWriteMutex.
+    using IntentRouteTable = std::vector<IntentRoute>;
+    std::atomic<std::shared_ptr<const IntentRouteTable>> intentRoutes;
+    std::mutex routesWriteMutex;
+
+    [[nodiscard]] std::shared_ptr<const IntentRouteTable> intentRoutesView() const {
+        return intentRoutes.load(std::memory_order_acquire);
+    }
+
+    // Keep-alive connections to module services, keyed by host:port
+    TinyMCP::Utils::HttpConnectionPool httpPool;
+
     // Server state
     std::atomic<bool> running;
     uint16_t serverPort;
     std::string workingDirectory;
+    std::string listenAddress;  // "unix:<path>" or empty for TCP
     
     // Worker threads
     std::vector<std::thread> workerThreads;
-    std::thread acceptThread;
-    
+
+    // Fixed pool size for the TcpListener epoll event loop; connection
+    // count no longer dictates thread count
+    static constexpr size_t kEventLoopThreads = 4;
+
+    // Health sweep registered on the shared TimerWheel at start();
+    // no dedicated timer thread
+    static constexpr std::chrono::seconds kHealthCheckInterval{30};
+    TinyMCP::Utils::TimerWheel::TimerId healthCheckTimer = 0;
+
+    // Warm-state snapshot: the registry is persisted periodically and
+    // restored by start() with entries marked stale-until-probed, so
+    // routing resumes immediately after a restart while the health
+    // sweep re-validates asynchronously
+    static constexpr std::chrono::seconds kSnapshotInterval{60};
+    TinyMCP::Utils::TimerWheel::TimerId snapshotTimer = 0;
+
+    // Idle mode (parked vehicle): the governor's listener reschedules
+    // both periodic timers at this multiple of their normal interval,
+    // and the first command restores them. The mutex covers the timer
+    // ids, which the listener mutates from wheel and event threads.
+    static constexpr int kIdleIntervalMultiplier = 10;
+    size_t idleListener = 0;
+    std::mutex idleTimerMutex;
+    void applyIdleCadence(bool idle);
+
+    [[nodiscard]] std::string snapshotPath() const {
+        return workingDirectory + "/orchestrator_state.snap";
+    }
+    void persistWarmState();
+    void restoreWarmState();
+
+    // Per-sweep probe budget: probes fan out concurrently and anything
+    // still unanswered at the deadline is marked unhealthy, so a sweep
+    // costs the slowest single probe instead of the sum of all probes
+    static constexpr std::chrono::seconds kHealthProbeDeadline{2};
+    std::atomic<size_t> inFlightProbes{0};
+    std::mutex probeMutex;
+    std::condition_variable probesDrained;
+
+
     // Thread synchronization
     std::mutex stateMutex;
     std::condition_variable stateCondition;
 
     // Private methods
-    void acceptLoop();
-    void handleClient(std::unique_ptr<TcpSocket> clientSocket);
-    void processClientRequest(std::unique_ptr<IRequestReader> reader, 
+    bool onClientReady(TcpSocket& clientSocket);
+    void processClientRequest(std::unique_ptr<IRequestReader> reader,
                              IResponseWriter* writer);
     
-    std::string callHttpService(const std::string& host, 
+    std::string callHttpService(const std::string& host,
                                uint16_t port,
                                const std::string& endpoint,
-                               const std::string& payload);
+                               const std::string& payload,
+                               long timeoutSeconds = 30);
     
     bool validateServiceConnection(const ServiceInfo& service);
     void periodicHealthCheck();
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "IJob.h"
+
+#include <coroutine>
+#include <functional>
+
+class JobWorker;
+
+// Awaitable job support: a job written as a JobTask coroutine suspends
+// across asynchronous work instead of parking a worker thread, so a
+// 4-thread pool keeps hundreds of I/O-bound jobs in flight. While an
+// operation is pending the worker is free; completion queues the
+// continuation on the pool exactly like a fresh job, so resumptions
+// obey the same routing, stealing and priority rules as everything
+// else.
+//
+//   JobTask fetchAndStore(JobWorker& pool, std::string url) {
+//       co_await AwaitOperation([&](std::function<void()> resume) {
+//           AsyncDownloadEngine::instance().submit(
+//               url, path, [resume](uint64_t, bool, const std::string&) {
+//                   resume();  // requeues the coroutine on the pool
+//               });
+//       });
+//       // runs on a pool worker once the download finished
+//   }
+//
+//   pool.spawn(fetchAndStore(pool, url), JobClass::Bulk);
+
+class JobTask {
+public:
+    struct promise_type {
+        // Filled in by JobWorker::spawn so awaitables know where to
+        // requeue the continuation and at which priority
+        JobWorker* pool = nullptr;
+        JobClass jobClass = JobClass::Bulk;
+
+        JobTask get_return_object() {
+            return JobTask{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        // Suspend at the end so the resuming job observes done() and
+        // destroys the frame
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    JobTask() = default;
+    explicit JobTask(Handle handle) : handle_(handle) {}
+    JobTask(JobTask&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+    JobTask& operator=(JobTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+    JobTask(const JobTask&) = delete;
+    JobTask& operator=(const JobTask&) = delete;
+
+    ~JobTask() {
+        // Only a task never handed to spawn() still owns its frame here
+        if (handle_) handle_.destroy();
+    }
+
+    // Detaches the frame; ownership passes to the pool's resume jobs
+    Handle release() {
+        Handle h = handle_;
+        handle_ = nullptr;
+        return h;
+    }
+
+private:
+    Handle handle_;
+};
+
+// One scheduled (re)entry into a coroutine: execute() drives the frame
+// to its next suspension point. If the frame finishes it is destroyed
+// here; if it suspended, the awaitable's completion owns the next step.
+class CoroutineJob : public IJob {
+public:
+    CoroutineJob(JobTask::Handle handle, JobClass jobClass)
+        : handle_(handle), jobClass_(jobClass) {}
+
+    void execute() override {
+        handle_.resume();
+        if (handle_.done()) {
+            handle_.destroy();
+        }
+    }
+
+    JobClass jobClass() const override { return jobClass_; }
+
+private:
+    JobTask::Handle handle_;
+    JobClass jobClass_;
+};
+
+// co_await adapter for callback-style asynchronous operations: start
+// receives a resume closure; invoking it (from any thread) requeues the
+// coroutine on its pool. Invoke it exactly once.
+class AwaitOperation {
+public:
+    using Starter = std::function<void(std::function<void()> resume)>;
+
+    explicit AwaitOperation(Starter start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(JobTask::Handle handle);
+    void await_resume() const noexcept {}
+
+private:
+    Starter start_;
+};
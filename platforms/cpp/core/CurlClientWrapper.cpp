@@ -2,12 +2,99 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
-bool CurlClient::init(const char* username, const char* password, bool verbose)
+CurlHandlePool& CurlHandlePool::instance()
+{
+    static CurlHandlePool pool;
+    return pool;
+}
+
+CurlHandlePool::CurlHandlePool()
 {
     curl_global_init(CURL_GLOBAL_DEFAULT);
-    curl = curl_easy_init();
+    share = curl_share_init();
+    if (share != nullptr)
+    {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+}
+
+CurlHandlePool::~CurlHandlePool()
+{
+    for (CURL* handle : idle)
+    {
+        curl_easy_cleanup(handle);
+    }
+    if (share != nullptr)
+    {
+        curl_share_cleanup(share);
+    }
+    curl_global_cleanup();
+}
+
+CURL* CurlHandlePool::acquire()
+{
+    CURL* handle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!idle.empty())
+        {
+            handle = idle.back();
+            idle.pop_back();
+        }
+    }
+    if (handle == nullptr)
+    {
+        handle = curl_easy_init();
+    }
+    if (handle != nullptr && share != nullptr)
+    {
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    }
+    return handle;
+}
+
+void CurlHandlePool::release(CURL* handle)
+{
+    if (handle == nullptr)
+    {
+        return;
+    }
+    // Reset wipes per-client options but keeps the handle's live
+    // connections and caches, which is the whole point of pooling
+    curl_easy_reset(handle);
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (idle.size() < kMaxIdleHandles)
+    {
+        idle.push_back(handle);
+    }
+    else
+    {
+        curl_easy_cleanup(handle);
+    }
+}
+
+void CurlHandlePool::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+{
+    static_cast<CurlHandlePool*>(userptr)->shareLocks[data].lock();
+}
+
+void CurlHandlePool::unlockShare(CURL*, curl_lock_data data, void* userptr)
+{
+    static_cast<CurlHandlePool*>(userptr)->shareLocks[data].unlock();
+}
+
+bool CurlClient::init(const char* username, const char* password, bool verbose)
+{
+    curl = CurlHandlePool::instance().acquire();
 
     auto optCode = CURLcode::CURLE_OK; // debugging purposes
 
@@ -28,7 +115,6 @@ bool CurlClient::init(const char* username, const char* password, bool verbose)
         return true;
     }
 
-    curl_global_cleanup();
     return false;
 
 };
@@ -50,19 +136,20 @@ CURLcode CurlClient::getFile(const char* url, const char* outFilename, const std
         return CURLcode::CURLE_ABORTED_BY_CALLBACK;
     }
 
-    if (!verifySSL)
-    {
-        optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    }
+    // Set explicitly both ways: pooled handles are reused and must not
+    // inherit the previous request's setting
+    optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
     optCode = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
     optCode = curl_easy_setopt(curl, CURLOPT_URL, url);
+    optCode = curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+    optCode = curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     optCode = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeData);
     optCode = curl_easy_setopt(curl, CURLOPT_WRITEDATA, &outFile);
     res = curl_easy_perform(curl);
 
     if (res == CURLE_OK)
     {
-        int32_t responseCode = 0;
+        long responseCode = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
         std::cout << "HTTP response code: " << responseCode << std::endl;
     }
@@ -73,7 +160,6 @@ CURLcode CurlClient::getFile(const char* url, const char* outFilename, const std
 CURLcode CurlClient::putFile(const char* url, const char* filename, const std::vector<std::string>& customHeaders, bool verifySSL)
 {
     auto optCode = CURLcode::CURLE_OK; // debugging purposes
-    std::unique_ptr<uint8_t> content = nullptr;
     struct curl_slist* chunk = nullptr;
     std::ifstream file(filename, std::ios::binary | std::ios::ate);
 
@@ -84,49 +170,183 @@ CURLcode CurlClient::putFile(const char* url, const char* filename, const std::v
     }
 
     std::streamsize file_size = file.tellg();
-    std::vector<char> buffer(file_size);
     file.seekg(0, std::ios::beg);
 
-    if (file.read(buffer.data(), file_size))
+    for (const std::string &header : customHeaders)
     {
-        std::string str(buffer.begin(), buffer.end());
+        chunk = curl_slist_append(chunk, header.c_str());
+    }
 
-        std::vector<uint8_t> vec(str.begin(), str.end());
+    // Set explicitly both ways: pooled handles are reused and must not
+    // inherit the previous request's setting. The body streams from the
+    // ifstream through the read callback instead of being copied whole
+    // into memory first.
+    optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
+    optCode = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
+    optCode = curl_easy_setopt(curl, CURLOPT_URL, url);
+    optCode = curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+    optCode = curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+    optCode = curl_easy_setopt(curl, CURLOPT_READFUNCTION, readFileBody);
+    optCode = curl_easy_setopt(curl, CURLOPT_READDATA, &file);
+    optCode = curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(file_size));
+    res = curl_easy_perform(curl);
+    // Clear upload mode so a later getFile/delFile on this client's
+    // handle does not inherit it
+    optCode = curl_easy_setopt(curl, CURLOPT_UPLOAD, 0L);
 
-        content = std::unique_ptr<uint8_t>(new uint8_t[vec.size()]);
+    if (res == CURLE_OK)
+    {
+        long responseCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        std::cout << "HTTP response code: " << responseCode << std::endl;
+    }
+
+    return res;
+}
 
-        copy(vec.begin(), vec.end(), content.get());
+CURLcode CurlClient::putFiles(const std::vector<std::pair<std::string, std::string>>& uploads,
+                              const std::vector<std::string>& customHeaders, bool verifySSL,
+                              size_t lanes, curl_off_t bytesPerSec)
+{
+    if (uploads.empty())
+    {
+        return CURLE_OK;
     }
-    else
+    if (lanes == 0)
     {
-        std::cout << "Unable to read file" << std::endl;
-        return CURLcode::CURLE_ABORTED_BY_CALLBACK;
+        lanes = 1;
+    }
+    if (lanes > uploads.size())
+    {
+        lanes = uploads.size();
     }
 
-    for (const std::string &header : customHeaders)
+    // One header list shared read-only by every lane
+    struct curl_slist* chunk = nullptr;
+    for (const std::string& header : customHeaders)
     {
         chunk = curl_slist_append(chunk, header.c_str());
     }
 
-    if (!verifySSL)
+    CURLM* multi = curl_multi_init();
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    // Per-lane cap so a capped batch shares the budget evenly,
+    // analogous to the download engine's per-handle recv caps
+    const curl_off_t laneCap = bytesPerSec > 0 ? bytesPerSec / static_cast<curl_off_t>(lanes) : 0;
+
+    struct Lane
     {
-        optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    }
-    optCode = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
-    optCode = curl_easy_setopt(curl, CURLOPT_URL, url);
-    optCode = curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-    optCode = curl_easy_setopt(curl, CURLOPT_POSTFIELDS, content.get());
-    optCode = curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<uint32_t>(file_size));
-    res = curl_easy_perform(curl);
+        CURL* handle = nullptr;
+        std::ifstream file;
+    };
+    std::unordered_map<CURL*, std::unique_ptr<Lane>> active;
+    CURLcode firstError = CURLE_OK;
+    size_t next = 0;
+
+    auto startNext = [&]() -> bool
+    {
+        while (next < uploads.size())
+        {
+            const auto& [uploadUrl, filename] = uploads[next];
+            ++next;
+
+            auto lane = std::make_unique<Lane>();
+            lane->file.open(filename, std::ios::binary | std::ios::ate);
+            if (lane->file.fail())
+            {
+                std::cout << "Unable to open provided path: " << filename << std::endl;
+                if (firstError == CURLE_OK)
+                {
+                    firstError = CURLE_ABORTED_BY_CALLBACK;
+                }
+                continue;
+            }
+            std::streamsize fileSize = lane->file.tellg();
+            lane->file.seekg(0, std::ios::beg);
+
+            CURL* handle = CurlHandlePool::instance().acquire();
+            if (handle == nullptr)
+            {
+                if (firstError == CURLE_OK)
+                {
+                    firstError = CURLE_FAILED_INIT;
+                }
+                continue;
+            }
+
+            curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, chunk);
+            curl_easy_setopt(handle, CURLOPT_URL, uploadUrl.c_str());
+            curl_easy_setopt(handle, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(handle, CURLOPT_READFUNCTION, readFileBody);
+            curl_easy_setopt(handle, CURLOPT_READDATA, &lane->file);
+            curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(fileSize));
+            // Prefer HTTP/2 and wait for an in-progress connection to
+            // the same host, so hundreds of small log files ride a few
+            // multiplexed connections instead of one each
+            curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+            if (laneCap > 0)
+            {
+                curl_easy_setopt(handle, CURLOPT_MAX_SEND_SPEED_LARGE, laneCap);
+            }
+
+            lane->handle = handle;
+            curl_multi_add_handle(multi, handle);
+            active[handle] = std::move(lane);
+            return true;
+        }
+        return false;
+    };
 
-    if (res == CURLE_OK)
+    for (size_t i = 0; i < lanes; ++i)
     {
-        int32_t responseCode = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
-        std::cout << "HTTP response code: " << responseCode << std::endl;
+        startNext();
     }
 
-    return res;
+    int stillRunning = 0;
+    do
+    {
+        curl_multi_perform(multi, &stillRunning);
+
+        int msgsLeft = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &msgsLeft))
+        {
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+            CURL* handle = msg->easy_handle;
+            if (msg->data.result != CURLE_OK && firstError == CURLE_OK)
+            {
+                firstError = msg->data.result;
+            }
+            else if (msg->data.result == CURLE_OK)
+            {
+                long responseCode = 0;
+                curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &responseCode);
+                std::cout << "HTTP response code: " << responseCode << std::endl;
+            }
+            curl_multi_remove_handle(multi, handle);
+            active.erase(handle);
+            CurlHandlePool::instance().release(handle);
+            if (startNext())
+            {
+                ++stillRunning;
+            }
+        }
+
+        if (stillRunning > 0)
+        {
+            int numfds = 0;
+            curl_multi_poll(multi, nullptr, 0, 1000, &numfds);
+        }
+    } while (stillRunning > 0 || !active.empty());
+
+    curl_multi_cleanup(multi);
+    curl_slist_free_all(chunk);
+    return firstError;
 }
 
 CURLcode CurlClient::delFile(const char* url, const std::vector<std::string>& customHeaders, bool verifySSL)
@@ -139,10 +359,9 @@ CURLcode CurlClient::delFile(const char* url, const std::vector<std::string>& cu
         chunk = curl_slist_append(chunk, header.c_str());
     }
 
-    if (!verifySSL)
-    {
-        optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    }
+    // Set explicitly both ways: pooled handles are reused and must not
+    // inherit the previous request's setting
+    optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
     optCode = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
     optCode = curl_easy_setopt(curl, CURLOPT_URL, url);
     optCode = curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
@@ -150,7 +369,7 @@ CURLcode CurlClient::delFile(const char* url, const std::vector<std::string>& cu
 
     if (res == CURLE_OK)
     {
-        int32_t responseCode = 0;
+        long responseCode = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
         std::cout << "HTTP response code: " << responseCode << std::endl;
     }
@@ -167,19 +386,20 @@ CURLcode CurlClient::getFileList(const char* url, std::string& output, const std
         chunk = curl_slist_append(chunk, header.c_str());
     }
 
-    if (!verifySSL)
-    {
-        optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    }
+    // Set explicitly both ways: pooled handles are reused and must not
+    // inherit the previous request's setting
+    optCode = curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verifySSL ? 1L : 0L);
     optCode = curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
     optCode = curl_easy_setopt(curl, CURLOPT_URL, url);
+    optCode = curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+    optCode = curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     optCode = curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeDataToString);
     optCode = curl_easy_setopt(curl, CURLOPT_WRITEDATA, &output);
     res = curl_easy_perform(curl);
 
     if (res == CURLE_OK)
     {
-        int32_t responseCode = 0;
+        long responseCode = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
         std::cout << "HTTP response code: " << responseCode << std::endl;
     }
@@ -188,8 +408,7 @@ CURLcode CurlClient::getFileList(const char* url, std::string& output, const std
 
 CurlClient::~CurlClient()
 {
-    curl_easy_cleanup(curl);
-    curl_global_cleanup();
+    CurlHandlePool::instance().release(curl);
 }
 
 size_t CurlClient::writeData(void* ptr, size_t size, size_t nmemb, void* stream)
@@ -209,3 +428,10 @@ size_t CurlClient::writeDataToString(void* ptr, size_t size, size_t nmemb, void*
     static_cast<std::string*>(buff)->append(static_cast<char*>(ptr), size * nmemb);
     return size * nmemb;
 };
+
+size_t CurlClient::readFileBody(char* buffer, size_t size, size_t nitems, void* stream)
+{
+    auto* file = static_cast<std::ifstream*>(stream);
+    file->read(buffer, static_cast<std::streamsize>(size * nitems));
+    return static_cast<size_t>(file->gcount());
+}
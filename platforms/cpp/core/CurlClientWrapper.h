@@ -1,14 +1,61 @@
 #pragma once
 #include "curl/curl.h"
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
+/**
+ * Process-wide pool of warm CURL easy handles.
+ *
+ * Every DownloadJob used to curl_easy_init its own handle, so
+ * back-to-back downloads from the same artifact server re-resolved DNS
+ * and re-handshook TLS on every job. Handles borrowed from this pool
+ * keep their connection cache across jobs (release() resets options but
+ * not live connections), and all handles are wired to one CURLSH share
+ * so DNS entries and TLS session tickets are reused even across
+ * concurrently borrowed handles.
+ */
+class CurlHandlePool
+{
+public:
+    static CurlHandlePool& instance();
+    ~CurlHandlePool();
+
+    CURL* acquire();
+    void release(CURL* handle);
+
+private:
+    static constexpr size_t kMaxIdleHandles = 8;
+
+    CurlHandlePool();
+    static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+    static void unlockShare(CURL* handle, curl_lock_data data, void* userptr);
+
+    CURLSH* share = nullptr;
+    std::mutex poolMutex;
+    std::vector<CURL*> idle;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+};
+
 class CurlClient
 {
 public:
     CurlClient() = default;
     bool init(const char* username, const char* password, bool verbose = true);
     CURLcode putFile(const char* url, const char* filename, const std::vector<std::string>& customHeaders, bool verifySSL);
+    // Batched upload for log shipping: PUTs every (url, filename) pair
+    // through one curl_multi with up to `lanes` streams in flight. The
+    // handles come from the pool (shared DNS/TLS/connection cache) and
+    // negotiate HTTP/2 with PIPEWAIT set, so same-host uploads multiplex
+    // on one connection instead of running serially. Bodies stream from
+    // disk via CURLOPT_READFUNCTION — no per-file buffering. A non-zero
+    // bytesPerSec caps total send rate, split evenly across the lanes,
+    // mirroring the download engine's bandwidth budget. Returns CURLE_OK
+    // when every upload succeeded, else the first failure.
+    CURLcode putFiles(const std::vector<std::pair<std::string, std::string>>& uploads,
+                      const std::vector<std::string>& customHeaders, bool verifySSL,
+                      size_t lanes = 4, curl_off_t bytesPerSec = 0);
     CURLcode getFile(const char* url, const char* outFilename, const std::vector<std::string>& customHeaders, bool verifySSL);
     CURLcode delFile(const char* url, const std::vector<std::string>& customHeaders, bool verifySSL);
     CURLcode getFileList(const char* url, std::string& output, const std::vector<std::string>& customHeaders, bool verifySSL);
@@ -19,4 +66,5 @@ private:
     CURLcode res = CURLcode::CURLE_OK;
     static size_t writeData(void* ptr, size_t size, size_t nmemb, void* stream);
     static size_t writeDataToString(void* ptr, size_t size, size_t nmemb, void* buff);
+    static size_t readFileBody(char* buffer, size_t size, size_t nitems, void* stream);
 };
@@ -1,22 +1,66 @@
 #include "DownloadJob.h"
 #include "IResponseWriter.h"
 #include "CurlClientWrapper.h"
+#include "StatusMulticast.h"
+#include "Utils/AsyncDownloadEngine.hpp"
 #include <iostream>
 
-DownloadJob::DownloadJob(std::shared_ptr<IResponseWriter> writer, const std::string& url, uint32_t sessionId, const std::string& outputPath)
+DownloadJob::DownloadJob(std::shared_ptr<IResponseWriter> writer, const std::string& url, uint32_t sessionId, const std::string& outputPath, uint8_t priority,
+                         std::shared_ptr<CancellationToken> cancelToken)
     : response_writer_(writer), url_(url), session_id_(sessionId), output_path_(outputPath),
-      curl_client_(std::make_unique<CurlClient>()) {
+      curl_client_(std::make_unique<CurlClient>()), priority_(priority),
+      cancel_token_(std::move(cancelToken)) {
     curl_client_->init(nullptr, nullptr, false);
 }
 
 DownloadJob::~DownloadJob() = default;
 
 void DownloadJob::execute() {
-    std::vector<std::string> headers;
-    CURLcode res = curl_client_->getFile(url_.c_str(), output_path_.c_str(), headers, true);
-    if (res == CURLE_OK) {
-        response_writer_->writeStatusResponse(session_id_, "Completed");
-    } else {
-        response_writer_->writeStatusResponse(session_id_, "Failed");
+    auto writer = response_writer_;
+    uint32_t session_id = session_id_;
+    auto token = cancel_token_;
+
+    // Aborted while queued: drop before the first byte moves
+    if (token && token->cancelled()) {
+        writer->write(StatusResponse{session_id, "Aborted"});
+        StatusMulticast::instance().publish(session_id, "Aborted");
+        StatusMulticast::instance().closeSession(session_id);
+        return;
+    }
+
+    // Hand the transfer to the shared curl_multi engine and return: the
+    // worker thread is free again immediately and the completion callback
+    // writes the status response from the engine's event thread
+    uint64_t transfer_id = TinyMCP::Utils::AsyncDownloadEngine::instance().submit(
+        url_, output_path_,
+        [writer, session_id, token](uint64_t, bool success, const std::string& error) {
+            std::string status;
+            if (success) {
+                status = "Completed";
+            } else if (token && token->cancelled()) {
+                status = "Aborted";
+            } else {
+                std::cerr << "Download failed for session " << session_id
+                          << ": " << error << std::endl;
+                status = "Failed";
+            }
+            writer->write(StatusResponse{session_id, status});
+            // Terminal update: fan the same serialized frame to every
+            // session watcher, then retire the topic
+            StatusMulticast::instance().publish(session_id, status);
+            StatusMulticast::instance().closeSession(session_id);
+        },
+        priority_ == 1 ? TinyMCP::Utils::DownloadPriority::Interactive
+                       : TinyMCP::Utils::DownloadPriority::Bulk);
+
+    // From here a cancel aborts the in-flight transfer; the engine's
+    // progress callback turns it into CURLE_ABORTED_BY_CALLBACK within
+    // one data event. onCancel fires immediately if the token was
+    // cancelled between the check above and the submit, so no window is
+    // left where an abort is lost.
+    if (token) {
+        token->onCancel([transfer_id] {
+            TinyMCP::Utils::AsyncDownloadEngine::instance().abort(transfer_id);
+        });
     }
 }
\ No newline at end of file
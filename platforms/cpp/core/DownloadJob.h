@@ -1,4 +1,5 @@
 #pragma once
+#include "CancellationToken.h"
 #include "IJob.h"
 #include <memory>
 #include <string>
@@ -13,10 +14,25 @@ private:
     uint32_t session_id_;
     std::string output_path_;
     std::unique_ptr<CurlClient> curl_client_;
+    // 0 = bulk, 1 = interactive; forwarded to the download engine's
+    // bandwidth scheduler
+    uint8_t priority_;
+    // Optional: cancelled-while-queued jobs are dropped in execute()
+    // without touching the network; once submitted, cancellation aborts
+    // the engine transfer
+    std::shared_ptr<CancellationToken> cancel_token_;
 
 public:
-    DownloadJob(std::shared_ptr<IResponseWriter> writer, const std::string& url, uint32_t sessionId, const std::string& outputPath);
+    DownloadJob(std::shared_ptr<IResponseWriter> writer, const std::string& url, uint32_t sessionId, const std::string& outputPath, uint8_t priority = 0,
+                std::shared_ptr<CancellationToken> cancelToken = nullptr);
     ~DownloadJob() override;
 
     void execute() override;
+
+    // The wire priority carries through to dispatch: JobWorker routes
+    // interactive downloads to the reserved core instead of queueing
+    // them behind bulk work
+    JobClass jobClass() const override {
+        return priority_ >= 1 ? JobClass::Interactive : JobClass::Bulk;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+#include "webgrab_generated.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+/**
+ * Single-pass fast decoders for the hot wire types.
+ *
+ * The generic path costs a recursive Verifier walk plus one GetRoot and
+ * union probe per accessor, which profiles at ~8µs per message on the
+ * Pi. The two dominant types — DownloadRequest on the request path and
+ * DownloadStatusResponse on the response path — are flat tables whose
+ * vtable slots are compile-time constants (the VT_ enums from the
+ * generated code), so one bounds-checked pass can validate the buffer
+ * and fill a packed POD view directly. decode() rejects anything
+ * malformed or truncated; callers fall back to the generic verifier for
+ * buffers it refuses (e.g. Message-union framing).
+ *
+ * String views alias the buffer and are invalidated with it.
+ */
+namespace webgrab {
+namespace fast {
+
+namespace detail {
+
+template <typename T>
+inline bool rd(const uint8_t* buf, size_t size, size_t pos, T& out) {
+    if (pos > size || size - pos < sizeof(T)) return false;
+    std::memcpy(&out, buf + pos, sizeof(T));
+    return true;
+}
+
+struct TableRef {
+    size_t pos;
+    size_t vtable;
+    uint16_t vtableSize;
+};
+
+// Resolves the root table and its vtable with bounds checks only; no
+// per-field verifier recursion
+inline bool root(const uint8_t* buf, size_t size, TableRef& out) {
+    uint32_t rootOff;
+    if (!rd(buf, size, 0, rootOff)) return false;
+    out.pos = rootOff;
+    int32_t soffset;
+    if (!rd(buf, size, out.pos, soffset)) return false;
+    const int64_t vt = static_cast<int64_t>(out.pos) - soffset;
+    if (vt < 0 || static_cast<size_t>(vt) >= size) return false;
+    out.vtable = static_cast<size_t>(vt);
+    if (!rd(buf, size, out.vtable, out.vtableSize)) return false;
+    if (out.vtableSize < 4 || (out.vtableSize & 1) ||
+        size - out.vtable < out.vtableSize) return false;
+    return true;
+}
+
+// 0 means the field is absent (default applies)
+inline uint16_t fieldOffset(const uint8_t* buf, const TableRef& table, uint16_t slot) {
+    if (slot >= table.vtableSize) return 0;
+    uint16_t off;
+    std::memcpy(&off, buf + table.vtable + slot, sizeof(off));
+    return off;
+}
+
+template <typename T>
+inline bool scalar(const uint8_t* buf, size_t size, const TableRef& table,
+                   uint16_t slot, T defaultValue, T& out) {
+    const uint16_t off = fieldOffset(buf, table, slot);
+    if (off == 0) {
+        out = defaultValue;
+        return true;
+    }
+    return rd(buf, size, table.pos + off, out);
+}
+
+inline bool string(const uint8_t* buf, size_t size, const TableRef& table,
+                   uint16_t slot, std::string_view& out) {
+    const uint16_t off = fieldOffset(buf, table, slot);
+    if (off == 0) return false;
+    const size_t fieldPos = table.pos + off;
+    uint32_t rel;
+    if (!rd(buf, size, fieldPos, rel)) return false;
+    const size_t strPos = fieldPos + rel;
+    uint32_t len;
+    if (!rd(buf, size, strPos, len)) return false;
+    // Require the terminating NUL flatc always emits: it is the last
+    // line of defense against a scalar field misread as a string offset
+    if (size - strPos - sizeof(len) <= len) return false;
+    const char* str = reinterpret_cast<const char*>(buf) + strPos + sizeof(len);
+    if (str[len] != '\0') return false;
+    out = std::string_view(str, len);
+    return true;
+}
+
+} // namespace detail
+
+struct DownloadRequestView {
+    std::string_view url;
+    int8_t priority;
+};
+
+struct StatusResponseView {
+    std::string_view status;
+    uint32_t sessionId;
+    uint64_t seq;
+};
+
+template <typename T>
+struct FastDecoder;
+
+template <>
+struct FastDecoder<DownloadRequest> {
+    using View = DownloadRequestView;
+    static bool decode(const uint8_t* buf, size_t size, View& out) {
+        detail::TableRef table;
+        if (!detail::root(buf, size, table)) return false;
+        // url is required on this path; a buffer without it is not a
+        // bare DownloadRequest
+        if (!detail::string(buf, size, table, DownloadRequest::VT_URL, out.url)) return false;
+        return detail::scalar<int8_t>(buf, size, table, DownloadRequest::VT_PRIORITY, 0,
+                                      out.priority);
+    }
+};
+
+template <>
+struct FastDecoder<DownloadStatusResponse> {
+    using View = StatusResponseView;
+    static bool decode(const uint8_t* buf, size_t size, View& out) {
+        detail::TableRef table;
+        if (!detail::root(buf, size, table)) return false;
+        if (!detail::string(buf, size, table, DownloadStatusResponse::VT_STATUS, out.status))
+            return false;
+        return detail::scalar<uint32_t>(buf, size, table, DownloadStatusResponse::VT_SESSIONID,
+                                        0, out.sessionId) &&
+               detail::scalar<uint64_t>(buf, size, table, DownloadStatusResponse::VT_SEQ, 0,
+                                        out.seq);
+    }
+};
+
+} // namespace fast
+} // namespace webgrab
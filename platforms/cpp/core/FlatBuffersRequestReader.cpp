@@ -1,13 +1,114 @@
 #include "FlatBuffersRequestReader.h"
+#include "AllocAudit.h"
+#include "BufferPool.h"
+#include "FastDecode.h"
+#include "FrameCodec.h"
 #include "webgrab_generated.h"
 #include <flatbuffers/verifier.h>
+#include <chrono>
+
+namespace {
+// The wire schema carries no client deadline, so the enqueue budget is
+// applied at arrival: a request that has not been admitted within it is
+// past the point where queueing can still meet the client's timeout
+constexpr std::chrono::milliseconds kEnqueueBudget{500};
+} // namespace
 
 FlatBuffersRequestReader::FlatBuffersRequestReader()
-    : current_type_(RequestType::Unknown) {}
+    : current_type_(RequestType::Unknown), verified_(false) {}
+
+FlatBuffersRequestReader::~FlatBuffersRequestReader() {
+    BufferPool::release(std::move(buffer_));
+}
+
+bool FlatBuffersRequestReader::verifyMessage() {
+    // Single verifier pass per message; accessors afterwards trust the
+    // buffer and hand out views without re-verifying
+    flatbuffers::Verifier verifier(buffer_.data(), buffer_.size());
+    verified_ = verifier.VerifyBuffer<webgrab::Message>(nullptr) ||
+                verifier.VerifyBuffer<webgrab::DownloadRequest>(nullptr) ||
+                verifier.VerifyBuffer<webgrab::DownloadStatusRequest>(nullptr) ||
+                verifier.VerifyBuffer<webgrab::DownloadAbortRequest>(nullptr) ||
+                verifier.VerifyBuffer<webgrab::ShutdownRequest>(nullptr);
+    return verified_;
+}
 
 bool FlatBuffersRequestReader::next(RequestEnvelope& out) {
+    AllocScope allocs(AllocTag::Serialization);
     if (!receiveMessage()) return false;
 
+    // Fast path for the dominant type: a bare DownloadRequest decodes
+    // in one bounds-checked pass over compile-time vtable slots,
+    // skipping the generic verifier and the per-accessor union probing.
+    // Anything the fast decoder refuses (Message framing, other types,
+    // malformed buffers) takes the generic path below.
+    webgrab::fast::DownloadRequestView view;
+    if (webgrab::fast::FastDecoder<webgrab::DownloadRequest>::decode(
+            buffer_.data(), buffer_.size(), view)) {
+        verified_ = true;
+        current_type_ = RequestType::Download;
+        if (replay_log_) {
+            replay_log_->append(buffer_.data(), buffer_.size());
+        }
+        out.type = current_type_;
+        out.sessionId = 0;
+        out.url = view.url;
+        out.priority = static_cast<uint8_t>(view.priority);
+        out.deadline = std::chrono::steady_clock::now() + kEnqueueBudget;
+        return true;
+    }
+
+    if (!verifyMessage()) return false;
+
+    // Envelope is verified and already serialized: logging it is one
+    // memcpy into the mapped ring
+    if (replay_log_) {
+        replay_log_->append(buffer_.data(), buffer_.size());
+    }
+
+    classifyMessage();
+
+    // Populate the envelope with zero-copy views into buffer_; they stay
+    // valid until the next receiveMessage() recycles it
+    out.type = current_type_;
+    out.sessionId = getSessionId();
+    out.url = getDownloadUrlView();
+    out.priority = getDownloadPriority();
+    out.deadline = std::chrono::steady_clock::now() + kEnqueueBudget;
+    return true;
+}
+
+bool FlatBuffersRequestReader::acceptFrame(uint32_t prefix, const void* body, size_t size) {
+    if ((prefix & FrameCodec::kLengthMask) != size) return false;
+    if (prefix & FrameCodec::kCompressedFlag) {
+        std::vector<uint8_t> inflated;
+        if (!FrameCodec::decompress(static_cast<const uint8_t*>(body), size, inflated)) {
+            return false;
+        }
+        return loadMessage(inflated.data(), inflated.size());
+    }
+    return loadMessage(body, size);
+}
+
+bool FlatBuffersRequestReader::loadMessage(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.assign(bytes, bytes + size);
+    if (!verifyMessage()) return false;
+    classifyMessage();
+    return true;
+}
+
+bool FlatBuffersRequestReader::adoptMessage(std::vector<uint8_t>&& data) {
+    // The previous buffer (if any) goes back to the pool rather than
+    // being freed by the move-assign
+    BufferPool::release(std::move(buffer_));
+    buffer_ = std::move(data);
+    if (!verifyMessage()) return false;
+    classifyMessage();
+    return true;
+}
+
+void FlatBuffersRequestReader::classifyMessage() {
     // Try to parse as Message union first
     auto msg = flatbuffers::GetRoot<webgrab::Message>(buffer_.data());
     if (msg && msg->request_type() != webgrab::Request_NONE) {
@@ -24,6 +125,9 @@ bool FlatBuffersRequestReader::next(RequestEnvelope& out) {
             case webgrab::Request_ShutdownRequest:
                 current_type_ = RequestType::Shutdown;
                 break;
+            case webgrab::Request_StatsRequest:
+                current_type_ = RequestType::Stats;
+                break;
             default:
                 current_type_ = RequestType::Unknown;
                 break;
@@ -43,9 +147,6 @@ bool FlatBuffersRequestReader::next(RequestEnvelope& out) {
             current_type_ = RequestType::Unknown;
         }
     }
-
-    out.type = current_type_;
-    return true;
 }
 
 bool FlatBuffersRequestReader::good() const {
@@ -72,18 +173,40 @@ bool FlatBuffersRequestReader::receiveMessage() {
 }
 
 std::string FlatBuffersRequestReader::getDownloadUrl() const {
+    return std::string(getDownloadUrlView());
+}
+
+std::string_view FlatBuffersRequestReader::getDownloadUrlView() const {
     if (current_type_ == RequestType::Download) {
-        // Try Message union first
+        // Try Message union first; the view aliases the string bytes that
+        // already live inside buffer_
         auto msg = flatbuffers::GetRoot<webgrab::Message>(buffer_.data());
         if (msg && msg->request_type() == webgrab::Request_DownloadRequest) {
             auto req = msg->request_as_DownloadRequest();
-            return req && req->url() ? req->url()->str() : "";
+            return req && req->url()
+                ? std::string_view(req->url()->c_str(), req->url()->size())
+                : std::string_view();
         }
         // Fallback to direct parsing
         auto req = flatbuffers::GetRoot<webgrab::DownloadRequest>(buffer_.data());
-        return req && req->url() ? req->url()->str() : "";
+        return req && req->url()
+            ? std::string_view(req->url()->c_str(), req->url()->size())
+            : std::string_view();
+    }
+    return {};
+}
+
+uint8_t FlatBuffersRequestReader::getDownloadPriority() const {
+    if (current_type_ == RequestType::Download) {
+        auto msg = flatbuffers::GetRoot<webgrab::Message>(buffer_.data());
+        if (msg && msg->request_type() == webgrab::Request_DownloadRequest) {
+            auto req = msg->request_as_DownloadRequest();
+            return req ? static_cast<uint8_t>(req->priority()) : 0;
+        }
+        auto req = flatbuffers::GetRoot<webgrab::DownloadRequest>(buffer_.data());
+        return req ? static_cast<uint8_t>(req->priority()) : 0;
     }
-    return "";
+    return 0;
 }
 
 uint32_t FlatBuffersRequestReader::getSessionId() const {
@@ -108,19 +231,8 @@ uint32_t FlatBuffersRequestReader::getSessionId() const {
 }
 
 bool FlatBuffersRequestReader::isValid() const {
-    flatbuffers::Verifier verifier(buffer_.data(), buffer_.size());
-    switch (current_type_) {
-    case RequestType::Download:
-        return verifier.VerifyBuffer<webgrab::DownloadRequest>(nullptr);
-    case RequestType::Status:
-        return verifier.VerifyBuffer<webgrab::DownloadStatusRequest>(nullptr);
-    case RequestType::Abort:
-        return verifier.VerifyBuffer<webgrab::DownloadAbortRequest>(nullptr);
-    case RequestType::Shutdown:
-        return verifier.VerifyBuffer<webgrab::ShutdownRequest>(nullptr);
-    default:
-        return false;
-    }
+    // Verification already happened once in next(); no second pass
+    return verified_;
 }
 
 std::string FlatBuffersRequestReader::getValidationError() const {
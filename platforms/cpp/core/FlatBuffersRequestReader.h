@@ -1,17 +1,29 @@
 #pragma once
 #include "IRequestReader.h"
 #include "IReader.h"
+#include "ReplayLog.h"
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 class FlatBuffersRequestReader : public IRequestReader, public IReader {
 private:
+    // Reader-owned message buffer, recycled between messages: next()
+    // verifies it once and hands out views into it, so dispatch needs no
+    // per-request allocation or memcpy
     std::vector<uint8_t> buffer_;
     RequestType current_type_;
+    bool verified_;
+    // Optional incident log: next() appends each verified envelope. The
+    // bytes are already serialized, so the append is one memcpy into the
+    // mapped ring file
+    std::shared_ptr<ReplayLog> replay_log_;
 
 public:
     explicit FlatBuffersRequestReader();
-    ~FlatBuffersRequestReader() override = default;
+    // Returns the message buffer to the thread's BufferPool free list,
+    // so steady-state ingestion recycles slabs instead of allocating
+    ~FlatBuffersRequestReader() override;
 
     // IRequestReader
     bool next(RequestEnvelope& out) override;
@@ -23,10 +35,34 @@ public:
 
     RequestType getType() const { return current_type_; }
     std::string getDownloadUrl() const;
+    // Zero-copy accessor; the view is invalidated by the next call to next()
+    std::string_view getDownloadUrlView() const;
     uint32_t getSessionId() const;
+    // Priority class of a download request (0 = bulk, 1 = interactive)
+    uint8_t getDownloadPriority() const;
     bool isValid() const;
     std::string getValidationError() const;
 
+    // Enables envelope logging; pass nullptr to disable. The log can be
+    // shared between readers — appends are serialized internally.
+    void enableReplayLog(std::shared_ptr<ReplayLog> log) { replay_log_ = std::move(log); }
+
+    // Loads an already-received envelope (replay path) instead of
+    // reading from a transport; classifies and verifies it like next()
+    bool loadMessage(const void* data, size_t size);
+
+    // Like loadMessage but takes ownership of the buffer by move — the
+    // pooled slab the socket filled becomes buffer_ directly, with no
+    // byte copy between receive and verification
+    bool adoptMessage(std::vector<uint8_t>&& data);
+
+    // Loads one wire frame given its host-order length prefix and body.
+    // A prefix with FrameCodec::kCompressedFlag set is inflated first;
+    // readers understand both forms regardless of negotiation.
+    bool acceptFrame(uint32_t prefix, const void* body, size_t size);
+
 private:
     bool receiveMessage();
+    bool verifyMessage();
+    void classifyMessage();
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "FlatBuffersRequestWriter.h"
+#include "FrameCodec.h"
 #include "TcpSocket.h"
 #include "webgrab_generated.h"
 #include <cstring>
@@ -57,6 +58,17 @@ bool FlatBuffersRequestWriter::write(const void* buffer, size_t size) {
 bool FlatBuffersRequestWriter::sendMessage(const void* data, size_t size) {
     if (!socket_ || !socket_->isConnected()) return false;
 
+    // Compressed frame: flag bit set in the prefix, body carries the
+    // uncompressed size ahead of the deflate stream. compress() refuses
+    // frames it cannot shrink, so the wire never grows.
+    if (compression_enabled_ &&
+        FrameCodec::compress(static_cast<const uint8_t*>(data), size, compress_scratch_)) {
+        uint32_t length = htonl(static_cast<uint32_t>(compress_scratch_.size()) |
+                                FrameCodec::kCompressedFlag);
+        if (!write(&length, sizeof(length))) return false;
+        return write(compress_scratch_.data(), compress_scratch_.size());
+    }
+
     // Send length prefix (big-endian uint32)
     uint32_t length = htonl(static_cast<uint32_t>(size));
     if (!write(&length, sizeof(length))) return false;
@@ -2,6 +2,7 @@
 #include "IRequestWriter.h"
 #include "IWriter.h"
 #include <memory>
+#include <vector>
 #include <flatbuffers/flatbuffers.h>
 
 class TcpSocket; // Forward declaration
@@ -10,6 +11,11 @@ class FlatBuffersRequestWriter : public IRequestWriter, public IWriter {
 private:
     std::shared_ptr<TcpSocket> socket_;
     flatbuffers::FlatBufferBuilder builder_;
+    // Per-frame compression (FrameCodec): off until the peer advertises
+    // support at connection start, so old readers never see a flagged
+    // length prefix
+    bool compression_enabled_ = false;
+    std::vector<uint8_t> compress_scratch_;
 
 public:
     explicit FlatBuffersRequestWriter(std::shared_ptr<TcpSocket> socket);
@@ -26,6 +32,11 @@ public:
     // IWriter
     bool write(const void* buffer, size_t size) override;
 
+    // Call after capability negotiation; frames at or above
+    // FrameCodec::kCompressionThreshold are then deflated when that
+    // actually shrinks them
+    void enableCompression(bool enable = true) { compression_enabled_ = enable; }
+
 private:
     bool sendMessage(const void* data, size_t size);
 };
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "FlatBuffersResponseReader.h"
+#include "BufferPool.h"
+#include "FastDecode.h"
+#include "FrameCodec.h"
 #include "TcpSocket.h"
 #include "webgrab_generated.h"
 #include <cstring>
@@ -35,22 +38,28 @@ bool FlatBuffersResponseReader::recv(DownloadResponse& out) {
 
 bool FlatBuffersResponseReader::recv(StatusResponse& out) {
     if (!receiveMessage()) return false;
-    // Try Message union first
+    // Fast path for the dominant response type: one bounds-checked pass
+    // over compile-time vtable slots, no union probing. This is also
+    // where the multicast stamping surfaces: the view carries the
+    // sessionId appended to the schema.
+    webgrab::fast::StatusResponseView view;
+    if (webgrab::fast::FastDecoder<webgrab::DownloadStatusResponse>::decode(
+            buffer_.data(), buffer_.size(), view)) {
+        out.sessionId = view.sessionId;
+        out.status = std::string(view.status);
+        return true;
+    }
+    // Fallback: Message union framing
     auto msg = flatbuffers::GetRoot<webgrab::Message>(buffer_.data());
     if (msg && msg->response_type() == webgrab::Response_DownloadStatusResponse) {
         auto resp = msg->response_as_DownloadStatusResponse();
         if (resp) {
-            out.sessionId = 0;
+            out.sessionId = resp->sessionId();
             out.status = resp->status() ? resp->status()->str() : "";
             return true;
         }
     }
-    // Fallback to direct parsing
-    auto resp = flatbuffers::GetRoot<webgrab::DownloadStatusResponse>(buffer_.data());
-    if (!resp) return false;
-    out.sessionId = 0;
-    out.status = resp->status() ? resp->status()->str() : "";
-    return true;
+    return false;
 }
 
 bool FlatBuffersResponseReader::recv(ErrorResponse& out) {
@@ -164,11 +173,13 @@ void FlatBuffersResponseReader::close() {
 
 bool FlatBuffersResponseReader::read(void* buffer, size_t size) {
     if (!socket_) return false;
-    std::vector<uint8_t> temp;
-    if (!socket_->receive(temp)) return false;
-    if (temp.size() < size) return false;
-    std::memcpy(buffer, temp.data(), size);
-    return true;
+    std::vector<uint8_t> temp = BufferPool::acquire(BufferPool::kDefaultReceiveSize);
+    const bool ok = socket_->receive(temp) && temp.size() >= size;
+    if (ok) {
+        std::memcpy(buffer, temp.data(), size);
+    }
+    BufferPool::release(std::move(temp));
+    return ok;
 }
 
 bool FlatBuffersResponseReader::receiveMessage() {
@@ -177,9 +188,16 @@ bool FlatBuffersResponseReader::receiveMessage() {
     // Read length prefix
     std::vector<uint8_t> length_buf(sizeof(uint32_t));
     if (!read(length_buf.data(), sizeof(uint32_t))) return false;
-    uint32_t length = ntohl(*reinterpret_cast<uint32_t*>(length_buf.data()));
+    uint32_t prefix = ntohl(*reinterpret_cast<uint32_t*>(length_buf.data()));
+    uint32_t length = prefix & FrameCodec::kLengthMask;
 
-    // Read data
+    // Read data; a flagged prefix marks a deflated body (readers always
+    // understand both forms)
+    if (prefix & FrameCodec::kCompressedFlag) {
+        std::vector<uint8_t> compressed(length);
+        if (!read(compressed.data(), length)) return false;
+        return FrameCodec::decompress(compressed.data(), compressed.size(), buffer_);
+    }
     buffer_.resize(length);
     return read(buffer_.data(), length);
 }
\ No newline at end of file
@@ -1,42 +1,99 @@
 #include "FlatBuffersResponseWriter.h"
+#include "AllocAudit.h"
+#include "ClientSendQueue.h"
 #include "TcpSocket.h"
 #include "webgrab_generated.h"
 #include <cstring>
+#include <vector>
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Per-thread builder free list. Builders above the clamp are not pooled
+// so one oversized response cannot pin its buffer forever.
+constexpr size_t kMaxPooledBuilders = 8;
+constexpr size_t kMaxPooledBuilderSize = 64 * 1024;
+
+thread_local std::vector<std::unique_ptr<flatbuffers::FlatBufferBuilder>> builder_pool;
+
+} // namespace
+
+std::unique_ptr<flatbuffers::FlatBufferBuilder> FlatBuffersResponseWriter::acquireBuilder() {
+    if (!builder_pool.empty()) {
+        auto builder = std::move(builder_pool.back());
+        builder_pool.pop_back();
+        return builder;
+    }
+    return std::make_unique<flatbuffers::FlatBufferBuilder>();
+}
+
+void FlatBuffersResponseWriter::releaseBuilder(std::unique_ptr<flatbuffers::FlatBufferBuilder> builder) {
+    if (!builder) return;
+    if (builder_pool.size() >= kMaxPooledBuilders ||
+        builder->GetSize() > kMaxPooledBuilderSize) {
+        return; // let it free its backing buffer
+    }
+    builder->Reset();
+    builder_pool.push_back(std::move(builder));
+}
 
 FlatBuffersResponseWriter::FlatBuffersResponseWriter(std::shared_ptr<TcpSocket> client_socket)
-    : client_socket_(client_socket) {}
+    : client_socket_(client_socket), builder_(acquireBuilder()) {
+    // Status responses are latency-sensitive; without this, Nagle holds
+    // the segment back waiting for an ACK after the previous response
+    if (client_socket_) {
+        client_socket_->setNoDelay(true);
+    }
+}
 
 FlatBuffersResponseWriter::~FlatBuffersResponseWriter() {
     close();
+    releaseBuilder(std::move(builder_));
 }
 
 bool FlatBuffersResponseWriter::write(const DownloadResponse& resp) {
-    builder_.Clear();
-    auto fb_resp = webgrab::CreateDownloadResponse(builder_, resp.sessionId);
-    builder_.Finish(fb_resp);
+    builder_->Clear();
+    auto fb_resp = webgrab::CreateDownloadResponse(*builder_, resp.sessionId);
+    builder_->Finish(fb_resp);
     return sendResponse();
 }
 
 bool FlatBuffersResponseWriter::write(const StatusResponse& resp) {
-    builder_.Clear();
-    auto status_str = builder_.CreateString(resp.status);
-    auto fb_resp = webgrab::CreateDownloadStatusResponse(builder_, status_str);
-    builder_.Finish(fb_resp);
-    return sendResponse();
+    builder_->Clear();
+    auto status_str = builder_->CreateString(resp.status);
+    // seq stays 0 on the request/response path; only the multicast
+    // publisher stamps per-session sequence numbers
+    auto fb_resp = webgrab::CreateDownloadStatusResponse(
+        *builder_, status_str, resp.sessionId, 0, resp.queuedMs, resp.execMs);
+    builder_->Finish(fb_resp);
+    // Status frames are droppable under queue pressure: a stale one is
+    // superseded by the next before the slow client would have read it
+    return sendResponse(/*droppable=*/true);
 }
 
 bool FlatBuffersResponseWriter::write(const ErrorResponse& resp) {
-    builder_.Clear();
-    auto error_str = builder_.CreateString(resp.error);
-    auto fb_resp = webgrab::CreateErrorResponse(builder_, error_str);
-    builder_.Finish(fb_resp);
+    builder_->Clear();
+    auto error_str = builder_->CreateString(resp.error);
+    auto fb_resp = webgrab::CreateErrorResponse(*builder_, error_str);
+    builder_->Finish(fb_resp);
+    return sendResponse();
+}
+
+bool FlatBuffersResponseWriter::write(const StatsResponse& resp) {
+    builder_->Clear();
+    auto stats_str = builder_->CreateString(resp.stats);
+    auto fb_resp = webgrab::CreateStatsResponse(*builder_, stats_str);
+    builder_->Finish(fb_resp);
     return sendResponse();
 }
 
 bool FlatBuffersResponseWriter::flush() {
-    // For TCP sockets, data is sent immediately, but we can ensure it's flushed
-    // In a real implementation, you might want to use TCP_NODELAY or similar
+    // Nothing buffered here: NODELAY is set on the socket and each
+    // response is uncorked after its gathered write, so data is already
+    // on the wire by the time flush() is called
     return client_socket_ && client_socket_->isConnected();
 }
 
@@ -50,10 +107,64 @@ bool FlatBuffersResponseWriter::write(const void* buffer, size_t size) {
     return client_socket_ && client_socket_->send(buffer, size);
 }
 
-bool FlatBuffersResponseWriter::sendResponse() {
+bool FlatBuffersResponseWriter::sendFilePayload(const std::string& path) {
     if (!client_socket_ || !client_socket_->isConnected()) return false;
 
-    uint32_t length = htonl(static_cast<uint32_t>(builder_.GetSize()));
-    if (!write(&length, sizeof(length))) return false;
-    return write(builder_.GetBufferPointer(), builder_.GetSize());
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) ||
+        static_cast<uint64_t>(st.st_size) > UINT32_MAX) {
+        // The frame prefix is uint32; anything larger cannot be framed
+        ::close(fd);
+        return false;
+    }
+
+    // Cork so the prefix rides in the same segment as the first payload
+    // pages; the kernel then streams the file without a userspace copy
+    uint32_t length = htonl(static_cast<uint32_t>(st.st_size));
+    client_socket_->cork();
+    const bool ok = client_socket_->send(&length, sizeof(length)) &&
+                    client_socket_->sendFile(fd, 0, static_cast<size_t>(st.st_size));
+    client_socket_->uncork();
+    ::close(fd);
+    return ok;
+}
+
+bool FlatBuffersResponseWriter::sendResponse(bool droppable) {
+    AllocScope allocs(AllocTag::Serialization);
+    if (!client_socket_ || !client_socket_->isConnected()) return false;
+
+    uint32_t length = htonl(static_cast<uint32_t>(builder_->GetSize()));
+
+    if (send_queue_) {
+        // Async path: hand the assembled frame to the flusher and return
+        // without touching the socket, so congestion on this client's
+        // link never blocks the producing worker
+        std::vector<uint8_t> frame;
+        frame.reserve(sizeof(length) + builder_->GetSize());
+        const uint8_t* prefix = reinterpret_cast<const uint8_t*>(&length);
+        frame.insert(frame.end(), prefix, prefix + sizeof(length));
+        frame.insert(frame.end(), builder_->GetBufferPointer(),
+                     builder_->GetBufferPointer() + builder_->GetSize());
+        return send_queue_->enqueue(std::move(frame),
+                                    droppable ? ClientSendQueue::FrameClass::Status
+                                              : ClientSendQueue::FrameClass::Result);
+    }
+
+    // Gather the length prefix and the builder's finished buffer into a
+    // single writev: the payload is transmitted in place, one syscall,
+    // no concatenation copy
+    struct iovec iov[2];
+    iov[0].iov_base = &length;
+    iov[0].iov_len = sizeof(length);
+    iov[1].iov_base = builder_->GetBufferPointer();
+    iov[1].iov_len = builder_->GetSize();
+    // Cork across the gathered write so a partial writev retry cannot
+    // leave the prefix stranded in its own undersized segment; uncork
+    // pushes the whole logical message out as one
+    client_socket_->cork();
+    const bool ok = client_socket_->sendv(iov, 2);
+    client_socket_->uncork();
+    return ok;
 }
\ No newline at end of file
@@ -2,14 +2,26 @@
 #include "IResponseWriter.h"
 #include "IWriter.h"
 #include <memory>
+#include <string>
 #include <flatbuffers/flatbuffers.h>
 
 class TcpSocket; // Forward declaration
+class ClientSendQueue;
 
 class FlatBuffersResponseWriter : public IResponseWriter, public IWriter {
 private:
     std::shared_ptr<TcpSocket> client_socket_;
-    flatbuffers::FlatBufferBuilder builder_;
+    // When attached, responses are handed to the queue's flusher instead
+    // of being sent inline, so a slow consumer cannot stall the caller
+    std::shared_ptr<ClientSendQueue> send_queue_;
+    // Builder checked out from a thread-local pool: writers are created
+    // per connection event, and status streaming emits thousands of
+    // responses per session, so the backing buffer is reused instead of
+    // allocated and freed each time
+    std::unique_ptr<flatbuffers::FlatBufferBuilder> builder_;
+
+    static std::unique_ptr<flatbuffers::FlatBufferBuilder> acquireBuilder();
+    static void releaseBuilder(std::unique_ptr<flatbuffers::FlatBufferBuilder> builder);
 
 public:
     explicit FlatBuffersResponseWriter(std::shared_ptr<TcpSocket> client_socket);
@@ -19,12 +31,26 @@ public:
     bool write(const DownloadResponse& resp) override;
     bool write(const StatusResponse& resp) override;
     bool write(const ErrorResponse& resp) override;
+    bool write(const StatsResponse& resp) override;
     bool flush() override;
     void close() override;
 
     // IWriter
     bool write(const void* buffer, size_t size) override;
 
+    // Streams a completed file to the client as one length-prefixed
+    // frame via the socket's sendfile path, so the payload never passes
+    // through a userspace buffer. Deliberately bypasses the async send
+    // queue even when one is attached — queueing a file would buffer it
+    // whole in RAM, which is exactly what sendfile avoids.
+    bool sendFilePayload(const std::string& path);
+
+    // Routes subsequent writes through the per-connection send queue.
+    // Status responses enqueue as droppable, everything else as Result.
+    void enableAsyncSend(std::shared_ptr<ClientSendQueue> queue) {
+        send_queue_ = std::move(queue);
+    }
+
 private:
-    bool sendResponse();
+    bool sendResponse(bool droppable = false);
 };
\ No newline at end of file
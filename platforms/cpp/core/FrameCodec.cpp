@@ -0,0 +1,48 @@
+#include "FrameCodec.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <zlib.h>
+
+namespace {
+
+// Guard against a corrupt header demanding an absurd allocation
+constexpr uint32_t kMaxUncompressedBytes = 64 * 1024 * 1024;
+
+} // namespace
+
+bool FrameCodec::compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    if (size < kCompressionThreshold || size > kLengthMask) return false;
+
+    uLongf bound = compressBound(static_cast<uLong>(size));
+    out.resize(sizeof(uint32_t) + bound);
+
+    if (compress2(out.data() + sizeof(uint32_t), &bound, data,
+                  static_cast<uLong>(size), Z_DEFAULT_COMPRESSION) != Z_OK) {
+        return false;
+    }
+    // Not worth flagging unless the wire actually shrinks
+    if (sizeof(uint32_t) + bound >= size) return false;
+
+    const uint32_t uncompressed = htonl(static_cast<uint32_t>(size));
+    std::memcpy(out.data(), &uncompressed, sizeof(uncompressed));
+    out.resize(sizeof(uint32_t) + bound);
+    return true;
+}
+
+bool FrameCodec::decompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    if (size < sizeof(uint32_t)) return false;
+
+    uint32_t uncompressed;
+    std::memcpy(&uncompressed, data, sizeof(uncompressed));
+    uncompressed = ntohl(uncompressed);
+    if (uncompressed == 0 || uncompressed > kMaxUncompressedBytes) return false;
+
+    out.resize(uncompressed);
+    uLongf outLen = uncompressed;
+    if (uncompress(out.data(), &outLen, data + sizeof(uint32_t),
+                   static_cast<uLong>(size - sizeof(uint32_t))) != Z_OK ||
+        outLen != uncompressed) {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Optional per-frame compression for the FlatBuffers wire framing.
+ *
+ * The ANPR module ships base64 image snippets in request payloads over
+ * the Pi's 4G uplink, where wire bytes are the bottleneck. A frame may
+ * therefore be deflate-compressed: the top bit of the 4-byte length
+ * prefix marks a compressed body, whose first 4 bytes (big-endian)
+ * carry the uncompressed size so the receiver allocates exactly once.
+ * Readers always understand both forms; writers only compress after the
+ * peer has advertised support at connection start, so old endpoints
+ * never see a flagged frame. Small frames stay raw — below the
+ * threshold the deflate header costs more than it saves.
+ */
+class FrameCodec {
+public:
+    // Top bit of the length prefix; lengths are capped well below it
+    static constexpr uint32_t kCompressedFlag = 0x80000000u;
+    static constexpr uint32_t kLengthMask = 0x7FFFFFFFu;
+    // Frames smaller than this are sent raw
+    static constexpr size_t kCompressionThreshold = 512;
+
+    // Deflates payload into out (uncompressed-size header included).
+    // Returns false when compression would not shrink the frame; the
+    // caller then sends it raw.
+    static bool compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    // Inflates a compressed frame body into out. Rejects truncated or
+    // corrupt streams and bodies whose header overstates the size.
+    static bool decompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+};
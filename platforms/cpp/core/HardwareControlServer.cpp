@@ -1,22 +1,88 @@
 #include "HardwareControlServer.h"
+#include "HardwareMetrics.h"
 
 #include <cstring>
 #include <iostream>
 #include <sstream>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <poll.h>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 
+namespace {
+
+// Keyword table for the string-valued command fields. Lookup checks
+// length and first character before comparing, so a miss costs two
+// loads instead of a strcmp per candidate.
+enum class GPIOKeyword {
+    Unknown,
+    Input,
+    Output,
+    Subscribe,
+    Unsubscribe,
+};
+
+struct KeywordEntry {
+    const char* name;
+    size_t length;
+    GPIOKeyword keyword;
+};
+
+constexpr KeywordEntry kKeywordTable[] = {
+    {"input",       5,  GPIOKeyword::Input},
+    {"output",      6,  GPIOKeyword::Output},
+    {"subscribe",   9,  GPIOKeyword::Subscribe},
+    {"unsubscribe", 11, GPIOKeyword::Unsubscribe},
+};
+
+GPIOKeyword LookupKeyword(const std::string& value) {
+    for (const auto& entry : kKeywordTable) {
+        if (value.size() == entry.length && value[0] == entry.name[0] &&
+            value.compare(0, entry.length, entry.name) == 0) {
+            return entry.keyword;
+        }
+    }
+    return GPIOKeyword::Unknown;
+}
+
+// One parser per connection thread; Json::CharReader construction is
+// the expensive part of the old per-request Json::Reader
+Json::CharReader* ThreadLocalJsonReader() {
+    thread_local std::unique_ptr<Json::CharReader> reader(
+        Json::CharReaderBuilder().newCharReader());
+    return reader.get();
+}
+
+// Blocking read of exactly len bytes; false on EOF or error
+bool RecvExact(int fd, void* buffer, size_t len) {
+    auto* out = static_cast<uint8_t*>(buffer);
+    while (len > 0) {
+        ssize_t n = recv(fd, out, len, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        out += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
 namespace WebGrab {
 
 HardwareControlServer::HardwareControlServer(int port,
                                              const std::string& mqtt_host,
-                                             int mqtt_port)
+                                             int mqtt_port,
+                                             int metrics_port)
     : port(port), serverSocket(-1), running(false),
-      mqtt_host(mqtt_host), mqtt_port(mqtt_port), mqtt_client(nullptr),
-      chip(nullptr) {
+      metrics_port(metrics_port), metricsSocket(-1),
+      mqtt_host(mqtt_host), mqtt_port(mqtt_port),
+      chip(nullptr), edgeThreadRunning(false) {
 }
 
 HardwareControlServer::~HardwareControlServer() {
@@ -42,6 +108,14 @@ bool HardwareControlServer::Start() {
     running = true;
     acceptThread = std::thread(&HardwareControlServer::AcceptConnections, this);
 
+    // Metrics endpoint is best-effort; GPIO service runs without it
+    if (metrics_port > 0 && SetupMetricsSocket()) {
+        metricsThread = std::thread(&HardwareControlServer::MetricsLoop, this);
+        std::cout << "Metrics endpoint on port " << metrics_port << std::endl;
+    } else if (metrics_port > 0) {
+        std::cerr << "Failed to setup metrics socket (continuing without metrics)" << std::endl;
+    }
+
     std::cout << "Hardware Control Server started on port " << port << std::endl;
     return true;
 }
@@ -49,24 +123,36 @@ bool HardwareControlServer::Start() {
 void HardwareControlServer::Stop() {
     running = false;
 
+    edgeThreadRunning = false;
+    if (edgeThread.joinable()) {
+        edgeThread.join();
+    }
+
     if (acceptThread.joinable()) {
         acceptThread.join();
     }
 
+    if (metricsSocket != -1) {
+        close(metricsSocket);
+        metricsSocket = -1;
+    }
+    if (metricsThread.joinable()) {
+        metricsThread.join();
+    }
+
     if (serverSocket != -1) {
         close(serverSocket);
         serverSocket = -1;
     }
 
-    // Clean up MQTT
-    if (mqtt_client) {
-        mosquitto_disconnect(mqtt_client);
-        mosquitto_destroy(mqtt_client);
-        mqtt_client = nullptr;
-    }
-
-    if (mqttThread.joinable()) {
-        mqttThread.join();
+    // Clean up MQTT: drop our subscriptions; the shared session
+    // disconnects when its last consumer releases it
+    if (mqtt_session_) {
+        for (uint64_t token : mqtt_tokens_) {
+            mqtt_session_->unsubscribe(token);
+        }
+        mqtt_tokens_.clear();
+        mqtt_session_.reset();
     }
 
     CleanupGPIO();
@@ -96,15 +182,24 @@ bool HardwareControlServer::InitializeGPIO() {
 void HardwareControlServer::CleanupGPIO() {
     std::lock_guard<std::mutex> lock(gpioMutex);
     
-    // Release all line requests
-    for (auto& [pin, info] : activeLines) {
-        if (info.request) {
-            gpiod_line_request_release(info.request);
-            info.request = nullptr;
-        }
+    // Dropping the entries releases the shared line requests
+    for (const auto& [pin, info] : activeLines) {
+        gpioShadow.remove(pin);
     }
     activeLines.clear();
 
+    // Release edge subscription requests
+    {
+        std::lock_guard<std::mutex> edgeLock(edgeMutex);
+        for (auto& [pin, request] : edgeLines) {
+            if (request) {
+                gpiod_line_request_release(request);
+            }
+            gpioShadow.remove(pin);
+        }
+        edgeLines.clear();
+    }
+
     // Close the chip
     if (chip) {
         gpiod_chip_close(chip);
@@ -143,6 +238,73 @@ bool HardwareControlServer::SetupServerSocket() {
     return true;
 }
 
+bool HardwareControlServer::SetupMetricsSocket() {
+    metricsSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (metricsSocket == -1) {
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(metricsSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(metrics_port);
+
+    if (bind(metricsSocket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1 ||
+        listen(metricsSocket, 5) == -1) {
+        close(metricsSocket);
+        metricsSocket = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void HardwareControlServer::MetricsLoop() {
+    // One scrape at a time is plenty; Prometheus polls every few seconds
+    while (running) {
+        pollfd pfd{};
+        pfd.fd = metricsSocket;
+        pfd.events = POLLIN;
+        int ready = poll(&pfd, 1, 500);
+        if (ready <= 0) {
+            continue;
+        }
+
+        int clientSocket = accept(metricsSocket, nullptr, nullptr);
+        if (clientSocket == -1) {
+            continue;
+        }
+
+        // Drain the request line; anything that is not GET /metrics
+        // gets a 404
+        char buffer[1024];
+        ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+        bool wantMetrics = false;
+        if (bytesRead > 0) {
+            buffer[bytesRead] = '\0';
+            wantMetrics = std::strncmp(buffer, "GET /metrics", 12) == 0;
+        }
+
+        std::string response;
+        if (wantMetrics) {
+            const std::string body = HardwareMetrics::instance().renderPrometheus();
+            response = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: text/plain; version=0.0.4\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+        } else {
+            response = "HTTP/1.1 404 Not Found\r\n"
+                       "Content-Length: 0\r\n"
+                       "Connection: close\r\n\r\n";
+        }
+        send(clientSocket, response.c_str(), response.size(), 0);
+        close(clientSocket);
+    }
+}
+
 void HardwareControlServer::AcceptConnections() {
     while (running) {
         sockaddr_in clientAddr{};
@@ -162,41 +324,182 @@ void HardwareControlServer::AcceptConnections() {
 }
 
 void HardwareControlServer::HandleClient(int clientSocket) {
-    char buffer[4096];
+    HardwareMetrics::instance().clientConnected();
+
+    // Protocol negotiation on the first byte: a JSON client's request
+    // starts with a printable character, the framed-mode preamble with
+    // the binary magic. Peeked, so the JSON path still sees its full
+    // first request.
+    uint8_t firstByte = 0;
+    if (recv(clientSocket, &firstByte, 1, MSG_PEEK) == 1 &&
+        firstByte == kGPIOBinaryMagic) {
+        HandleBinaryClient(clientSocket);
+    } else {
+        char buffer[4096];
+        while (running) {
+            ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+            if (bytesRead <= 0) {
+                break;
+            }
+
+            buffer[bytesRead] = '\0';
+            std::string request(buffer);
+            std::string response = HandleGPIOControl(request);
+
+            send(clientSocket, response.c_str(), response.length(), 0);
+        }
+    }
+
+    close(clientSocket);
+    HardwareMetrics::instance().clientDisconnected();
+    std::cout << "Client disconnected" << std::endl;
+}
+
+void HardwareControlServer::HandleBinaryClient(int clientSocket) {
+    // Framed mode (see kGPIOFramingVersion in the header): preamble,
+    // then 2-byte big-endian length + payload per command. Packed
+    // commands share HandleBinaryGPIOCommand with the MQTT binary path;
+    // a framed JSON payload goes through the normal JSON handler.
+    uint8_t preamble[2];
+    if (!RecvExact(clientSocket, preamble, sizeof(preamble)) ||
+        preamble[1] != kGPIOFramingVersion) {
+        return;
+    }
+
+    std::vector<char> payload(kGPIOMaxFrameBytes);
+    std::string frame;
 
     while (running) {
-        ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-        if (bytesRead <= 0) {
+        uint8_t lengthBytes[2];
+        if (!RecvExact(clientSocket, lengthBytes, sizeof(lengthBytes))) {
+            break;
+        }
+        const uint16_t length =
+            static_cast<uint16_t>(lengthBytes[0] << 8 | lengthBytes[1]);
+        if (length == 0 || length > kGPIOMaxFrameBytes) {
+            break;  // protocol error; drop the connection
+        }
+        if (!RecvExact(clientSocket, payload.data(), length)) {
             break;
         }
 
-        buffer[bytesRead] = '\0';
-        std::string request(buffer);
-        std::string response = HandleGPIOControl(request);
+        std::string response;
+        if (length == sizeof(GPIOBinaryCommand) &&
+            static_cast<uint8_t>(payload[0]) == kGPIOBinaryMagic) {
+            GPIOBinaryCommand cmd;
+            std::memcpy(&cmd, payload.data(), sizeof(cmd));
+            response = HandleBinaryGPIOCommand(cmd);
+        } else {
+            response = HandleGPIOControl(std::string(payload.data(), length));
+        }
 
-        send(clientSocket, response.c_str(), response.length(), 0);
+        if (response.size() > 0xFFFF) {
+            break;  // cannot frame; responses here are small JSON
+        }
+        // Header and body in one send; at thousands of ops per second
+        // two syscalls per response would be the next bottleneck
+        frame.clear();
+        frame.push_back(static_cast<char>(response.size() >> 8));
+        frame.push_back(static_cast<char>(response.size() & 0xFF));
+        frame.append(response);
+        if (send(clientSocket, frame.data(), frame.size(), 0) !=
+            static_cast<ssize_t>(frame.size())) {
+            break;
+        }
     }
-
-    close(clientSocket);
-    std::cout << "Client disconnected" << std::endl;
 }
 
 std::string HardwareControlServer::HandleGPIOControl(const std::string& jsonRequest) {
     Json::Value params;
     Json::Value response;
-    Json::Reader reader;
 
     try {
-        if (!reader.parse(jsonRequest, params)) {
+        std::string parseErrors;
+        if (!ThreadLocalJsonReader()->parse(jsonRequest.data(),
+                                            jsonRequest.data() + jsonRequest.size(),
+                                            &params, &parseErrors)) {
             response["success"] = false;
             response["error"] = "Invalid JSON request";
             return Json::FastWriter().write(response);
         }
 
+        // Array form: {"pins": [...], "direction": "...", "values": [...]}
+        // touches every listed offset through a single gpiod request
+        if (params.isMember("pins") && params["pins"].isArray()) {
+            std::vector<int> pins;
+            for (const auto& p : params["pins"]) {
+                int pin = p.asInt();
+                if (pin < 0 || pin > 40) {
+                    response["success"] = false;
+                    response["error"] = "Invalid pin number. Must be between 0 and 40.";
+                    return Json::FastWriter().write(response);
+                }
+                pins.push_back(pin);
+            }
+
+            std::string direction = params.get("direction", "").asString();
+            std::vector<bool> values;
+            if (params.isMember("values") && params["values"].isArray()) {
+                for (const auto& v : params["values"]) {
+                    values.push_back(v.asInt() != 0);
+                }
+                if (values.size() != pins.size()) {
+                    response["success"] = false;
+                    response["error"] = "'values' length must match 'pins' length";
+                    return Json::FastWriter().write(response);
+                }
+            }
+
+            GPIOKeyword directionKeyword = LookupKeyword(direction);
+            if (!direction.empty()) {
+                if (directionKeyword != GPIOKeyword::Input && directionKeyword != GPIOKeyword::Output) {
+                    response["success"] = false;
+                    response["error"] = "Invalid direction. Must be 'input' or 'output'.";
+                    return Json::FastWriter().write(response);
+                }
+                if (!ConfigureGPIOPins(pins, direction)) {
+                    response["success"] = false;
+                    response["error"] = "Failed to configure GPIO pins";
+                    return Json::FastWriter().write(response);
+                }
+                response["success"] = true;
+                response["message"] = std::to_string(pins.size()) + " GPIO pins configured as " + direction;
+                if (directionKeyword == GPIOKeyword::Output && !values.empty()) {
+                    if (!SetGPIOPins(pins, values)) {
+                        response["success"] = false;
+                        response["error"] = "Failed to set GPIO pin values";
+                    }
+                }
+            } else if (!values.empty()) {
+                if (SetGPIOPins(pins, values)) {
+                    response["success"] = true;
+                    response["message"] = std::to_string(pins.size()) + " GPIO pins set";
+                } else {
+                    response["success"] = false;
+                    response["error"] = "Failed to set GPIO pin values. Pins may not be configured as output.";
+                }
+            } else {
+                std::vector<bool> read_values;
+                if (GetGPIOPins(pins, read_values)) {
+                    response["success"] = true;
+                    Json::Value arr(Json::arrayValue);
+                    for (bool v : read_values) {
+                        arr.append(v ? 1 : 0);
+                    }
+                    response["values"] = arr;
+                } else {
+                    response["success"] = false;
+                    response["error"] = "Failed to read GPIO pin values";
+                }
+            }
+            return Json::FastWriter().write(response);
+        }
+
         // Extract parameters
         int pin = params.get("pin", -1).asInt();
         std::string direction = params.get("direction", "").asString();
         int value = params.get("value", -1).asInt();
+        std::string edge = params.get("edge", "").asString();
 
         // Validate pin
         if (pin < 0 || pin > 40) {
@@ -205,15 +508,43 @@ std::string HardwareControlServer::HandleGPIOControl(const std::string& jsonRequ
             return Json::FastWriter().write(response);
         }
 
+        // Handle edge subscription requests
+        if (!edge.empty()) {
+            GPIOKeyword edgeKeyword = LookupKeyword(edge);
+            if (edgeKeyword == GPIOKeyword::Subscribe) {
+                if (SubscribeGPIOEdges(pin)) {
+                    response["success"] = true;
+                    response["message"] = "GPIO pin " + std::to_string(pin) +
+                                          " edge events published to hardware/gpio/events";
+                } else {
+                    response["success"] = false;
+                    response["error"] = "Failed to subscribe to GPIO pin edges";
+                }
+            } else if (edgeKeyword == GPIOKeyword::Unsubscribe) {
+                if (UnsubscribeGPIOEdges(pin)) {
+                    response["success"] = true;
+                    response["message"] = "GPIO pin " + std::to_string(pin) + " edge subscription removed";
+                } else {
+                    response["success"] = false;
+                    response["error"] = "GPIO pin not subscribed";
+                }
+            } else {
+                response["success"] = false;
+                response["error"] = "Invalid edge action. Must be 'subscribe' or 'unsubscribe'.";
+            }
+            return Json::FastWriter().write(response);
+        }
+
         // Handle direction configuration
         if (!direction.empty()) {
-            if (direction == "input" || direction == "output") {
+            GPIOKeyword directionKeyword = LookupKeyword(direction);
+            if (directionKeyword == GPIOKeyword::Input || directionKeyword == GPIOKeyword::Output) {
                 if (ConfigureGPIOPin(pin, direction)) {
                     response["success"] = true;
                     response["message"] = "GPIO pin " + std::to_string(pin) + " configured as " + direction;
 
                     // If output and value provided, set the value
-                    if (direction == "output" && value >= 0) {
+                    if (directionKeyword == GPIOKeyword::Output && value >= 0) {
                         if (SetGPIOPin(pin, value != 0)) {
                             std::string currentMessage = response.get("message", "").asString();
                             response["message"] = currentMessage + " and set to " + std::to_string(value);
@@ -223,7 +554,7 @@ std::string HardwareControlServer::HandleGPIOControl(const std::string& jsonRequ
                         }
                     }
                     // If input, read the current value
-                    else if (direction == "input") {
+                    else if (directionKeyword == GPIOKeyword::Input) {
                         bool currentValue;
                         if (GetGPIOPin(pin, currentValue)) {
                             response["value"] = currentValue ? 1 : 0;
@@ -274,20 +605,69 @@ std::string HardwareControlServer::HandleGPIOControl(const std::string& jsonRequ
     }
 }
 
+std::string HardwareControlServer::HandleBinaryGPIOCommand(const GPIOBinaryCommand& cmd) {
+    Json::Value response;
+
+    int pin = cmd.pin;
+    if (pin > 40) {
+        response["success"] = false;
+        response["error"] = "Invalid pin number. Must be between 0 and 40.";
+        return Json::FastWriter().write(response);
+    }
+
+    switch (static_cast<GPIOBinaryAction>(cmd.action)) {
+    case GPIOBinaryAction::Get: {
+        bool value;
+        if (GetGPIOPin(pin, value)) {
+            response["success"] = true;
+            response["value"] = value ? 1 : 0;
+        } else {
+            response["success"] = false;
+            response["error"] = "Failed to read GPIO pin value";
+        }
+        break;
+    }
+    case GPIOBinaryAction::Set:
+        response["success"] = SetGPIOPin(pin, cmd.value != 0);
+        if (!response["success"].asBool()) {
+            response["error"] = "Failed to set GPIO pin value";
+        }
+        break;
+    case GPIOBinaryAction::ConfigureInput:
+        response["success"] = ConfigureGPIOPin(pin, "input");
+        break;
+    case GPIOBinaryAction::ConfigureOutput:
+        response["success"] = ConfigureGPIOPin(pin, "output");
+        if (response["success"].asBool()) {
+            response["success"] = SetGPIOPin(pin, cmd.value != 0);
+        }
+        break;
+    case GPIOBinaryAction::Subscribe:
+        response["success"] = SubscribeGPIOEdges(pin);
+        break;
+    case GPIOBinaryAction::Unsubscribe:
+        response["success"] = UnsubscribeGPIOEdges(pin);
+        break;
+    default:
+        response["success"] = false;
+        response["error"] = "Unknown binary GPIO action";
+        break;
+    }
+
+    response["pin"] = pin;
+    return Json::FastWriter().write(response);
+}
+
 bool HardwareControlServer::ConfigureGPIOPin(int pin, const std::string& direction) {
+    GpioOpTimer timer(HardwareMetrics::GpioConfigure);
     if (!chip) return false;
 
     std::lock_guard<std::mutex> lock(gpioMutex);
 
     try {
         // Release existing line request if it exists
-        auto it = activeLines.find(pin);
-        if (it != activeLines.end()) {
-            if (it->second.request) {
-                gpiod_line_request_release(it->second.request);
-            }
-            activeLines.erase(it);
-        }
+        activeLines.erase(pin);
+        gpioShadow.remove(pin);
 
         // Create line settings
         struct gpiod_line_settings* settings = gpiod_line_settings_new();
@@ -346,11 +726,16 @@ bool HardwareControlServer::ConfigureGPIOPin(int pin, const std::string& directi
 
         // Store the configured line
         GPIOLineInfo info;
-        info.request = request;
+        info.request = std::shared_ptr<struct gpiod_line_request>(request, gpiod_line_request_release);
         info.offset = offset;
         info.is_output = is_output;
         activeLines[pin] = info;
 
+        // Outputs start INACTIVE per the line settings above
+        if (is_output) {
+            gpioShadow.update(pin, false);
+        }
+
         std::cout << "GPIO pin " << pin << " configured as " << direction << std::endl;
         return true;
 
@@ -361,6 +746,7 @@ bool HardwareControlServer::ConfigureGPIOPin(int pin, const std::string& directi
 }
 
 bool HardwareControlServer::SetGPIOPin(int pin, bool value) {
+    GpioOpTimer timer(HardwareMetrics::GpioSet);
     std::lock_guard<std::mutex> lock(gpioMutex);
 
     auto it = activeLines.find(pin);
@@ -375,17 +761,26 @@ bool HardwareControlServer::SetGPIOPin(int pin, bool value) {
     }
 
     enum gpiod_line_value val = value ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE;
-    int ret = gpiod_line_request_set_value(it->second.request, it->second.offset, val);
+    int ret = gpiod_line_request_set_value(it->second.request.get(), it->second.offset, val);
     
     if (ret < 0) {
         std::cerr << "Failed to set GPIO pin " << pin << std::endl;
         return false;
     }
 
+    gpioShadow.update(pin, value);
     return true;
 }
 
 bool HardwareControlServer::GetGPIOPin(int pin, bool& value) {
+    GpioOpTimer timer(HardwareMetrics::GpioGet);
+
+    // Pins we drive (or watch via edges) answer from the mirror with no
+    // syscall and no gpioMutex contention against control writes
+    if (gpioShadow.read(pin, value)) {
+        return true;
+    }
+
     std::lock_guard<std::mutex> lock(gpioMutex);
 
     auto it = activeLines.find(pin);
@@ -394,7 +789,7 @@ bool HardwareControlServer::GetGPIOPin(int pin, bool& value) {
         return false;
     }
 
-    enum gpiod_line_value val = gpiod_line_request_get_value(it->second.request, it->second.offset);
+    enum gpiod_line_value val = gpiod_line_request_get_value(it->second.request.get(), it->second.offset);
     
     if (val == GPIOD_LINE_VALUE_ERROR) {
         std::cerr << "Failed to get GPIO pin " << pin << std::endl;
@@ -405,83 +800,397 @@ bool HardwareControlServer::GetGPIOPin(int pin, bool& value) {
     return true;
 }
 
-bool HardwareControlServer::InitializeMQTT() {
-    mosquitto_lib_init();
-    
-    mqtt_client = mosquitto_new("hardware-control-server", true, this);
-    if (!mqtt_client) {
-        std::cerr << "Failed to create MQTT client" << std::endl;
+bool HardwareControlServer::ConfigureGPIOPins(const std::vector<int>& pins, const std::string& direction) {
+    GpioOpTimer timer(HardwareMetrics::GpioConfigure);
+    if (!chip || pins.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(gpioMutex);
+
+    // Release any existing requests for these pins first
+    for (int pin : pins) {
+        activeLines.erase(pin);
+        gpioShadow.remove(pin);
+    }
+
+    struct gpiod_line_settings* settings = gpiod_line_settings_new();
+    if (!settings) {
+        std::cerr << "Failed to create line settings" << std::endl;
         return false;
     }
 
-    mosquitto_connect_callback_set(mqtt_client, on_mqtt_connect);
-    mosquitto_message_callback_set(mqtt_client, on_mqtt_message);
+    bool is_output = (direction == "output");
+    if (is_output) {
+        gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
+        gpiod_line_settings_set_output_value(settings, GPIOD_LINE_VALUE_INACTIVE);
+    } else {
+        gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+    }
 
-    int rc = mosquitto_connect(mqtt_client, mqtt_host.c_str(), mqtt_port, 60);
-    if (rc != MOSQ_ERR_SUCCESS) {
-        std::cerr << "Failed to connect to MQTT broker: " << mosquitto_strerror(rc) << std::endl;
-        mosquitto_destroy(mqtt_client);
-        mqtt_client = nullptr;
+    struct gpiod_line_config* line_config = gpiod_line_config_new();
+    if (!line_config) {
+        gpiod_line_settings_free(settings);
+        std::cerr << "Failed to create line config" << std::endl;
         return false;
     }
 
-    // Subscribe to GPIO control topics
-    mosquitto_subscribe(mqtt_client, nullptr, "hardware/gpio/control", 0);
-    mosquitto_subscribe(mqtt_client, nullptr, "hardware/gpio/status", 0);
+    // All offsets share the same settings within one config
+    std::vector<unsigned int> offsets;
+    offsets.reserve(pins.size());
+    for (int pin : pins) {
+        offsets.push_back(static_cast<unsigned int>(pin));
+    }
 
-    // Start MQTT loop thread
-    mqttThread = std::thread(&HardwareControlServer::MQTTLoop, this);
+    int ret = gpiod_line_config_add_line_settings(line_config, offsets.data(),
+                                                  offsets.size(), settings);
+    gpiod_line_settings_free(settings);
+    if (ret < 0) {
+        gpiod_line_config_free(line_config);
+        std::cerr << "Failed to add line settings to config" << std::endl;
+        return false;
+    }
 
-    std::cout << "MQTT initialized and connected to " << mqtt_host << ":" << mqtt_port << std::endl;
+    struct gpiod_request_config* req_config = gpiod_request_config_new();
+    if (!req_config) {
+        gpiod_line_config_free(line_config);
+        std::cerr << "Failed to create request config" << std::endl;
+        return false;
+    }
+    gpiod_request_config_set_consumer(req_config, "hardware-control-server");
+
+    struct gpiod_line_request* raw = gpiod_chip_request_lines(chip, req_config, line_config);
+    gpiod_request_config_free(req_config);
+    gpiod_line_config_free(line_config);
+
+    if (!raw) {
+        std::cerr << "Failed to request GPIO lines (bulk)" << std::endl;
+        return false;
+    }
+
+    // Every pin of the group shares the one request
+    auto request = std::shared_ptr<struct gpiod_line_request>(raw, gpiod_line_request_release);
+    for (size_t i = 0; i < pins.size(); i++) {
+        GPIOLineInfo info;
+        info.request = request;
+        info.offset = offsets[i];
+        info.is_output = is_output;
+        activeLines[pins[i]] = info;
+        if (is_output) {
+            gpioShadow.update(pins[i], false);
+        }
+    }
+
+    std::cout << "GPIO pins (" << pins.size() << ") configured as " << direction
+              << " in one request" << std::endl;
     return true;
 }
 
-void HardwareControlServer::MQTTLoop() {
-    while (running && mqtt_client) {
-        int rc = mosquitto_loop(mqtt_client, 100, 1);
-        if (rc != MOSQ_ERR_SUCCESS) {
-            if (running) {
-                std::cerr << "MQTT loop error: " << mosquitto_strerror(rc) << std::endl;
-                // Try to reconnect
-                mosquitto_reconnect(mqtt_client);
-            }
+bool HardwareControlServer::SetGPIOPins(const std::vector<int>& pins, const std::vector<bool>& values) {
+    GpioOpTimer timer(HardwareMetrics::GpioSet);
+    if (pins.size() != values.size() || pins.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(gpioMutex);
+
+    // Group offsets by owning request so each kernel request gets one
+    // set_values_subset ioctl, even if the pins were configured in
+    // separate batches
+    std::unordered_map<struct gpiod_line_request*,
+                       std::pair<std::vector<unsigned int>, std::vector<enum gpiod_line_value>>> groups;
+
+    for (size_t i = 0; i < pins.size(); i++) {
+        auto it = activeLines.find(pins[i]);
+        if (it == activeLines.end() || !it->second.request || !it->second.is_output) {
+            std::cerr << "GPIO pin " << pins[i] << " not configured as output" << std::endl;
+            return false;
+        }
+        auto& group = groups[it->second.request.get()];
+        group.first.push_back(it->second.offset);
+        group.second.push_back(values[i] ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE);
+    }
+
+    for (auto& [request, group] : groups) {
+        int ret = gpiod_line_request_set_values_subset(request, group.first.size(),
+                                                       group.first.data(), group.second.data());
+        if (ret < 0) {
+            std::cerr << "Failed to set GPIO pins (bulk)" << std::endl;
+            return false;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
+
+    for (size_t i = 0; i < pins.size(); i++) {
+        gpioShadow.update(pins[i], values[i]);
+    }
+    return true;
 }
 
-void HardwareControlServer::on_mqtt_connect(struct mosquitto* mosq, void* obj, int rc) {
-    if (rc == 0) {
-        std::cout << "MQTT connected successfully" << std::endl;
-    } else {
-        std::cerr << "MQTT connection failed: " << mosquitto_connack_string(rc) << std::endl;
+bool HardwareControlServer::GetGPIOPins(const std::vector<int>& pins, std::vector<bool>& values) {
+    GpioOpTimer timer(HardwareMetrics::GpioGet);
+    if (pins.empty()) return false;
+
+    values.assign(pins.size(), false);
+
+    // The dashboard's full-pin poll typically hits only mirrored pins;
+    // one unmirrored pin sends the whole batch down the kernel path so
+    // the caller still gets a single consistent read
+    bool allMirrored = true;
+    for (size_t i = 0; i < pins.size(); i++) {
+        bool value = false;
+        if (!gpioShadow.read(pins[i], value)) {
+            allMirrored = false;
+            break;
+        }
+        values[i] = value;
+    }
+    if (allMirrored) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(gpioMutex);
+
+    values.assign(pins.size(), false);
+
+    std::unordered_map<struct gpiod_line_request*,
+                       std::pair<std::vector<unsigned int>, std::vector<size_t>>> groups;
+
+    for (size_t i = 0; i < pins.size(); i++) {
+        auto it = activeLines.find(pins[i]);
+        if (it == activeLines.end() || !it->second.request) {
+            std::cerr << "GPIO pin " << pins[i] << " not configured" << std::endl;
+            return false;
+        }
+        auto& group = groups[it->second.request.get()];
+        group.first.push_back(it->second.offset);
+        group.second.push_back(i);
+    }
+
+    for (auto& [request, group] : groups) {
+        std::vector<enum gpiod_line_value> vals(group.first.size(), GPIOD_LINE_VALUE_ERROR);
+        int ret = gpiod_line_request_get_values_subset(request, group.first.size(),
+                                                       group.first.data(), vals.data());
+        if (ret < 0) {
+            std::cerr << "Failed to get GPIO pins (bulk)" << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < vals.size(); i++) {
+            values[group.second[i]] = (vals[i] == GPIOD_LINE_VALUE_ACTIVE);
+        }
+    }
+
+    return true;
+}
+
+bool HardwareControlServer::SubscribeGPIOEdges(int pin) {
+    if (!chip) return false;
+
+    // The kernel allows only one request per line, so drop any plain
+    // input/output request for this pin before re-requesting with edges
+    {
+        std::lock_guard<std::mutex> lock(gpioMutex);
+        activeLines.erase(pin);
+        gpioShadow.remove(pin);
+    }
+
+    std::lock_guard<std::mutex> lock(edgeMutex);
+
+    if (edgeLines.count(pin)) {
+        return true; // already subscribed
+    }
+
+    struct gpiod_line_settings* settings = gpiod_line_settings_new();
+    if (!settings) {
+        std::cerr << "Failed to create line settings" << std::endl;
+        return false;
+    }
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+    gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+
+    struct gpiod_line_config* line_config = gpiod_line_config_new();
+    if (!line_config) {
+        gpiod_line_settings_free(settings);
+        std::cerr << "Failed to create line config" << std::endl;
+        return false;
+    }
+
+    unsigned int offset = static_cast<unsigned int>(pin);
+    int ret = gpiod_line_config_add_line_settings(line_config, &offset, 1, settings);
+    gpiod_line_settings_free(settings);
+    if (ret < 0) {
+        gpiod_line_config_free(line_config);
+        std::cerr << "Failed to add line settings to config" << std::endl;
+        return false;
+    }
+
+    struct gpiod_request_config* req_config = gpiod_request_config_new();
+    if (!req_config) {
+        gpiod_line_config_free(line_config);
+        std::cerr << "Failed to create request config" << std::endl;
+        return false;
+    }
+    gpiod_request_config_set_consumer(req_config, "hardware-control-server-edge");
+
+    struct gpiod_line_request* request = gpiod_chip_request_lines(chip, req_config, line_config);
+    gpiod_request_config_free(req_config);
+    gpiod_line_config_free(line_config);
+
+    if (!request) {
+        std::cerr << "Failed to request edge events for GPIO line " << pin << std::endl;
+        return false;
     }
+
+    edgeLines[pin] = request;
+
+    if (!edgeThreadRunning.exchange(true)) {
+        edgeThread = std::thread(&HardwareControlServer::EdgeEventLoop, this);
+    }
+
+    std::cout << "GPIO pin " << pin << " subscribed for edge events" << std::endl;
+    return true;
+}
+
+bool HardwareControlServer::UnsubscribeGPIOEdges(int pin) {
+    std::lock_guard<std::mutex> lock(edgeMutex);
+
+    auto it = edgeLines.find(pin);
+    if (it == edgeLines.end()) {
+        return false;
+    }
+
+    if (it->second) {
+        gpiod_line_request_release(it->second);
+    }
+    edgeLines.erase(it);
+    gpioShadow.remove(pin);
+    return true;
 }
 
-void HardwareControlServer::on_mqtt_message(struct mosquitto* mosq, void* obj,
-                                           const struct mosquitto_message* msg) {
-    auto* server = static_cast<HardwareControlServer*>(obj);
-    if (!server || !msg || !msg->payload) {
+void HardwareControlServer::EdgeEventLoop() {
+    struct gpiod_edge_event_buffer* buffer = gpiod_edge_event_buffer_new(16);
+    if (!buffer) {
+        std::cerr << "Failed to create edge event buffer" << std::endl;
+        edgeThreadRunning = false;
         return;
     }
 
-    std::string topic(msg->topic);
-    std::string payload(static_cast<const char*>(msg->payload), msg->payloadlen);
+    while (edgeThreadRunning) {
+        // Snapshot subscribed fds; short poll timeout keeps subscription
+        // changes and shutdown responsive without a wakeup channel
+        std::vector<struct pollfd> fds;
+        std::vector<int> pins;
+        {
+            std::lock_guard<std::mutex> lock(edgeMutex);
+            fds.reserve(edgeLines.size());
+            pins.reserve(edgeLines.size());
+            for (const auto& [pin, request] : edgeLines) {
+                if (!request) continue;
+                struct pollfd pfd{};
+                pfd.fd = gpiod_line_request_get_fd(request);
+                pfd.events = POLLIN;
+                fds.push_back(pfd);
+                pins.push_back(pin);
+            }
+        }
+
+        if (fds.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        int ready = poll(fds.data(), fds.size(), 200);
+        if (ready <= 0) {
+            continue;
+        }
+
+        // Drain under edgeMutex, publish after releasing it:
+        // PublishEdgeEvent takes mqttMutex, and the MQTT handler holds
+        // mqttMutex while routing edge subscribe/unsubscribe commands
+        // into edgeMutex — publishing under the edge lock would be an
+        // ABBA wedge between the two threads.
+        struct PendingEdge {
+            int pin;
+            bool rising;
+            uint64_t timestampNs;
+        };
+        std::vector<PendingEdge> events;
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (!(fds[i].revents & POLLIN)) continue;
+
+            std::lock_guard<std::mutex> lock(edgeMutex);
+            auto it = edgeLines.find(pins[i]);
+            if (it == edgeLines.end() || !it->second) {
+                continue; // unsubscribed while we were polling
+            }
 
-    server->HandleMQTTMessage(topic, payload);
+            int count = gpiod_line_request_read_edge_events(it->second, buffer, 16);
+            for (int e = 0; e < count; e++) {
+                struct gpiod_edge_event* event = gpiod_edge_event_buffer_get_event(buffer, e);
+                if (!event) continue;
+                bool rising = (gpiod_edge_event_get_event_type(event) == GPIOD_EDGE_EVENT_RISING_EDGE);
+                events.push_back({pins[i], rising, gpiod_edge_event_get_timestamp_ns(event)});
+            }
+        }
+        for (const PendingEdge& e : events) {
+            PublishEdgeEvent(e.pin, e.rising, e.timestampNs);
+        }
+    }
+
+    gpiod_edge_event_buffer_free(buffer);
+}
+
+void HardwareControlServer::PublishEdgeEvent(int pin, bool rising, uint64_t timestamp_ns) {
+    // The kernel just told us the level; mirror it so reads of this
+    // edge-subscribed input skip the syscall too
+    gpioShadow.update(pin, rising);
+
+    Json::Value event;
+    event["pin"] = pin;
+    event["edge"] = rising ? "rising" : "falling";
+    event["value"] = rising ? 1 : 0;
+    event["timestamp_ns"] = static_cast<Json::UInt64>(timestamp_ns);
+
+    std::string payload = Json::FastWriter().write(event);
+
+    std::lock_guard<std::mutex> lock(mqttMutex);
+    if (mqtt_session_) {
+        mqtt_session_->publish("hardware/gpio/events", payload, 0, false);
+    }
+}
+
+bool HardwareControlServer::InitializeMQTT() {
+    // Shared per-broker session: one connection and keepalive stream
+    // serves this server plus any MQTT reader/writer on the node
+    mqtt_session_ = MQTTSession::get(mqtt_host, mqtt_port);
+    if (!mqtt_session_) {
+        return false;
+    }
+
+    auto handler = [this](const std::string& topic, const MqttPayload& payload) {
+        HandleMQTTMessage(topic, *payload);
+    };
+    mqtt_tokens_.push_back(mqtt_session_->subscribe("hardware/gpio/control", handler));
+    mqtt_tokens_.push_back(mqtt_session_->subscribe("hardware/gpio/status", handler));
+
+    std::cout << "MQTT initialized and connected to " << mqtt_host << ":" << mqtt_port << std::endl;
+    return true;
 }
 
 void HardwareControlServer::HandleMQTTMessage(const std::string& topic, const std::string& payload) {
+    HardwareMetrics::instance().mqttMessageBegin();
     std::lock_guard<std::mutex> lock(mqttMutex);
 
     if (topic == "hardware/gpio/control") {
-        // Handle GPIO control via MQTT
-        std::string response = HandleGPIOControl(payload);
-        
+        // Compact binary commands skip the JSON parse entirely
+        std::string response;
+        if (payload.size() == sizeof(GPIOBinaryCommand) &&
+            static_cast<uint8_t>(payload[0]) == kGPIOBinaryMagic) {
+            GPIOBinaryCommand cmd;
+            std::memcpy(&cmd, payload.data(), sizeof(cmd));
+            response = HandleBinaryGPIOCommand(cmd);
+        } else {
+            response = HandleGPIOControl(payload);
+        }
+
         // Publish response
-        if (mqtt_client) {
-            mosquitto_publish(mqtt_client, nullptr, "hardware/gpio/response", 
-                           response.length(), response.c_str(), 0, false);
+        if (mqtt_session_) {
+            mqtt_session_->publish("hardware/gpio/response", response, 0, false);
         }
     } else if (topic == "hardware/gpio/status") {
         // Handle status request
@@ -499,7 +1208,7 @@ void HardwareControlServer::HandleMQTTMessage(const std::string& topic, const st
             // Actually, since we're in HandleMQTTMessage which already holds mqttMutex,
             // and GetGPIOPin holds gpioMutex, this is safe
             if (info.request) {
-                enum gpiod_line_value val = gpiod_line_request_get_value(info.request, info.offset);
+                enum gpiod_line_value val = gpiod_line_request_get_value(info.request.get(), info.offset);
                 if (val != GPIOD_LINE_VALUE_ERROR) {
                     pinInfo["value"] = (val == GPIOD_LINE_VALUE_ACTIVE) ? 1 : 0;
                 }
@@ -511,11 +1220,12 @@ void HardwareControlServer::HandleMQTTMessage(const std::string& topic, const st
         Json::StreamWriterBuilder builder;
         std::string statusJson = Json::writeString(builder, status);
         
-        if (mqtt_client) {
-            mosquitto_publish(mqtt_client, nullptr, "hardware/gpio/status_response",
-                           statusJson.length(), statusJson.c_str(), 0, false);
+        if (mqtt_session_) {
+            mqtt_session_->publish("hardware/gpio/status_response", statusJson, 0, false);
         }
     }
+
+    HardwareMetrics::instance().mqttMessageEnd();
 }
 
 } // namespace WebGrab
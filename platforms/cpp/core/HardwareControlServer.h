@@ -3,28 +3,151 @@
 // Use libgpiod C API for compatibility with both 1.x and 2.x
 #include <gpiod.h>
 #include <json/json.h>
-#include <mosquitto.h>
+
+#include "MQTTSession.h"
 
 // Standard library includes
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <netinet/in.h>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 
 namespace WebGrab {
 
+/**
+ * @brief Compact binary GPIO command for the MQTT control path
+ *
+ * Payloads on hardware/gpio/control that are exactly 4 bytes and start
+ * with kGPIOBinaryMagic are decoded as this packed struct instead of
+ * JSON, skipping the parse entirely for latency-critical callers:
+ *
+ *   byte 0  magic   = 0xA5
+ *   byte 1  action  (see GPIOBinaryAction)
+ *   byte 2  pin     GPIO offset (0-40)
+ *   byte 3  value   0/1 for Set / ConfigureOutput, ignored otherwise
+ *
+ * Responses are published as JSON on hardware/gpio/response, same as
+ * the JSON command form.
+ */
+enum class GPIOBinaryAction : uint8_t {
+    Get = 0,
+    Set = 1,
+    ConfigureInput = 2,
+    ConfigureOutput = 3,
+    Subscribe = 4,
+    Unsubscribe = 5,
+};
+
+constexpr uint8_t kGPIOBinaryMagic = 0xA5;
+
+struct GPIOBinaryCommand {
+    uint8_t magic;
+    uint8_t action;
+    uint8_t pin;
+    uint8_t value;
+} __attribute__((packed));
+
+/**
+ * The TCP port speaks the same packed command over a negotiated framed
+ * mode. A connection whose first byte is kGPIOBinaryMagic sends a
+ * two-byte preamble {magic, kGPIOFramingVersion} and then frames of
+ * 2-byte big-endian length + payload; every other connection stays on
+ * the legacy recv-per-JSON-request loop. A 4-byte framed payload
+ * starting with the magic is decoded as GPIOBinaryCommand (the same
+ * parser as the MQTT form); anything else in a frame is treated as
+ * JSON. Responses come back framed the same way, JSON-bodied like the
+ * MQTT responses. This is what lets the motion controller sustain
+ * thousands of ops per second on one socket — the per-op cost is a
+ * 6-byte read and a struct switch, not a JSON parse.
+ */
+constexpr uint8_t kGPIOFramingVersion = 0x01;
+// Upper bound on a framed request; a frame claiming more is a protocol
+// error and drops the connection
+constexpr uint16_t kGPIOMaxFrameBytes = 4096;
+
 /**
  * @brief GPIO Line Info for tracking configured pins
+ *
+ * The line request is shared: pins configured together in a bulk
+ * operation reference the same kernel request object, so the request
+ * is released only when the last pin of the group is dropped.
  */
 struct GPIOLineInfo {
-    struct gpiod_line_request* request;
+    std::shared_ptr<struct gpiod_line_request> request;
     unsigned int offset;
     bool is_output;
-    
-    GPIOLineInfo() : request(nullptr), offset(0), is_output(false) {}
+
+    GPIOLineInfo() : offset(0), is_output(false) {}
+};
+
+/**
+ * @brief Seqlock-protected mirror of pin state the server already knows
+ *
+ * Output pins only change through SetGPIOPin/SetGPIOPins and
+ * edge-subscribed inputs report every transition through the edge
+ * thread, so for both of them the kernel read in GetGPIOPin is
+ * redundant — the server holds the truth. The mirror keeps it in two
+ * bitmask words behind a sequence counter: writers (already serialized
+ * by gpioMutex/edgeMutex) bump the counter around the store, readers
+ * retry the rare torn snapshot. The dashboard's 10Hz full-pin poll is
+ * then served with zero syscalls and never contends with control
+ * writes. Plain inputs without an edge subscription are never marked
+ * known and keep taking the kernel path.
+ */
+struct GPIOShadowState {
+    static constexpr int kMaxPins = 64;
+
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint64_t> knownBits{0};
+    std::atomic<uint64_t> valueBits{0};
+
+    // Writers run under the GPIO/edge mutexes; the seqlock only orders
+    // them against the lock-free readers
+    void update(int pin, bool value) {
+        if (pin < 0 || pin >= kMaxPins) return;
+        const uint64_t bit = 1ULL << pin;
+        seq.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        knownBits.store(knownBits.load(std::memory_order_relaxed) | bit,
+                        std::memory_order_relaxed);
+        const uint64_t vals = valueBits.load(std::memory_order_relaxed);
+        valueBits.store(value ? (vals | bit) : (vals & ~bit),
+                        std::memory_order_relaxed);
+        seq.fetch_add(1, std::memory_order_release);
+    }
+
+    // Reconfiguration or unsubscription makes the mirrored level stale
+    void remove(int pin) {
+        if (pin < 0 || pin >= kMaxPins) return;
+        const uint64_t bit = 1ULL << pin;
+        seq.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        knownBits.store(knownBits.load(std::memory_order_relaxed) & ~bit,
+                        std::memory_order_relaxed);
+        seq.fetch_add(1, std::memory_order_release);
+    }
+
+    /** @return true and the mirrored level when the pin is known */
+    bool read(int pin, bool& value) const {
+        if (pin < 0 || pin >= kMaxPins) return false;
+        const uint64_t bit = 1ULL << pin;
+        for (;;) {
+            const uint32_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) continue; // writer mid-flight
+            const uint64_t known = knownBits.load(std::memory_order_relaxed);
+            const uint64_t vals = valueBits.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) != before) continue;
+            if (!(known & bit)) return false;
+            value = (vals & bit) != 0;
+            return true;
+        }
+    }
 };
 
 /**
@@ -36,9 +159,12 @@ struct GPIOLineInfo {
  */
 class HardwareControlServer {
 public:
+    // metrics_port serves Prometheus text format on GET /metrics;
+    // 0 disables the listener
     explicit HardwareControlServer(int port = 8081,
                                    const std::string& mqtt_host = "localhost",
-                                   int mqtt_port = 1883);
+                                   int mqtt_port = 1883,
+                                   int metrics_port = 9091);
     ~HardwareControlServer();
 
     bool Start();
@@ -51,11 +177,18 @@ private:
     std::atomic<bool> running;
     std::thread acceptThread;
 
-    // MQTT configuration
+    // Prometheus scrape endpoint; counters live in HardwareMetrics so
+    // scraping never touches the GPIO path
+    int metrics_port;
+    int metricsSocket;
+    std::thread metricsThread;
+
+    // MQTT: thin client of the shared per-broker session, so this
+    // server, MQTTBridge and MQTTReader share one broker connection
     std::string mqtt_host;
     int mqtt_port;
-    struct mosquitto* mqtt_client;
-    std::thread mqttThread;
+    std::shared_ptr<MQTTSession> mqtt_session_;
+    std::vector<uint64_t> mqtt_tokens_;
     std::mutex mqttMutex;
 
     // GPIO management using C API
@@ -63,6 +196,17 @@ private:
     std::unordered_map<int, GPIOLineInfo> activeLines;
     std::mutex gpioMutex;
 
+    // Lock-free telemetry mirror; reads for pins we drive (or watch via
+    // edges) never reach the kernel or gpioMutex
+    GPIOShadowState gpioShadow;
+
+    // Edge subscriptions: one edge-detecting line request per pin, drained
+    // by a single poll() thread that pushes events straight to MQTT
+    std::unordered_map<int, struct gpiod_line_request*> edgeLines;
+    std::mutex edgeMutex;
+    std::thread edgeThread;
+    std::atomic<bool> edgeThreadRunning;
+
     // Server methods
     bool InitializeGPIO();
     void CleanupGPIO();
@@ -70,19 +214,31 @@ private:
     bool InitializeMQTT();
     void AcceptConnections();
     void HandleClient(int clientSocket);
-    void MQTTLoop();
+    void HandleBinaryClient(int clientSocket);
+    bool SetupMetricsSocket();
+    void MetricsLoop();
 
-    // MQTT callbacks
-    static void on_mqtt_connect(struct mosquitto* mosq, void* obj, int rc);
-    static void on_mqtt_message(struct mosquitto* mosq, void* obj,
-                               const struct mosquitto_message* msg);
     void HandleMQTTMessage(const std::string& topic, const std::string& payload);
 
     // Hardware control methods
     std::string HandleGPIOControl(const std::string& jsonRequest);
+    std::string HandleBinaryGPIOCommand(const GPIOBinaryCommand& cmd);
     bool SetGPIOPin(int pin, bool value);
     bool GetGPIOPin(int pin, bool& value);
     bool ConfigureGPIOPin(int pin, const std::string& direction);
+
+    // Bulk variants: all offsets go through a single gpiod request so an
+    // 8-pin relay bank costs one syscall round trip instead of eight
+    bool ConfigureGPIOPins(const std::vector<int>& pins, const std::string& direction);
+    bool SetGPIOPins(const std::vector<int>& pins, const std::vector<bool>& values);
+    bool GetGPIOPins(const std::vector<int>& pins, std::vector<bool>& values);
+
+    // Edge subscription methods. Subscribed pins get kernel edge events
+    // published to hardware/gpio/events instead of being polled.
+    bool SubscribeGPIOEdges(int pin);
+    bool UnsubscribeGPIOEdges(int pin);
+    void EdgeEventLoop();
+    void PublishEdgeEvent(int pin, bool rising, uint64_t timestamp_ns);
 };
 
 } // namespace WebGrab
\ No newline at end of file
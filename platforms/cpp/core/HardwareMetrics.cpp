@@ -0,0 +1,118 @@
+#include "HardwareMetrics.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace WebGrab {
+
+namespace {
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char* ActionLabel(HardwareMetrics::Action action) {
+    switch (action) {
+    case HardwareMetrics::GpioSet: return "set";
+    case HardwareMetrics::GpioGet: return "get";
+    default: return "configure";
+    }
+}
+
+} // namespace
+
+HardwareMetrics& HardwareMetrics::instance() {
+    static HardwareMetrics metrics;
+    return metrics;
+}
+
+HardwareMetrics::Shard& HardwareMetrics::localShard() {
+    thread_local std::shared_ptr<Shard> shard = [this] {
+        auto s = std::make_shared<Shard>();
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        shards_.push_back(s);
+        return s;
+    }();
+    return *shard;
+}
+
+void HardwareMetrics::recordGpioOp(Action action, uint64_t durationNs) {
+    Shard& shard = localShard();
+    shard.opCount[action].fetch_add(1, std::memory_order_relaxed);
+    shard.opDurationNs[action].fetch_add(durationNs, std::memory_order_relaxed);
+
+    size_t bucket = 0;
+    while (bucket < kBucketCount - 1 && durationNs > kBucketBoundsNs[bucket]) {
+        bucket++;
+    }
+    shard.latency[action][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string HardwareMetrics::renderPrometheus() {
+    // Sum the shards into one flat view; relaxed loads are fine, a
+    // scrape is a sample, not a transaction
+    uint64_t count[kActionCount] = {};
+    uint64_t durationNs[kActionCount] = {};
+    uint64_t latency[kActionCount][kBucketCount] = {};
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (const auto& shard : shards_) {
+            for (size_t a = 0; a < kActionCount; a++) {
+                count[a] += shard->opCount[a].load(std::memory_order_relaxed);
+                durationNs[a] += shard->opDurationNs[a].load(std::memory_order_relaxed);
+                for (size_t b = 0; b < kBucketCount; b++) {
+                    latency[a][b] += shard->latency[a][b].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    std::ostringstream out;
+    out << "# HELP hardware_gpio_ops_total GPIO operations by action\n"
+        << "# TYPE hardware_gpio_ops_total counter\n";
+    for (size_t a = 0; a < kActionCount; a++) {
+        out << "hardware_gpio_ops_total{action=\""
+            << ActionLabel(static_cast<Action>(a)) << "\"} " << count[a] << "\n";
+    }
+
+    out << "# HELP hardware_gpio_op_duration_seconds GPIO operation latency\n"
+        << "# TYPE hardware_gpio_op_duration_seconds histogram\n";
+    for (size_t a = 0; a < kActionCount; a++) {
+        const char* label = ActionLabel(static_cast<Action>(a));
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < kBucketCount - 1; b++) {
+            cumulative += latency[a][b];
+            out << "hardware_gpio_op_duration_seconds_bucket{action=\"" << label
+                << "\",le=\"" << static_cast<double>(kBucketBoundsNs[b]) / 1e9
+                << "\"} " << cumulative << "\n";
+        }
+        out << "hardware_gpio_op_duration_seconds_bucket{action=\"" << label
+            << "\",le=\"+Inf\"} " << count[a] << "\n";
+        out << "hardware_gpio_op_duration_seconds_sum{action=\"" << label
+            << "\"} " << static_cast<double>(durationNs[a]) / 1e9 << "\n";
+        out << "hardware_gpio_op_duration_seconds_count{action=\"" << label
+            << "\"} " << count[a] << "\n";
+    }
+
+    out << "# HELP hardware_mqtt_inflight MQTT messages currently being handled\n"
+        << "# TYPE hardware_mqtt_inflight gauge\n"
+        << "hardware_mqtt_inflight " << mqttInFlight_.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP hardware_tcp_clients Active TCP client connections\n"
+        << "# TYPE hardware_tcp_clients gauge\n"
+        << "hardware_tcp_clients " << activeClients_.load(std::memory_order_relaxed) << "\n";
+
+    return out.str();
+}
+
+GpioOpTimer::GpioOpTimer(HardwareMetrics::Action action)
+    : action_(action), startNs_(NowNs()) {
+}
+
+GpioOpTimer::~GpioOpTimer() {
+    HardwareMetrics::instance().recordGpioOp(action_, NowNs() - startNs_);
+}
+
+} // namespace WebGrab
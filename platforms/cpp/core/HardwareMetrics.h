@@ -0,0 +1,96 @@
+#pragma once
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WebGrab {
+
+/**
+ * @brief Wait-free metrics for the hardware control server
+ *
+ * GPIO operations record into a per-thread shard: plain relaxed atomic
+ * adds that only the owning thread writes, so the hot GPIO path never
+ * contends with a scrape or with another connection thread. A scrape
+ * walks the shard registry and sums — the cost lands entirely on the
+ * scraper.
+ *
+ * Gauges (MQTT in-flight depth, active TCP clients) are incremented and
+ * decremented from different threads, so they use single shared atomics;
+ * those events are rare enough that contention is a non-issue.
+ *
+ * renderPrometheus() emits the text exposition format served by the
+ * /metrics listener in HardwareControlServer.
+ */
+class HardwareMetrics {
+public:
+    enum Action : uint8_t {
+        GpioSet = 0,
+        GpioGet,
+        GpioConfigure,
+        kActionCount,
+    };
+
+    static HardwareMetrics& instance();
+
+    // Hot path: one shard lookup and three relaxed adds
+    void recordGpioOp(Action action, uint64_t durationNs);
+
+    void mqttMessageBegin() { mqttInFlight_.fetch_add(1, std::memory_order_relaxed); }
+    void mqttMessageEnd() { mqttInFlight_.fetch_sub(1, std::memory_order_relaxed); }
+    void clientConnected() { activeClients_.fetch_add(1, std::memory_order_relaxed); }
+    void clientDisconnected() { activeClients_.fetch_sub(1, std::memory_order_relaxed); }
+
+    std::string renderPrometheus();
+
+private:
+    HardwareMetrics() = default;
+
+    // Cumulative histogram bounds; +Inf bucket is implicit
+    static constexpr uint64_t kBucketBoundsNs[] = {
+        100'000,        // 100 us
+        1'000'000,      // 1 ms
+        10'000'000,     // 10 ms
+        100'000'000,    // 100 ms
+        1'000'000'000,  // 1 s
+    };
+    static constexpr size_t kBucketCount =
+        sizeof(kBucketBoundsNs) / sizeof(kBucketBoundsNs[0]) + 1;
+
+    // Cache-line aligned so one thread's adds never invalidate another
+    // shard's line
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> opCount[kActionCount]{};
+        std::atomic<uint64_t> opDurationNs[kActionCount]{};
+        std::atomic<uint64_t> latency[kActionCount][kBucketCount]{};
+    };
+
+    Shard& localShard();
+
+    std::mutex registryMutex_;
+    // shared_ptr keeps a shard summable after its thread exited
+    std::vector<std::shared_ptr<Shard>> shards_;
+
+    std::atomic<int64_t> mqttInFlight_{0};
+    std::atomic<int64_t> activeClients_{0};
+};
+
+// RAII latency sample for one GPIO operation
+class GpioOpTimer {
+public:
+    explicit GpioOpTimer(HardwareMetrics::Action action);
+    ~GpioOpTimer();
+
+    GpioOpTimer(const GpioOpTimer&) = delete;
+    GpioOpTimer& operator=(const GpioOpTimer&) = delete;
+
+private:
+    HardwareMetrics::Action action_;
+    uint64_t startNs_;
+};
+
+} // namespace WebGrab
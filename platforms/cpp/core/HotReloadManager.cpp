@@ -1,36 +1,50 @@
 #include "HotReloadManager.h"
 #include <iostream>
+#include <sys/inotify.h>
 
 HotReloadManager::HotReloadManager(const std::string& dllPath, ReloadCallback callback)
-    : dllPath_(dllPath), dllHandle_(nullptr), callback_(callback) {
+    : dllPath_(dllPath), dllHandle_(nullptr), callback_(callback),
+      inotifyFd_(-1), watchDescriptor_(-1) {
     lastStat_ = {};
 }
 
 HotReloadManager::~HotReloadManager() {
+    stopWatching();
     unloadDll();
 }
 
 bool HotReloadManager::loadDll() {
-    dllHandle_ = dlopen(dllPath_.c_str(), RTLD_LAZY);
-    if (!dllHandle_) {
+    void* handle = dlopen(dllPath_.c_str(), RTLD_LAZY);
+    if (!handle) {
         std::cerr << "Failed to load shared library: " << dllPath_ << " - " << dlerror() << "\n";
         return false;
     }
+
+    // Publish the new generation before the old one is released; jobs
+    // that already acquired the previous ref keep running against it
+    // and the deleter dlcloses it once their refs drain.
+    DllRef generation(handle, [](void* h) {
+        if (h) dlclose(h);
+    });
+    activeDll_.store(std::move(generation), std::memory_order_release);
+    dllHandle_ = handle;
+    generation_.fetch_add(1, std::memory_order_release);
+
     getFileStat(dllPath_, lastStat_);
     return true;
 }
 
 void HotReloadManager::unloadDll() {
-    if (dllHandle_) {
-        dlclose(dllHandle_);
-        dllHandle_ = nullptr;
-    }
+    // Drop our reference; the mapping goes away when in-flight refs do.
+    activeDll_.store(nullptr, std::memory_order_release);
+    dllHandle_ = nullptr;
 }
 
 bool HotReloadManager::reloadIfChanged() {
     if (hasFileChanged()) {
         std::cout << "Shared library changed, reloading...\n";
-        unloadDll();
+        // Load-then-swap: the old generation stays mapped for jobs
+        // still holding a ref, so there is no window with no library.
         if (loadDll()) {
             callback_();  // Notify about reload
             return true;
@@ -42,6 +56,77 @@ bool HotReloadManager::reloadIfChanged() {
     return false;
 }
 
+bool HotReloadManager::startWatching() {
+    if (inotifyFd_ >= 0) return true;
+
+    // Watch the directory, not the file: the inode changes when the
+    // build installs a new library over the old path.
+    std::string dir = ".";
+    watchName_ = dllPath_;
+    size_t slash = dllPath_.rfind('/');
+    if (slash != std::string::npos) {
+        dir = dllPath_.substr(0, slash);
+        watchName_ = dllPath_.substr(slash + 1);
+    }
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        std::cerr << "inotify_init1 failed, falling back to polling\n";
+        return false;
+    }
+
+    watchDescriptor_ = inotify_add_watch(inotifyFd_, dir.c_str(),
+                                         IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchDescriptor_ < 0) {
+        std::cerr << "inotify_add_watch failed for " << dir
+                  << ", falling back to polling\n";
+        close(inotifyFd_);
+        inotifyFd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+void HotReloadManager::stopWatching() {
+    if (inotifyFd_ >= 0) {
+        if (watchDescriptor_ >= 0) {
+            inotify_rm_watch(inotifyFd_, watchDescriptor_);
+            watchDescriptor_ = -1;
+        }
+        close(inotifyFd_);
+        inotifyFd_ = -1;
+    }
+}
+
+bool HotReloadManager::processWatchEvents() {
+    if (inotifyFd_ < 0) return false;
+
+    // Drain everything queued, then reload at most once: an install
+    // may emit several events for the same file.
+    bool libraryTouched = false;
+    char buf[4096] __attribute__((aligned(alignof(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(inotifyFd_, buf, sizeof(buf))) > 0) {
+        for (char* p = buf; p < buf + len;) {
+            auto* event = reinterpret_cast<struct inotify_event*>(p);
+            if (event->len > 0 && watchName_ == event->name) {
+                libraryTouched = true;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    if (!libraryTouched) return false;
+
+    std::cout << "Shared library changed, reloading...\n";
+    if (loadDll()) {
+        callback_();
+        return true;
+    }
+    std::cerr << "Failed to reload shared library\n";
+    return false;
+}
+
 bool HotReloadManager::getFileStat(const std::string& path, struct stat& st) {
     return stat(path.c_str(), &st) == 0;
 }
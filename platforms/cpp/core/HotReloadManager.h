@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include <functional>
 #include <memory>
@@ -10,6 +11,11 @@ class HotReloadManager {
 public:
     using ReloadCallback = std::function<void()>;
 
+    // A reference to one loaded generation of the library. The mapping
+    // stays valid for as long as the ref is held; dlclose runs when the
+    // last ref to that generation drops.
+    using DllRef = std::shared_ptr<void>;
+
     HotReloadManager(const std::string& dllPath, ReloadCallback callback);
     ~HotReloadManager();
 
@@ -18,12 +24,49 @@ public:
     bool reloadIfChanged();
     void* getDllHandle() const { return dllHandle_; }
 
+    // Pin the current generation for the duration of a job. Jobs
+    // resolve their symbols against ref.get(); a reload swapping in a
+    // new generation underneath them leaves their mapping alive until
+    // they release the ref, so reloads never pause the workers.
+    DllRef acquire() const {
+        return activeDll_.load(std::memory_order_acquire);
+    }
+
+    // Monotonic count of successful loads; lets callers detect that
+    // cached symbols belong to a stale generation.
+    uint64_t generation() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    // Event-driven change detection: watches the library's directory
+    // with inotify (IN_CLOSE_WRITE/IN_MOVED_TO, so a rename-into-place
+    // install triggers exactly once). The main loop selects/polls on
+    // watchFd() instead of stat()ing the path every tick.
+    bool startWatching();
+    void stopWatching();
+    int watchFd() const { return inotifyFd_; }
+
+    // Drains pending inotify events and reloads when one names the
+    // watched library; call when watchFd() becomes readable. Returns
+    // true when a reload happened.
+    bool processWatchEvents();
+
 private:
     std::string dllPath_;
     void* dllHandle_;
     struct stat lastStat_;
     ReloadCallback callback_;
 
+    // Active generation, swapped atomically on reload. Old generations
+    // are dlclosed by the shared_ptr deleter once their refs drain.
+    std::atomic<std::shared_ptr<void>> activeDll_;
+    std::atomic<uint64_t> generation_{0};
+
+    // inotify watch on the containing directory; -1 when not watching
+    int inotifyFd_;
+    int watchDescriptor_;
+    std::string watchName_;  // basename of dllPath_ to match in events
+
     bool getFileStat(const std::string& path, struct stat& st);
     bool hasFileChanged();
-};
\ No newline at end of file
+};
@@ -1,7 +1,21 @@
 #pragma once
 
+#include <cstdint>
+
+// Scheduling class for a job: interactive jobs (a command someone is
+// waiting on) must not queue behind bulk work such as downloads.
+// JobWorker routes on this when its SchedulingPolicy reserves a core
+// for interactive work.
+enum class JobClass : uint8_t {
+    Bulk = 0,
+    Interactive = 1,
+};
+
 class IJob {
 public:
     virtual ~IJob() = default;
     virtual void execute() = 0;
-};
\ No newline at end of file
+
+    // Bulk unless a job declares otherwise
+    virtual JobClass jobClass() const { return JobClass::Bulk; }
+};
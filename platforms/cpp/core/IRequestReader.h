@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <chrono>
 #include <cstdint>
 
 enum class RequestType {
@@ -7,11 +9,25 @@ enum class RequestType {
     Status,
     Abort,
     Shutdown,
+    // Server-side latency statistics query (StatsRequest in webgrab.fbs)
+    Stats,
     Unknown
 };
 
 struct RequestEnvelope {
     RequestType type;
+    uint32_t sessionId = 0;
+    // Zero-copy view into the reader-owned message buffer; valid only
+    // until the next call to next() on the same reader
+    std::string_view url;
+    // Download priority class: 0 = bulk, 1 = interactive (see
+    // DownloadRequest.priority in webgrab.fbs)
+    uint8_t priority = 0;
+    // Enqueue deadline, stamped when the request comes off the wire. A
+    // request still waiting for admission past it is shed with an
+    // "overloaded" error rather than joining a queue it cannot clear in
+    // time. Default (epoch) means no deadline.
+    std::chrono::steady_clock::time_point deadline{};
     // Additional data can be added
 };
 
@@ -10,18 +10,35 @@ struct DownloadResponse {
 struct StatusResponse {
     uint32_t sessionId;
     std::string status;
+    // Hex SHA-256 streamed during the download; empty while in
+    // progress or when checksumming is disabled
+    std::string checksum;
+    // Server-truth latency breakdown from the JobInfo stamps: time the
+    // job spent queued before dispatch and executing after it. 0 when
+    // the phase has not happened yet.
+    uint32_t queuedMs = 0;
+    uint32_t execMs = 0;
 };
 
 struct ErrorResponse {
     std::string error;
 };
 
+// Rendered per-class latency histograms (StatsRequest); stats is the
+// JSON produced by MessageQueueProcessor::renderStats()
+struct StatsResponse {
+    std::string stats;
+};
+
 class IResponseWriter {
 public:
     virtual ~IResponseWriter() = default;
     virtual bool write(const DownloadResponse& resp) = 0;
     virtual bool write(const StatusResponse& resp) = 0;
     virtual bool write(const ErrorResponse& resp) = 0;
+    // Optional: transports that cannot carry a stats payload leave the
+    // default, which reports the response as unwritable
+    virtual bool write(const StatsResponse&) { return false; }
     virtual bool flush() = 0;
     virtual void close() = 0;
 };
\ No newline at end of file
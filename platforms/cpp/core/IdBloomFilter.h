@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace WebGrab {
+
+/**
+ * @brief Bloom filter over known context ids
+ *
+ * Answers "this id definitely does not exist" without touching the
+ * persistence layer, so probes for bad or expired ids from stale
+ * clients stop costing disk reads. mayContain() returning false is
+ * authoritative; true means "ask persistence". Deletions leave stale
+ * positive bits — harmless, the lookup just falls through — and are
+ * scrubbed when the cleanup sweep reassigns the filter from a fresh
+ * enumeration.
+ *
+ * Lookups take the lock shared; add/assign take it exclusive. The
+ * filter only short-circuits once assign() has seeded it from a full
+ * enumeration — before that (or when the backend cannot enumerate)
+ * ready() stays false and callers must not trust a negative.
+ */
+class IdBloomFilter {
+public:
+    void add(const std::string& id) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        setBits(id);
+    }
+
+    bool mayContain(const std::string& id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        uint64_t h1 = 0;
+        uint64_t h2 = 0;
+        hashPair(id, h1, h2);
+        for (int i = 0; i < kProbes; ++i) {
+            size_t bit = static_cast<size_t>(h1 + static_cast<uint64_t>(i) * h2) % kBitCount;
+            if ((words_[bit / 64] & (1ULL << (bit % 64))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Rebuild from a full enumeration: atomically replaces the bit set
+    // and marks the filter ready
+    void assign(const std::vector<std::string>& ids) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        words_.fill(0);
+        for (const auto& id : ids) {
+            setBits(id);
+        }
+        ready_ = true;
+    }
+
+    bool ready() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return ready_;
+    }
+
+private:
+    // 64 Kbit (8 KB): under 1% false positives up to ~5000 live ids,
+    // far beyond the session and user counts a single box sees
+    static constexpr size_t kBitCount = 1u << 16;
+    static constexpr int kProbes = 4;
+
+    static void hashPair(const std::string& id, uint64_t& h1, uint64_t& h2) {
+        h1 = std::hash<std::string>{}(id);
+        // FNV-1a as the second, independent hash for double hashing
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : id) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        h2 = h | 1;  // odd, so the probe stride never collapses
+    }
+
+    void setBits(const std::string& id) {
+        uint64_t h1 = 0;
+        uint64_t h2 = 0;
+        hashPair(id, h1, h2);
+        for (int i = 0; i < kProbes; ++i) {
+            size_t bit = static_cast<size_t>(h1 + static_cast<uint64_t>(i) * h2) % kBitCount;
+            words_[bit / 64] |= 1ULL << (bit % 64);
+        }
+    }
+
+    std::array<uint64_t, kBitCount / 64> words_{};
+    bool ready_ = false;
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace WebGrab
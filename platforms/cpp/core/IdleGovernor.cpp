@@ -0,0 +1,107 @@
+#include "IdleGovernor.h"
+
+#include "Utils/TimerWheel.hpp"
+
+namespace {
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+IdleGovernor& IdleGovernor::instance() {
+    static IdleGovernor governor;
+    return governor;
+}
+
+void IdleGovernor::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (evalTimer_ != 0) {
+        return;
+    }
+    lastActivityNs_.store(nowNs(), std::memory_order_relaxed);
+    evalTimer_ = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+        std::chrono::duration_cast<std::chrono::milliseconds>(kEvalInterval),
+        [this] { evaluate(); });
+}
+
+void IdleGovernor::stop() {
+    uint64_t timer = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer = evalTimer_;
+        evalTimer_ = 0;
+    }
+    if (timer != 0) {
+        TinyMCP::Utils::TimerWheel::instance().cancel(timer);
+    }
+    if (idle_.load(std::memory_order_relaxed)) {
+        transition(false);
+    }
+}
+
+void IdleGovernor::setQuietPeriod(std::chrono::seconds quiet) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quietPeriod_ = quiet;
+}
+
+IdleGovernor::ListenerId IdleGovernor::addListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const ListenerId id = nextListenerId_++;
+    listeners_.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void IdleGovernor::removeListener(ListenerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = listeners_.begin(); it != listeners_.end(); ++it) {
+        if (it->first == id) {
+            listeners_.erase(it);
+            return;
+        }
+    }
+}
+
+void IdleGovernor::noteActivity() {
+    lastActivityNs_.store(nowNs(), std::memory_order_relaxed);
+    if (idle_.load(std::memory_order_relaxed)) {
+        transition(false);
+    }
+}
+
+void IdleGovernor::evaluate() {
+    // Runs on the TimerWheel thread every kEvalInterval
+    if (idle_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::chrono::seconds quiet;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quiet = quietPeriod_;
+    }
+    const int64_t last = lastActivityNs_.load(std::memory_order_relaxed);
+    if (nowNs() - last >=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(quiet).count()) {
+        transition(true);
+    }
+}
+
+void IdleGovernor::transition(bool idle) {
+    // Copy the listeners out so a listener can (de)register without
+    // deadlocking, and so transitions serialize on the exchange below
+    // rather than the listener runtime
+    if (idle_.exchange(idle, std::memory_order_relaxed) == idle) {
+        return;
+    }
+    std::vector<std::pair<ListenerId, Listener>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        listeners = listeners_;
+    }
+    for (const auto& [id, listener] : listeners) {
+        listener(idle);
+    }
+}
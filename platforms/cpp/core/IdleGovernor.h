@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Coordinated idle mode for the vehicle deployment
+ *
+ * A parked vehicle still ran the full duty cycle — health sweeps,
+ * snapshots, the MQTT drain — draining the battery pack for nobody.
+ * The governor watches for a quiet period with no commands and flips
+ * the process into idle: registered listeners stretch their periodic
+ * work to long intervals. The first sign of life (TCP request, MQTT
+ * message) flips it straight back — noteActivity() runs the listeners
+ * inline on the event thread, so full cadence is restored before the
+ * waking request finishes, well under the 10 ms budget.
+ *
+ * noteActivity() is called on every command hot path, so the non-idle
+ * case is just a relaxed timestamp store and a relaxed flag load. The
+ * idle evaluation itself rides the shared TimerWheel. Worker threads
+ * need no coordination here: an empty JobWorker already parks every
+ * worker on its condition variable, which costs nothing until the
+ * wakeup futex fires.
+ */
+class IdleGovernor {
+public:
+    using ListenerId = size_t;
+    // Invoked with true on entering idle (TimerWheel thread) and false
+    // on leaving it (the event thread that saw the activity)
+    using Listener = std::function<void(bool idle)>;
+
+    // Quiet time with no activity before idle mode engages
+    static constexpr std::chrono::minutes kDefaultQuietPeriod{10};
+
+    static IdleGovernor& instance();
+
+    // Arms the periodic idle evaluation; idempotent
+    void start();
+    // Disarms it and leaves idle mode if engaged
+    void stop();
+
+    void setQuietPeriod(std::chrono::seconds quiet);
+
+    ListenerId addListener(Listener listener);
+    void removeListener(ListenerId id);
+
+    // Hot path: stamps the activity clock and, when idle, restores full
+    // cadence inline before returning
+    void noteActivity();
+
+    bool idle() const { return idle_.load(std::memory_order_relaxed); }
+
+private:
+    IdleGovernor() = default;
+
+    // How often the quiet-period check runs; also bounds how late idle
+    // mode can engage
+    static constexpr std::chrono::seconds kEvalInterval{15};
+
+    void evaluate();
+    void transition(bool idle);
+
+    std::atomic<int64_t> lastActivityNs_{0};
+    std::atomic<bool> idle_{false};
+
+    std::mutex mutex_;
+    std::vector<std::pair<ListenerId, Listener>> listeners_;
+    ListenerId nextListenerId_ = 1;
+    std::chrono::seconds quietPeriod_{kDefaultQuietPeriod};
+    uint64_t evalTimer_ = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include "CancellationToken.h"
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+enum class JobStatus { Queued, Downloading, Completed, Failed, Aborted };
+
+struct JobInfo {
+    uint32_t sessionId;
+    std::string url;
+    JobStatus status;
+    std::string filePath;
+    // Created at registration; abortJob cancels through it whether the
+    // job is still queued or already transferring
+    std::shared_ptr<CancellationToken> cancelToken;
+    // Priority class (0 = bulk, 1 = interactive); admission accounting
+    // releases the right per-class slot when the job leaves Queued
+    uint8_t priority = 0;
+    // Lifecycle stamps for the server-truth latency breakdown surfaced
+    // in DownloadStatusResponse (queuedMs/execMs) and the StatsRequest
+    // histograms. Default (epoch) means the phase has not happened.
+    std::chrono::steady_clock::time_point enqueuedAt{};
+    std::chrono::steady_clock::time_point startedAt{};
+    std::chrono::steady_clock::time_point completedAt{};
+};
+
+/**
+ * Sharded session-id -> JobInfo table with a periodically published
+ * read-only snapshot.
+ *
+ * The jobs map used to be one unordered_map under one mutex, shared by
+ * enqueue, worker status updates and dashboard StatusTask polling, so a
+ * poll burst contended directly with the download completion path. The
+ * table is now split into 16 shards keyed by the low session-id bits,
+ * each behind a spinlock (the critical sections are a few map
+ * operations, never blocking), and status queries read a snapshot
+ * republished at most every 250ms — polling therefore touches the
+ * shard locks only when the snapshot has gone stale, and at most one
+ * poller pays the rebuild.
+ */
+class JobTable {
+public:
+    static constexpr size_t kShards = 16;
+    static constexpr std::chrono::milliseconds kSnapshotInterval{250};
+
+    using Map = std::unordered_map<uint32_t, JobInfo>;
+
+    void insert(JobInfo info) {
+        Shard& shard = shardFor(info.sessionId);
+        SpinGuard guard(shard.lock);
+        shard.jobs[info.sessionId] = std::move(info);
+    }
+
+    // Locked mutation; mutate receives JobInfo&. Returns false when the
+    // session is unknown.
+    template <typename F>
+    bool withJob(uint32_t sessionId, F&& mutate) {
+        Shard& shard = shardFor(sessionId);
+        SpinGuard guard(shard.lock);
+        auto it = shard.jobs.find(sessionId);
+        if (it == shard.jobs.end()) {
+            return false;
+        }
+        mutate(it->second);
+        return true;
+    }
+
+    // Read-only view for status queries; at most kSnapshotInterval old.
+    // The returned map is immutable and shared, so callers hold no lock
+    // while inspecting it.
+    std::shared_ptr<const Map> snapshot() {
+        const auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            if (snapshot_ && now - snapshotTime_ < kSnapshotInterval) {
+                return snapshot_;
+            }
+        }
+
+        auto fresh = std::make_shared<Map>();
+        for (Shard& shard : shards_) {
+            SpinGuard guard(shard.lock);
+            fresh->insert(shard.jobs.begin(), shard.jobs.end());
+        }
+
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        // A racing poller may have republished meanwhile; last writer
+        // wins, both snapshots are equally fresh
+        snapshot_ = std::move(fresh);
+        snapshotTime_ = now;
+        return snapshot_;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        Map jobs;
+    };
+
+    struct SpinGuard {
+        explicit SpinGuard(std::atomic_flag& flag) : flag_(flag) {
+            while (flag_.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+        ~SpinGuard() { flag_.clear(std::memory_order_release); }
+        std::atomic_flag& flag_;
+    };
+
+    Shard& shardFor(uint32_t sessionId) { return shards_[sessionId % kShards]; }
+
+    std::array<Shard, kShards> shards_;
+
+    std::mutex snapshotMutex_;
+    std::shared_ptr<const Map> snapshot_;
+    std::chrono::steady_clock::time_point snapshotTime_{};
+};
@@ -1,10 +1,31 @@
 #include "JobWorker.h"
 #include "IJob.h"
+#include "NumaPlacement.h"
+#include "ThreadHeartbeat.h"
+#include <algorithm>
 #include <iostream>
 
-JobWorker::JobWorker(size_t numThreads) : stop_requested_(false) {
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+JobWorker::JobWorker(size_t numThreads)
+    : JobWorker(numThreads, SchedulingPolicy{}) {}
+
+JobWorker::JobWorker(size_t numThreads, SchedulingPolicy policy)
+    : policy_(policy), stop_requested_(false) {
+    if (numThreads == 0) numThreads = 1;
+    // A reserved interactive core only makes sense alongside bulk workers
+    if (numThreads < 2) policy_.reserveInteractiveCore = false;
+
+    worker_states_.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        worker_states_.emplace_back(std::make_unique<WorkerState>());
+    }
     for (size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back(&JobWorker::workerLoop, this);
+        workers_.emplace_back(&JobWorker::workerLoop, this, i);
     }
 }
 
@@ -12,33 +33,297 @@ JobWorker::~JobWorker() {
     stop();
 }
 
+size_t JobWorker::bulkBase() const {
+    return policy_.reserveInteractiveCore ? 1 : 0;
+}
+
+size_t JobWorker::targetFor(const IJob& job) {
+    // Interactive jobs go to the reserved worker; everything else
+    // round-robins across the bulk workers
+    if (policy_.reserveInteractiveCore && job.jobClass() == JobClass::Interactive) {
+        return 0;
+    }
+    const size_t base = bulkBase();
+    const size_t bulkCount = worker_states_.size() - base;
+    return base + next_worker_.fetch_add(1, std::memory_order_relaxed) % bulkCount;
+}
+
+void JobWorker::applyThreadPolicy(size_t index) {
+    const bool interactiveWorker = policy_.reserveInteractiveCore && index == 0;
+
+    if (policy_.pinToCores) {
+        // Stable placement: the scheduler stops migrating workers
+        // between cores, keeping their caches warm. With a reserved
+        // core, bulk workers land on cores past core 0.
+        const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cores > 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(static_cast<int>(index % static_cast<size_t>(cores)), &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+                std::cerr << "JobWorker: failed to pin worker " << index
+                          << " to a core" << std::endl;
+            }
+        }
+    }
+
+    if (policy_.bindMemoryToNode) {
+        // After pinning the thread sits on one node for good; prefer
+        // that node for its page faults so the thread-local buffer-pool
+        // slabs and arenas it first-touches below are node-local rather
+        // than wherever the thread happened to wake. No-op on
+        // single-node boxes.
+        if (!NumaPlacement::preferLocalNode()) {
+            std::cerr << "JobWorker: failed to bind worker " << index
+                      << " memory to its node" << std::endl;
+        }
+    }
+
+    if (!interactiveWorker && policy_.bulkNice != 0) {
+        // Per-thread nice (Linux: PRIO_PROCESS with a tid), so bulk
+        // downloads yield CPU to latency-sensitive work
+        const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, policy_.bulkNice) != 0) {
+            std::cerr << "JobWorker: failed to set nice for worker " << index
+                      << std::endl;
+        }
+    }
+}
+
 void JobWorker::addJob(std::unique_ptr<IJob> job) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    job_queue_.push(std::move(job));
-    cv_.notify_one();
+    const bool interactive = policy_.reserveInteractiveCore &&
+                             job->jobClass() == JobClass::Interactive;
+    size_t target = targetFor(*job);
+    {
+        std::lock_guard<std::mutex> lock(worker_states_[target]->mutex);
+        // The reserved deque is not capped: interactive jobs must never
+        // land in the overflow queue where a bulk worker would run them
+        if (interactive ||
+            worker_states_[target]->jobs.size() < kMaxLocalQueueDepth) {
+            worker_states_[target]->jobs.push_back(std::move(job));
+            job = nullptr;
+        }
+    }
+    if (job) {
+        // Local deque saturated, spill to the shared overflow queue
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        overflow_queue_.push(std::move(job));
+    }
+    // Publish the counter under the wakeup mutex: a bump landing between
+    // a parked worker's predicate check and its block would otherwise be
+    // missed for good. The notify itself is safe outside the lock.
+    if (interactive) {
+        {
+            std::lock_guard<std::mutex> lock(wakeup_mutex_);
+            pending_interactive_.fetch_add(1, std::memory_order_release);
+        }
+        interactive_cv_.notify_one();
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(wakeup_mutex_);
+            pending_jobs_.fetch_add(1, std::memory_order_release);
+        }
+        cv_.notify_one();
+    }
+}
+
+void JobWorker::addJobs(std::vector<std::unique_ptr<IJob>> jobs) {
+    if (jobs.empty()) return;
+
+    // Peel interactive jobs off to the reserved worker first: one lock
+    // and one wakeup for the lot
+    if (policy_.reserveInteractiveCore) {
+        size_t moved = 0;
+        {
+            std::lock_guard<std::mutex> lock(worker_states_[0]->mutex);
+            for (auto& job : jobs) {
+                if (job && job->jobClass() == JobClass::Interactive) {
+                    worker_states_[0]->jobs.push_back(std::move(job));
+                    ++moved;
+                }
+            }
+        }
+        if (moved > 0) {
+            {
+                std::lock_guard<std::mutex> lock(wakeup_mutex_);
+                pending_interactive_.fetch_add(moved, std::memory_order_release);
+            }
+            interactive_cv_.notify_one();
+            jobs.erase(std::remove(jobs.begin(), jobs.end(), nullptr), jobs.end());
+            if (jobs.empty()) return;
+        }
+    }
+
+    // Spread the batch over the bulk deques starting at the round-robin
+    // cursor; each target deque is locked once for its whole share.
+    const size_t base = bulkBase();
+    size_t workerCount = worker_states_.size() - base;
+    size_t start = next_worker_.fetch_add(jobs.size(), std::memory_order_relaxed);
+    size_t added = 0;
+    size_t index = 0;
+
+    for (size_t w = 0; w < workerCount && index < jobs.size(); ++w) {
+        WorkerState& target = *worker_states_[base + (start + w) % workerCount];
+        // Even share, rounded up so the last workers aren't starved
+        size_t share = (jobs.size() - index + workerCount - w - 1) / (workerCount - w);
+        std::lock_guard<std::mutex> lock(target.mutex);
+        while (share > 0 && index < jobs.size() &&
+               target.jobs.size() < kMaxLocalQueueDepth) {
+            target.jobs.push_back(std::move(jobs[index++]));
+            ++added;
+            --share;
+        }
+    }
+
+    if (index < jobs.size()) {
+        // Remainder spills to the shared overflow queue
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        while (index < jobs.size()) {
+            overflow_queue_.push(std::move(jobs[index++]));
+            ++added;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        pending_jobs_.fetch_add(added, std::memory_order_release);
+    }
+    // Wake only as many workers as there are jobs: a 3-job batch on an
+    // 8-worker pool shouldn't march every sleeper through the deques
+    // just to find them empty
+    const size_t bulkWorkers = worker_states_.size() - base;
+    if (added >= bulkWorkers) {
+        cv_.notify_all();
+    } else {
+        for (size_t i = 0; i < added; ++i) {
+            cv_.notify_one();
+        }
+    }
+}
+
+void JobWorker::spawn(JobTask task, JobClass jobClass) {
+    JobTask::Handle handle = task.release();
+    if (!handle) return;
+    handle.promise().pool = this;
+    handle.promise().jobClass = jobClass;
+    addJob(std::make_unique<CoroutineJob>(handle, jobClass));
+}
+
+void JobTask::promise_type::unhandled_exception() {
+    // Nobody awaits a spawned job, so surface the failure here rather
+    // than dropping it with the frame
+    try {
+        throw;
+    } catch (const std::exception& e) {
+        std::cerr << "CoroutineJob: unhandled exception: " << e.what()
+                  << std::endl;
+    } catch (...) {
+        std::cerr << "CoroutineJob: unhandled exception" << std::endl;
+    }
+}
+
+void AwaitOperation::await_suspend(JobTask::Handle handle) {
+    JobWorker* pool = handle.promise().pool;
+    const JobClass jobClass = handle.promise().jobClass;
+    // The resume closure may fire from any thread (I/O completion,
+    // timer); it queues the continuation instead of resuming inline so
+    // the completing thread is never hijacked for job work
+    start_([pool, handle, jobClass]() {
+        pool->addJob(std::make_unique<CoroutineJob>(handle, jobClass));
+    });
 }
 
 void JobWorker::stop() {
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        stop_requested_ = true;
+        // Same ordering rule as the counter publishes: the flag must not
+        // flip inside a worker's predicate-check window
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        stop_requested_.store(true);
     }
     cv_.notify_all();
+    interactive_cv_.notify_all();
     for (auto& w : workers_) {
         if (w.joinable()) w.join();
     }
 }
 
-void JobWorker::workerLoop() {
+std::unique_ptr<IJob> JobWorker::takeJob(size_t index) {
+    // 1. Own deque, newest first (better cache locality for bursts)
+    {
+        WorkerState& own = *worker_states_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            auto job = std::move(own.jobs.front());
+            own.jobs.pop_front();
+            return job;
+        }
+    }
+
+    // The reserved worker runs interactive jobs only; it never pulls
+    // bulk work onto its quiet core
+    const size_t base = bulkBase();
+    if (index < base) {
+        return nullptr;
+    }
+
+    // 2. Steal from the back of another bulk worker's deque (never from
+    // the reserved deque: interactive jobs stay where they were pinned)
+    const size_t bulkCount = worker_states_.size() - base;
+    for (size_t offset = 1; offset < bulkCount; ++offset) {
+        WorkerState& victim =
+            *worker_states_[base + (index - base + offset) % bulkCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            auto job = std::move(victim.jobs.back());
+            victim.jobs.pop_back();
+            return job;
+        }
+    }
+
+    // 3. Global overflow queue
+    {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        if (!overflow_queue_.empty()) {
+            auto job = std::move(overflow_queue_.front());
+            overflow_queue_.pop();
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void JobWorker::workerLoop(size_t index) {
+    applyThreadPolicy(index);
+
+    ThreadHeartbeat::Registration heartbeat(ThreadHeartbeat::instance().registerThread(
+        "job-worker-" + std::to_string(index)));
+
+    // The reserved worker sleeps on its own class counter and condition
+    // variable, so pending bulk work never spins it awake
+    const bool interactiveWorker = policy_.reserveInteractiveCore && index == 0;
+    std::atomic<size_t>& pending =
+        interactiveWorker ? pending_interactive_ : pending_jobs_;
+    std::condition_variable& wakeup = interactiveWorker ? interactive_cv_ : cv_;
+
     while (true) {
-        std::unique_ptr<IJob> job;
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            cv_.wait(lock, [this]() { return stop_requested_ || !job_queue_.empty(); });
-            if (stop_requested_ && job_queue_.empty()) break;
-            job = std::move(job_queue_.front());
-            job_queue_.pop();
+        heartbeat.counter().beat();
+        std::unique_ptr<IJob> job = takeJob(index);
+        if (!job) {
+            std::unique_lock<std::mutex> lock(wakeup_mutex_);
+            // Parked, not stalled: the liveness probe skips the wait
+            ThreadHeartbeat::WaitScope parked(heartbeat.counter());
+            wakeup.wait(lock, [this, &pending]() {
+                return stop_requested_.load() ||
+                       pending.load(std::memory_order_acquire) > 0;
+            });
+            if (stop_requested_.load() &&
+                pending.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+            continue;
         }
+        pending.fetch_sub(1, std::memory_order_release);
         job->execute();
     }
-}
\ No newline at end of file
+}
@@ -1,27 +1,87 @@
 #pragma once
+#include "CoroutineJob.h"
 #include <thread>
+#include <deque>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include <vector>
 #include <memory>
 
 class IJob;
 
+// Work-stealing job pool. Each worker owns a deque and pops from its own
+// front; idle workers steal from the back of a victim's deque, then fall
+// back to a global overflow queue. addJob() distributes round-robin so
+// dispatch no longer serializes all threads on a single queue mutex.
 class JobWorker {
 public:
-    JobWorker(size_t numThreads);
+    // Thread placement and priority. The defaults leave scheduling to
+    // the kernel; on the Pi, pinning stops the scheduler migrating
+    // workers between cores (visible as cache-miss spikes), reserving a
+    // core keeps interactive jobs (see JobClass) off the cores churning
+    // through bulk downloads, and bulkNice lets those downloads yield
+    // CPU to everything latency-sensitive.
+    struct SchedulingPolicy {
+        bool pinToCores = false;           // pin worker i to core i % ncores
+        bool reserveInteractiveCore = false; // worker 0 runs only
+                                             // JobClass::Interactive jobs
+        int bulkNice = 0;                  // nice value for bulk workers
+        bool bindMemoryToNode = false;     // on multi-node (NUMA) boxes,
+                                           // first-touch each worker's
+                                           // allocations on its own node
+    };
+
+    explicit JobWorker(size_t numThreads);
+    JobWorker(size_t numThreads, SchedulingPolicy policy);
     ~JobWorker();
 
     void addJob(std::unique_ptr<IJob> job);
+
+    // Block enqueue for bursts: distributes the whole batch across the
+    // per-worker deques with one lock acquisition per target deque, and
+    // wakes at most as many workers as jobs added instead of a wakeup
+    // per job.
+    void addJobs(std::vector<std::unique_ptr<IJob>> jobs);
+
+    // Runs a coroutine job (see CoroutineJob.h) on the pool: each
+    // segment between suspension points is queued like a normal job of
+    // the given class, so an I/O wait never occupies a worker thread.
+    void spawn(JobTask task, JobClass jobClass = JobClass::Bulk);
+
     void stop();
 
 private:
+    // Per-worker deque depth before addJob spills to the overflow queue
+    static constexpr size_t kMaxLocalQueueDepth = 256;
+
+    struct WorkerState {
+        std::mutex mutex;
+        std::deque<std::unique_ptr<IJob>> jobs;
+    };
+
+    SchedulingPolicy policy_;
     std::vector<std::thread> workers_;
-    std::queue<std::unique_ptr<IJob>> job_queue_;
-    std::mutex queue_mutex_;
+    std::vector<std::unique_ptr<WorkerState>> worker_states_;
+    std::queue<std::unique_ptr<IJob>> overflow_queue_;
+    std::mutex overflow_mutex_;
+    std::atomic<size_t> next_worker_{0};
+    std::atomic<size_t> pending_jobs_{0};
+    // Interactive jobs have their own counter and wakeup so the reserved
+    // worker never spins on bulk traffic
+    std::atomic<size_t> pending_interactive_{0};
+    std::mutex wakeup_mutex_;
     std::condition_variable cv_;
-    bool stop_requested_;
+    std::condition_variable interactive_cv_;
+    std::atomic<bool> stop_requested_;
+
+    void workerLoop(size_t index);
+    std::unique_ptr<IJob> takeJob(size_t index);
+    void applyThreadPolicy(size_t index);
 
-    void workerLoop();
-};
\ No newline at end of file
+    // First worker index eligible for bulk jobs: 1 when worker 0 is the
+    // reserved interactive worker, 0 otherwise
+    size_t bulkBase() const;
+    size_t targetFor(const IJob& job);
+};
@@ -1,10 +1,16 @@
 // Standard library includes
+#include <algorithm>
 #include <iostream>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
 #include <string>
 #include <sstream>
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <vector>
 #include <signal.h>
 
 // Third-party includes
@@ -17,6 +23,75 @@
 std::atomic_bool g_bStop{ false };
 void signal_handler(int signal) { g_bStop = true; }
 
+/**
+ * @brief JSON-scripted load profile for the simulator's load mode
+ *
+ * Example profile:
+ * {
+ *   "warmup_seconds": 5,
+ *   "duration_seconds": 30,
+ *   "threads": 4,
+ *   "rate_per_thread": 60,
+ *   "mix": [
+ *     {"method": "download", "url": "http://example.com/f", "weight": 1},
+ *     {"method": "status", "session_id": 1, "weight": 8},
+ *     {"method": "abort", "session_id": 1, "weight": 1}
+ *   ]
+ * }
+ *
+ * Weights pick the next call per iteration; rate_per_thread of 0 means
+ * unthrottled. Samples taken during warmup are discarded so connection
+ * and cache warmup does not skew the percentiles.
+ */
+struct LoadProfile {
+    struct Call {
+        std::string method;
+        std::string url;
+        uint32_t sessionId = 0;
+        int weight = 1;
+    };
+
+    double warmupSeconds = 0.0;
+    double durationSeconds = 10.0;
+    int threads = 1;
+    int ratePerThread = 0;
+    std::vector<Call> mix;
+
+    static bool load(const std::string& path, LoadProfile& out) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "Cannot open load profile: " << path << std::endl;
+            return false;
+        }
+        Json::Value root;
+        Json::CharReaderBuilder builder;
+        std::string errs;
+        if (!Json::parseFromStream(builder, in, &root, &errs)) {
+            std::cerr << "Bad load profile: " << errs << std::endl;
+            return false;
+        }
+        out.warmupSeconds = root.get("warmup_seconds", 0.0).asDouble();
+        out.durationSeconds = root.get("duration_seconds", 10.0).asDouble();
+        out.threads = root.get("threads", 1).asInt();
+        out.ratePerThread = root.get("rate_per_thread", 0).asInt();
+        for (const auto& jCall : root["mix"]) {
+            Call call;
+            call.method = jCall.get("method", "").asString();
+            call.url = jCall.get("url", "").asString();
+            call.sessionId = jCall.get("session_id", 0).asUInt();
+            call.weight = jCall.get("weight", 1).asInt();
+            if (!call.method.empty() && call.weight > 0) {
+                out.mix.push_back(call);
+            }
+        }
+        if (out.mix.empty()) {
+            std::cerr << "Load profile has no usable mix entries" << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
 /**
  * @brief Simple MCP client simulator for testing WebGrab MCP server
  *
@@ -101,6 +176,111 @@ public:
         }
     }
 
+    /**
+     * @brief Run a scripted load profile and print latency percentiles
+     *
+     * Spawns profile.threads workers, each pacing itself to
+     * rate_per_thread calls/sec and drawing calls from the weighted
+     * mix. Latency is measured around the request submission path;
+     * samples inside the warmup window are discarded. Per-method
+     * p50/p90/p99/max land on stderr so they survive stdout capture.
+     */
+    bool runLoadProfile(const LoadProfile& profile) {
+        using Clock = std::chrono::steady_clock;
+
+        echo_ = false;  // request JSON would swamp stdout at load rates
+        const auto start = Clock::now();
+        const auto warmupEnd =
+            start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(profile.warmupSeconds));
+        const auto end =
+            start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+                        profile.warmupSeconds + profile.durationSeconds));
+
+        std::vector<int> weights;
+        for (const auto& call : profile.mix) {
+            weights.push_back(call.weight);
+        }
+
+        // methodName -> measured latencies in microseconds
+        std::map<std::string, std::vector<uint64_t>> samples;
+        std::mutex samplesMutex;
+
+        auto worker = [&](int threadIndex) {
+            std::mt19937 rng(static_cast<uint32_t>(threadIndex) * 2654435761u + 1);
+            std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+            std::map<std::string, std::vector<uint64_t>> local;
+
+            const auto period = profile.ratePerThread > 0
+                ? std::chrono::nanoseconds(1000000000 / profile.ratePerThread)
+                : std::chrono::nanoseconds(0);
+            auto next = Clock::now();
+
+            while (!g_bStop) {
+                auto now = Clock::now();
+                if (now >= end) break;
+                if (period.count() > 0) {
+                    if (now < next) {
+                        std::this_thread::sleep_until(next);
+                        now = Clock::now();
+                    }
+                    next += period;
+                }
+
+                const LoadProfile::Call& call = profile.mix[pick(rng)];
+                const auto t0 = Clock::now();
+                if (call.method == "download") {
+                    sendDownloadRequest(call.url);
+                } else if (call.method == "status") {
+                    sendStatusRequest(call.sessionId);
+                } else if (call.method == "abort") {
+                    sendAbortRequest(call.sessionId);
+                } else if (call.method == "list") {
+                    sendListToolsRequest();
+                }
+                const auto t1 = Clock::now();
+
+                if (t0 >= warmupEnd) {
+                    local[call.method].push_back(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+                            .count()));
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(samplesMutex);
+            for (auto& [method, values] : local) {
+                auto& merged = samples[method];
+                merged.insert(merged.end(), values.begin(), values.end());
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int i = 0; i < profile.threads; ++i) {
+            pool.emplace_back(worker, i);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+        echo_ = true;
+
+        std::cerr << "method        calls     p50(us)   p90(us)   p99(us)   max(us)"
+                  << std::endl;
+        for (auto& [method, values] : samples) {
+            if (values.empty()) continue;
+            std::sort(values.begin(), values.end());
+            auto pct = [&](double p) {
+                return values[static_cast<size_t>(p * (values.size() - 1))];
+            };
+            std::ostringstream row;
+            row << method;
+            row << std::string(method.size() < 14 ? 14 - method.size() : 1, ' ');
+            row << values.size() << "   " << pct(0.50) << "   " << pct(0.90) << "   "
+                << pct(0.99) << "   " << values.back();
+            std::cerr << row.str() << std::endl;
+        }
+        return !samples.empty();
+    }
+
 private:
     void printHelp() {
         std::cout << "Available commands:" << std::endl;
@@ -159,10 +339,14 @@ private:
         Json::StreamWriterBuilder writer;
         std::string jsonStr = Json::writeString(writer, request);
 
-        std::cout << jsonStr << std::endl;
+        if (echo_) {
+            std::cout << jsonStr << std::endl;
+        }
 
         // In a real MCP client, we would send this via the transport
         // and wait for a response. For this simulator, we just print it.
+        // Load mode times this same path, so once the transport round
+        // trip lands the percentiles pick it up without changes.
     }
 
     std::string generateId() {
@@ -172,6 +356,7 @@ private:
 
     std::unique_ptr<MCP::CTransport> transport;
     std::unique_ptr<MCP::CSession> session;
+    std::atomic_bool echo_{ true };
 };
 
 int main(int argc, char* argv[])
@@ -186,6 +371,18 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // --load <profile.json> switches to scripted load mode; anything
+    // else keeps the interactive console
+    if (argc >= 3 && std::string(argv[1]) == "--load")
+    {
+        LoadProfile profile;
+        if (!LoadProfile::load(argv[2], profile))
+        {
+            return 1;
+        }
+        return simulator.runLoadProfile(profile) ? 0 : 1;
+    }
+
     simulator.run();
 
     return 0;
@@ -2,6 +2,7 @@
 
 // Local includes
 #include "WebGrabClientWrapper.h"
+#include "ToolSchemaValidator.h"
 
 // Third-party includes
 #include <Public/PublicDef.h>
@@ -41,7 +42,8 @@ int AbortTask::Execute() {
         goto PROC_END;
     }
     jArgument = spCallToolRequest->jArguments;
-    if (!jArgument.isMember(TOOL_ARGUMENT_SESSION_ID) || !jArgument[TOOL_ARGUMENT_SESSION_ID].isConvertibleTo(Json::uintValue)) {
+    // Structural checks live in the validator compiled at registration
+    if (!ToolSchemaValidators::instance().validate(TOOL_NAME, jArgument)) {
         goto PROC_END;
     }
     sessionId = jArgument[TOOL_ARGUMENT_SESSION_ID].asUInt();
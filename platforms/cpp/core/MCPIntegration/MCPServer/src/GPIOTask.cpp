@@ -1,4 +1,6 @@
 #include "GPIOTask.h"
+#include "GpioLineRegistry.h"
+#include "ToolSchemaValidator.h"
 
 // Third-party includes
 #include <Public/PublicDef.h>
@@ -10,13 +12,7 @@
 namespace MCPIntegration {
 
 GPIOTask::GPIOTask(const std::shared_ptr<MCP::Request>& spRequest)
-    : ProcessCallToolRequest(spRequest) {
-    try {
-        chip = std::make_unique<gpiod::chip>("gpiochip0");
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to open GPIO chip: " << e.what() << std::endl;
-    }
-}
+    : ProcessCallToolRequest(spRequest) {}
 
 std::shared_ptr<MCP::CMCPTask> GPIOTask::Clone() const {
     auto spClone = std::make_shared<GPIOTask>(nullptr);
@@ -32,7 +28,7 @@ int GPIOTask::Cancel() {
 
 int GPIOTask::Execute() {
     int iErrCode = MCP::ERRNO_INTERNAL_ERROR;
-    if (!IsValid() || !chip) {
+    if (!IsValid()) {
         return iErrCode;
     }
 
@@ -50,54 +46,45 @@ int GPIOTask::Execute() {
     }
     jArgument = spCallToolRequest->jArguments;
 
-    // Validate pin
-    if (!jArgument.isMember(TOOL_ARGUMENT_PIN) || !jArgument[TOOL_ARGUMENT_PIN].isInt()) {
+    // Presence, types and numeric ranges (pin 0-40, value 0-1) come
+    // from the validator compiled at registration; only the semantic
+    // checks the schema cannot express remain here
+    if (!ToolSchemaValidators::instance().validate(TOOL_NAME, jArgument)) {
         goto PROC_END;
     }
     pin = jArgument[TOOL_ARGUMENT_PIN].asInt();
-    if (pin < 0 || pin > 40) {
-        goto PROC_END;
-    }
 
-    // Validate direction
-    if (!jArgument.isMember(TOOL_ARGUMENT_DIRECTION) || !jArgument[TOOL_ARGUMENT_DIRECTION].isString()) {
-        goto PROC_END;
-    }
     direction = jArgument[TOOL_ARGUMENT_DIRECTION].asString();
     if (direction != "input" && direction != "output") {
         goto PROC_END;
     }
 
-    // Validate value for output
+    // Output writes need an explicit value
     if (direction == "output") {
-        if (!jArgument.isMember(TOOL_ARGUMENT_VALUE) || !jArgument[TOOL_ARGUMENT_VALUE].isInt()) {
+        if (!jArgument.isMember(TOOL_ARGUMENT_VALUE)) {
             goto PROC_END;
         }
         value = jArgument[TOOL_ARGUMENT_VALUE].asInt();
-        if (value != 0 && value != 1) {
-            goto PROC_END;
-        }
     }
 
-    // Execute GPIO operation
+    // Execute GPIO operation against the shared registry: the line is
+    // already resolved and requested after the first call on this pin,
+    // and the set/get runs under the registry lock so a concurrent
+    // clone flipping the pin's direction cannot release it mid-call
     try {
-        gpiod::line line = chip->get_line(pin);
-
-        if (direction == "output") {
-            line.request({"mcp_gpio", gpiod::line::direction::OUTPUT});
-            line.set_value(value);
+        bool isOutput = direction == "output";
+        bool lineOk = GpioLineRegistry::instance().withLine(
+            pin, isOutput, [&](gpiod::line& line) {
+                if (isOutput) {
+                    line.set_value(value);
+                } else {
+                    // Store the value for response
+                    value = line.get_value();
+                }
+            });
+        if (lineOk) {
             iErrCode = MCP::ERRNO_OK;
-        } else if (direction == "input") {
-            line.request({"mcp_gpio", gpiod::line::direction::INPUT});
-            int current_value = line.get_value();
-            iErrCode = MCP::ERRNO_OK;
-            // Store the value for response
-            value = current_value;
         }
-
-        // Keep track of active lines
-        active_lines[pin] = std::move(line);
-
     } catch (const std::exception& e) {
         std::cerr << "GPIO operation failed: " << e.what() << std::endl;
         iErrCode = MCP::ERRNO_INTERNAL_ERROR;
@@ -4,9 +4,6 @@
 #include <Task/BasicTask.h>
 #include <Message/Request.h>
 
-// Third-party includes
-#include <gpiod.hpp>
-
 // Standard library includes
 #include <string>
 #include <memory>
@@ -56,9 +53,9 @@ public:
     int Execute() override;
     int Cancel() override;
 
-private:
-    std::unique_ptr<gpiod::chip> chip;
-    std::unordered_map<int, gpiod::line> active_lines;
+    // The task itself is stateless: chip and line handles live in the
+    // shared GpioLineRegistry, so per-call clones construct for free
+    // and repeated calls against the same pin skip chip/line lookup.
 };
 
 } // namespace MCPIntegration
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "GpioLineRegistry.h"
+
+// Standard library includes
+#include <iostream>
+
+namespace MCPIntegration {
+
+GpioLineRegistry& GpioLineRegistry::instance() {
+    static GpioLineRegistry registry;
+    return registry;
+}
+
+GpioLineRegistry::GpioLineRegistry() {
+    try {
+        chip_ = std::make_unique<gpiod::chip>("gpiochip0");
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to open GPIO chip: " << e.what() << std::endl;
+    }
+}
+
+bool GpioLineRegistry::withLine(int pin, bool output,
+                                const std::function<void(gpiod::line&)>& op) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!chip_) return false;
+
+    auto it = lines_.find(pin);
+    if (it != lines_.end() && it->second.output != output) {
+        // Direction flip: drop the old request before re-requesting
+        it->second.line.release();
+        lines_.erase(it);
+        it = lines_.end();
+    }
+
+    if (it == lines_.end()) {
+        try {
+            gpiod::line line = chip_->get_line(pin);
+            line.request({"mcp_gpio", output ? gpiod::line::direction::OUTPUT
+                                             : gpiod::line::direction::INPUT});
+            it = lines_.emplace(pin, Entry{std::move(line), output}).first;
+        } catch (const std::exception& e) {
+            std::cerr << "GPIO line request failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Warm path reaches here without any chip or line lookup. The
+    // operation runs under the registry lock: released, a concurrent
+    // direction flip on the same pin could free the request out from
+    // under the caller.
+    op(it->second.line);
+    return true;
+}
+
+} // namespace MCPIntegration
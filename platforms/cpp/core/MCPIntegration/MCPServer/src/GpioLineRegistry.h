@@ -0,0 +1,51 @@
+#pragma once
+
+// Third-party includes
+#include <gpiod.hpp>
+
+// Standard library includes
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace MCPIntegration {
+
+/**
+ * @brief Shared registry of requested GPIO line handles
+ *
+ * Opening the chip and requesting a line are kernel round trips, and
+ * the LED animation tooling fires tool calls at 60/sec against the
+ * same pin — each call used to pay both. The registry opens the chip
+ * once and keeps every pin's requested line for reuse, re-requesting
+ * only when a call flips the pin's direction. It is process-wide so
+ * all task clones share the same handles.
+ */
+class GpioLineRegistry {
+public:
+    static GpioLineRegistry& instance();
+
+    // Requests the pin in the given direction (reusing the cached
+    // request when the direction already matches) and runs op on the
+    // line while the registry lock is held: task clones execute
+    // concurrently, and a handle handed out past the lock could be
+    // released by another clone's direction flip mid-operation.
+    // Returns false when the chip or line is unavailable; exceptions
+    // thrown by op propagate to the caller.
+    bool withLine(int pin, bool output,
+                  const std::function<void(gpiod::line&)>& op);
+
+private:
+    GpioLineRegistry();
+
+    struct Entry {
+        gpiod::line line;
+        bool output;
+    };
+
+    std::unique_ptr<gpiod::chip> chip_;
+    std::mutex mutex_;
+    std::unordered_map<int, Entry> lines_;
+};
+
+} // namespace MCPIntegration
@@ -2,6 +2,7 @@
 
 // Local includes
 #include "WebGrabClientWrapper.h"
+#include "ToolSchemaValidator.h"
 
 // Third-party includes
 #include <Public/PublicDef.h>
@@ -33,6 +34,9 @@ int StatusTask::Execute() {
 
     Json::Value jArgument;
     uint32_t sessionId = 0;
+    bool deltaMode = false;
+    std::string status;
+    std::string resultText;
     auto spCallToolRequest = std::dynamic_pointer_cast<MCP::CallToolRequest>(m_spRequest);
     if (!spCallToolRequest) {
         goto PROC_END;
@@ -41,18 +45,42 @@ int StatusTask::Execute() {
         goto PROC_END;
     }
     jArgument = spCallToolRequest->jArguments;
-    if (!jArgument.isMember(TOOL_ARGUMENT_SESSION_ID) || !jArgument[TOOL_ARGUMENT_SESSION_ID].isConvertibleTo(Json::uintValue)) {
+    // Structural checks live in the validator compiled at registration
+    if (!ToolSchemaValidators::instance().validate(TOOL_NAME, jArgument)) {
+        goto PROC_END;
+    }
+
+    // Delta mode: the 2Hz dashboard poll passes the last sequence it
+    // saw and gets back only the sessions that changed since — the
+    // response is O(changes), not O(jobs)
+    if (jArgument.isMember(TOOL_ARGUMENT_SINCE_SEQ)) {
+        deltaMode = true;
+        uint64_t sinceSeq = jArgument[TOOL_ARGUMENT_SINCE_SEQ].asUInt64();
+        std::vector<std::pair<uint32_t, std::string>> changes;
+        uint64_t currentSeq = clientWrapper->statusChangesSince(sinceSeq, changes);
+        resultText = "seq=" + std::to_string(currentSeq);
+        if (changes.empty()) {
+            resultText += "; no changes";
+        } else {
+            for (const auto& [id, st] : changes) {
+                resultText += "; session " + std::to_string(id) + ": " + st;
+            }
+        }
+        iErrCode = MCP::ERRNO_OK;
+        goto PROC_END;
+    }
+
+    if (!jArgument.isMember(TOOL_ARGUMENT_SESSION_ID)) {
         goto PROC_END;
     }
     sessionId = jArgument[TOOL_ARGUMENT_SESSION_ID].asUInt();
 
     // Check status
-    std::string status;
     if (clientWrapper->status(sessionId, status)) {
         iErrCode = MCP::ERRNO_OK;
+        resultText = "Status for session " + std::to_string(sessionId) + ": " + status;
     } else {
         iErrCode = MCP::ERRNO_INTERNAL_ERROR;
-        status = "Failed to get status";
     }
 
 PROC_END:
@@ -62,10 +90,12 @@ PROC_END:
         textContent.strType = MCP::CONST_TEXT;
         if (MCP::ERRNO_OK == iErrCode) {
             spExecuteResult->bIsError = false;
-            textContent.strText = "Status for session " + std::to_string(sessionId) + ": " + status;
+            textContent.strText = resultText;
         } else {
             spExecuteResult->bIsError = true;
-            textContent.strText = "Failed to check status for session " + std::to_string(sessionId);
+            textContent.strText = deltaMode
+                ? "Failed to poll status changes"
+                : "Failed to check status for session " + std::to_string(sessionId);
         }
         spExecuteResult->vecTextContent.push_back(textContent);
         iErrCode = NotifyResult(spExecuteResult);
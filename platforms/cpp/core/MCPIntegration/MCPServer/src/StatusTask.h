@@ -20,18 +20,23 @@ class WebGrabClientWrapper;
 class StatusTask : public MCP::ProcessCallToolRequest {
 public:
     static constexpr const char* TOOL_NAME = "download_status";
-    static constexpr const char* TOOL_DESCRIPTION = "Check the status of a download session.";
+    static constexpr const char* TOOL_DESCRIPTION = "Check the status of a download session, or poll for status changes with since_seq.";
     static constexpr const char* TOOL_INPUT_SCHEMA = R"({
         "type": "object",
         "properties": {
             "session_id": {
                 "type": "integer",
                 "description": "The session ID of the download to check"
+            },
+            "since_seq": {
+                "type": "integer",
+                "description": "Delta mode: return only sessions whose status changed after this sequence number (0 for all). The response carries the sequence to pass next time."
             }
         },
-        "required": ["session_id"]
+        "required": []
     })";
     static constexpr const char* TOOL_ARGUMENT_SESSION_ID = "session_id";
+    static constexpr const char* TOOL_ARGUMENT_SINCE_SEQ = "since_seq";
 
     StatusTask(const std::shared_ptr<MCP::Request>& spRequest, WebGrabClientWrapper* clientWrapper);
 
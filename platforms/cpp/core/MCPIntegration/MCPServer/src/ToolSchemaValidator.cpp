@@ -0,0 +1,95 @@
+#include "ToolSchemaValidator.h"
+
+namespace MCPIntegration {
+
+ToolSchemaValidator::ToolSchemaValidator(const Json::Value& schema) {
+    const Json::Value& properties = schema["properties"];
+    uint32_t nextBit = 0;
+    for (const auto& name : properties.getMemberNames()) {
+        Field field;
+        field.name = name;
+        field.bit = 1u << nextBit++;
+
+        const Json::Value& prop = properties[name];
+        const std::string type = prop.get("type", "").asString();
+        if (type == "integer") {
+            field.type = FieldType::Integer;
+        } else if (type == "number") {
+            field.type = FieldType::Number;
+        } else if (type == "string") {
+            field.type = FieldType::String;
+        } else if (type == "boolean") {
+            field.type = FieldType::Boolean;
+        }
+        if (prop.isMember("minimum") && prop.isMember("maximum")) {
+            field.hasRange = true;
+            field.minimum = prop["minimum"].asDouble();
+            field.maximum = prop["maximum"].asDouble();
+        }
+        fields_.push_back(std::move(field));
+    }
+
+    for (const auto& jRequired : schema["required"]) {
+        const std::string name = jRequired.asString();
+        for (const Field& field : fields_) {
+            if (field.name == name) {
+                requiredMask_ |= field.bit;
+                break;
+            }
+        }
+    }
+}
+
+bool ToolSchemaValidator::validate(const Json::Value& arguments) const {
+    uint32_t seenMask = 0;
+    for (const Field& field : fields_) {
+        if (!arguments.isMember(field.name)) {
+            continue;
+        }
+        const Json::Value& value = arguments[field.name];
+        switch (field.type) {
+            case FieldType::Integer:
+                if (!value.isConvertibleTo(Json::intValue)) return false;
+                break;
+            case FieldType::Number:
+                if (!value.isNumeric()) return false;
+                break;
+            case FieldType::String:
+                if (!value.isString()) return false;
+                break;
+            case FieldType::Boolean:
+                if (!value.isBool()) return false;
+                break;
+            case FieldType::Any:
+                break;
+        }
+        if (field.hasRange && value.isNumeric()) {
+            const double v = value.asDouble();
+            if (v < field.minimum || v > field.maximum) return false;
+        }
+        seenMask |= field.bit;
+    }
+    return (seenMask & requiredMask_) == requiredMask_;
+}
+
+ToolSchemaValidators& ToolSchemaValidators::instance() {
+    static ToolSchemaValidators registry;
+    return registry;
+}
+
+void ToolSchemaValidators::add(const std::string& toolName, const Json::Value& schema) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    validators_[toolName] = ToolSchemaValidator(schema);
+}
+
+bool ToolSchemaValidators::validate(const std::string& toolName,
+                                    const Json::Value& arguments) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = validators_.find(toolName);
+    if (it == validators_.end()) {
+        return true;
+    }
+    return it->second.validate(arguments);
+}
+
+} // namespace MCPIntegration
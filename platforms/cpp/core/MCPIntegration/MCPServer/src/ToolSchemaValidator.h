@@ -0,0 +1,73 @@
+#pragma once
+
+// Third-party includes
+#include <json/json.h>
+
+// Standard library includes
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MCPIntegration {
+
+/**
+ * @brief Precompiled validator for one tool's inputSchema
+ *
+ * Tool tasks used to re-derive the schema's structure on every call by
+ * walking the Json::Value tree with isMember/type probes. The schema is
+ * fixed at registration, so it compiles once into flat field
+ * descriptors — a type tag per property, min/max where the schema gives
+ * them, and a required-field bitmap — and each call validates the
+ * parsed arguments in one pass over those descriptors.
+ */
+class ToolSchemaValidator {
+public:
+    ToolSchemaValidator() = default;
+    explicit ToolSchemaValidator(const Json::Value& schema);
+
+    // One pass: per-field type and range comparisons plus one bitmap
+    // compare for required coverage
+    bool validate(const Json::Value& arguments) const;
+
+private:
+    enum class FieldType : uint8_t { Integer, Number, String, Boolean, Any };
+
+    struct Field {
+        std::string name;
+        FieldType type = FieldType::Any;
+        bool hasRange = false;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        uint32_t bit = 0;
+    };
+
+    std::vector<Field> fields_;
+    uint32_t requiredMask_ = 0;
+};
+
+/**
+ * @brief Registry mapping tool names to their compiled validators
+ *
+ * Populated once at registerTool time by the server, consulted by task
+ * Execute paths. Lookups after initialization are read-only.
+ */
+class ToolSchemaValidators {
+public:
+    static ToolSchemaValidators& instance();
+
+    void add(const std::string& toolName, const Json::Value& schema);
+
+    // Validates toolName's arguments; unknown tools pass, since a tool
+    // without a registered schema keeps its own checks
+    bool validate(const std::string& toolName, const Json::Value& arguments) const;
+
+private:
+    ToolSchemaValidators() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ToolSchemaValidator> validators_;
+};
+
+} // namespace MCPIntegration
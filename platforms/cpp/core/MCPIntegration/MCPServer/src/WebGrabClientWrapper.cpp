@@ -24,11 +24,13 @@ bool WebGrabClientWrapper::download(const std::string& url, uint32_t& sessionId)
         return false;
     }
 
-    // WebGrabClient::executeDownload returns a session ID
-    // We need to capture it somehow - let's assume it modifies a reference parameter
-    // This is a simplification; in reality we'd need to modify WebGrabClient to return session ID
-    sessionId = 0;  // Placeholder - need to implement proper session ID handling
-    return client->executeDownload(url);
+    if (!client->executeDownload(url, sessionId)) {
+        return false;
+    }
+    // New sessions enter the snapshot immediately so the next delta
+    // poll reports them
+    statusSnapshot_[sessionId] = StatusEntry{"started", ++statusSeq_};
+    return true;
 }
 
 bool WebGrabClientWrapper::status(uint32_t sessionId, std::string& status) {
@@ -37,9 +39,15 @@ bool WebGrabClientWrapper::status(uint32_t sessionId, std::string& status) {
         return false;
     }
 
-    // For now, we can't get status string from WebGrabClient
-    // This is a limitation of the current WebGrabClient API
-    return client->executeStatus(sessionId);
+    if (!client->executeStatus(sessionId, status)) {
+        return false;
+    }
+    auto& entry = statusSnapshot_[sessionId];
+    if (entry.status != status) {
+        entry.status = status;
+        entry.seq = ++statusSeq_;
+    }
+    return true;
 }
 
 bool WebGrabClientWrapper::abort(uint32_t sessionId) {
@@ -51,4 +59,29 @@ bool WebGrabClientWrapper::abort(uint32_t sessionId) {
     return client->executeAbort(sessionId);
 }
 
+uint64_t WebGrabClientWrapper::statusChangesSince(
+    uint64_t sinceSeq, std::vector<std::pair<uint32_t, std::string>>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!client) {
+        return statusSeq_;
+    }
+
+    // Refresh the tracked sessions, bumping the sequence only where the
+    // backend reports something new, then hand back just the entries
+    // stamped after the caller's last poll
+    for (auto& [sessionId, entry] : statusSnapshot_) {
+        std::string current;
+        if (client->executeStatus(sessionId, current) && entry.status != current) {
+            entry.status = current;
+            entry.seq = ++statusSeq_;
+        }
+    }
+    for (const auto& [sessionId, entry] : statusSnapshot_) {
+        if (entry.seq > sinceSeq) {
+            out.emplace_back(sessionId, entry.status);
+        }
+    }
+    return statusSeq_;
+}
+
 } // namespace MCPIntegration
\ No newline at end of file
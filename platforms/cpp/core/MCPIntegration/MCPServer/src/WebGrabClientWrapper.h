@@ -4,9 +4,13 @@
 class WebGrabClient;
 
 // Standard library includes
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace MCPIntegration {
 
@@ -56,9 +60,33 @@ public:
      */
     bool abort(uint32_t sessionId);
 
+    /**
+     * @brief Collect status changes since a snapshot sequence number
+     *
+     * Refreshes every session tracked by this server and appends
+     * (sessionId, status) for the ones whose status changed after
+     * sinceSeq. The sequence only advances on actual changes, so a
+     * steady-state delta poll transfers nothing.
+     *
+     * @param sinceSeq Sequence number from the caller's previous poll (0 for everything)
+     * @param out Receives the changed sessions
+     * @return Current snapshot sequence number, to pass into the next poll
+     */
+    uint64_t statusChangesSince(uint64_t sinceSeq,
+                                std::vector<std::pair<uint32_t, std::string>>& out);
+
 private:
+    struct StatusEntry {
+        std::string status;
+        uint64_t seq = 0;
+    };
+
     std::unique_ptr<WebGrabClient> client;
     std::mutex mutex_;  // For thread safety
+    // Sequence-stamped status snapshot of the sessions started or polled
+    // through this server; statusSeq_ bumps only when a status changes
+    std::unordered_map<uint32_t, StatusEntry> statusSnapshot_;
+    uint64_t statusSeq_ = 0;
 };
 
 } // namespace MCPIntegration
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "StatusTask.h"
 #include "AbortTask.h"
 #include "GPIOTask.h"
+#include "ToolSchemaValidator.h"
 
 // Third-party includes
 #include <Public/Config.h>
@@ -151,6 +152,12 @@ int CWebGrabMCPServer::Initialize() {
         vecTools.push_back(tool);
     }
 
+    // Compile each tool's schema into its one-pass validator now, so
+    // per-call validation is a few comparisons instead of a tree walk
+    for (const auto& tool : vecTools) {
+        ToolSchemaValidators::instance().add(tool.strName, tool.jInputSchema);
+    }
+
     RegisterServerTools(vecTools, false);
 
     // 5. Register the tasks for implementing the actual capabilities.
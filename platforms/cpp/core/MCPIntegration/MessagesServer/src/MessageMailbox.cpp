@@ -0,0 +1,101 @@
+#include "MessageMailbox.h"
+
+// Third-party includes
+#include <Public/PublicDef.h>
+
+namespace MCPIntegration {
+
+CMessageMailbox::~CMessageMailbox() {
+    Stop();
+}
+
+int CMessageMailbox::Start(DeliveryHandler handler) {
+    if (!handler) {
+        return MCP::ERRNO_INTERNAL_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(mailMutex);
+    if (bRunning) {
+        return MCP::ERRNO_INTERNAL_ERROR;
+    }
+    deliveryHandler = std::move(handler);
+    bRunning = true;
+    deliveryThread = std::thread(&CMessageMailbox::DeliveryLoop, this);
+    return MCP::ERRNO_OK;
+}
+
+void CMessageMailbox::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mailMutex);
+        if (!bRunning) {
+            return;
+        }
+        bRunning = false;
+    }
+    mailReady.notify_all();
+    if (deliveryThread.joinable()) {
+        deliveryThread.join();
+    }
+}
+
+int CMessageMailbox::Submit(Message message) {
+    std::lock_guard<std::mutex> lock(mailMutex);
+    if (!bRunning) {
+        return MCP::ERRNO_INTERNAL_ERROR;
+    }
+    Mailbox& box = mailboxes[message.strRecipient];
+    if (box.mail.size() >= MAX_PER_RECIPIENT) {
+        // Backpressure: the producer hears about the stall instead of
+        // the queue absorbing it
+        return MCP::ERRNO_INTERNAL_ERROR;
+    }
+    if (!box.bQueued) {
+        box.bQueued = true;
+        readyRecipients.push_back(message.strRecipient);
+        mailReady.notify_one();
+    }
+    box.mail.push_back(std::move(message));
+    return MCP::ERRNO_OK;
+}
+
+size_t CMessageMailbox::PendingCount(const std::string& strRecipient) const {
+    std::lock_guard<std::mutex> lock(mailMutex);
+    auto it = mailboxes.find(strRecipient);
+    return it == mailboxes.end() ? 0 : it->second.mail.size();
+}
+
+void CMessageMailbox::DeliveryLoop() {
+    std::vector<Message> batch;
+    batch.reserve(BATCH_SIZE);
+
+    std::unique_lock<std::mutex> lock(mailMutex);
+    while (true) {
+        mailReady.wait(lock, [this] { return !bRunning || !readyRecipients.empty(); });
+        if (!bRunning && readyRecipients.empty()) {
+            return;
+        }
+
+        std::string strRecipient = std::move(readyRecipients.front());
+        readyRecipients.pop_front();
+        Mailbox& box = mailboxes[strRecipient];
+
+        const size_t count = std::min(box.mail.size(), BATCH_SIZE);
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(std::move(box.mail.front()));
+            box.mail.pop_front();
+        }
+        if (box.mail.empty()) {
+            box.bQueued = false;
+        } else {
+            // Round-robin: leftover mail goes to the back of the line so
+            // one busy recipient cannot starve the others
+            readyRecipients.push_back(strRecipient);
+        }
+
+        lock.unlock();
+        deliveryHandler(strRecipient, batch);
+        batch.clear();
+        lock.lock();
+    }
+}
+
+} // namespace MCPIntegration
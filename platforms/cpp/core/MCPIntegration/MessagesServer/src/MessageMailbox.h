@@ -0,0 +1,75 @@
+#pragma once
+
+// Standard library includes
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MCPIntegration {
+
+/**
+ * @brief Bounded per-recipient mailbox with batched delivery
+ *
+ * Outbound messages are queued into one bounded deque per recipient and
+ * drained in batches (up to BATCH_SIZE per wakeup) by a single delivery
+ * thread that round-robins over recipients with pending mail. A full
+ * mailbox rejects the submit instead of growing, so a stalled recipient
+ * pushes back on its producer rather than ballooning queue memory while
+ * other recipients keep flowing.
+ */
+class CMessageMailbox {
+public:
+    static constexpr size_t MAX_PER_RECIPIENT = 256;
+    static constexpr size_t BATCH_SIZE = 32;
+
+    struct Message {
+        std::string strRecipient;
+        std::string strChannel; // "sms", "mms", "email"
+        std::string strBody;
+    };
+
+    // Receives one drained batch; all messages share one recipient
+    using DeliveryHandler =
+        std::function<void(const std::string& strRecipient, std::vector<Message>& batch)>;
+
+    CMessageMailbox() = default;
+    ~CMessageMailbox();
+
+    CMessageMailbox(const CMessageMailbox&) = delete;
+    CMessageMailbox& operator=(const CMessageMailbox&) = delete;
+
+    // Starts the delivery thread; returns MCP::ERRNO_OK style codes
+    int Start(DeliveryHandler handler);
+    void Stop();
+
+    // Queues one message. Returns ERRNO_OK, or ERRNO_INTERNAL_ERROR when
+    // that recipient's mailbox is full (backpressure: report busy or
+    // retry later) or the mailbox is not running.
+    int Submit(Message message);
+
+    // Pending messages for one recipient, for status queries
+    size_t PendingCount(const std::string& strRecipient) const;
+
+private:
+    struct Mailbox {
+        std::deque<Message> mail;
+        bool bQueued = false; // present in readyRecipients
+    };
+
+    void DeliveryLoop();
+
+    DeliveryHandler deliveryHandler;
+    mutable std::mutex mailMutex;
+    std::condition_variable mailReady;
+    std::unordered_map<std::string, Mailbox> mailboxes;
+    std::deque<std::string> readyRecipients;
+    std::thread deliveryThread;
+    bool bRunning = false;
+};
+
+} // namespace MCPIntegration
@@ -1,6 +1,7 @@
 #pragma once
 
 // Local includes
+#include "MessageMailbox.h"
 #include <Entity/Server.h>
 
 // Standard library includes
@@ -22,10 +23,16 @@ public:
 
     int Initialize() override;
 
+    // Outbound queue shared by the channel tools; Submit returns an
+    // error on a full recipient mailbox so callers can report busy
+    CMessageMailbox& Mailbox() { return mailbox; }
+
 private:
     friend class MCP::CMCPServer<CMessagesMCPServer>;
     CMessagesMCPServer() = default;
     static CMessagesMCPServer s_Instance;
+
+    CMessageMailbox mailbox;
 };
 
 } // namespace MCPIntegration
@@ -30,6 +30,18 @@ int CMessagesMCPServer::Initialize() {
     std::vector<MCP::Tool> vecTools;
     RegisterServerTools(vecTools, false);
 
+    // Outbound delivery: channel senders will hang off this handler;
+    // until then drained batches are logged. One batch per wakeup per
+    // recipient keeps per-message dispatch overhead off the hot path.
+    int err = mailbox.Start([](const std::string& strRecipient,
+                               std::vector<CMessageMailbox::Message>& batch) {
+        std::cout << "Delivering " << batch.size() << " message(s) to "
+                  << strRecipient << std::endl;
+    });
+    if (MCP::ERRNO_OK != err) {
+        return err;
+    }
+
     return MCP::ERRNO_OK;
 }
 
@@ -50,6 +62,7 @@ static int run_server_loop() {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     server.Stop();
+    server.Mailbox().Stop();
     std::cout << "Messages MCP Server stopped" << std::endl;
     return MCP::ERRNO_OK;
 }
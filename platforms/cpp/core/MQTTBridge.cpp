@@ -0,0 +1,83 @@
+#include "MQTTBridge.h"
+
+#include <iostream>
+
+namespace WebGrab {
+
+MQTTBridge::MQTTBridge(const std::string& host, int port, const std::string& client_id)
+    : host_(host), port_(port), client_id_(client_id) {
+}
+
+MQTTBridge::~MQTTBridge() {
+    disconnect();
+}
+
+bool MQTTBridge::connect() {
+    if (session_) {
+        return session_->isConnected();
+    }
+    session_ = MQTTSession::get(host_, port_);
+    return session_ != nullptr;
+}
+
+void MQTTBridge::disconnect() {
+    if (!session_) {
+        return;
+    }
+    for (const auto& [topic, token] : subscriptions_) {
+        session_->unsubscribe(token);
+    }
+    subscriptions_.clear();
+    session_.reset();
+}
+
+bool MQTTBridge::publish(const std::string& topic, const std::string& payload,
+                         int qos, bool retain) {
+    return session_ && session_->publish(topic, payload, qos, retain);
+}
+
+bool MQTTBridge::subscribe(const std::string& topic, int qos) {
+    if (!session_ || subscriptions_.count(topic)) {
+        return session_ != nullptr;
+    }
+    uint64_t token = session_->subscribe(
+        topic,
+        [this](const std::string& t, const MqttPayload& p) { handle_message(t, *p); },
+        qos);
+    subscriptions_[topic] = token;
+    return true;
+}
+
+bool MQTTBridge::unsubscribe(const std::string& topic) {
+    auto it = subscriptions_.find(topic);
+    if (!session_ || it == subscriptions_.end()) {
+        return false;
+    }
+    session_->unsubscribe(it->second);
+    subscriptions_.erase(it);
+    return true;
+}
+
+void MQTTBridge::setMessageCallback(MessageCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    message_callback_ = std::move(callback);
+}
+
+void MQTTBridge::setLastWill(const std::string& topic, const std::string& /*payload*/,
+                             int /*qos*/, bool /*retain*/) {
+    std::cerr << "MQTTBridge: last will on '" << topic
+              << "' ignored; the shared session has no per-client wills" << std::endl;
+}
+
+void MQTTBridge::handle_message(const std::string& topic, const std::string& payload) {
+    MessageCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = message_callback_;
+    }
+    if (callback) {
+        callback(topic, payload);
+    }
+}
+
+} // namespace WebGrab
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <mosquitto.h>
-#include <string>
+#include "MQTTSession.h"
+
 #include <functional>
 #include <memory>
-#include <unordered_map>
 #include <mutex>
-#include <atomic>
+#include <string>
+#include <unordered_map>
 
 namespace WebGrab {
 
@@ -15,6 +15,9 @@ namespace WebGrab {
  *
  * Provides a high-level interface for MQTT pub/sub operations
  * while maintaining compatibility with existing interfaces.
+ *
+ * Thin client of the shared MQTTSession: every bridge on a node rides
+ * the same broker connection instead of opening its own.
  */
 class MQTTBridge {
 public:
@@ -27,7 +30,7 @@ public:
     // Connection management
     bool connect();
     void disconnect();
-    bool isConnected() const { return connected_; }
+    bool isConnected() const { return session_ && session_->isConnected(); }
 
     // Publishing
     bool publish(const std::string& topic, const std::string& payload,
@@ -38,31 +41,30 @@ public:
     bool unsubscribe(const std::string& topic);
 
     // Message handling
-    void setMessageCallback(MessageCallback callback) { message_callback_ = callback; }
+    void setMessageCallback(MessageCallback callback);
 
     // Utility methods
     std::string getClientId() const { return client_id_; }
+
+    // A last will is per-connection state; on the shared session one
+    // bridge's will would speak for every consumer, so this is not
+    // supported and only logs. Callers needing a will must own a
+    // dedicated connection.
     void setLastWill(const std::string& topic, const std::string& payload, int qos = 0, bool retain = false);
 
 private:
-    struct mosquitto* mosq_;
+    std::shared_ptr<MQTTSession> session_;
     std::string host_;
     int port_;
     std::string client_id_;
-    std::atomic<bool> connected_;
+
+    // One session token per subscribed topic, for unsubscribe
+    std::unordered_map<std::string, uint64_t> subscriptions_;
 
     MessageCallback message_callback_;
     std::mutex callback_mutex_;
 
-    // MQTT callbacks
-    static void on_connect(struct mosquitto* mosq, void* obj, int rc);
-    static void on_disconnect(struct mosquitto* mosq, void* obj, int rc);
-    static void on_message(struct mosquitto* mosq, void* obj, const struct mosquitto_message* msg);
-    static void on_publish(struct mosquitto* mosq, void* obj, int mid);
-
-    void handle_connect(int rc);
-    void handle_disconnect(int rc);
-    void handle_message(const struct mosquitto_message* msg);
+    void handle_message(const std::string& topic, const std::string& payload);
 };
 
-} // namespace WebGrab
\ No newline at end of file
+} // namespace WebGrab
@@ -3,12 +3,16 @@
 #include "IReader.h"
 #include "IRequestReader.h"
 #include "IResponseReader.h"
-#include <mosquitto.h>
+#include "MQTTSession.h"
+#include "TopicTrie.h"
+#include <memory>
 #include <string>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <thread>
+#include <vector>
 
 namespace WebGrab {
 
@@ -34,29 +38,110 @@ public:
     bool tryRecv(StatusResponse& out, std::chrono::milliseconds timeout) override;
     bool tryRecv(ErrorResponse& out, std::chrono::milliseconds timeout) override;
 
+    // Per-filter subscription routing. subscribeFilter compiles the
+    // filter (+/# wildcards) into the topic trie and returns an id
+    // whose queue receives only matching payloads, routed directly in
+    // the mosquitto callback. The hot hardware filter
+    // ("webgrab/gpio/#") then never queues behind bulk download status
+    // traffic in the shared queue. Register filters before the client
+    // starts delivering; the trie is read-only afterwards.
+    size_t subscribeFilter(const std::string& filter) {
+        size_t id = subscriptions_.size();
+        subscriptions_.push_back(std::make_unique<Subscription>());
+        topic_trie_.addFilter(filter, id);
+        return id;
+    }
+
+    // Drain a subscription's queue, same contract as drainMessages.
+    size_t drainSubscription(size_t id, std::vector<MqttPayload>& out,
+                             size_t maxMessages, std::chrono::milliseconds timeout) {
+        Subscription& sub = *subscriptions_[id];
+        std::unique_lock<std::mutex> lock(sub.mutex);
+        if (sub.queue.empty()) {
+            sub.cv.wait_for(lock, timeout,
+                            [&]() { return !sub.queue.empty() || !connected_; });
+        }
+        size_t drained = 0;
+        while (!sub.queue.empty() && drained < maxMessages) {
+            out.push_back(std::move(sub.queue.front()));
+            sub.queue.pop();
+            ++drained;
+        }
+        return drained;
+    }
+
+    // Batch drain: blocks until at least one message arrives (or the
+    // timeout passes), then moves up to maxMessages off the queue under
+    // a single lock acquisition. A 100-message burst costs one wakeup
+    // and one lock cycle instead of 100. Returns the number appended.
+    size_t drainMessages(std::vector<MqttPayload>& out, size_t maxMessages,
+                         std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (message_queue_.empty()) {
+            queue_cv_.wait_for(lock, timeout,
+                               [this]() { return !message_queue_.empty() || !connected_; });
+        }
+        size_t drained = 0;
+        while (!message_queue_.empty() && drained < maxMessages) {
+            out.push_back(std::move(message_queue_.front()));
+            message_queue_.pop();
+            ++drained;
+        }
+        return drained;
+    }
+
 private:
-    // MQTT connection
-    struct mosquitto* mqtt_client_;
+    // Thin client of the shared per-broker session: the constructor
+    // registers topic_prefix_ + "#" and handle_message routes from the
+    // session's loop thread; no private mosquitto client or loop
+    std::shared_ptr<MQTTSession> session_;
+    uint64_t session_token_ = 0;
     std::string host_;
     int port_;
     std::string topic_prefix_;
     std::atomic<bool> connected_;
-    std::thread mqtt_thread_;
 
-    // Message queues
-    std::queue<std::string> message_queue_;
+    // Message queues hold refcounted payload handles, not copies; the
+    // bytes were claimed once in MQTTSession::handleMessage
+    std::queue<MqttPayload> message_queue_;
     std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
 
-    // MQTT callbacks
-    static void on_connect(struct mosquitto* mosq, void* obj, int rc);
-    static void on_message(struct mosquitto* mosq, void* obj,
-                          const struct mosquitto_message* msg);
-    void handle_message(const std::string& topic, const std::string& payload);
+    // Per-filter routing: queues are independent so one subscriber's
+    // backlog never delays another's delivery
+    struct Subscription {
+        std::queue<MqttPayload> queue;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    std::vector<std::unique_ptr<Subscription>> subscriptions_;
+    TopicTrie topic_trie_;
+
+    // Called from the session's delivery callback: route to matching
+    // subscription queues via the trie, falling back to the shared
+    // queue for topics nothing subscribed to.
+    void handle_message(const std::string& topic, const MqttPayload& payload) {
+        bool routed = false;
+        topic_trie_.match(topic, [&](size_t id) {
+            Subscription& sub = *subscriptions_[id];
+            {
+                std::lock_guard<std::mutex> lock(sub.mutex);
+                sub.queue.push(payload);
+            }
+            sub.cv.notify_one();
+            routed = true;
+        });
+        if (!routed) {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                message_queue_.push(payload);
+            }
+            queue_cv_.notify_one();
+        }
+    }
 
     // Helper methods
     bool initialize_mqtt();
-    void mqtt_loop();
     bool wait_for_message(std::string& message, std::chrono::milliseconds timeout);
     RequestType parse_request_type(const std::string& json_payload);
 };
@@ -0,0 +1,214 @@
+#include "MQTTSession.h"
+
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+namespace WebGrab {
+
+namespace {
+
+// One live session per broker; weak so the connection closes when the
+// last consumer drops its shared_ptr
+std::mutex g_registry_mutex;
+std::unordered_map<std::string, std::weak_ptr<MQTTSession>>& Registry() {
+    static std::unordered_map<std::string, std::weak_ptr<MQTTSession>> registry;
+    return registry;
+}
+
+} // namespace
+
+std::shared_ptr<MQTTSession> MQTTSession::get(const std::string& host, int port) {
+    const std::string key = host + ":" + std::to_string(port);
+
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    auto& registry = Registry();
+    if (auto existing = registry[key].lock()) {
+        return existing;
+    }
+
+    std::shared_ptr<MQTTSession> session(new MQTTSession(host, port));
+    if (!session->open()) {
+        return nullptr;
+    }
+    registry[key] = session;
+    return session;
+}
+
+MQTTSession::MQTTSession(std::string host, int port)
+    : host_(std::move(host)), port_(port) {
+    consumers_.store(std::make_shared<const ConsumerList>());
+}
+
+MQTTSession::~MQTTSession() {
+    running_.store(false);
+    if (loopThread_.joinable()) {
+        loopThread_.join();
+    }
+    if (mosq_) {
+        if (connected_.exchange(false)) {
+            mosquitto_disconnect(mosq_);
+        }
+        mosquitto_destroy(mosq_);
+    }
+}
+
+bool MQTTSession::open() {
+    mosquitto_lib_init();
+
+    mosq_ = mosquitto_new(nullptr, true, this);
+    if (!mosq_) {
+        std::cerr << "Failed to create MQTT client" << std::endl;
+        return false;
+    }
+
+    mosquitto_connect_callback_set(mosq_, on_connect);
+    mosquitto_message_callback_set(mosq_, on_message);
+
+    int rc = mosquitto_connect(mosq_, host_.c_str(), port_, 60);
+    if (rc != MOSQ_ERR_SUCCESS) {
+        std::cerr << "MQTT connect failed: " << mosquitto_strerror(rc) << std::endl;
+        mosquitto_destroy(mosq_);
+        mosq_ = nullptr;
+        return false;
+    }
+
+    connected_.store(true);
+    running_.store(true);
+    loopThread_ = std::thread(&MQTTSession::loop, this);
+
+    std::cout << "MQTT session connected to " << host_ << ":" << port_ << std::endl;
+    return true;
+}
+
+void MQTTSession::loop() {
+    while (running_.load()) {
+        int rc = mosquitto_loop(mosq_, 100, 1);
+        if (rc != MOSQ_ERR_SUCCESS && running_.load()) {
+            connected_.store(false);
+            std::cerr << "MQTT loop error: " << mosquitto_strerror(rc) << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            if (mosquitto_reconnect(mosq_) == MOSQ_ERR_SUCCESS) {
+                connected_.store(true);
+            }
+        }
+    }
+}
+
+uint64_t MQTTSession::subscribe(const std::string& filter, MessageHandler handler, int qos) {
+    std::lock_guard<std::mutex> lock(consumersWriteMutex_);
+    auto current = consumers_.load();
+
+    // Subscribe at the broker only for the first consumer of a filter
+    bool filterKnown = false;
+    for (const Consumer& c : *current) {
+        if (c.filter == filter) {
+            filterKnown = true;
+            break;
+        }
+    }
+    if (!filterKnown) {
+        mosquitto_subscribe(mosq_, nullptr, filter.c_str(), qos);
+    }
+
+    const uint64_t token = nextToken_++;
+    auto next = std::make_shared<ConsumerList>(*current);
+    next->push_back({token, filter, std::move(handler), qos});
+    consumers_.store(std::shared_ptr<const ConsumerList>(std::move(next)));
+    return token;
+}
+
+void MQTTSession::unsubscribe(uint64_t token) {
+    std::lock_guard<std::mutex> lock(consumersWriteMutex_);
+    auto current = consumers_.load();
+
+    std::string droppedFilter;
+    auto next = std::make_shared<ConsumerList>();
+    next->reserve(current->size());
+    for (const Consumer& c : *current) {
+        if (c.token == token) {
+            droppedFilter = c.filter;
+        } else {
+            next->push_back(c);
+        }
+    }
+
+    // Release the broker subscription when its last consumer leaves
+    if (!droppedFilter.empty()) {
+        bool stillUsed = false;
+        for (const Consumer& c : *next) {
+            if (c.filter == droppedFilter) {
+                stillUsed = true;
+                break;
+            }
+        }
+        if (!stillUsed) {
+            mosquitto_unsubscribe(mosq_, nullptr, droppedFilter.c_str());
+        }
+    }
+
+    consumers_.store(std::shared_ptr<const ConsumerList>(std::move(next)));
+}
+
+bool MQTTSession::publish(const std::string& topic, const std::string& payload,
+                          int qos, bool retain) {
+    if (!mosq_ || !connected_.load()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    int rc = mosquitto_publish(mosq_, nullptr, topic.c_str(),
+                               static_cast<int>(payload.size()), payload.data(),
+                               qos, retain);
+    if (rc != MOSQ_ERR_SUCCESS) {
+        std::cerr << "MQTT publish failed: " << mosquitto_strerror(rc) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void MQTTSession::on_connect(struct mosquitto* /*mosq*/, void* obj, int rc) {
+    auto* session = static_cast<MQTTSession*>(obj);
+    if (rc == 0) {
+        // Re-established after a drop: the broker forgot our filters
+        session->resubscribeAll();
+    } else {
+        std::cerr << "MQTT connection failed: " << mosquitto_connack_string(rc) << std::endl;
+    }
+}
+
+void MQTTSession::resubscribeAll() {
+    auto snapshot = consumers_.load();
+    for (const Consumer& c : *snapshot) {
+        mosquitto_subscribe(mosq_, nullptr, c.filter.c_str(), c.qos);
+    }
+}
+
+void MQTTSession::on_message(struct mosquitto* /*mosq*/, void* obj,
+                             const struct mosquitto_message* msg) {
+    auto* session = static_cast<MQTTSession*>(obj);
+    if (session && msg && msg->topic) {
+        session->handleMessage(msg);
+    }
+}
+
+void MQTTSession::handleMessage(const struct mosquitto_message* msg) {
+    const std::string topic(msg->topic);
+    // Claim mosquitto's transient buffer once; consumers share the
+    // refcount from here on
+    const MqttPayload payload = std::make_shared<const std::string>(
+        static_cast<const char*>(msg->payload ? msg->payload : ""),
+        static_cast<size_t>(msg->payloadlen));
+
+    // Lock-free fan-out from the loop thread
+    auto snapshot = consumers_.load();
+    for (const Consumer& c : *snapshot) {
+        bool match = false;
+        mosquitto_topic_matches_sub(c.filter.c_str(), topic.c_str(), &match);
+        if (match) {
+            c.handler(topic, payload);
+        }
+    }
+}
+
+} // namespace WebGrab
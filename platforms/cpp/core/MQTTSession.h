@@ -0,0 +1,114 @@
+#pragma once
+
+#include <mosquitto.h>
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WebGrab {
+
+/**
+ * @brief Refcounted immutable MQTT payload
+ *
+ * mosquitto owns the callback's buffer only for the callback's
+ * duration, so the session claims it into one shared allocation;
+ * every consumer queue and handler after that shares the refcount
+ * instead of copying bytes. One copy end to end.
+ */
+using MqttPayload = std::shared_ptr<const std::string>;
+
+/**
+ * @brief Shared MQTT session: one mosquitto connection per broker
+ *
+ * MQTTBridge, MQTTReader, and the hardware server each used to open
+ * their own client to the same local broker — three keepalive streams
+ * and three sets of connection state for one box. get() hands out the
+ * session for a host:port, creating it on first use; every consumer
+ * on the node then rides the same connection.
+ *
+ * Subscriptions register a filter plus a handler; the mosquitto
+ * callback fans each message out to every matching consumer
+ * (mosquitto_topic_matches_sub, so +/# filters work). The consumer
+ * list is an RCU-style snapshot — delivery never takes the
+ * registration lock. Publishes go through one serialized lane, which
+ * mosquitto's threading model requires anyway.
+ *
+ * Handlers run on the session's network loop thread and must not
+ * block; queue and return, as MQTTReader does.
+ */
+class MQTTSession {
+public:
+    using MessageHandler =
+        std::function<void(const std::string& topic, const MqttPayload& payload)>;
+
+    /**
+     * @brief Session for host:port, shared across the process
+     *
+     * Connects on first use. Returns nullptr when the broker is
+     * unreachable; callers treat that the same as their old private
+     * connection failing.
+     */
+    static std::shared_ptr<MQTTSession> get(const std::string& host = "localhost",
+                                            int port = 1883);
+
+    ~MQTTSession();
+
+    bool isConnected() const { return connected_.load(); }
+
+    /**
+     * @brief Register a handler for a topic filter; returns a token
+     *
+     * The broker subscription is issued once per distinct filter and
+     * released when the last consumer of that filter unsubscribes.
+     */
+    uint64_t subscribe(const std::string& filter, MessageHandler handler, int qos = 0);
+    void unsubscribe(uint64_t token);
+
+    // Serialized publish lane shared by all consumers
+    bool publish(const std::string& topic, const std::string& payload,
+                 int qos = 0, bool retain = false);
+
+private:
+    MQTTSession(std::string host, int port);
+    bool open();
+
+    struct Consumer {
+        uint64_t token;
+        std::string filter;
+        MessageHandler handler;
+        int qos;
+    };
+
+    // RCU snapshot, same idiom as the orchestrator's service registry:
+    // the loop thread loads it lock-free, registration copies and
+    // republishes under consumersWriteMutex_
+    using ConsumerList = std::vector<Consumer>;
+    std::atomic<std::shared_ptr<const ConsumerList>> consumers_;
+    std::mutex consumersWriteMutex_;
+    uint64_t nextToken_ = 1;
+
+    std::mutex publishMutex_;
+
+    struct mosquitto* mosq_ = nullptr;
+    std::string host_;
+    int port_;
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> running_{false};
+    std::thread loopThread_;
+
+    static void on_message(struct mosquitto* mosq, void* obj,
+                           const struct mosquitto_message* msg);
+    static void on_connect(struct mosquitto* mosq, void* obj, int rc);
+    void handleMessage(const struct mosquitto_message* msg);
+    void resubscribeAll();
+    void loop();
+};
+
+} // namespace WebGrab
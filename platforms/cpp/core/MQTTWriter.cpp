@@ -0,0 +1,135 @@
+#include "MQTTWriter.h"
+
+#include <iostream>
+#include <sstream>
+
+namespace WebGrab {
+
+MQTTWriter::MQTTWriter(const std::string& host, int port, const std::string& topic_prefix)
+    : host_(host)
+    , port_(port)
+    , topic_prefix_(topic_prefix) {
+    initialize_mqtt();
+}
+
+MQTTWriter::~MQTTWriter() {
+    disableCoalescing();
+    close();
+}
+
+bool MQTTWriter::initialize_mqtt() {
+    // Shared per-broker session: another writer or reader on this node
+    // already paid for the connection and keepalive
+    session_ = MQTTSession::get(host_, port_);
+    return session_ != nullptr;
+}
+
+bool MQTTWriter::publish_message(const std::string& topic, const std::string& payload,
+                                 int qos, bool retain) {
+    if (!session_) return false;
+    return session_->publish(topic, payload, qos, retain);
+}
+
+std::string MQTTWriter::get_response_topic(const std::string& response_type) const {
+    return topic_prefix_ + "response/" + response_type;
+}
+
+bool MQTTWriter::write(const void* buffer, size_t size) {
+    return publish_message(topic_prefix_ + "raw",
+                           std::string(static_cast<const char*>(buffer), size), 1);
+}
+
+void MQTTWriter::close() {
+    // The session disconnects when its last consumer releases it
+    session_.reset();
+}
+
+bool MQTTWriter::write(const DownloadResponse& resp) {
+    // Command results are never coalesced: QoS1 so the client sees them
+    std::ostringstream oss;
+    oss << "{\"sessionId\": " << resp.sessionId << "}";
+    return publish_message(get_response_topic("download"), oss.str(), 1);
+}
+
+bool MQTTWriter::write(const StatusResponse& resp) {
+    std::ostringstream oss;
+    oss << "{\"sessionId\": " << resp.sessionId
+        << ", \"status\": \"" << resp.status << "\"";
+    if (!resp.checksum.empty()) {
+        oss << ", \"checksum\": \"" << resp.checksum << "\"";
+    }
+    oss << "}";
+
+    std::string topic = get_response_topic("status/" + std::to_string(resp.sessionId));
+
+    if (coalescing_enabled_.load()) {
+        // Keep only the newest payload per topic; the window thread
+        // publishes it on the next tick
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_status_[topic] = oss.str();
+        pending_cv_.notify_one();
+        return true;
+    }
+
+    // Ephemeral progress: QoS0, a lost sample is superseded by the next
+    return publish_message(topic, oss.str(), 0);
+}
+
+bool MQTTWriter::write(const ErrorResponse& resp) {
+    std::ostringstream oss;
+    oss << "{\"error\": \"" << resp.error << "\"}";
+    return publish_message(get_response_topic("error"), oss.str(), 1);
+}
+
+bool MQTTWriter::flush() {
+    if (coalescing_enabled_.load()) {
+        flush_pending();
+    }
+    return session_ && session_->isConnected();
+}
+
+void MQTTWriter::enableCoalescing(std::chrono::milliseconds window) {
+    if (coalesce_running_.exchange(true)) {
+        coalesce_window_ = window;
+        return;
+    }
+    coalesce_window_ = window;
+    coalescing_enabled_.store(true);
+    coalesce_thread_ = std::thread(&MQTTWriter::coalesce_loop, this);
+}
+
+void MQTTWriter::disableCoalescing() {
+    coalescing_enabled_.store(false);
+    if (coalesce_running_.exchange(false)) {
+        pending_cv_.notify_all();
+        if (coalesce_thread_.joinable()) {
+            coalesce_thread_.join();
+        }
+        flush_pending();
+    }
+}
+
+void MQTTWriter::flush_pending() {
+    std::unordered_map<std::string, std::string> batch;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        batch.swap(pending_status_);
+    }
+    for (const auto& [topic, payload] : batch) {
+        publish_message(topic, payload, 0);
+    }
+}
+
+void MQTTWriter::coalesce_loop() {
+    while (coalesce_running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(pending_mutex_);
+            pending_cv_.wait_for(lock, coalesce_window_, [this] {
+                return !coalesce_running_.load();
+            });
+        }
+        flush_pending();
+    }
+}
+
+} // namespace WebGrab
@@ -2,9 +2,15 @@
 
 #include "IWriter.h"
 #include "IResponseWriter.h"
-#include <mosquitto.h>
+#include "MQTTSession.h"
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace WebGrab {
 
@@ -24,17 +30,34 @@ public:
     bool write(const ErrorResponse& resp) override;
     bool flush() override;
 
+    // Coalescing: status publishes are buffered per topic and only the
+    // latest value per session goes out each window, at QoS0 since a
+    // newer progress value supersedes a lost one. Download/error
+    // responses always publish immediately at QoS1.
+    void enableCoalescing(std::chrono::milliseconds window = std::chrono::milliseconds(20));
+    void disableCoalescing();
+
 private:
-    // MQTT connection
-    struct mosquitto* mqtt_client_;
+    // Rides the shared per-broker session; no private mosquitto client
+    std::shared_ptr<MQTTSession> session_;
     std::string host_;
     int port_;
     std::string topic_prefix_;
-    std::atomic<bool> connected_;
+
+    // Coalescing state: topic -> latest pending payload
+    std::atomic<bool> coalescing_enabled_{false};
+    std::chrono::milliseconds coalesce_window_{20};
+    std::mutex pending_mutex_;
+    std::unordered_map<std::string, std::string> pending_status_;
+    std::condition_variable pending_cv_;
+    std::thread coalesce_thread_;
+    std::atomic<bool> coalesce_running_{false};
 
     // Helper methods
     bool initialize_mqtt();
     bool publish_message(const std::string& topic, const std::string& payload, int qos = 0, bool retain = false);
+    void coalesce_loop();
+    void flush_pending();
 
     // Response topic generation
     std::string get_response_topic(const std::string& response_type) const;
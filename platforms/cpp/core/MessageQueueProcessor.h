@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -6,20 +7,13 @@
 #include <atomic>
 #include <thread>
 
+#include "CancellationToken.h"
 #include "IRequestReader.h"
 #include "IResponseWriter.h"
+#include "JobTable.h"
 #include "MQTTReader.h"
 #include "MQTTWriter.h"
 
-enum class JobStatus { Queued, Downloading, Completed, Failed, Aborted };
-
-struct JobInfo {
-    uint32_t sessionId;
-    std::string url;
-    JobStatus status;
-    std::string filePath;
-};
-
 class MessageQueueProcessor : public IRequestReader, public IResponseWriter {
 public:
     MessageQueueProcessor(const std::string& workingDir,
@@ -45,10 +39,26 @@ public:
     void enableMQTT(bool enable = true);
     bool isMQTTEnabled() const { return mqtt_enabled_; }
 
+    // Cancels a job in any state: a queued job is dropped before its
+    // first byte, a transferring one is torn down via the engine within
+    // one progress event. Returns false for unknown or finished jobs.
+    bool abortJob(uint32_t sessionId);
+
+    // Lifecycle stamps for the server-truth latency breakdown. The
+    // dispatch path calls markJobStarted when the worker picks the job
+    // up (this also releases its admission slot) and markJobFinished
+    // when the transfer ends; the stamps feed queuedMs/execMs in
+    // StatusResponse and the per-class StatsRequest histograms. Both
+    // no-op on unknown sessions or out-of-order transitions, so a
+    // racing abort wins cleanly.
+    void markJobStarted(uint32_t sessionId);
+    void markJobFinished(uint32_t sessionId, bool success);
+
 private:
     std::string workingDir_;
-    std::unordered_map<uint32_t, JobInfo> jobs_;
-    std::mutex jobs_mutex_;
+    // Sharded; status queries go through jobs_.snapshot() and never
+    // contend with the registration/completion paths
+    JobTable jobs_;
     uint32_t next_session_id_;
 
     // MQTT integration
@@ -58,10 +68,76 @@ private:
     std::thread mqtt_processor_thread_;
     std::atomic<bool> running_;
 
-    void enqueueJob(const std::string& url, IResponseWriter* writer);
+    // Bounded admission, per priority class. Depth limits are per class
+    // so a bulk backlog sheds bulk work instead of burying interactive
+    // requests, and shallow for interactive because a deep interactive
+    // queue has already lost — nothing in it can answer within an
+    // interactive budget.
+    static constexpr size_t kNumClasses = 2;
+    static constexpr uint32_t kQueueDepthLimit[kNumClasses] = {256, 64};
+    static constexpr uint32_t kRetryAfterSec[kNumClasses] = {5, 1};
+    std::atomic<uint32_t> queueDepth_[kNumClasses]{};
+
+    // True when the class has room and the deadline (when set) has not
+    // passed. On rejection writes ErrorResponse("overloaded; ...") with
+    // a retry-after hint and returns false; the caller must not
+    // register the job.
+    bool admitJob(uint8_t priority, std::chrono::steady_clock::time_point deadline,
+                  IResponseWriter* writer);
+    // Releases the class slot when an admitted job leaves Queued:
+    // abortJob here, the worker's dispatch path in the full pipeline
+    void releaseAdmission(uint8_t priority);
+
+    // priority: 0 = bulk, 1 = interactive (DownloadRequest.priority).
+    // Returns the registered job for the caller to hand to JobWorker,
+    // which dispatches on its class; nullptr when admission shed the
+    // request (the overload error has already been written) or when the
+    // request was a redelivery (the original job's DownloadResponse has
+    // already been written, see findDuplicate).
+    std::unique_ptr<class IJob> enqueueJob(const std::string& url, IResponseWriter* writer, uint8_t priority = 0,
+                                           std::chrono::steady_clock::time_point deadline = {});
+
+    // Redelivery dedupe. Flaky uplinks make MQTT resend
+    // DownloadRequests, and each duplicate used to spawn a concurrent
+    // download of the same URL. A time-windowed index recognizes a
+    // retransmit while the original job is still live and answers with
+    // the original session id, attaching the duplicate to that job's
+    // status stream instead of spending a worker slot and bandwidth on
+    // it. The wire carries no requester identity, so (url, priority
+    // class) stands in for (url, requester).
+    static constexpr std::chrono::seconds kDedupeWindow{10};
+    // Amortized sweep threshold: exceeding it prunes expired entries
+    static constexpr size_t kDedupeSweepSize = 1024;
+    struct DedupeEntry {
+        uint32_t sessionId;
+        std::chrono::steady_clock::time_point at;
+    };
+    std::mutex dedupeMutex_;
+    std::unordered_map<std::string, DedupeEntry> dedupeIndex_;
+    // The live original's session id for a retransmit; 0 when the
+    // request is new (session ids start at 1) or the original finished
+    uint32_t findDuplicate(const std::string& url, uint8_t priority);
+    void recordEnqueue(const std::string& url, uint8_t priority, uint32_t sessionId);
     void processMQTTMessages();
     std::string statusToString(JobStatus status);
 
+    // Rolling per-class latency histograms, HardwareMetrics-style:
+    // relaxed atomic buckets bumped once per completed job, so the hot
+    // path pays two increments and a StatsRequest pays the whole read.
+    // Bucket i covers durations up to 2^i ms; the last bucket absorbs
+    // overflow.
+    static constexpr size_t kLatencyBuckets = 12;
+    struct LatencyHistogram {
+        std::atomic<uint64_t> queued[kLatencyBuckets]{};
+        std::atomic<uint64_t> exec[kLatencyBuckets]{};
+        std::atomic<uint64_t> count{};
+    };
+    LatencyHistogram latency_[kNumClasses];
+    void recordLatency(uint8_t priority, uint32_t queuedMs, uint32_t execMs);
+    // JSON for StatsResponse: per class, the bucket upper bounds and the
+    // queued/exec counts
+    std::string renderStats();
+
     // GPIO control methods (for hybrid functionality)
     bool handleGPIORequest(const std::string& request_json, std::string& response_json);
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief First-touch NUMA placement for worker and connection threads
+ *
+ * On the 2-socket x86 boxes fronting the fleet, a thread that faults a
+ * page gets it from whichever node it happened to wake on; a worker
+ * pinned to socket 0 can spend its life reading buffers that live on
+ * socket 1. preferLocalNode() tells the kernel to satisfy this thread's
+ * future faults from the node it is currently running on, so the
+ * thread-local arenas and buffer-pool slabs it first-touches afterwards
+ * are node-local. Combined with core pinning the thread then never
+ * leaves that node.
+ *
+ * Built on the raw set_mempolicy/getcpu syscalls — no libnuma
+ * dependency. On single-node machines (every Pi) and on kernels without
+ * the syscalls everything collapses to a no-op, so callers can invoke it
+ * unconditionally.
+ */
+namespace NumaPlacement {
+
+// Number of online NUMA nodes, read once from sysfs; 1 when the
+// topology is not exposed (non-Linux, or no NUMA support).
+inline int nodeCount() {
+    static const int count = [] {
+        int nodes = 0;
+        std::ifstream online("/sys/devices/system/node/online");
+        // Format is a range list like "0" or "0-1"; the highest id
+        // bounds the count
+        std::string text;
+        if (online && std::getline(online, text) && !text.empty()) {
+            size_t dash = text.rfind('-');
+            size_t comma = text.rfind(',');
+            size_t start = dash == std::string::npos
+                               ? (comma == std::string::npos ? 0 : comma + 1)
+                               : dash + 1;
+            nodes = std::stoi(text.substr(start)) + 1;
+        }
+        return nodes > 0 ? nodes : 1;
+    }();
+    return count;
+}
+
+// Node the calling thread is currently running on; 0 when the kernel
+// cannot say.
+inline int currentNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+// Prefer the calling thread's current node for its future page faults
+// (MPOL_PREFERRED). Call after pinning, before the thread first-touches
+// its arenas. Returns true when the policy applies or nothing needed
+// doing; false only when a multi-node kernel refused it.
+inline bool preferLocalNode() {
+    if (nodeCount() < 2) {
+        return true;
+    }
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    constexpr int kMpolPreferred = 1;  // <numaif.h> value; header not shipped
+    const int node = currentNode();
+    unsigned long mask = 1UL << node;
+    // maxnode counts bits and the kernel wants one past the highest;
+    // a single unsigned long covers any box we run on
+    return syscall(SYS_set_mempolicy, kMpolPreferred, &mask,
+                   sizeof(mask) * 8) == 0;
+#else
+    return true;
+#endif
+}
+
+}  // namespace NumaPlacement
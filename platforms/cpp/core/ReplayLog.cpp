@@ -0,0 +1,156 @@
+#include "ReplayLog.h"
+#include "Utils/HugePages.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4C524757; // "WGRL"
+constexpr uint32_t kVersion = 1;
+// Length value marking the rest of the ring tail as dead space; the
+// next record starts at offset 0
+constexpr uint32_t kWrapMarker = 0xFFFFFFFF;
+constexpr size_t kLenBytes = sizeof(uint32_t);
+
+} // namespace
+
+struct ReplayLog::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t head; // byte offset of the oldest record
+    uint64_t tail; // byte offset of the next append
+    uint64_t used; // bytes occupied, dead tail space included
+    uint64_t count;
+};
+
+ReplayLog::Header* ReplayLog::header() const {
+    return static_cast<Header*>(map_);
+}
+
+uint8_t* ReplayLog::data() const {
+    return static_cast<uint8_t*>(map_) + sizeof(Header);
+}
+
+std::unique_ptr<ReplayLog> ReplayLog::open(const std::string& path, size_t capacityBytes) {
+    if (capacityBytes < kLenBytes * 2) return nullptr;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return nullptr;
+
+    const size_t mapSize = sizeof(Header) + capacityBytes;
+    if (ftruncate(fd, static_cast<off_t>(mapSize)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // Long-lived and appended to constantly; huge-page backing when the
+    // kernel grants it, normal pages otherwise
+    TinyMCP::Utils::HugePages::instance().adviseMapping("replay-log", map, mapSize);
+
+    auto log = std::unique_ptr<ReplayLog>(new ReplayLog());
+    log->fd_ = fd;
+    log->map_ = map;
+    log->mapSize_ = mapSize;
+
+    Header* h = log->header();
+    if (h->magic != kMagic || h->version != kVersion || h->capacity != capacityBytes) {
+        // Fresh or mismatched file: reinitialize rather than misparse
+        std::memset(h, 0, sizeof(Header));
+        h->magic = kMagic;
+        h->version = kVersion;
+        h->capacity = capacityBytes;
+    }
+    return log;
+}
+
+ReplayLog::~ReplayLog() {
+    if (map_) munmap(map_, mapSize_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void ReplayLog::evictOldest() {
+    Header* h = header();
+    if (h->count == 0 && h->used == 0) return;
+
+    const uint64_t remaining = h->capacity - h->head;
+    if (remaining < kLenBytes) {
+        h->used -= remaining;
+        h->head = 0;
+        return;
+    }
+    uint32_t len;
+    std::memcpy(&len, data() + h->head, kLenBytes);
+    if (len == kWrapMarker) {
+        h->used -= remaining;
+        h->head = 0;
+        return;
+    }
+    h->used -= kLenBytes + len;
+    h->head += kLenBytes + len;
+    h->count--;
+}
+
+bool ReplayLog::append(const void* src, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Header* h = header();
+
+    const uint64_t needed = kLenBytes + size;
+    if (needed > h->capacity) return false;
+
+    // Records never cross the ring end: claim the dead tail as occupied
+    // space (with a wrap marker when it can hold one) and restart at 0
+    if (h->capacity - h->tail < needed) {
+        const uint64_t deadTail = h->capacity - h->tail;
+        while (h->capacity - h->used < deadTail) evictOldest();
+        if (deadTail >= kLenBytes) {
+            std::memcpy(data() + h->tail, &kWrapMarker, kLenBytes);
+        }
+        h->used += deadTail;
+        h->tail = 0;
+    }
+
+    while (h->capacity - h->used < needed) evictOldest();
+
+    const uint32_t len = static_cast<uint32_t>(size);
+    std::memcpy(data() + h->tail, &len, kLenBytes);
+    std::memcpy(data() + h->tail + kLenBytes, src, size);
+    h->used += needed;
+    h->tail += needed;
+    h->count++;
+    return true;
+}
+
+void ReplayLog::forEach(const std::function<void(const void*, size_t)>& visit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Header* h = header();
+
+    uint64_t pos = h->head;
+    for (uint64_t remaining = h->count; remaining > 0; remaining--) {
+        if (h->capacity - pos < kLenBytes) {
+            pos = 0;
+        } else {
+            uint32_t len;
+            std::memcpy(&len, data() + pos, kLenBytes);
+            if (len == kWrapMarker) pos = 0;
+        }
+        uint32_t len;
+        std::memcpy(&len, data() + pos, kLenBytes);
+        visit(data() + pos + kLenBytes, len);
+        pos += kLenBytes + len;
+    }
+}
+
+size_t ReplayLog::recordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(header()->count);
+}
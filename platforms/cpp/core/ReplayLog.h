@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * Memory-mapped circular log of serialized request envelopes.
+ *
+ * Reproducing a production incident used to mean reconstructing the
+ * request sequence from packet captures. The log instead appends every
+ * verified envelope — the bytes are already serialized, so an append is
+ * one memcpy into the mapping, length-prefixed — to a fixed-size ring
+ * file. When the ring is full the oldest records are evicted, so the
+ * file never grows and always holds the most recent traffic window.
+ * The webgrab-replay tool feeds a log back through
+ * MessageQueueProcessor at configurable speed.
+ *
+ * Layout: a fixed header (magic, version, capacity, head/tail byte
+ * positions, record count) followed by the data ring. Records are
+ * contiguous [uint32 length][payload]; a record that would cross the
+ * ring end is preceded by a wrap marker and starts at offset 0, and the
+ * dead tail is accounted so eviction reclaims it. Durability is
+ * best-effort via kernel writeback of the shared mapping — incident
+ * replay, not a transaction journal.
+ */
+class ReplayLog {
+public:
+    // Opens or creates the ring file with the given data capacity. An
+    // existing file with a matching header resumes where it left off; a
+    // mismatched one is reinitialized. Returns nullptr on I/O failure.
+    static std::unique_ptr<ReplayLog> open(const std::string& path, size_t capacityBytes);
+
+    ~ReplayLog();
+
+    ReplayLog(const ReplayLog&) = delete;
+    ReplayLog& operator=(const ReplayLog&) = delete;
+
+    // Appends one envelope, evicting oldest records as needed. Oversized
+    // records (larger than the ring) are dropped. Returns false on drop.
+    bool append(const void* data, size_t size);
+
+    // Visits records oldest to newest; the pointer is valid only for the
+    // duration of the callback.
+    void forEach(const std::function<void(const void* data, size_t size)>& visit);
+
+    size_t recordCount() const;
+
+private:
+    ReplayLog() = default;
+
+    struct Header;
+
+    Header* header() const;
+    uint8_t* data() const;
+    void evictOldest();
+
+    mutable std::mutex mutex_;
+    void* map_ = nullptr;
+    size_t mapSize_ = 0;
+    int fd_ = -1;
+};
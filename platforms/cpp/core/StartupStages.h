@@ -0,0 +1,80 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Staged startup with per-stage timing instrumentation.
+ *
+ * Cold boot used to bring every subsystem up serially before serving,
+ * which put ~4s between a watchdog restart and the first accepted
+ * command. The pattern now: run the stage that makes the process
+ * reachable (the TCP listener) blocking, hand the independent slow
+ * stages (GPIO, MQTT, persistence, UI adapters) to background threads,
+ * and join them before declaring full readiness. Every stage reports
+ * its wall time and outcome through the instrumentation hook, so a slow
+ * boot names its culprit in the log.
+ */
+class StartupStages {
+public:
+    // stage name, wall time, success
+    using Report = std::function<void(const std::string&, std::chrono::milliseconds, bool)>;
+
+    explicit StartupStages(Report report) : report_(std::move(report)) {}
+
+    ~StartupStages() { waitAll(); }
+
+    // Runs the stage inline; the caller depends on its completion
+    bool runBlocking(const std::string& name, const std::function<bool()>& stage) {
+        const bool ok = timed(name, stage);
+        if (!ok) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            all_ok_ = false;
+        }
+        return ok;
+    }
+
+    // Launches the stage on a background thread; outcome lands in
+    // waitAll(). Stages must not depend on each other.
+    void runDeferred(const std::string& name, std::function<bool()> stage) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers_.emplace_back([this, name, stage = std::move(stage)] {
+            if (!timed(name, stage)) {
+                std::lock_guard<std::mutex> inner(mutex_);
+                all_ok_ = false;
+            }
+        });
+    }
+
+    // Joins all deferred stages; true when every stage so far succeeded
+    bool waitAll() {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            workers.swap(workers_);
+        }
+        for (std::thread& w : workers) {
+            if (w.joinable()) w.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return all_ok_;
+    }
+
+private:
+    bool timed(const std::string& name, const std::function<bool()>& stage) {
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = stage();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (report_) report_(name, elapsed, ok);
+        return ok;
+    }
+
+    Report report_;
+    std::mutex mutex_;
+    std::vector<std::thread> workers_;
+    bool all_ok_ = true;
+};
@@ -0,0 +1,77 @@
+#include "StatusMulticast.h"
+#include "webgrab_generated.h"
+#include <arpa/inet.h>
+#include <cstring>
+
+StatusMulticast& StatusMulticast::instance() {
+    static StatusMulticast hub;
+    return hub;
+}
+
+void StatusMulticast::subscribe(uint32_t sessionId, std::shared_ptr<IWriter> sink) {
+    if (!sink) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_[sessionId].sinks.push_back(std::move(sink));
+}
+
+void StatusMulticast::unsubscribe(uint32_t sessionId, const IWriter* sink) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = topics_.find(sessionId);
+    if (it == topics_.end()) return;
+    auto& sinks = it->second.sinks;
+    for (auto sit = sinks.begin(); sit != sinks.end();) {
+        auto live = sit->lock();
+        if (!live || live.get() == sink) {
+            sit = sinks.erase(sit);
+        } else {
+            ++sit;
+        }
+    }
+}
+
+uint64_t StatusMulticast::publish(uint32_t sessionId, const std::string& status) {
+    // Stamp the sequence and pin the live subscribers under the lock;
+    // serialization and the writes happen outside it. Per-session
+    // updates come from a single engine thread, so frames leave in seq
+    // order.
+    std::vector<std::shared_ptr<IWriter>> live;
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Topic& topic = topics_[sessionId];
+        seq = ++topic.nextSeq;
+        live.reserve(topic.sinks.size());
+        for (auto it = topic.sinks.begin(); it != topic.sinks.end();) {
+            if (auto sink = it->lock()) {
+                live.push_back(std::move(sink));
+                ++it;
+            } else {
+                it = topic.sinks.erase(it);
+            }
+        }
+    }
+    if (live.empty()) return seq;
+
+    // One serialization per update: the identical frame goes to every
+    // watcher. Framed with the same 4-byte network-order length prefix
+    // as FlatBuffersResponseWriter::sendResponse, so TCP subscribers
+    // parse it through the normal response path.
+    flatbuffers::FlatBufferBuilder builder(256);
+    auto status_str = builder.CreateString(status);
+    builder.Finish(webgrab::CreateDownloadStatusResponse(builder, status_str, sessionId, seq));
+
+    std::vector<uint8_t> frame(sizeof(uint32_t) + builder.GetSize());
+    uint32_t length = htonl(static_cast<uint32_t>(builder.GetSize()));
+    std::memcpy(frame.data(), &length, sizeof(length));
+    std::memcpy(frame.data() + sizeof(length), builder.GetBufferPointer(), builder.GetSize());
+
+    for (auto& sink : live) {
+        sink->write(frame.data(), frame.size());
+    }
+    return seq;
+}
+
+void StatusMulticast::closeSession(uint32_t sessionId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_.erase(sessionId);
+}
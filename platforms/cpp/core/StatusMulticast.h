@@ -0,0 +1,51 @@
+#pragma once
+#include "IWriter.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Per-session status multicast hub.
+ *
+ * Status updates used to be serialized once per watcher: every dashboard
+ * or MQTT subscriber interested in a session cost its own FlatBuffers
+ * build of the same DownloadStatusResponse. The hub instead serializes
+ * one buffer per update — stamped with the session id and a per-session
+ * monotonically increasing sequence number — and writes the identical
+ * length-prefixed frame to every subscriber. TCP response writers and
+ * the MQTT bridge subscribe alike, since both implement the raw IWriter
+ * byte interface. Serialization cost is O(1) per update regardless of
+ * watcher count, and a gap in seq tells a client it missed frames.
+ *
+ * Subscribers are held weakly: a disconnected writer drops off the topic
+ * on the next publish without an explicit unsubscribe.
+ */
+class StatusMulticast {
+public:
+    static StatusMulticast& instance();
+
+    void subscribe(uint32_t sessionId, std::shared_ptr<IWriter> sink);
+    void unsubscribe(uint32_t sessionId, const IWriter* sink);
+
+    // Serializes one frame for the update and writes it to every live
+    // subscriber of the session. Returns the stamped sequence number.
+    uint64_t publish(uint32_t sessionId, const std::string& status);
+
+    // Drops the session topic after its terminal update so the table
+    // does not grow with session ids.
+    void closeSession(uint32_t sessionId);
+
+private:
+    StatusMulticast() = default;
+
+    struct Topic {
+        uint64_t nextSeq = 0;
+        std::vector<std::weak_ptr<IWriter>> sinks;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<uint32_t, Topic> topics_;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+// Standard library includes
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace WebGrab {
+
+/**
+ * @brief Global string interning pool with stable uint32 ids
+ *
+ * Intent names and parameter keys are a small closed set ("play_music",
+ * "hardware_control", "device", ...) that used to be hashed and compared
+ * as std::string on every command. Interning maps each distinct string
+ * to a stable non-zero id once, after which the hot routing path
+ * compares integers. Lookups hash by string_view, so callers never
+ * materialize a std::string just to query the pool.
+ *
+ * Ids start at 1; 0 is reserved as "not interned" so default-initialized
+ * fields are distinguishable from real entries. Ids are never reused.
+ */
+class StringInterner {
+public:
+    static constexpr uint32_t kInvalidId = 0;
+
+    static StringInterner& instance() {
+        static StringInterner pool;
+        return pool;
+    }
+
+    /**
+     * @brief Return the id for str, registering it on first sight
+     *
+     * Read-mostly: the common case is a shared-lock hash probe; only a
+     * genuinely new string takes the exclusive lock.
+     */
+    uint32_t intern(std::string_view str) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = index.find(str);
+            if (it != index.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = index.find(str);
+        if (it != index.end()) {
+            return it->second;
+        }
+        storage.emplace_back(str);
+        uint32_t id = static_cast<uint32_t>(storage.size());
+        // The key views the deque-owned copy; deque never relocates it
+        index.emplace(std::string_view(storage.back()), id);
+        return id;
+    }
+
+    /**
+     * @brief Resolve an id back to its string; empty view for kInvalidId
+     */
+    std::string_view lookup(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (id == kInvalidId || id > storage.size()) {
+            return {};
+        }
+        return std::string_view(storage[id - 1]);
+    }
+
+private:
+    StringInterner() = default;
+
+    // Heterogeneous lookup: probe with string_view, no temporary string
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+    struct Equal {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const {
+            return a == b;
+        }
+    };
+
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> storage; // stable addresses back the index keys
+    std::unordered_map<std::string_view, uint32_t, Hash, Equal> index;
+};
+
+} // namespace WebGrab
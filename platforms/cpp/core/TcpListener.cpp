@@ -1,37 +1,121 @@
 #include "TcpListener.h"
 #include "TcpSocket.h"
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/un.h>
 #include <netinet/in.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <cstring>
 #include <iostream>
 
 TcpListener::TcpListener(uint16_t port) : listenfd_(-1), port_(port) {}
 
+TcpListener::TcpListener(const std::string& unixAddress) : listenfd_(-1), port_(0) {
+    if (unixAddress.rfind("unix:", 0) == 0) {
+        unixPath_ = unixAddress.substr(5);
+    } else {
+        unixPath_ = unixAddress;
+    }
+}
+
 TcpListener::~TcpListener() {
-    if (listenfd_ >= 0) {
-        close(listenfd_);
+    stop();
+    for (int fd : listenFds_) {
+        close(fd);
+    }
+    listenFds_.clear();
+    listenfd_ = -1;
+    if (!unixPath_.empty()) {
+        unlink(unixPath_.c_str());
     }
 }
 
-bool TcpListener::start() {
-    listenfd_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (listenfd_ < 0) return false;
+int TcpListener::createListenSocket(bool reuseport) {
+    if (!unixPath_.empty()) {
+        // SO_REUSEPORT has no meaning for AF_UNIX; a single socket serves
+        (void)reuseport;
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (unixPath_.size() >= sizeof(addr.sun_path)) {
+            close(fd);
+            return -1;
+        }
+        std::strncpy(addr.sun_path, unixPath_.c_str(), sizeof(addr.sun_path) - 1);
+
+        // Drop a stale socket file from a previous run
+        unlink(unixPath_.c_str());
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+
+        if (listen(fd, 128) < 0) {
+            close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    if (reuseport) {
+        int opt = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+            std::cerr << "SO_REUSEPORT not available: " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+    }
 
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = INADDR_ANY;
     addr.sin_port = htons(port_);
 
-    if (bind(listenfd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-        close(listenfd_);
-        return false;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
     }
 
-    if (listen(listenfd_, 10) < 0) {
-        close(listenfd_);
-        return false;
+    if (listen(fd, 128) < 0) {
+        close(fd);
+        return -1;
     }
 
+    return fd;
+}
+
+bool TcpListener::start() {
+    listenfd_ = createListenSocket(false);
+    if (listenfd_ < 0) return false;
+    listenFds_.push_back(listenfd_);
+    return true;
+}
+
+bool TcpListener::startMultiAcceptor(size_t numSockets) {
+    if (numSockets == 0) numSockets = 1;
+
+    for (size_t i = 0; i < numSockets; ++i) {
+        int fd = createListenSocket(true);
+        if (fd < 0) {
+            for (int open : listenFds_) close(open);
+            listenFds_.clear();
+            return false;
+        }
+        listenFds_.push_back(fd);
+    }
+
+    listenfd_ = listenFds_.front();
+    std::cout << "TcpListener opened " << numSockets
+              << " SO_REUSEPORT sockets on port " << port_ << std::endl;
     return true;
 }
 
@@ -43,4 +127,165 @@ std::unique_ptr<TcpSocket> TcpListener::accept() {
 
     // Create TcpSocket from accepted file descriptor
     return std::make_unique<TcpSocket>(clientfd);
-}
\ No newline at end of file
+}
+
+bool TcpListener::startEventLoop(size_t numThreads, ClientReadyHandler onReady,
+                                 ClientClosedHandler onClosed) {
+    if (listenfd_ < 0 || eventLoopRunning_.load()) return false;
+
+    epollfd_ = epoll_create1(0);
+    if (epollfd_ < 0) {
+        std::cerr << "epoll_create1 failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Non-blocking listen fds so acceptPending can drain each backlog.
+    // EPOLLONESHOT on them too: exactly one pool thread accepts per
+    // socket, then re-arms, avoiding a thundering herd per connection.
+    for (int fd : listenFds_) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(epollfd_);
+            epollfd_ = -1;
+            return false;
+        }
+    }
+
+    onReady_ = std::move(onReady);
+    onClosed_ = std::move(onClosed);
+    eventLoopRunning_.store(true);
+
+    if (numThreads == 0) numThreads = 1;
+    eventThreads_.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        eventThreads_.emplace_back(&TcpListener::eventLoop, this);
+    }
+
+    std::cout << "TcpListener event loop started with " << numThreads
+              << " threads on port " << port_ << std::endl;
+    return true;
+}
+
+void TcpListener::stop() {
+    if (!eventLoopRunning_.exchange(false)) {
+        return;
+    }
+
+    for (std::thread& t : eventThreads_) {
+        if (t.joinable()) t.join();
+    }
+    eventThreads_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connections_.clear();
+    }
+
+    if (epollfd_ >= 0) {
+        close(epollfd_);
+        epollfd_ = -1;
+    }
+}
+
+bool TcpListener::isListenFd(int fd) const {
+    for (int listenFd : listenFds_) {
+        if (fd == listenFd) return true;
+    }
+    return false;
+}
+
+void TcpListener::acceptPending(int listenfd) {
+    for (;;) {
+        // Peer address is unused; nullptr works for both AF_INET and AF_UNIX
+        int clientfd = ::accept(listenfd, nullptr, nullptr);
+        if (clientfd < 0) break; // EAGAIN: backlog drained
+        auto client = std::make_unique<TcpSocket>(clientfd);
+
+        int fd = client->getFd();
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.fd = fd;
+
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex_);
+            connections_[fd] = std::move(client);
+        }
+
+        if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            std::cerr << "epoll_ctl ADD failed for client fd " << fd << std::endl;
+            closeConnection(fd);
+        }
+    }
+
+    // Re-arm this listen fd for the next connection burst
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.fd = listenfd;
+    epoll_ctl(epollfd_, EPOLL_CTL_MOD, listenfd, &ev);
+}
+
+void TcpListener::closeConnection(int fd) {
+    std::unique_ptr<TcpSocket> victim;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        auto it = connections_.find(fd);
+        if (it == connections_.end()) return;
+        victim = std::move(it->second);
+        connections_.erase(it);
+    }
+    // Closing the fd removes it from the epoll set automatically
+    if (onClosed_) {
+        onClosed_(*victim);
+    }
+}
+
+void TcpListener::eventLoop() {
+    constexpr int kMaxEvents = 64;
+    epoll_event events[kMaxEvents];
+
+    while (eventLoopRunning_.load()) {
+        int n = epoll_wait(epollfd_, events, kMaxEvents, 200);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "epoll_wait failed: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            if (isListenFd(fd)) {
+                acceptPending(fd);
+                continue;
+            }
+
+            if (events[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) {
+                closeConnection(fd);
+                continue;
+            }
+
+            TcpSocket* socket = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(connectionsMutex_);
+                auto it = connections_.find(fd);
+                if (it != connections_.end()) socket = it->second.get();
+            }
+            if (!socket) continue;
+
+            bool keepOpen = onReady_ && onReady_(*socket);
+            if (!keepOpen || !socket->isConnected()) {
+                closeConnection(fd);
+            } else {
+                // Re-arm for the next request on this connection
+                epoll_event ev{};
+                ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+                ev.data.fd = fd;
+                epoll_ctl(epollfd_, EPOLL_CTL_MOD, fd, &ev);
+            }
+        }
+    }
+}
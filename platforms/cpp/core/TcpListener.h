@@ -1,17 +1,65 @@
 #pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 class TcpSocket;
 
 class TcpListener {
 public:
+    // Invoked from an event-loop thread when a client socket is readable.
+    // Return false to close the connection.
+    using ClientReadyHandler = std::function<bool(TcpSocket&)>;
+    // Invoked when a connection is closed by either side.
+    using ClientClosedHandler = std::function<void(TcpSocket&)>;
+
     TcpListener(uint16_t port);
+    // Listens on an AF_UNIX stream socket instead of TCP; address has
+    // the form "unix:<path>". Same-host clients connecting with the
+    // matching TcpSocket address skip the loopback TCP stack.
+    explicit TcpListener(const std::string& unixAddress);
     ~TcpListener();
 
     bool start();
+
+    // Multi-acceptor mode: opens numSockets SO_REUSEPORT listening
+    // sockets on the same port so the kernel load-balances incoming
+    // connections across them (one per event-loop thread), instead of
+    // funneling a reconnect storm through a single backlog.
+    bool startMultiAcceptor(size_t numSockets);
+
     std::unique_ptr<TcpSocket> accept();
 
+    // epoll event loop: multiplexes all accepted client sockets on a small
+    // fixed thread pool instead of one thread per connection. EPOLLONESHOT
+    // guarantees a connection is handled by one pool thread at a time.
+    bool startEventLoop(size_t numThreads, ClientReadyHandler onReady,
+                        ClientClosedHandler onClosed = nullptr);
+    void stop();
+
 private:
-    int listenfd_;
+    int listenfd_;               // primary listening socket (listenFds_[0])
+    std::vector<int> listenFds_; // all listening sockets
     uint16_t port_;
-};
\ No newline at end of file
+    std::string unixPath_;       // non-empty for AF_UNIX listeners
+
+    // Event loop state
+    int epollfd_ = -1;
+    std::atomic<bool> eventLoopRunning_{false};
+    std::vector<std::thread> eventThreads_;
+    std::mutex connectionsMutex_;
+    std::unordered_map<int, std::unique_ptr<TcpSocket>> connections_;
+    ClientReadyHandler onReady_;
+    ClientClosedHandler onClosed_;
+
+    void eventLoop();
+    void acceptPending(int listenfd);
+    void closeConnection(int fd);
+    int createListenSocket(bool reuseport);
+    bool isListenFd(int fd) const;
+};
@@ -1,13 +1,23 @@
 #include "TcpSocket.h"
+#include "AllocAudit.h"
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/un.h>
+#include <algorithm>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <cerrno>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
 #include <iostream>
 
 TcpSocket::TcpSocket(const std::string& host, uint16_t port)
-    : sockfd_(-1), host_(host), port_(port), connected_(false) {}
+    : sockfd_(-1), host_(host), port_(port), connected_(false) {
+    if (host_.rfind("unix:", 0) == 0) {
+        unixPath_ = host_.substr(5);
+    }
+}
 
 TcpSocket::TcpSocket(int sockfd)
     : sockfd_(sockfd), host_(""), port_(0), connected_(sockfd >= 0) {}
@@ -17,6 +27,30 @@ TcpSocket::~TcpSocket() {
 }
 
 bool TcpSocket::connect() {
+    if (!unixPath_.empty()) {
+        sockfd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (sockfd_ < 0) return false;
+
+        sockaddr_un server_addr{};
+        server_addr.sun_family = AF_UNIX;
+        if (unixPath_.size() >= sizeof(server_addr.sun_path)) {
+            close(sockfd_);
+            sockfd_ = -1;
+            return false;
+        }
+        std::strncpy(server_addr.sun_path, unixPath_.c_str(), sizeof(server_addr.sun_path) - 1);
+
+        if (::connect(sockfd_, reinterpret_cast<sockaddr*>(&server_addr), sizeof(server_addr)) < 0) {
+            close(sockfd_);
+            sockfd_ = -1;
+            return false;
+        }
+
+        connected_ = true;
+        applyPendingOptions();
+        return true;
+    }
+
     sockfd_ = socket(AF_INET, SOCK_STREAM, 0);
     if (sockfd_ < 0) return false;
 
@@ -33,9 +67,52 @@ bool TcpSocket::connect() {
     }
 
     connected_ = true;
+    applyPendingOptions();
     return true;
 }
 
+bool TcpSocket::setNoDelay(bool enable) {
+    noDelay_ = enable;
+    if (sockfd_ < 0) return true;  // remembered, applied on connect()
+    return setTcpOption(TCP_NODELAY, enable ? 1 : 0);
+}
+
+bool TcpSocket::setSendBufferSize(int bytes) {
+    sendBufferSize_ = bytes;
+    if (sockfd_ < 0) return true;  // remembered, applied on connect()
+    return setsockopt(sockfd_, SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes)) == 0;
+}
+
+bool TcpSocket::cork() {
+    return setTcpOption(TCP_CORK, 1);
+}
+
+bool TcpSocket::uncork() {
+    return setTcpOption(TCP_CORK, 0);
+}
+
+bool TcpSocket::setTcpOption(int option, int value) {
+    if (sockfd_ < 0) return false;
+    // AF_UNIX streams have no TCP layer; the options succeed as no-ops.
+    // Fds adopted from accept() may also be unix sockets, which surface
+    // as ENOPROTOOPT/EOPNOTSUPP from setsockopt and get the same pass.
+    if (!unixPath_.empty()) return true;
+    if (setsockopt(sockfd_, IPPROTO_TCP, option, &value, sizeof(value)) == 0) {
+        return true;
+    }
+    return errno == ENOPROTOOPT || errno == EOPNOTSUPP;
+}
+
+void TcpSocket::applyPendingOptions() {
+    if (noDelay_) {
+        setTcpOption(TCP_NODELAY, 1);
+    }
+    if (sendBufferSize_ > 0) {
+        setsockopt(sockfd_, SOL_SOCKET, SO_SNDBUF, &sendBufferSize_,
+                   sizeof(sendBufferSize_));
+    }
+}
+
 bool TcpSocket::isConnected() const {
     return connected_;
 }
@@ -48,12 +125,119 @@ void TcpSocket::disconnect() {
     connected_ = false;
 }
 
+void TcpSocket::shutdownNow() {
+    if (sockfd_ >= 0) {
+        ::shutdown(sockfd_, SHUT_RDWR);
+    }
+    connected_ = false;
+}
+
 bool TcpSocket::send(const void* data, size_t size) {
     if (!connected_) return false;
     return ::send(sockfd_, data, size, 0) == static_cast<ssize_t>(size);
 }
 
+bool TcpSocket::sendv(struct iovec* iov, int iovcnt) {
+    if (!connected_) return false;
+
+    while (iovcnt > 0) {
+        ssize_t bytes = ::writev(sockfd_, iov, iovcnt);
+        if (bytes <= 0) {
+            connected_ = false;
+            return false;
+        }
+
+        // Skip fully written segments; adjust a partially written one
+        size_t written = static_cast<size_t>(bytes);
+        while (iovcnt > 0 && written >= iov->iov_len) {
+            written -= iov->iov_len;
+            ++iov;
+            --iovcnt;
+        }
+        if (iovcnt > 0 && written > 0) {
+            iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + written;
+            iov->iov_len -= written;
+        }
+    }
+
+    return true;
+}
+
+bool TcpSocket::sendFile(int fd, off_t offset, size_t count) {
+    if (!connected_) return false;
+
+    size_t remaining = count;
+    while (remaining > 0) {
+        ssize_t bytes = ::sendfile(sockfd_, fd, &offset, remaining);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            // Fall back only when nothing has gone out yet and the
+            // kernel says this fd pair cannot sendfile (ESPIPE: source
+            // is not seekable); a mid-stream error is a real send
+            // failure
+            if (remaining == count &&
+                (errno == EINVAL || errno == ENOSYS || errno == ESPIPE)) {
+                break;
+            }
+            connected_ = false;
+            return false;
+        }
+        if (bytes == 0) {
+            // File shrank under us; the frame can no longer be completed
+            connected_ = false;
+            return false;
+        }
+        remaining -= static_cast<size_t>(bytes);
+    }
+    if (remaining == 0) return true;
+
+    // Buffered fallback: chunk through userspace and the ordinary send
+    // path. Non-seekable sources (ESPIPE) stream from their current
+    // position.
+    if (lseek(fd, offset, SEEK_SET) < 0 && errno != ESPIPE) {
+        return false;
+    }
+    std::vector<uint8_t> chunk(64 * 1024);
+    while (remaining > 0) {
+        ssize_t n = ::read(fd, chunk.data(), std::min(remaining, chunk.size()));
+        if (n <= 0) {
+            connected_ = false;
+            return false;
+        }
+        if (!send(chunk.data(), static_cast<size_t>(n))) return false;
+        remaining -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void TcpSocket::queueSend(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    sendQueue_.insert(sendQueue_.end(), bytes, bytes + size);
+}
+
+bool TcpSocket::flushQueued() {
+    if (!connected_) return false;
+    if (sendQueue_.empty()) return true;
+
+    size_t sent = 0;
+    while (sent < sendQueue_.size()) {
+        ssize_t bytes = ::send(sockfd_, sendQueue_.data() + sent,
+                               sendQueue_.size() - sent, 0);
+        if (bytes <= 0) {
+            connected_ = false;
+            sendQueue_.clear();
+            return false;
+        }
+        sent += bytes;
+    }
+
+    // Keep the capacity for the next batch
+    sendQueue_.clear();
+    return true;
+}
+
 bool TcpSocket::receive(std::vector<uint8_t>& buffer) {
+    AllocScope allocs(AllocTag::Networking);
     if (!connected_) return false;
     uint8_t temp[1024];
     ssize_t bytes = recv(sockfd_, temp, sizeof(temp), 0);
@@ -66,6 +250,7 @@ bool TcpSocket::receive(std::vector<uint8_t>& buffer) {
 }
 
 bool TcpSocket::receiveExact(std::vector<uint8_t>& buffer, size_t expectedSize) {
+    AllocScope allocs(AllocTag::Networking);
     if (buffer.size() < expectedSize) return false;
     size_t received = 0;
     while (received < expectedSize) {
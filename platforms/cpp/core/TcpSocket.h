@@ -1,10 +1,15 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
+#include <sys/uio.h>
 
 class TcpSocket {
 public:
+    // host may be an IPv4 address or "unix:<path>"; the latter connects
+    // over an AF_UNIX stream socket (port is ignored), which skips the
+    // loopback TCP stack for same-host modules
     TcpSocket(const std::string& host, uint16_t port);
     explicit TcpSocket(int sockfd);  // Constructor from existing file descriptor
     ~TcpSocket();
@@ -13,15 +18,65 @@ public:
     bool isConnected() const;
     void disconnect();
 
+    // Thread-safe abort: shuts down both directions so a send or recv
+    // blocked in another thread returns with an error, without closing
+    // the fd out from under it. The fd itself is released later by
+    // disconnect() or the destructor.
+    void shutdownNow();
+
     bool send(const void* data, size_t size);
+
+    // Scatter-gather send: transmits all iovec segments in order with
+    // writev, so a length prefix and a payload living in different
+    // buffers go out in one syscall without being concatenated first
+    bool sendv(struct iovec* iov, int iovcnt);
+
+    // Zero-copy file transmission: streams count bytes of fd from
+    // offset with sendfile(2), so pages move straight from the page
+    // cache to the socket and a large artifact never visits userspace.
+    // Falls back to a buffered read/send loop when the fd pair cannot
+    // sendfile at all (non-regular source, filesystem without support).
+    bool sendFile(int fd, off_t offset, size_t count);
+
+    // Batched submission mode for response streaming: queued frames
+    // accumulate in a userspace buffer and go out in a single syscall on
+    // flush, so a status storm of thousands of frames does not pay one
+    // write per frame. The queue buffer keeps its capacity across
+    // flushes.
+    void queueSend(const void* data, size_t size);
+    bool flushQueued();
+    size_t queuedBytes() const { return sendQueue_.size(); }
+
     bool receive(std::vector<uint8_t>& buffer);
     bool receiveExact(std::vector<uint8_t>& buffer, size_t expectedSize);
-    
+
+    // Socket options surface. Options set before connect() are remembered
+    // and applied once the fd exists; on AF_UNIX streams the TCP-level
+    // ones succeed as no-ops (there is no Nagle to disable there).
+    bool setNoDelay(bool enable);
+    bool setSendBufferSize(int bytes);
+
+    // Corks the socket around a multi-part write: cork, write the parts
+    // of one logical message, uncork to push them out as full segments.
+    // Guards against Nagle stalling between a length prefix and its
+    // payload when they go out in separate syscalls.
+    bool cork();
+    bool uncork();
+
     int getFd() const { return sockfd_; }  // For timeout operations
 
 private:
+    bool setTcpOption(int option, int value);
+    void applyPendingOptions();
+
     int sockfd_;
     std::string host_;
+    std::string unixPath_;  // non-empty when host_ was "unix:<path>"
     uint16_t port_;
-    bool connected_;
+    // Atomic: cleared by shutdownNow() or a failed send on one thread
+    // while another polls isConnected()
+    std::atomic<bool> connected_;
+    bool noDelay_ = false;
+    int sendBufferSize_ = 0;  // 0 = kernel default
+    std::vector<uint8_t> sendQueue_;
 };
\ No newline at end of file
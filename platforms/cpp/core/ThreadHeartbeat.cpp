@@ -0,0 +1,105 @@
+#include "ThreadHeartbeat.h"
+
+#include "Utils/TimerWheel.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+ThreadHeartbeat& ThreadHeartbeat::instance() {
+    static ThreadHeartbeat heartbeat;
+    return heartbeat;
+}
+
+ThreadHeartbeat::Counter& ThreadHeartbeat::registerThread(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_.emplace_back();
+    counters_.back().name = name;
+    return counters_.back();
+}
+
+bool ThreadHeartbeat::probe(std::string& detail) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool healthy = true;
+    for (Counter& counter : counters_) {
+        if (!counter.active.load(std::memory_order_acquire)) {
+            continue;
+        }
+        const uint64_t beats = counter.beats.load(std::memory_order_relaxed);
+        const bool advanced = beats != counter.lastProbed;
+        counter.lastProbed = beats;
+        if (!advanced && !counter.waiting.load(std::memory_order_acquire)) {
+            if (!healthy || !detail.empty()) detail += ", ";
+            detail += counter.name;
+            healthy = false;
+        }
+    }
+    return healthy;
+}
+
+void ThreadHeartbeat::startWatchdog() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (probeTimer_ != 0) {
+        return;
+    }
+    probeTimer_ = TinyMCP::Utils::TimerWheel::instance().scheduleEvery(
+        std::chrono::duration_cast<std::chrono::milliseconds>(kProbeInterval),
+        [this] { probeAndPet(); });
+}
+
+void ThreadHeartbeat::stopWatchdog() {
+    uint64_t timer = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer = probeTimer_;
+        probeTimer_ = 0;
+    }
+    if (timer != 0) {
+        TinyMCP::Utils::TimerWheel::instance().cancel(timer);
+    }
+}
+
+void ThreadHeartbeat::probeAndPet() {
+    std::string stalled;
+    if (probe(stalled)) {
+        petWatchdog();
+    } else {
+        // Deliberately not petting: if systemd's watchdog is armed it
+        // restarts us per WatchdogSec, which is the recovery we want
+        std::cerr << "ThreadHeartbeat: stalled thread(s): " << stalled
+                  << std::endl;
+    }
+}
+
+void ThreadHeartbeat::petWatchdog() {
+    // sd_notify's wire format, spoken directly so the Pi build carries
+    // no libsystemd: one datagram "WATCHDOG=1" to $NOTIFY_SOCKET
+    if (notifyFd_ == -2) {
+        notifyFd_ = -1;
+        const char* path = std::getenv("NOTIFY_SOCKET");
+        if (path && (path[0] == '/' || path[0] == '@')) {
+            notifyFd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (notifyFd_ >= 0) {
+                sockaddr_un addr{};
+                addr.sun_family = AF_UNIX;
+                std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+                if (addr.sun_path[0] == '@') {
+                    addr.sun_path[0] = '\0';  // abstract namespace
+                }
+                if (connect(notifyFd_, reinterpret_cast<sockaddr*>(&addr),
+                            sizeof(addr)) != 0) {
+                    close(notifyFd_);
+                    notifyFd_ = -1;
+                }
+            }
+        }
+    }
+    if (notifyFd_ >= 0) {
+        static const char kMessage[] = "WATCHDOG=1";
+        send(notifyFd_, kMessage, sizeof(kMessage) - 1, MSG_NOSIGNAL);
+    }
+}
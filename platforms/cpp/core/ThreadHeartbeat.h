@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Per-thread liveness counters with a systemd watchdog self-probe
+ *
+ * checkServiceHealth watches remote modules; nothing watched our own
+ * threads, so a wedged worker went unnoticed until users complained.
+ * Each long-lived loop (JobWorker workers, the accept loop, the MQTT
+ * drain) registers a counter and bumps it once per iteration — a single
+ * relaxed store, invisible on the hot path. A thread about to block
+ * indefinitely opens a WaitScope so parking on a condition variable or
+ * in accept() never reads as a stall.
+ *
+ * probe() passes when every active counter either advanced since the
+ * previous probe or is parked in a wait. startWatchdog() runs the probe
+ * on the shared TimerWheel every few seconds and, when it passes, pets
+ * the systemd watchdog (WATCHDOG=1 over $NOTIFY_SOCKET, spoken directly
+ * — no libsystemd). A wedged thread stops the petting and systemd
+ * restarts the process per WatchdogSec; without systemd the probe still
+ * logs the stalled thread by name.
+ */
+class ThreadHeartbeat {
+public:
+    struct Counter {
+        std::string name;
+        std::atomic<uint64_t> beats{0};
+        std::atomic<bool> waiting{false};
+        std::atomic<bool> active{true};
+        uint64_t lastProbed = 0;  // probe thread only
+
+        // One relaxed store; only the owning thread writes
+        void beat() {
+            beats.store(beats.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+        }
+    };
+
+    // Marks the thread as deliberately blocked (condition variable,
+    // accept) for the scope, so the probe does not flag it
+    class WaitScope {
+    public:
+        explicit WaitScope(Counter& counter) : counter_(counter) {
+            counter_.waiting.store(true, std::memory_order_release);
+        }
+        ~WaitScope() {
+            counter_.waiting.store(false, std::memory_order_release);
+        }
+        WaitScope(const WaitScope&) = delete;
+        WaitScope& operator=(const WaitScope&) = delete;
+
+    private:
+        Counter& counter_;
+    };
+
+    // Holds the registration for the thread's lifetime; the counter is
+    // excluded from probing once the loop returns
+    class Registration {
+    public:
+        explicit Registration(Counter& counter) : counter_(&counter) {}
+        ~Registration() {
+            if (counter_) counter_->active.store(false, std::memory_order_release);
+        }
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+
+        Counter& counter() { return *counter_; }
+
+    private:
+        Counter* counter_;
+    };
+
+    // Probe cadence; also how fast a stall is detected
+    static constexpr std::chrono::seconds kProbeInterval{5};
+
+    static ThreadHeartbeat& instance();
+
+    // Called once from the loop being watched, before it starts beating
+    Counter& registerThread(const std::string& name);
+
+    // True when every active thread advanced or is parked; on failure
+    // appends the stalled thread names to detail
+    bool probe(std::string& detail);
+
+    // Arms the periodic probe + watchdog pet on the TimerWheel;
+    // idempotent
+    void startWatchdog();
+    void stopWatchdog();
+
+private:
+    ThreadHeartbeat() = default;
+
+    void probeAndPet();
+    void petWatchdog();
+
+    std::mutex mutex_;
+    // Deque: counters never move, so threads beat without the lock
+    std::deque<Counter> counters_;
+    uint64_t probeTimer_ = 0;
+    int notifyFd_ = -2;  // -2 = not yet resolved, -1 = no NOTIFY_SOCKET
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace WebGrab {
+
+/**
+ * @brief Compiled MQTT topic-filter trie with + and # wildcard support
+ *
+ * Filters are split on '/' and inserted once; matching a topic walks
+ * the trie level by level instead of string-comparing every
+ * subscription's filter per message. '+' matches exactly one level,
+ * '#' matches the rest of the topic (including zero levels), per the
+ * MQTT 3.1.1 matching rules.
+ */
+class TopicTrie {
+public:
+    /**
+     * @brief Insert a filter and associate it with subscriber id
+     */
+    void addFilter(const std::string& filter, size_t subscriberId) {
+        Node* node = &root_;
+        size_t start = 0;
+        while (start <= filter.size()) {
+            size_t slash = filter.find('/', start);
+            std::string level = filter.substr(
+                start, slash == std::string::npos ? std::string::npos : slash - start);
+            if (level == "#") {
+                node->hashSubs.push_back(subscriberId);
+                return;
+            }
+            std::unique_ptr<Node>& child =
+                level == "+" ? node->plus : node->children[level];
+            if (!child) child = std::make_unique<Node>();
+            node = child.get();
+            if (slash == std::string::npos) break;
+            start = slash + 1;
+        }
+        node->subs.push_back(subscriberId);
+    }
+
+    /**
+     * @brief Invoke onMatch(subscriberId) for every filter the topic matches
+     */
+    void match(const std::string& topic,
+               const std::function<void(size_t)>& onMatch) const {
+        matchFrom(&root_, topic, 0, onMatch);
+    }
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> children;
+        std::unique_ptr<Node> plus;   // '+': any single level
+        std::vector<size_t> subs;     // filters terminating at this node
+        std::vector<size_t> hashSubs; // '#' filters rooted at this node
+    };
+
+    static void matchFrom(const Node* node, const std::string& topic, size_t start,
+                          const std::function<void(size_t)>& onMatch) {
+        // '#' at this level matches everything below, including nothing
+        for (size_t id : node->hashSubs) onMatch(id);
+
+        if (start > topic.size()) {
+            for (size_t id : node->subs) onMatch(id);
+            return;
+        }
+
+        size_t slash = topic.find('/', start);
+        std::string level = topic.substr(
+            start, slash == std::string::npos ? std::string::npos : slash - start);
+        size_t next = slash == std::string::npos ? topic.size() + 1 : slash + 1;
+
+        auto it = node->children.find(level);
+        if (it != node->children.end()) {
+            matchFrom(it->second.get(), topic, next, onMatch);
+        }
+        if (node->plus) {
+            matchFrom(node->plus.get(), topic, next, onMatch);
+        }
+    }
+
+    Node root_;
+};
+
+} // namespace WebGrab
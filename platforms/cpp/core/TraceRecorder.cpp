@@ -0,0 +1,74 @@
+#include "TraceRecorder.h"
+#include <iostream>
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::Ring& TraceRecorder::localRing() {
+    thread_local std::shared_ptr<Ring> ring = [this] {
+        auto r = std::make_shared<Ring>();
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        rings_.push_back(r);
+        return r;
+    }();
+    return *ring;
+}
+
+void TraceRecorder::record(const Record& rec) {
+    Ring& ring = localRing();
+    const uint64_t slot = ring.next.load(std::memory_order_relaxed);
+    ring.records[slot & (kRecordsPerThread - 1)] = rec;
+    // Release so a concurrent dump that observes the index also sees
+    // the record it covers
+    ring.next.store(slot + 1, std::memory_order_release);
+}
+
+void TraceRecorder::setLatencyTrigger(std::chrono::nanoseconds threshold) {
+    thresholdNs_.store(threshold.count(), std::memory_order_relaxed);
+}
+
+void TraceRecorder::maybeTrigger(const Record& rec) {
+    const int64_t threshold = thresholdNs_.load(std::memory_order_relaxed);
+    if (threshold <= 0 ||
+        rec.endNs - rec.startNs < static_cast<uint64_t>(threshold)) {
+        return;
+    }
+    // At most one automatic dump per second; a latency storm should not
+    // turn the recorder itself into the bottleneck
+    constexpr uint64_t kMinGapNs = 1'000'000'000;
+    uint64_t last = lastTriggerNs_.load(std::memory_order_relaxed);
+    const uint64_t now = nowNs();
+    if (now - last < kMinGapNs ||
+        !lastTriggerNs_.compare_exchange_strong(last, now,
+                                                std::memory_order_relaxed)) {
+        return;
+    }
+    std::cerr << "TraceRecorder: span '" << rec.name << "' took "
+              << (rec.endNs - rec.startNs) / 1000 << " us, dumping flight record"
+              << std::endl;
+    dump(std::cerr);
+}
+
+void TraceRecorder::dump(std::ostream& os) {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        rings = rings_;
+    }
+    size_t threadIndex = 0;
+    for (const auto& ring : rings) {
+        const uint64_t next = ring->next.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>(next, kRecordsPerThread);
+        os << "# thread " << threadIndex++ << " (" << count << " spans)\n";
+        for (uint64_t i = next - count; i < next; i++) {
+            // Copy: the owning thread may still be writing newer slots
+            const Record rec = ring->records[i & (kRecordsPerThread - 1)];
+            if (!rec.name) continue;
+            os << rec.name << " start=" << rec.startNs
+               << " dur_us=" << (rec.endNs - rec.startNs) / 1000 << "\n";
+        }
+    }
+    os.flush();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * Flight-recorder tracing for the command path.
+ *
+ * When p99 latency spikes there was no visibility into where the time
+ * went between accept and the response write. A TraceSpan is an RAII
+ * marker: construction and destruction take two monotonic timestamps
+ * and push one fixed-size record into the calling thread's lock-free
+ * ring. Rings are per thread and single-writer, so the hot path costs
+ * two clock reads and one array store — no locks, no allocation after
+ * the thread's first span.
+ *
+ * The recorder dumps on demand, or automatically (rate-limited) when a
+ * span exceeds the configured latency threshold, so the spike that
+ * triggered the dump is still in the rings when it is written out.
+ * Dump reads race the writers by design; a handful of torn records in
+ * a diagnostic dump is the accepted price for an unperturbed hot path.
+ *
+ * Span names must be string literals (the record stores the pointer).
+ */
+class TraceRecorder {
+public:
+    struct Record {
+        const char* name = nullptr;
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+    };
+
+    static constexpr size_t kRecordsPerThread = 1024;
+
+    static TraceRecorder& instance();
+
+    // Hot path: store into the caller's ring
+    void record(const Record& rec);
+
+    // A span running at least this long triggers an automatic dump to
+    // stderr, at most once per second; zero disables the trigger
+    void setLatencyTrigger(std::chrono::nanoseconds threshold);
+
+    // Writes every thread's surviving records, oldest first per thread
+    void dump(std::ostream& os);
+
+    void maybeTrigger(const Record& rec);
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    TraceRecorder() = default;
+
+    struct Ring {
+        std::array<Record, kRecordsPerThread> records;
+        std::atomic<uint64_t> next{0};
+    };
+
+    Ring& localRing();
+
+    std::mutex registryMutex_;
+    // shared_ptr keeps a ring dumpable after its thread exited
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::atomic<int64_t> thresholdNs_{0};
+    std::atomic<uint64_t> lastTriggerNs_{0};
+};
+
+// RAII span; see TraceRecorder
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name)
+        : name_(name), startNs_(TraceRecorder::nowNs()) {}
+
+    ~TraceSpan() {
+        TraceRecorder::Record rec{name_, startNs_, TraceRecorder::nowNs()};
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.record(rec);
+        recorder.maybeTrigger(rec);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    uint64_t startNs_;
+};
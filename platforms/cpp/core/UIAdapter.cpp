@@ -5,25 +5,39 @@
 #include <chrono>
 #include <cstdlib>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <thread>
 
 // System includes
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #include <cstring>
+#include <filesystem>
+
+// Third-party includes
+#include <openssl/evp.h>
+#include <zlib.h>
 
 namespace WebGrab {
 
 // VoiceUIAdapter implementation
-VoiceUIAdapter::VoiceUIAdapter() 
+VoiceUIAdapter::VoiceUIAdapter()
     : running(false)
     , audioInputDevice("default")
     , audioOutputDevice("default") {
 }
 
+VoiceUIAdapter::~VoiceUIAdapter() {
+    stop();
+}
+
 bool VoiceUIAdapter::initialize() {
     std::cout << "Initializing Voice UI Adapter..." << std::endl;
     
@@ -38,19 +52,43 @@ bool VoiceUIAdapter::start() {
     if (running) {
         return true;
     }
-    
+
     running = true;
-    
+
+    // Pipeline workers own the slow synthesis/transcription shells
+    ttsThread = std::thread(&VoiceUIAdapter::ttsLoop, this);
+    sttThread = std::thread(&VoiceUIAdapter::sttLoop, this);
+
     // Start audio processing thread
     std::thread audioThread(&VoiceUIAdapter::processAudioInput, this);
     audioThread.detach();
-    
+
     std::cout << "Voice UI Adapter started" << std::endl;
     return true;
 }
 
 void VoiceUIAdapter::stop() {
-    running = false;
+    if (!running.exchange(false)) {
+        return;
+    }
+    // Notify under each queue's mutex: the workers wait untimed on
+    // predicates over `running`, so a flip-and-notify landing in their
+    // predicate-check window would leave them parked and this join
+    // hanging
+    {
+        std::lock_guard<std::mutex> lock(ttsMutex);
+        ttsCv.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(sttMutex);
+        sttCv.notify_all();
+    }
+    if (ttsThread.joinable()) {
+        ttsThread.join();
+    }
+    if (sttThread.joinable()) {
+        sttThread.join();
+    }
     std::cout << "Voice UI Adapter stopped" << std::endl;
 }
 
@@ -78,11 +116,128 @@ void VoiceUIAdapter::processCommand(const std::string& command, const UIContext&
 
 bool VoiceUIAdapter::sendResponse(const UIResponse& response, const UIContext& context) {
     std::cout << "Voice response: " << response.content << std::endl;
-    
-    // In a real implementation, convert text to speech and play
-    bool ttsSuccess = convertTextToSpeech(response.content, "/tmp/response.wav");
-    
-    return ttsSuccess;
+
+    // A cached phrase plays straight from memory; everything else is
+    // handed to the synthesis worker so the voice loop never waits out
+    // an espeak run
+    if (playCachedAudio(response.content, "/tmp/response.wav")) {
+        return true;
+    }
+    return enqueueTextToSpeech(response.content, "/tmp/response.wav");
+}
+
+bool VoiceUIAdapter::enqueueTextToSpeech(std::string text, std::string outputFile) {
+    {
+        std::lock_guard<std::mutex> lock(ttsMutex);
+        if (ttsQueue.size() >= kQueueCapacity) {
+            // Stale speech is worse than dropped speech: keep the newest
+            ttsQueue.pop_front();
+        }
+        ttsQueue.push_back(TtsJob{std::move(text), std::move(outputFile)});
+    }
+    ttsCv.notify_one();
+    return true;
+}
+
+void VoiceUIAdapter::enqueueSpeechToText(std::string audioFile, UIContext context) {
+    {
+        std::lock_guard<std::mutex> lock(sttMutex);
+        if (sttQueue.size() >= kQueueCapacity) {
+            sttQueue.pop_front();
+        }
+        sttQueue.push_back(SttJob{std::move(audioFile), std::move(context)});
+    }
+    sttCv.notify_one();
+}
+
+void VoiceUIAdapter::ttsLoop() {
+    while (true) {
+        TtsJob job;
+        {
+            std::unique_lock<std::mutex> lock(ttsMutex);
+            ttsCv.wait(lock, [this] { return !ttsQueue.empty() || !running; });
+            if (!running) {
+                return;
+            }
+            job = std::move(ttsQueue.front());
+            ttsQueue.pop_front();
+        }
+
+        // The response may have been synthesized while this job queued
+        if (playCachedAudio(job.text, job.outputFile)) {
+            continue;
+        }
+        if (!convertTextToSpeech(job.text, job.outputFile)) {
+            continue;
+        }
+
+        // Keep the WAV so the next identical confirmation skips synthesis
+        std::ifstream in(job.outputFile, std::ios::binary);
+        if (in) {
+            std::string wav((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+            cacheAudio(job.text, std::move(wav));
+        }
+    }
+}
+
+void VoiceUIAdapter::sttLoop() {
+    while (true) {
+        SttJob job;
+        {
+            std::unique_lock<std::mutex> lock(sttMutex);
+            sttCv.wait(lock, [this] { return !sttQueue.empty() || !running; });
+            if (!running) {
+                return;
+            }
+            job = std::move(sttQueue.front());
+            sttQueue.pop_front();
+        }
+
+        std::string transcript = convertSpeechToText(job.audioFile);
+        if (!transcript.empty()) {
+            processCommand(transcript, job.context);
+        }
+    }
+}
+
+bool VoiceUIAdapter::playCachedAudio(const std::string& text, const std::string& outputFile) {
+    std::string wav;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = ttsIndex.find(text);
+        if (it == ttsIndex.end()) {
+            return false;
+        }
+        ttsLru.splice(ttsLru.begin(), ttsLru, it->second);
+        wav = it->second->second;
+    }
+
+    std::ofstream out(outputFile, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(wav.data(), static_cast<std::streamsize>(wav.size()));
+    return static_cast<bool>(out);
+}
+
+void VoiceUIAdapter::cacheAudio(const std::string& text, std::string wav) {
+    if (wav.empty() || wav.size() > kMaxCachedWavBytes) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = ttsIndex.find(text);
+    if (it != ttsIndex.end()) {
+        ttsLru.splice(ttsLru.begin(), ttsLru, it->second);
+        it->second->second = std::move(wav);
+        return;
+    }
+    ttsLru.emplace_front(text, std::move(wav));
+    ttsIndex[text] = ttsLru.begin();
+    if (ttsLru.size() > kTtsCacheCapacity) {
+        ttsIndex.erase(ttsLru.back().first);
+        ttsLru.pop_back();
+    }
 }
 
 void VoiceUIAdapter::processAudioInput() {
@@ -296,15 +451,27 @@ void TextUIAdapter::displayResponse(const std::string& response) {
 }
 
 // WebUIAdapter implementation
-WebUIAdapter::WebUIAdapter(uint16_t port) 
+WebUIAdapter::WebUIAdapter(uint16_t port, const std::string& webRoot)
     : httpPort(port)
     , running(false)
-    , httpServerSocket(-1) {
+    , httpServerSocket(-1)
+    , webRoot(webRoot) {
+}
+
+WebUIAdapter::~WebUIAdapter() {
+    if (running) {
+        stop();
+    }
+    for (auto& [addr, size] : assetMappings) {
+        munmap(addr, size);
+    }
 }
 
 bool WebUIAdapter::initialize() {
     std::cout << "Initializing Web UI Adapter on port " << httpPort << "..." << std::endl;
-    
+
+    loadStaticAssets();
+
     // Create server socket
     httpServerSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (httpServerSocket < 0) {
@@ -327,13 +494,13 @@ bool WebUIAdapter::initialize() {
         return false;
     }
     
-    if (listen(httpServerSocket, 10) < 0) {
+    if (listen(httpServerSocket, 128) < 0) {
         std::cerr << "Failed to listen on HTTP server socket" << std::endl;
         close(httpServerSocket);
         httpServerSocket = -1;
         return false;
     }
-    
+
     return true;
 }
 
@@ -349,10 +516,20 @@ bool WebUIAdapter::start() {
     }
     
     running = true;
-    
-    // Start HTTP server thread
+
+    // One epoll set per reactor; the acceptor thread only accepts
+    for (Reactor& reactor : reactors) {
+        reactor.epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (reactor.epollFd < 0) {
+            std::cerr << "Failed to create reactor epoll set" << std::endl;
+            running = false;
+            return false;
+        }
+        reactor.thread = std::thread(&WebUIAdapter::reactorLoop, this, std::ref(reactor));
+    }
+
     httpServerThread = std::thread(&WebUIAdapter::httpServerLoop, this);
-    
+
     std::cout << "Web UI Adapter started on port " << httpPort << std::endl;
     std::cout << "Web interface available at: http://localhost:" << httpPort << std::endl;
     
@@ -361,16 +538,33 @@ bool WebUIAdapter::start() {
 
 void WebUIAdapter::stop() {
     running = false;
-    
+
     if (httpServerSocket >= 0) {
         close(httpServerSocket);
         httpServerSocket = -1;
     }
-    
+
     if (httpServerThread.joinable()) {
         httpServerThread.join();
     }
-    
+
+    // Reactors notice running == false on their next epoll_wait timeout
+    for (Reactor& reactor : reactors) {
+        if (reactor.thread.joinable()) {
+            reactor.thread.join();
+        }
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        for (auto& [fd, conn] : reactor.connections) {
+            close(fd);
+        }
+        reactor.connections.clear();
+        if (reactor.epollFd >= 0) {
+            close(reactor.epollFd);
+            reactor.epollFd = -1;
+        }
+    }
+    activeConnections = 0;
+
     std::cout << "Web UI Adapter stopped" << std::endl;
 }
 
@@ -398,17 +592,403 @@ void WebUIAdapter::processCommand(const std::string& command, const UIContext& c
 
 bool WebUIAdapter::sendResponse(const UIResponse& response, const UIContext& context) {
     std::cout << "Web response to session " << context.sessionId << ": " << response.content << std::endl;
-    
-    // In a real implementation, send HTTP/WebSocket response
+
+    // Every connected dashboard shows the same state, so one publish
+    // fans the response out to all subscribers
+    broadcastResponse(response);
     return true;
 }
 
-void WebUIAdapter::handleHttpRequest(const std::string& path, const std::string& body, std::string& response) {
+std::string WebUIAdapter::serializeResponse(const UIResponse& response) {
+    std::ostringstream oss;
+    oss << "{\"success\": " << (response.success ? "true" : "false")
+        << ", \"contentType\": \"" << response.contentType << "\""
+        << ", \"content\": \"" << response.content << "\"";
+    for (const auto& [key, value] : response.metadata) {
+        oss << ", \"" << key << "\": \"" << value << "\"";
+    }
+    oss << "}";
+    return oss.str();
+}
+
+std::shared_ptr<const std::string> WebUIAdapter::makeBinaryFrame(const std::string& payload) {
+    // Server-to-client frame, unmasked: FIN + binary opcode, then the
+    // 7/16/64-bit payload length forms of RFC 6455
+    std::string frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(0x82));
+
+    size_t len = payload.size();
+    if (len < 126) {
+        frame.push_back(static_cast<char>(len));
+    } else if (len <= 0xFFFF) {
+        frame.push_back(126);
+        frame.push_back(static_cast<char>((len >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(len & 0xFF));
+    } else {
+        frame.push_back(127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((len >> shift) & 0xFF));
+        }
+    }
+
+    frame += payload;
+    return std::make_shared<const std::string>(std::move(frame));
+}
+
+void WebUIAdapter::registerWebSocketClient(const std::string& sessionId, int fd,
+                                           size_t reactorIndex) {
+    std::lock_guard<std::mutex> lock(webSocketMutex);
+    webSocketClients[sessionId] = WebSocketClient{fd, reactorIndex};
+}
+
+void WebUIAdapter::unregisterWebSocketClient(const std::string& sessionId) {
+    {
+        std::lock_guard<std::mutex> lock(webSocketMutex);
+        webSocketClients.erase(sessionId);
+    }
+    activeSessions.erase(sessionId);
+}
+
+void WebUIAdapter::broadcastResponse(const UIResponse& response) {
+    // Serialize and frame exactly once; ~40 subscribers share the one
+    // refcounted buffer instead of 40 serializations
+    std::shared_ptr<const std::string> frame = makeBinaryFrame(serializeResponse(response));
+
+    // Snapshot the roster first: closeConnection locks reactor.mutex and
+    // then webSocketMutex, so holding webSocketMutex across the reactor
+    // locks below would invert that order
+    std::vector<std::pair<size_t, int>> targets;
+    {
+        std::lock_guard<std::mutex> lock(webSocketMutex);
+        targets.reserve(webSocketClients.size());
+        for (const auto& [sessionId, client] : webSocketClients) {
+            targets.emplace_back(client.reactor, client.fd);
+        }
+    }
+
+    // Frames go through the connection's outbox, never straight to the
+    // socket: a direct send() can stop mid-frame on a non-blocking fd
+    // and the next write would interleave bytes into the stream,
+    // desynchronizing the client's frame parser for good. Arming
+    // EPOLLOUT hands the (partial-write-safe) flush to the owning
+    // reactor's flushOutbox.
+    for (const auto& [reactorIndex, fd] : targets) {
+        Reactor& reactor = reactors[reactorIndex];
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        auto it = reactor.connections.find(fd);
+        if (it == reactor.connections.end() || !it->second.isWebSocket) {
+            continue; // closed (and unregistered) since the snapshot
+        }
+        it->second.outbox += *frame;
+        epoll_event mod{};
+        mod.events = EPOLLIN | EPOLLOUT;
+        mod.data.fd = fd;
+        epoll_ctl(reactor.epollFd, EPOLL_CTL_MOD, fd, &mod);
+    }
+}
+
+namespace {
+
+/**
+ * @brief Build a framed HTTP/1.1 response; Content-Length makes
+ *        keep-alive and pipelining possible
+ */
+std::string makeHttpResponse(const char* status, const char* contentType,
+                             const std::string& body) {
+    std::ostringstream oss;
+    oss << "HTTP/1.1 " << status << "\r\n"
+        << "Content-Type: " << contentType << "\r\n"
+        << "Content-Length: " << body.size() << "\r\n"
+        << "Connection: keep-alive\r\n\r\n"
+        << body;
+    return oss.str();
+}
+
+bool headerValueIs(const std::string& headers, const char* name, const char* value) {
+    // Case-insensitive "Name: value" search, line by line
+    size_t pos = 0;
+    size_t nameLen = strlen(name);
+    while (pos < headers.size()) {
+        size_t eol = headers.find("\r\n", pos);
+        if (eol == std::string::npos) eol = headers.size();
+        if (eol - pos > nameLen && headers[pos + nameLen] == ':' &&
+            strncasecmp(headers.c_str() + pos, name, nameLen) == 0) {
+            size_t v = pos + nameLen + 1;
+            while (v < eol && headers[v] == ' ') ++v;
+            return strncasecmp(headers.c_str() + v, value, strlen(value)) == 0;
+        }
+        pos = eol + 2;
+    }
+    return false;
+}
+
+size_t contentLengthOf(const std::string& headers) {
+    size_t pos = 0;
+    while (pos < headers.size()) {
+        size_t eol = headers.find("\r\n", pos);
+        if (eol == std::string::npos) eol = headers.size();
+        if (eol - pos > 15 && strncasecmp(headers.c_str() + pos, "content-length:", 15) == 0) {
+            return static_cast<size_t>(strtoul(headers.c_str() + pos + 15, nullptr, 10));
+        }
+        pos = eol + 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Extract a header's trimmed value, or empty if absent
+ */
+std::string headerValueOf(const std::string& headers, const char* name) {
+    size_t pos = 0;
+    size_t nameLen = strlen(name);
+    while (pos < headers.size()) {
+        size_t eol = headers.find("\r\n", pos);
+        if (eol == std::string::npos) eol = headers.size();
+        if (eol - pos > nameLen && headers[pos + nameLen] == ':' &&
+            strncasecmp(headers.c_str() + pos, name, nameLen) == 0) {
+            size_t v = pos + nameLen + 1;
+            while (v < eol && headers[v] == ' ') ++v;
+            return headers.substr(v, eol - v);
+        }
+        pos = eol + 2;
+    }
+    return {};
+}
+
+/**
+ * @brief Build the 101 Switching Protocols reply for a WebSocket upgrade
+ *
+ * Sec-WebSocket-Accept is base64(SHA-1(key + RFC 6455 GUID)); SHA-1 is
+ * mandated by the RFC here, not a security choice, and OpenSSL already
+ * rides along via libcurl.
+ */
+std::string makeWebSocketAccept(const std::string& key) {
+    static const char kWebSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    std::string material = key + kWebSocketGuid;
+
+    unsigned char digest[20];
+    unsigned int digestLen = 0;
+    EVP_Digest(material.data(), material.size(), digest, &digestLen,
+               EVP_sha1(), nullptr);
+
+    char accept[29] = {}; // base64 of 20 bytes is 28 chars + NUL
+    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(accept), digest,
+                    static_cast<int>(digestLen));
+
+    return std::string("HTTP/1.1 101 Switching Protocols\r\n"
+                       "Upgrade: websocket\r\n"
+                       "Connection: Upgrade\r\n"
+                       "Sec-WebSocket-Accept: ") + accept + "\r\n\r\n";
+}
+
+const char* contentTypeForExtension(const std::string& ext) {
+    if (ext == ".html" || ext == ".htm") return "text/html";
+    if (ext == ".js") return "application/javascript";
+    if (ext == ".css") return "text/css";
+    if (ext == ".json") return "application/json";
+    if (ext == ".svg") return "image/svg+xml";
+    if (ext == ".png") return "image/png";
+    if (ext == ".jpg" || ext == ".jpeg") return "image/jpeg";
+    if (ext == ".ico") return "image/x-icon";
+    if (ext == ".txt") return "text/plain";
+    return nullptr;
+}
+
+/**
+ * @brief Content hash for ETags; FNV-1a 64 keeps the adapter free of a
+ *        crypto dependency and collisions only cost a full 200 reply
+ */
+std::string computeEtag(const char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    char buf[20];
+    snprintf(buf, sizeof(buf), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return buf;
+}
+
+/**
+ * @brief gzip-wrap a buffer; empty result when compression does not pay
+ */
+std::string gzipCompress(const char* data, size_t size) {
+    z_stream stream{};
+    // windowBits 15 + 16 selects the gzip wrapper
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return {};
+    }
+
+    std::string out;
+    out.resize(deflateBound(&stream, static_cast<uLong>(size)));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+
+    int rc = deflate(&stream, Z_FINISH);
+    size_t compressed = stream.total_out;
+    deflateEnd(&stream);
+
+    if (rc != Z_STREAM_END || compressed >= size) {
+        return {};
+    }
+    out.resize(compressed);
+    return out;
+}
+
+/**
+ * @brief One parsed request pulled off the front of a connection buffer
+ */
+struct ParsedHttpRequest {
+    std::string method;
+    std::string path;
+    std::string headers;
+    std::string body;
+    bool keepAlive = true;
+    size_t consumed = 0;   // bytes to drop from the buffer
+};
+
+/**
+ * @brief Parse the next complete request, if the buffer holds one
+ * @return false when more bytes are needed
+ */
+bool parseNextRequest(const std::string& buffer, ParsedHttpRequest& out) {
+    size_t headerEnd = buffer.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return false;
+    }
+
+    size_t bodyLen = contentLengthOf(buffer.substr(0, headerEnd));
+    if (buffer.size() < headerEnd + 4 + bodyLen) {
+        return false;
+    }
+
+    size_t methodEnd = buffer.find(' ');
+    size_t pathEnd = methodEnd == std::string::npos
+        ? std::string::npos : buffer.find(' ', methodEnd + 1);
+    if (pathEnd == std::string::npos || methodEnd > headerEnd) {
+        // Malformed request line; consume the block and let the caller
+        // answer with an error
+        out.consumed = headerEnd + 4 + bodyLen;
+        out.path.clear();
+        return true;
+    }
+
+    out.method = buffer.substr(0, methodEnd);
+    out.path = buffer.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    out.headers = buffer.substr(0, headerEnd);
+    out.body = buffer.substr(headerEnd + 4, bodyLen);
+    out.consumed = headerEnd + 4 + bodyLen;
+
+    // HTTP/1.1 defaults to keep-alive unless the client opts out
+    bool http10 = buffer.compare(pathEnd + 1, 8, "HTTP/1.0") == 0;
+    out.keepAlive = http10 ? headerValueIs(out.headers, "Connection", "keep-alive")
+                           : !headerValueIs(out.headers, "Connection", "close");
+    return true;
+}
+
+} // namespace
+
+void WebUIAdapter::loadStaticAssets() {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    if (!fs::is_directory(webRoot, ec)) {
+        std::cout << "No static asset directory at " << webRoot << std::endl;
+        return;
+    }
+
+    size_t totalBytes = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(webRoot, ec)) {
+        if (!entry.is_regular_file()) continue;
+
+        const char* contentType =
+            contentTypeForExtension(entry.path().extension().string());
+        if (!contentType) continue;
+
+        int fd = open(entry.path().c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            continue;
+        }
+
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size),
+                            PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps the file alive
+        if (mapped == MAP_FAILED) continue;
+
+        assetMappings.emplace_back(mapped, static_cast<size_t>(st.st_size));
+
+        StaticAsset asset;
+        asset.data = static_cast<const char*>(mapped);
+        asset.size = static_cast<size_t>(st.st_size);
+        asset.contentType = contentType;
+        asset.etag = computeEtag(asset.data, asset.size);
+        asset.gzip = gzipCompress(asset.data, asset.size);
+        totalBytes += asset.size;
+
+        std::string urlPath = "/" + fs::relative(entry.path(), webRoot, ec).generic_string();
+        // Directory indexes answer for the directory path too
+        if (entry.path().filename() == "index.html") {
+            std::string dirPath = urlPath.substr(0, urlPath.size() - strlen("index.html"));
+            staticAssets[dirPath] = asset;
+            if (dirPath.size() > 1) {
+                staticAssets[dirPath.substr(0, dirPath.size() - 1)] = asset;
+            }
+        }
+        staticAssets[urlPath] = std::move(asset);
+    }
+
+    std::cout << "Cached " << staticAssets.size() << " static asset routes ("
+              << totalBytes << " bytes mapped) from " << webRoot << std::endl;
+}
+
+void WebUIAdapter::handleHttpRequest(const std::string& path, const std::string& headers,
+                                     const std::string& body, std::string& response) {
+    // Static assets first: revalidations collapse to a string compare
+    auto assetIt = staticAssets.find(path);
+    if (assetIt != staticAssets.end()) {
+        const StaticAsset& asset = assetIt->second;
+
+        if (headerValueOf(headers, "If-None-Match") == asset.etag) {
+            response = "HTTP/1.1 304 Not Modified\r\nETag: " + asset.etag +
+                       "\r\nConnection: keep-alive\r\n\r\n";
+            return;
+        }
+
+        bool gzipped = !asset.gzip.empty() &&
+            headerValueOf(headers, "Accept-Encoding").find("gzip") != std::string::npos;
+        size_t bodySize = gzipped ? asset.gzip.size() : asset.size;
+
+        std::ostringstream oss;
+        oss << "HTTP/1.1 200 OK\r\n"
+            << "Content-Type: " << asset.contentType << "\r\n"
+            << "Content-Length: " << bodySize << "\r\n"
+            << "ETag: " << asset.etag << "\r\n";
+        if (gzipped) {
+            oss << "Content-Encoding: gzip\r\n";
+        }
+        oss << "Connection: keep-alive\r\n\r\n";
+        response = oss.str();
+        if (gzipped) {
+            response += asset.gzip;
+        } else {
+            response.append(asset.data, asset.size);
+        }
+        return;
+    }
+
     // Simple HTTP request handler
     if (path == "/" || path == "/index.html") {
-        response = "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\n"
+        response = makeHttpResponse("200 OK", "text/html",
                    "<html><body><h1>AI-SERVIS Web Interface</h1>"
-                   "<p>Voice command interface</p></body></html>";
+                   "<p>Voice command interface</p></body></html>");
     } else if (path == "/api/command" && !body.empty()) {
         // Process command via orchestrator
         UIContext context;
@@ -416,24 +996,42 @@ void WebUIAdapter::handleHttpRequest(const std::string& path, const std::string&
         context.sessionId = generateSessionId();
         context.interfaceType = "web";
         context.timestamp = std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
-        
+        activeSessions.put(context.sessionId, context);
+
         processCommand(body, context);
-        
-        response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n"
-                   R"({"status": "ok", "message": "Command processed"})";
+
+        response = makeHttpResponse("200 OK", "application/json",
+                   R"({"status": "ok", "message": "Command processed"})");
     } else if (path == "/api/status") {
-        response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n"
-                   R"({"status": "ok", "service": "ai-servis"})";
+        response = makeHttpResponse("200 OK", "application/json",
+                   R"({"status": "ok", "service": "ai-servis"})");
     } else {
-        response = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\n\r\nNot Found";
+        response = makeHttpResponse("404 Not Found", "text/plain", "Not Found");
     }
 }
 
 void WebUIAdapter::httpServerLoop() {
+    // Acceptor: epoll on the listen socket (with a timeout so stop() is
+    // honored), hand each connection to a reactor round-robin
+    int acceptEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (acceptEpoll < 0) {
+        std::cerr << "Failed to create acceptor epoll set" << std::endl;
+        return;
+    }
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = httpServerSocket;
+    epoll_ctl(acceptEpoll, EPOLL_CTL_ADD, httpServerSocket, &listenEvent);
+
     while (running && httpServerSocket >= 0) {
+        epoll_event event{};
+        int ready = epoll_wait(acceptEpoll, &event, 1, 500);
+        if (ready <= 0) {
+            continue;
+        }
+
         sockaddr_in clientAddr{};
         socklen_t clientAddrLen = sizeof(clientAddr);
-        
         int clientSocket = accept(httpServerSocket, reinterpret_cast<sockaddr*>(&clientAddr), &clientAddrLen);
         if (clientSocket < 0) {
             if (running) {
@@ -441,45 +1039,293 @@ void WebUIAdapter::httpServerLoop() {
             }
             continue;
         }
-        
-        // Handle request in a simple way (single-threaded for now)
-        char buffer[4096];
-        ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+
+        if (activeConnections.load() >= kMaxConnections) {
+            // Refuse above the cap rather than letting the reactors drown
+            std::string refusal = makeHttpResponse("503 Service Unavailable",
+                                                   "text/plain", "Server busy");
+            send(clientSocket, refusal.c_str(), refusal.size(), MSG_NOSIGNAL);
+            close(clientSocket);
+            continue;
+        }
+
+        fcntl(clientSocket, F_SETFL, fcntl(clientSocket, F_GETFL, 0) | O_NONBLOCK);
+
+        Reactor& reactor = reactors[nextReactor];
+        nextReactor = (nextReactor + 1) % kReactorThreads;
+
+        {
+            std::lock_guard<std::mutex> lock(reactor.mutex);
+            HttpConnection& conn = reactor.connections[clientSocket];
+            conn.fd = clientSocket;
+        }
+
+        epoll_event connEvent{};
+        connEvent.events = EPOLLIN;
+        connEvent.data.fd = clientSocket;
+        if (epoll_ctl(reactor.epollFd, EPOLL_CTL_ADD, clientSocket, &connEvent) != 0) {
+            std::lock_guard<std::mutex> lock(reactor.mutex);
+            reactor.connections.erase(clientSocket);
+            close(clientSocket);
+            continue;
+        }
+        activeConnections.fetch_add(1);
+    }
+
+    close(acceptEpoll);
+}
+
+void WebUIAdapter::reactorLoop(Reactor& reactor) {
+    std::array<epoll_event, 64> events;
+
+    while (running) {
+        int ready = epoll_wait(reactor.epollFd, events.data(),
+                               static_cast<int>(events.size()), 500);
+        if (ready <= 0) {
+            continue;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            // WebSocket commands collected during the read are dispatched
+            // only after the reactor lock is released: the orchestrator
+            // path ends in broadcastResponse, which needs this same mutex
+            std::vector<std::pair<std::string, std::string>> wsMessages;
+            {
+                std::lock_guard<std::mutex> lock(reactor.mutex);
+                handleReactorEvent(reactor, events[i].data.fd, events[i].events, wsMessages);
+            }
+            for (const auto& [sessionId, message] : wsMessages) {
+                handleWebSocketMessage(sessionId, message);
+            }
+        }
+    }
+}
+
+void WebUIAdapter::handleReactorEvent(Reactor& reactor, int fd, uint32_t eventMask,
+                                      std::vector<std::pair<std::string, std::string>>& wsMessages) {
+    // Caller holds reactor.mutex
+    auto it = reactor.connections.find(fd);
+    if (it == reactor.connections.end()) {
+        return;
+    }
+    HttpConnection& conn = it->second;
+
+    if (eventMask & (EPOLLHUP | EPOLLERR)) {
+        closeConnection(reactor, fd);
+        return;
+    }
+    if (eventMask & EPOLLIN) {
+        handleReadable(reactor, conn, wsMessages);
+        if (reactor.connections.find(fd) == reactor.connections.end()) {
+            return; // closed during read
+        }
+    }
+    if ((eventMask & EPOLLOUT) || !conn.outbox.empty()) {
+        if (!flushOutbox(conn)) {
+            closeConnection(reactor, fd);
+            return;
+        }
+        // Track writability only while there is something to write
+        epoll_event mod{};
+        mod.events = conn.outbox.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+        mod.data.fd = fd;
+        epoll_ctl(reactor.epollFd, EPOLL_CTL_MOD, fd, &mod);
+        if (conn.outbox.empty() && conn.closeAfterWrite) {
+            closeConnection(reactor, fd);
+        }
+    }
+}
+
+void WebUIAdapter::handleReadable(Reactor& reactor, HttpConnection& conn,
+                                  std::vector<std::pair<std::string, std::string>>& wsMessages) {
+    char buffer[4096];
+    while (true) {
+        ssize_t bytesRead = recv(conn.fd, buffer, sizeof(buffer), 0);
         if (bytesRead > 0) {
-            buffer[bytesRead] = '\0';
-            std::string request(buffer);
-            
-            // Parse HTTP request (simplified)
-            std::string method, path, body;
-            size_t methodEnd = request.find(' ');
-            if (methodEnd != std::string::npos) {
-                method = request.substr(0, methodEnd);
-                size_t pathStart = methodEnd + 1;
-                size_t pathEnd = request.find(' ', pathStart);
-                if (pathEnd != std::string::npos) {
-                    path = request.substr(pathStart, pathEnd - pathStart);
+            conn.inbox.append(buffer, static_cast<size_t>(bytesRead));
+            if (conn.inbox.size() > kMaxRequestBytes) {
+                if (!conn.isWebSocket) {
+                    conn.outbox += makeHttpResponse("413 Payload Too Large",
+                                                    "text/plain", "Request too large");
                 }
+                conn.closeAfterWrite = true;
+                break;
             }
-            
-            // Extract body if present
-            size_t bodyStart = request.find("\r\n\r\n");
-            if (bodyStart != std::string::npos) {
-                body = request.substr(bodyStart + 4);
+            continue;
+        }
+        if (bytesRead == 0) {
+            // Peer closed; flush whatever is pending, then drop
+            conn.closeAfterWrite = true;
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        closeConnection(reactor, conn.fd);
+        return;
+    }
+
+    // Past the handshake the buffer holds RFC 6455 frames, not requests
+    if (conn.isWebSocket) {
+        drainWebSocketFrames(reactor, conn, wsMessages);
+        return;
+    }
+
+    // Drain every complete pipelined request already buffered; responses
+    // accumulate in the outbox and go out in one burst
+    ParsedHttpRequest request;
+    while (parseNextRequest(conn.inbox, request)) {
+        conn.inbox.erase(0, request.consumed);
+        if (request.path.empty()) {
+            conn.outbox += makeHttpResponse("400 Bad Request", "text/plain", "Bad Request");
+            conn.closeAfterWrite = true;
+            break;
+        }
+        if (headerValueIs(request.headers, "Upgrade", "websocket")) {
+            std::string key = headerValueOf(request.headers, "Sec-WebSocket-Key");
+            if (key.empty()) {
+                conn.outbox += makeHttpResponse("400 Bad Request", "text/plain",
+                                                "Missing Sec-WebSocket-Key");
+                conn.closeAfterWrite = true;
+                break;
             }
-            
-            std::string httpResponse;
-            handleHttpRequest(path, body, httpResponse);
-            
-            send(clientSocket, httpResponse.c_str(), httpResponse.length(), 0);
+            conn.outbox += makeWebSocketAccept(key);
+            conn.isWebSocket = true;
+            conn.sessionId = generateSessionId();
+            registerWebSocketClient(conn.sessionId, conn.fd,
+                                    static_cast<size_t>(&reactor - reactors.data()));
+            // Anything the client sent after the upgrade request is
+            // already WebSocket framing
+            drainWebSocketFrames(reactor, conn, wsMessages);
+            return;
+        }
+        std::string httpResponse;
+        handleHttpRequest(request.path, request.headers, request.body, httpResponse);
+        conn.outbox += httpResponse;
+        if (!request.keepAlive) {
+            conn.closeAfterWrite = true;
+            break;
         }
-        
-        close(clientSocket);
     }
 }
 
+void WebUIAdapter::drainWebSocketFrames(Reactor& reactor, HttpConnection& conn,
+                                        std::vector<std::pair<std::string, std::string>>& wsMessages) {
+    // Caller holds reactor.mutex. Client-to-server frames are masked per
+    // RFC 6455; unmask and hand complete text/binary payloads up as
+    // commands. Fragmented messages from the dashboard do not occur in
+    // practice, so continuation frames take the same dispatch path.
+    while (true) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(conn.inbox.data());
+        size_t avail = conn.inbox.size();
+        if (avail < 2) {
+            return;
+        }
+
+        uint8_t opcode = p[0] & 0x0F;
+        bool masked = (p[1] & 0x80) != 0;
+        uint64_t payloadLen = p[1] & 0x7F;
+        size_t headerLen = 2;
+        if (payloadLen == 126) {
+            if (avail < 4) return;
+            payloadLen = (static_cast<uint64_t>(p[2]) << 8) | p[3];
+            headerLen = 4;
+        } else if (payloadLen == 127) {
+            if (avail < 10) return;
+            payloadLen = 0;
+            for (int i = 0; i < 8; ++i) {
+                payloadLen = (payloadLen << 8) | p[2 + i];
+            }
+            headerLen = 10;
+        }
+
+        // An unmasked client frame is a protocol error (RFC 6455 §5.1)
+        // and an oversized one would let a client pin the inbox buffer
+        if (!masked || payloadLen > kMaxRequestBytes) {
+            closeConnection(reactor, conn.fd);
+            return; // conn is gone
+        }
+        if (avail < headerLen + 4 + payloadLen) {
+            return; // frame incomplete; EPOLLIN will bring the rest
+        }
+
+        const unsigned char* mask = p + headerLen;
+        std::string payload = conn.inbox.substr(headerLen + 4, static_cast<size_t>(payloadLen));
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(static_cast<unsigned char>(payload[i]) ^ mask[i % 4]);
+        }
+        conn.inbox.erase(0, headerLen + 4 + static_cast<size_t>(payloadLen));
+
+        switch (opcode) {
+            case 0x0: // continuation
+            case 0x1: // text
+            case 0x2: // binary
+                wsMessages.emplace_back(conn.sessionId, std::move(payload));
+                break;
+            case 0x8: // close: echo the close and flush out
+                conn.outbox += std::string("\x88\x00", 2);
+                conn.closeAfterWrite = true;
+                return;
+            case 0x9: // ping -> pong with the same payload (<= 125 bytes)
+                if (payload.size() <= 125) {
+                    conn.outbox += static_cast<char>(0x8A);
+                    conn.outbox += static_cast<char>(payload.size());
+                    conn.outbox += payload;
+                }
+                break;
+            default:  // pong / reserved opcodes: ignore
+                break;
+        }
+    }
+}
+
+bool WebUIAdapter::flushOutbox(HttpConnection& conn) {
+    while (!conn.outbox.empty()) {
+        ssize_t sent = send(conn.fd, conn.outbox.data(), conn.outbox.size(), MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn.outbox.erase(0, static_cast<size_t>(sent));
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true; // EPOLLOUT will resume the flush
+        }
+        return false;
+    }
+    return true;
+}
+
+void WebUIAdapter::closeConnection(Reactor& reactor, int fd) {
+    // Caller holds reactor.mutex
+    auto it = reactor.connections.find(fd);
+    if (it != reactor.connections.end() && it->second.isWebSocket) {
+        // Drop the broadcast registration so broadcastResponse stops
+        // queueing frames for a dead fd (lock order: reactor.mutex,
+        // then webSocketMutex — broadcastResponse never holds both)
+        unregisterWebSocketClient(it->second.sessionId);
+    }
+    epoll_ctl(reactor.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    reactor.connections.erase(fd);
+    activeConnections.fetch_sub(1);
+}
+
 void WebUIAdapter::handleWebSocketMessage(const std::string& sessionId, const std::string& message) {
-    // Placeholder for WebSocket message handling
     std::cout << "WebSocket message from " << sessionId << ": " << message << std::endl;
+
+    // Commands arriving over a socket run through the orchestrator like
+    // any other; the resulting UIResponse goes out once over the shared
+    // broadcast buffer rather than per-client. The session context is
+    // looked up in its shard so repeat messages keep their state.
+    UIContext context;
+    if (!activeSessions.get(sessionId, context)) {
+        context.userId = "web_user";
+        context.sessionId = sessionId;
+        context.interfaceType = "web";
+    }
+    context.timestamp = std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    activeSessions.put(sessionId, context);
+
+    processCommand(message, context);
 }
 
 std::string WebUIAdapter::generateSessionId() {
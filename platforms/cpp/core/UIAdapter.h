@@ -1,9 +1,20 @@
 #pragma once
 
+// Local includes
+#include "ContextManager.h" // ShardedContextCache
+
 // Standard library includes
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -24,14 +35,83 @@ struct UIContext {
     std::unordered_map<std::string, std::string> metadata;
 };
 
+/**
+ * @brief Fixed-capacity inline metadata for UIResponse
+ *
+ * Responses carry one or two short annotations ("timestamp",
+ * "voice_synthesized"), yet the old unordered_map paid bucket and node
+ * allocations for each. Entries now live in a flat inline array of
+ * kCapacity slots, looked up by linear scan; with short-string
+ * optimization covering the typical keys and values, building a
+ * response allocates nothing for metadata. Writes past capacity are
+ * dropped — capacity is sized well above anything the adapters emit.
+ */
+class ResponseMetadata {
+public:
+    static constexpr size_t kCapacity = 8;
+
+    struct Entry {
+        std::string key;
+        std::string value;
+    };
+
+    /**
+     * @brief Map-style write access: overwrites an existing key or
+     *        appends; a full table hands back a discard slot
+     */
+    std::string& operator[](std::string_view key) {
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].key == key) {
+                return entries[i].value;
+            }
+        }
+        if (count < kCapacity) {
+            entries[count].key = key;
+            return entries[count++].value;
+        }
+        discard.clear();
+        return discard;
+    }
+
+    std::string_view get(std::string_view key) const {
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].key == key) {
+                return entries[i].value;
+            }
+        }
+        return {};
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() {
+        for (size_t i = 0; i < count; ++i) {
+            entries[i] = Entry{};
+        }
+        count = 0;
+    }
+
+    const Entry* begin() const { return entries.data(); }
+    const Entry* end() const { return entries.data() + count; }
+
+private:
+    std::array<Entry, kCapacity> entries;
+    size_t count = 0;
+    std::string discard; // sink for writes past capacity
+};
+
 /**
  * @brief UI response format
+ *
+ * Cheap to construct on the stack and to move: content and contentType
+ * move as strings, metadata is inline. Pass by value and std::move when
+ * handing a response down the adapter chain.
  */
 struct UIResponse {
     std::string content;
     std::string contentType; // "text", "audio", "json", "html"
     bool success;
-    std::unordered_map<std::string, std::string> metadata;
+    ResponseMetadata metadata;
 };
 
 /**
@@ -80,12 +160,21 @@ protected:
 
 /**
  * @brief Voice interface adapter
+ *
+ * Synthesis and transcription shell out to espeak/vosk and take on the
+ * order of a second, so they run as pipeline stages on dedicated worker
+ * threads instead of inline: sendResponse and transcription requests
+ * enqueue onto bounded queues and return immediately, keeping the voice
+ * loop responsive for the next utterance. Synthesized audio for the
+ * fixed response phrases is kept in a small LRU keyed by exact text —
+ * a repeated confirmation replays from memory in milliseconds instead
+ * of re-running ~800ms of synthesis.
  */
 class VoiceUIAdapter : public IUIAdapter {
 public:
     VoiceUIAdapter();
-    ~VoiceUIAdapter() override = default;
-    
+    ~VoiceUIAdapter() override;
+
     bool initialize() override;
     bool start() override;
     void stop() override;
@@ -94,11 +183,53 @@ public:
     std::string getType() const override { return "voice"; }
 
 private:
-    bool running;
+    // Deeper queues would only add latency to stale speech; newest
+    // responses matter, so a full queue drops its oldest entry
+    static constexpr size_t kQueueCapacity = 16;
+    // Sized above the ~30 fixed response phrases the orchestrator emits
+    static constexpr size_t kTtsCacheCapacity = 32;
+    // Free-form responses (long track listings) would evict the short
+    // confirmations that make the cache pay; cap what one entry may hold
+    static constexpr size_t kMaxCachedWavBytes = 512 * 1024;
+
+    struct TtsJob {
+        std::string text;
+        std::string outputFile;
+    };
+    struct SttJob {
+        std::string audioFile;
+        UIContext context;
+    };
+
+    std::atomic<bool> running;
     std::string audioInputDevice;
     std::string audioOutputDevice;
-    
+
+    // TTS stage: sendResponse enqueues, ttsLoop synthesizes and caches
+    std::mutex ttsMutex;
+    std::condition_variable ttsCv;
+    std::deque<TtsJob> ttsQueue;
+    std::thread ttsThread;
+
+    // STT stage: transcripts feed processCommand off the capture path
+    std::mutex sttMutex;
+    std::condition_variable sttCv;
+    std::deque<SttJob> sttQueue;
+    std::thread sttThread;
+
+    // LRU of synthesized WAV bytes, most recent at the front
+    std::mutex cacheMutex;
+    std::list<std::pair<std::string, std::string>> ttsLru; // text -> wav
+    std::unordered_map<std::string,
+        std::list<std::pair<std::string, std::string>>::iterator> ttsIndex;
+
     void processAudioInput();
+    void ttsLoop();
+    void sttLoop();
+    bool enqueueTextToSpeech(std::string text, std::string outputFile);
+    void enqueueSpeechToText(std::string audioFile, UIContext context);
+    bool playCachedAudio(const std::string& text, const std::string& outputFile);
+    void cacheAudio(const std::string& text, std::string wav);
     bool convertTextToSpeech(const std::string& text, const std::string& outputFile);
     std::string convertSpeechToText(const std::string& audioFile);
 };
@@ -131,8 +262,9 @@ private:
  */
 class WebUIAdapter : public IUIAdapter {
 public:
-    WebUIAdapter(uint16_t port = 8080);
-    ~WebUIAdapter() override = default;
+    // webRoot is indexed into the in-memory asset cache at initialize()
+    WebUIAdapter(uint16_t port = 8080, const std::string& webRoot = "web");
+    ~WebUIAdapter() override;
     
     bool initialize() override;
     bool start() override;
@@ -143,14 +275,103 @@ public:
 
 private:
     uint16_t httpPort;
-    bool running;
+    std::atomic<bool> running;
     int httpServerSocket;
     std::thread httpServerThread;
-    std::unordered_map<std::string, UIContext> activeSessions;
-    
-    void handleHttpRequest(const std::string& path, const std::string& body, std::string& response);
+
+    // Session contexts, touched by every HTTP/WebSocket request across
+    // all reactor threads. Same treatment as the orchestrator's service
+    // registry: sessionIds hash to one of 16 independently locked
+    // shards (ShardedContextCache), so a lookup on one reactor never
+    // serializes the others, and the LRU cap keeps abandoned web
+    // sessions from accumulating.
+    ShardedContextCache<UIContext> activeSessions;
+
+    // epoll keep-alive server: httpServerLoop only accepts, handing each
+    // connection round-robin to one of kReactorThreads reactors. Every
+    // reactor runs its own epoll set over non-blocking sockets, keeps
+    // connections open across requests (HTTP/1.1 keep-alive) and parses
+    // pipelined requests straight out of the connection's input buffer,
+    // so the dashboard's polling UI stops paying connect+close per
+    // refresh. Connections beyond kMaxConnections are refused with 503.
+    static constexpr size_t kReactorThreads = 2;
+    static constexpr size_t kMaxConnections = 256;
+    static constexpr size_t kMaxRequestBytes = 64 * 1024;
+
+    struct HttpConnection {
+        int fd = -1;
+        std::string inbox;   // unparsed request bytes; may hold several
+                             // pipelined requests (or WebSocket frames
+                             // once upgraded)
+        std::string outbox;  // response bytes awaiting EPOLLOUT
+        bool closeAfterWrite = false;
+        bool isWebSocket = false;  // upgraded; inbox carries RFC 6455 frames
+        std::string sessionId;     // set on upgrade, keys webSocketClients
+    };
+
+    struct Reactor {
+        int epollFd = -1;
+        std::thread thread;
+        std::mutex mutex;    // acceptor inserts race the event loop
+        std::unordered_map<int, HttpConnection> connections;
+    };
+
+    std::array<Reactor, kReactorThreads> reactors;
+    std::atomic<size_t> activeConnections{0};
+    size_t nextReactor = 0;
+
+    // Static asset cache, built once at initialize(): every file under
+    // webRoot is mmapped read-only and kept mapped for the process
+    // lifetime, with its ETag and a gzip variant precomputed. Requests
+    // are then served from the hash table — a revalidation is a string
+    // compare answering 304, a full hit copies straight out of the
+    // mapping — and the SD card is never touched per request.
+    struct StaticAsset {
+        const char* data = nullptr; // mmapped, read-only
+        size_t size = 0;
+        std::string contentType;
+        std::string etag;
+        std::string gzip;           // precompressed; empty when not smaller
+    };
+    std::unordered_map<std::string, StaticAsset> staticAssets; // URL path -> asset
+    std::vector<std::pair<void*, size_t>> assetMappings;       // for munmap
+    std::string webRoot;
+
+    void loadStaticAssets();
+
+    // WebSocket broadcast: the orchestrator state that all dashboard
+    // clients subscribe to is serialized once per publish into a shared
+    // refcounted binary frame; the same buffer is then appended to every
+    // subscriber's outbox, so fan-out cost no longer scales with client
+    // count. The reactor index lets broadcastResponse find the owning
+    // connection without scanning every reactor.
+    struct WebSocketClient {
+        int fd = -1;
+        size_t reactor = 0;
+    };
+    std::unordered_map<std::string, WebSocketClient> webSocketClients; // sessionId -> client
+    std::mutex webSocketMutex;
+
+    void handleHttpRequest(const std::string& path, const std::string& headers,
+                           const std::string& body, std::string& response);
     void handleWebSocketMessage(const std::string& sessionId, const std::string& message);
+    void registerWebSocketClient(const std::string& sessionId, int fd, size_t reactorIndex);
+    void unregisterWebSocketClient(const std::string& sessionId);
+    void broadcastResponse(const UIResponse& response);
+    static std::shared_ptr<const std::string> makeBinaryFrame(const std::string& payload);
+    static std::string serializeResponse(const UIResponse& response);
     void httpServerLoop();
+    void reactorLoop(Reactor& reactor);
+    // wsMessages collects complete WebSocket commands for dispatch after
+    // the reactor lock is released (see handleReactorEvent)
+    void handleReactorEvent(Reactor& reactor, int fd, uint32_t events,
+                            std::vector<std::pair<std::string, std::string>>& wsMessages);
+    void handleReadable(Reactor& reactor, HttpConnection& conn,
+                        std::vector<std::pair<std::string, std::string>>& wsMessages);
+    void drainWebSocketFrames(Reactor& reactor, HttpConnection& conn,
+                              std::vector<std::pair<std::string, std::string>>& wsMessages);
+    bool flushOutbox(HttpConnection& conn);
+    void closeConnection(Reactor& reactor, int fd);
     std::string generateSessionId();
 };
 
@@ -0,0 +1,502 @@
+#include "AsyncDownloadEngine.hpp"
+#include "ContentCacheIndex.hpp"
+#include "HostResolverCache.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <string_view>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace TinyMCP {
+namespace Utils {
+
+AsyncDownloadEngine::AsyncDownloadEngine() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    multi_handle_ = curl_multi_init();
+    // Multiplex same-host transfers as HTTP/2 streams over one
+    // connection instead of opening a connection per transfer
+    curl_multi_setopt(multi_handle_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    running_.store(true);
+    event_thread_ = std::thread(&AsyncDownloadEngine::eventLoop, this);
+}
+
+AsyncDownloadEngine::~AsyncDownloadEngine() {
+    running_.store(false);
+    curl_multi_wakeup(multi_handle_);
+    if (event_thread_.joinable()) {
+        event_thread_.join();
+    }
+
+    // Fail anything still in flight so no callback is silently dropped
+    for (auto& [handle, transfer] : active_) {
+        curl_multi_remove_handle(multi_handle_, handle);
+        curl_easy_cleanup(handle);
+        if (transfer->resolve_list) curl_slist_free_all(transfer->resolve_list);
+        if (transfer->validator_headers) curl_slist_free_all(transfer->validator_headers);
+        if (transfer->output_fd >= 0) close(transfer->output_fd);
+        if (transfer->on_complete) {
+            transfer->on_complete(transfer->id, false, "Engine shut down");
+        }
+    }
+    for (auto& transfer : pending_) {
+        if (transfer->on_complete) {
+            transfer->on_complete(transfer->id, false, "Engine shut down");
+        }
+    }
+
+    curl_multi_cleanup(multi_handle_);
+    curl_global_cleanup();
+}
+
+AsyncDownloadEngine& AsyncDownloadEngine::instance() {
+    static AsyncDownloadEngine engine;
+    return engine;
+}
+
+uint64_t AsyncDownloadEngine::submit(const std::string& url, const std::string& output_path,
+                                     CompletionCallback on_complete,
+                                     DownloadPriority priority) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->id = next_transfer_id_.fetch_add(1);
+    transfer->url = url;
+    transfer->output_path = output_path;
+    transfer->on_complete = std::move(on_complete);
+    transfer->priority = priority;
+
+    uint64_t id = transfer->id;
+    {
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        pending_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_handle_);
+    return id;
+}
+
+std::vector<uint64_t> AsyncDownloadEngine::submitMany(
+    const std::vector<std::pair<std::string, std::string>>& transfers,
+    CompletionCallback on_complete, DownloadPriority priority) {
+    std::vector<uint64_t> ids;
+    ids.reserve(transfers.size());
+
+    std::vector<std::unique_ptr<Transfer>> batch;
+    batch.reserve(transfers.size());
+    for (const auto& [url, output_path] : transfers) {
+        auto transfer = std::make_unique<Transfer>();
+        transfer->id = next_transfer_id_.fetch_add(1);
+        transfer->url = url;
+        transfer->output_path = output_path;
+        transfer->on_complete = on_complete;
+        transfer->priority = priority;
+        ids.push_back(transfer->id);
+        batch.push_back(std::move(transfer));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        for (auto& transfer : batch) {
+            pending_.push_back(std::move(transfer));
+        }
+    }
+    curl_multi_wakeup(multi_handle_);
+    return ids;
+}
+
+bool AsyncDownloadEngine::abort(uint64_t transfer_id) {
+    std::lock_guard<std::mutex> lock(transfers_mutex_);
+    for (auto& [handle, transfer] : active_) {
+        if (transfer->id == transfer_id) {
+            transfer->abort_requested.store(true);
+            return true;
+        }
+    }
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        if ((*it)->id == transfer_id) {
+            if ((*it)->on_complete) {
+                (*it)->on_complete(transfer_id, false, "Aborted before start");
+            }
+            pending_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t AsyncDownloadEngine::activeTransfers() const {
+    std::lock_guard<std::mutex> lock(transfers_mutex_);
+    return active_.size() + pending_.size();
+}
+
+void AsyncDownloadEngine::setBandwidthBudget(curl_off_t bytes_per_sec) {
+    bandwidth_budget_.store(bytes_per_sec);
+    // Wake the event loop so caps adjust without waiting for traffic
+    curl_multi_wakeup(multi_handle_);
+}
+
+void AsyncDownloadEngine::rebalanceBandwidth() {
+    curl_off_t budget = bandwidth_budget_.load();
+
+    size_t interactive = 0;
+    size_t bulk = 0;
+    {
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        for (const auto& [handle, transfer] : active_) {
+            (transfer->priority == DownloadPriority::Interactive ? interactive : bulk)++;
+        }
+    }
+
+    // Interactive gets 80% of the budget, bulk the rest; either side
+    // takes the whole budget when the other is idle. budget == 0 means
+    // uncapped for everyone.
+    curl_off_t interactive_pool = bulk == 0 ? budget : (budget * 8) / 10;
+    curl_off_t bulk_pool = interactive == 0 ? budget : budget - interactive_pool;
+
+    std::lock_guard<std::mutex> lock(transfers_mutex_);
+    for (const auto& [handle, transfer] : active_) {
+        curl_off_t cap = 0;
+        if (budget > 0) {
+            cap = transfer->priority == DownloadPriority::Interactive
+                      ? interactive_pool / static_cast<curl_off_t>(interactive)
+                      : bulk_pool / static_cast<curl_off_t>(bulk);
+            if (cap <= 0) cap = 1;
+        }
+        // Takes effect as the transfer progresses; only the event
+        // thread touches active handles
+        curl_easy_setopt(handle, CURLOPT_MAX_RECV_SPEED_LARGE, cap);
+    }
+}
+
+size_t AsyncDownloadEngine::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    auto* transfer = static_cast<Transfer*>(userp);
+    size_t total_size = size * nmemb;
+    const char* data = static_cast<const char*>(contents);
+    size_t written = 0;
+    while (written < total_size) {
+        ssize_t n = write(transfer->output_fd, data + written, total_size - written);
+        if (n <= 0) return 0;
+        written += static_cast<size_t>(n);
+    }
+    return total_size;
+}
+
+size_t AsyncDownloadEngine::HeaderCallback(char* buffer, size_t size, size_t nitems,
+                                           void* userp) {
+    auto* transfer = static_cast<Transfer*>(userp);
+    size_t total = size * nitems;
+    std::string_view line(buffer, total);
+
+    auto has_prefix = [&line](std::string_view name) {
+        if (line.size() < name.size()) return false;
+        for (size_t i = 0; i < name.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(line[i])) != name[i]) return false;
+        }
+        return true;
+    };
+    auto value_after = [&line](size_t skip) {
+        std::string_view v = line.substr(skip);
+        while (!v.empty() && (v.front() == ':' || v.front() == ' ')) v.remove_prefix(1);
+        while (!v.empty() && (v.back() == '\r' || v.back() == '\n' || v.back() == ' ')) {
+            v.remove_suffix(1);
+        }
+        return std::string(v);
+    };
+
+    if (has_prefix("etag:")) {
+        transfer->response_etag = value_after(5);
+    } else if (has_prefix("last-modified:")) {
+        transfer->response_last_modified = value_after(14);
+    }
+    return total;
+}
+
+int AsyncDownloadEngine::ProgressCallback(void* clientp, curl_off_t, curl_off_t,
+                                          curl_off_t, curl_off_t) {
+    auto* transfer = static_cast<Transfer*>(clientp);
+    return transfer->abort_requested.load() ? 1 : 0;
+}
+
+void AsyncDownloadEngine::startPendingTransfers() {
+    std::vector<std::unique_ptr<Transfer>> to_start;
+    {
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+
+        // Refill the retry bucket, then pick what may start: fresh
+        // transfers always, retries only once their backoff elapsed and
+        // a token is available — so an outage recovery probes the link
+        // instead of stampeding it
+        auto now = std::chrono::steady_clock::now();
+        if (last_token_refill_.time_since_epoch().count() != 0) {
+            double elapsed = std::chrono::duration<double>(now - last_token_refill_).count();
+            retry_tokens_ = std::min(kRetryTokenBurst,
+                                     retry_tokens_ + elapsed * kRetryTokensPerSec);
+        }
+        last_token_refill_ = now;
+
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            Transfer& candidate = **it;
+            if (candidate.attempts > 0) {
+                if (now < candidate.not_before || retry_tokens_ < 1.0) {
+                    ++it;
+                    continue;
+                }
+                retry_tokens_ -= 1.0;
+            }
+            to_start.push_back(std::move(*it));
+            it = pending_.erase(it);
+        }
+    }
+
+    for (auto& transfer : to_start) {
+        // First attempt only: if the index holds validators for this
+        // URL and the cached artifact on disk still matches the
+        // recorded size, make the request conditional and write to a
+        // side file so a 304 never touches the artifact
+        if (transfer->attempts == 0) {
+            ContentCacheIndex::Entry cached;
+            if (ContentCacheIndex::instance().lookup(transfer->url, cached)) {
+                std::error_code ec;
+                auto on_disk = std::filesystem::file_size(cached.path, ec);
+                if (!ec && on_disk == cached.size) {
+                    transfer->cached_path = cached.path;
+                    if (!cached.etag.empty()) {
+                        transfer->validator_headers =
+                            curl_slist_append(transfer->validator_headers,
+                                              ("If-None-Match: " + cached.etag).c_str());
+                    }
+                    if (!cached.last_modified.empty()) {
+                        transfer->validator_headers = curl_slist_append(
+                            transfer->validator_headers,
+                            ("If-Modified-Since: " + cached.last_modified).c_str());
+                    }
+                }
+            }
+            transfer->write_path = transfer->cached_path.empty()
+                                       ? transfer->output_path
+                                       : transfer->output_path + ".new";
+        }
+
+        // A retry appends after the bytes already banked on disk; a
+        // fresh attempt (or a server that refused the range) truncates
+        const bool resuming = transfer->resume_offset > 0;
+        transfer->output_fd =
+            open(transfer->write_path.c_str(),
+                 O_WRONLY | O_CREAT | (resuming ? O_APPEND : O_TRUNC), 0644);
+        if (transfer->output_fd < 0) {
+            if (transfer->validator_headers) {
+                curl_slist_free_all(transfer->validator_headers);
+                transfer->validator_headers = nullptr;
+            }
+            if (transfer->on_complete) {
+                transfer->on_complete(transfer->id, false,
+                                      "Unable to open " + transfer->write_path);
+            }
+            continue;
+        }
+
+        CURL* handle = curl_easy_init();
+        if (!handle) {
+            close(transfer->output_fd);
+            if (transfer->validator_headers) {
+                curl_slist_free_all(transfer->validator_headers);
+                transfer->validator_headers = nullptr;
+            }
+            if (transfer->on_complete) {
+                transfer->on_complete(transfer->id, false, "curl_easy_init failed");
+            }
+            continue;
+        }
+
+        transfer->handle = handle;
+        curl_easy_setopt(handle, CURLOPT_URL, transfer->url.c_str());
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, transfer.get());
+        curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(handle, CURLOPT_XFERINFODATA, transfer.get());
+        curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        // Prefer HTTP/2 and wait for an in-progress connection to the
+        // same host rather than racing a new one: a 400-file sync rides
+        // a handful of multiplexed connections (falls back to 1.1
+        // against servers without h2)
+        curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer.get());
+        // Capture the response's ETag / Last-Modified for the index
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(handle, CURLOPT_HEADERDATA, transfer.get());
+        if (transfer->validator_headers) {
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, transfer->validator_headers);
+        }
+        if (resuming) {
+            curl_easy_setopt(handle, CURLOPT_RESUME_FROM_LARGE, transfer->resume_offset);
+        }
+
+        // Feed curl the shared resolver cache's address so a slow DNS
+        // server cannot stall the event thread mid-transfer; an unknown
+        // host falls back to curl's own resolver
+        CURLU* parsed = curl_url();
+        if (parsed &&
+            curl_url_set(parsed, CURLUPART_URL, transfer->url.c_str(), 0) == CURLUE_OK) {
+            char* host = nullptr;
+            char* port = nullptr;
+            curl_url_get(parsed, CURLUPART_HOST, &host, 0);
+            curl_url_get(parsed, CURLUPART_PORT, &port, CURLU_DEFAULT_PORT);
+            if (host && port) {
+                transfer->resolve_list = HostResolverCache::instance().resolveListFor(
+                    host, static_cast<uint16_t>(std::atoi(port)));
+                if (transfer->resolve_list) {
+                    curl_easy_setopt(handle, CURLOPT_RESOLVE, transfer->resolve_list);
+                }
+            }
+            curl_free(host);
+            curl_free(port);
+        }
+        if (parsed) curl_url_cleanup(parsed);
+
+        curl_multi_add_handle(multi_handle_, handle);
+
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        active_[handle] = std::move(transfer);
+    }
+}
+
+void AsyncDownloadEngine::finishTransfer(CURL* handle, CURLcode result) {
+    std::unique_ptr<Transfer> transfer;
+    {
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        auto it = active_.find(handle);
+        if (it == active_.end()) return;
+        transfer = std::move(it->second);
+        active_.erase(it);
+    }
+
+    curl_multi_remove_handle(multi_handle_, handle);
+    long response_code = 0;
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_cleanup(handle);
+    if (transfer->resolve_list) {
+        curl_slist_free_all(transfer->resolve_list);
+        transfer->resolve_list = nullptr;
+    }
+    if (transfer->validator_headers) {
+        curl_slist_free_all(transfer->validator_headers);
+        transfer->validator_headers = nullptr;
+    }
+    close(transfer->output_fd);
+    transfer->output_fd = -1;
+    transfer->handle = nullptr;
+
+    const bool aborted = transfer->abort_requested.load();
+    bool success = (result == CURLE_OK) && !aborted;
+
+    // Not modified: the cached artifact is current. Drop the empty side
+    // file and materialize the artifact at output_path — already there
+    // when the paths coincide, otherwise via hardlink with a copy
+    // fallback for cross-filesystem targets.
+    if (success && response_code == 304 && !transfer->cached_path.empty()) {
+        std::filesystem::remove(transfer->write_path);
+        bool materialized = true;
+        if (transfer->cached_path != transfer->output_path) {
+            std::error_code ec;
+            std::filesystem::remove(transfer->output_path, ec);
+            ec.clear();
+            std::filesystem::create_hard_link(transfer->cached_path,
+                                              transfer->output_path, ec);
+            if (ec) {
+                ec.clear();
+                std::filesystem::copy_file(transfer->cached_path, transfer->output_path,
+                                           std::filesystem::copy_options::overwrite_existing,
+                                           ec);
+            }
+            materialized = !ec;
+        }
+        if (transfer->on_complete) {
+            transfer->on_complete(transfer->id, materialized,
+                                  materialized ? "" : "Unable to materialize cached copy");
+        }
+        return;
+    }
+
+    // Transient failure with retries left: keep the bytes already on
+    // disk and re-queue with backoff, resuming from the file's current
+    // size. A server that refused the range restarts from zero.
+    if (!success && !aborted && transfer->attempts < kMaxRetries && running_.load()) {
+        ++transfer->attempts;
+        std::error_code ec;
+        auto banked = std::filesystem::file_size(transfer->write_path, ec);
+        transfer->resume_offset =
+            (ec || result == CURLE_RANGE_ERROR) ? 0 : static_cast<curl_off_t>(banked);
+        transfer->not_before =
+            std::chrono::steady_clock::now() +
+            std::chrono::seconds(1LL << (transfer->attempts - 1));
+        transfer->response_etag.clear();
+        transfer->response_last_modified.clear();
+        std::lock_guard<std::mutex> lock(transfers_mutex_);
+        pending_.push_back(std::move(transfer));
+        return;
+    }
+
+    // Fresh body written to a side file moves into place now that the
+    // 304 possibility is gone
+    if (success && transfer->write_path != transfer->output_path) {
+        std::error_code ec;
+        std::filesystem::rename(transfer->write_path, transfer->output_path, ec);
+        if (ec) success = false;
+    }
+
+    // Record the validators so the next restart can ask "still this
+    // one?" instead of re-downloading
+    if (success &&
+        (!transfer->response_etag.empty() || !transfer->response_last_modified.empty())) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(transfer->output_path, ec);
+        if (!ec) {
+            ContentCacheIndex::instance().update(
+                transfer->url, {transfer->response_etag, transfer->response_last_modified,
+                                transfer->output_path, size});
+        }
+    }
+
+    if (!success) {
+        std::filesystem::remove(transfer->write_path);
+    }
+    if (transfer->on_complete) {
+        std::string error = success ? "" : curl_easy_strerror(result);
+        transfer->on_complete(transfer->id, success, error);
+    }
+}
+
+void AsyncDownloadEngine::eventLoop() {
+    size_t last_active = 0;
+    while (running_.load()) {
+        startPendingTransfers();
+
+        // Rebalance per-handle caps whenever the active set changed
+        {
+            std::unique_lock<std::mutex> lock(transfers_mutex_);
+            size_t now_active = active_.size();
+            lock.unlock();
+            if (now_active != last_active) {
+                rebalanceBandwidth();
+                last_active = now_active;
+            }
+        }
+
+        int still_running = 0;
+        curl_multi_perform(multi_handle_, &still_running);
+
+        int msgs_in_queue = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi_handle_, &msgs_in_queue)) {
+            if (msg->msg == CURLMSG_DONE) {
+                finishTransfer(msg->easy_handle, msg->data.result);
+            }
+        }
+
+        int numfds = 0;
+        curl_multi_poll(multi_handle_, nullptr, 0, 1000, &numfds);
+    }
+}
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,144 @@
+#pragma once
+#include <string>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+#include <curl/curl.h>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Priority class for a transfer: interactive fetches (configs, small
+// assets a command is waiting on) must not be starved by bulk model
+// downloads sharing the link.
+enum class DownloadPriority : uint8_t {
+    Bulk = 0,
+    Interactive = 1,
+};
+
+// curl_multi based async download engine: one event thread drives any
+// number of in-flight easy handles, so a queued download no longer
+// occupies a JobWorker thread for the whole transfer. Callers submit a
+// transfer and receive a completion callback from the event thread.
+class AsyncDownloadEngine {
+public:
+    using CompletionCallback =
+        std::function<void(uint64_t transfer_id, bool success, const std::string& error)>;
+
+    AsyncDownloadEngine();
+    ~AsyncDownloadEngine();
+
+    // Non-copyable
+    AsyncDownloadEngine(const AsyncDownloadEngine&) = delete;
+    AsyncDownloadEngine& operator=(const AsyncDownloadEngine&) = delete;
+
+    // Process-wide engine shared by all download jobs
+    static AsyncDownloadEngine& instance();
+
+    // Queues a transfer; on_complete fires from the event thread exactly
+    // once. Returns a transfer id usable with abort().
+    uint64_t submit(const std::string& url, const std::string& output_path,
+                    CompletionCallback on_complete,
+                    DownloadPriority priority = DownloadPriority::Bulk);
+
+    // Batch submission for artifact sync: queues every (url, output
+    // path) pair under one lock and one event-thread wakeup, and
+    // on_complete fires once per transfer. Handles negotiate HTTP/2
+    // with CURLOPT_PIPEWAIT set, so same-host transfers multiplex as
+    // streams on one connection instead of opening one connection (and
+    // one TLS handshake) each. Returns the transfer ids in input order.
+    std::vector<uint64_t> submitMany(
+        const std::vector<std::pair<std::string, std::string>>& transfers,
+        CompletionCallback on_complete,
+        DownloadPriority priority = DownloadPriority::Bulk);
+
+    bool abort(uint64_t transfer_id);
+
+    size_t activeTransfers() const;
+
+    // Total receive budget in bytes/sec shared by all transfers; 0
+    // (the default) leaves every handle uncapped. With a budget set,
+    // interactive transfers split 80% of it and bulk transfers the
+    // remaining 20% — each side takes the whole budget when the other
+    // is idle. Shares are rebalanced via CURLOPT_MAX_RECV_SPEED_LARGE
+    // as transfers come and go.
+    void setBandwidthBudget(curl_off_t bytes_per_sec);
+
+private:
+    struct Transfer {
+        uint64_t id;
+        CURL* handle = nullptr;
+        int output_fd = -1;
+        // CURLOPT_RESOLVE entry from the shared HostResolverCache; must
+        // outlive the transfer, freed in finishTransfer
+        struct curl_slist* resolve_list = nullptr;
+        std::string url;
+        std::string output_path;
+        CompletionCallback on_complete;
+        DownloadPriority priority = DownloadPriority::Bulk;
+        std::atomic<bool> abort_requested{false};
+        // Retry state: a failed transfer re-enters pending_ with the
+        // bytes already on disk as the resume offset, and does not
+        // restart before not_before
+        int attempts = 0;
+        curl_off_t resume_offset = 0;
+        std::chrono::steady_clock::time_point not_before{};
+        // Conditional-request state from the ContentCacheIndex: the
+        // stored validators ride as If-None-Match / If-Modified-Since
+        // request headers, the response's validators are captured for
+        // the index, and a 304 short-circuits to cached_path. Writes
+        // land in write_path — a side file while a 304 is possible, so
+        // the cached artifact stays intact until the answer is known.
+        struct curl_slist* validator_headers = nullptr;
+        std::string cached_path;
+        std::string write_path;
+        std::string response_etag;
+        std::string response_last_modified;
+    };
+
+    // A transfer gets kMaxRetries resumed attempts with doubling
+    // backoff (1s, 2s, 4s, 8s) before its failure is reported
+    static constexpr int kMaxRetries = 4;
+    // Token bucket gating retry starts: during an outage every failed
+    // transfer wants to reconnect at once, and an unthrottled wave of
+    // attempts keeps the recovering link saturated. Refill 2/sec with a
+    // burst of 4 lets a handful probe while the rest wait their turn.
+    static constexpr double kRetryTokenBurst = 4.0;
+    static constexpr double kRetryTokensPerSec = 2.0;
+
+    CURLM* multi_handle_;
+    std::thread event_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> next_transfer_id_{1};
+
+    mutable std::mutex transfers_mutex_;
+    std::vector<std::unique_ptr<Transfer>> pending_;
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active_;
+
+    std::atomic<curl_off_t> bandwidth_budget_{0};
+
+    // Retry token bucket; touched only under transfers_mutex_ in
+    // startPendingTransfers
+    double retry_tokens_ = kRetryTokenBurst;
+    std::chrono::steady_clock::time_point last_token_refill_{};
+
+    void eventLoop();
+    void startPendingTransfers();
+    void finishTransfer(CURL* handle, CURLcode result);
+
+    // Event-thread only: recomputes each active handle's recv-speed cap
+    void rebalanceBandwidth();
+
+    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userp);
+    static int ProgressCallback(void* clientp, curl_off_t dltotal, curl_off_t dlnow,
+                                curl_off_t ultotal, curl_off_t ulnow);
+};
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,74 @@
+#include "ContentCacheIndex.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace TinyMCP {
+namespace Utils {
+
+ContentCacheIndex& ContentCacheIndex::instance() {
+    static ContentCacheIndex index;
+    return index;
+}
+
+void ContentCacheIndex::setIndexPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_path_ = path;
+    entries_.clear();
+    loaded_ = false;
+    loadLocked();
+}
+
+bool ContentCacheIndex::lookup(const std::string& url, Entry& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_) loadLocked();
+    auto it = entries_.find(url);
+    if (it == entries_.end()) return false;
+    if (it->second.etag.empty() && it->second.last_modified.empty()) return false;
+    out = it->second;
+    return true;
+}
+
+void ContentCacheIndex::update(const std::string& url, Entry entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_) loadLocked();
+    entries_[url] = std::move(entry);
+    persistLocked();
+}
+
+void ContentCacheIndex::loadLocked() {
+    loaded_ = true;
+    std::ifstream in(index_path_);
+    if (!in) return;
+
+    // One entry per line: url \t etag \t last_modified \t path \t size.
+    // Validators never contain tabs; a malformed line is just skipped.
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string url, sizeText;
+        Entry entry;
+        if (std::getline(fields, url, '\t') && std::getline(fields, entry.etag, '\t') &&
+            std::getline(fields, entry.last_modified, '\t') &&
+            std::getline(fields, entry.path, '\t') && std::getline(fields, sizeText)) {
+            entry.size = std::strtoull(sizeText.c_str(), nullptr, 10);
+            entries_[url] = std::move(entry);
+        }
+    }
+}
+
+void ContentCacheIndex::persistLocked() {
+    // Write-then-rename so a crash mid-write cannot truncate the index
+    const std::string temp = index_path_ + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out) return;
+        for (const auto& [url, entry] : entries_) {
+            out << url << '\t' << entry.etag << '\t' << entry.last_modified << '\t'
+                << entry.path << '\t' << entry.size << '\n';
+        }
+    }
+    std::rename(temp.c_str(), index_path_.c_str());
+}
+
+} // namespace Utils
+} // namespace TinyMCP
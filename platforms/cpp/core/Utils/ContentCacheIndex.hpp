@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Persistent index of downloaded artifacts keyed by URL, holding the
+// HTTP validators (ETag / Last-Modified) and the on-disk location and
+// size of the last successful download. The download engine consults
+// it to issue conditional requests: a 304 answer short-circuits to the
+// artifact already on disk, so a restart sync of unchanged config and
+// model files costs stat calls instead of transfers.
+//
+// The index survives restarts as a small TSV file, rewritten on each
+// update — entries are few (one per distinct URL) and updates happen
+// at download completion, off the hot path.
+class ContentCacheIndex {
+public:
+    struct Entry {
+        std::string etag;
+        std::string last_modified;
+        std::string path;
+        std::uintmax_t size = 0;
+    };
+
+    static ContentCacheIndex& instance();
+
+    // Overrides the on-disk index location (default download-cache.idx
+    // in the working directory) and reloads from it.
+    void setIndexPath(const std::string& path);
+
+    // True when the URL has an entry with at least one validator; the
+    // caller still has to verify the cached file is intact.
+    bool lookup(const std::string& url, Entry& out);
+
+    void update(const std::string& url, Entry entry);
+
+private:
+    ContentCacheIndex() = default;
+
+    void loadLocked();
+    void persistLocked();
+
+    std::mutex mutex_;
+    bool loaded_ = false;
+    std::string index_path_ = "download-cache.idx";
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,120 @@
+#include "HostResolverCache.hpp"
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <cstring>
+
+namespace TinyMCP {
+namespace Utils {
+
+HostResolverCache& HostResolverCache::instance() {
+    static HostResolverCache cache;
+    return cache;
+}
+
+HostResolverCache::HostResolverCache() {
+    refresher = std::thread(&HostResolverCache::refresherLoop, this);
+}
+
+HostResolverCache::~HostResolverCache() {
+    refreshQueue.requestShutdown();
+    if (refresher.joinable()) {
+        refresher.join();
+    }
+}
+
+std::string HostResolverCache::resolveNow(const std::string& host) {
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        return "";
+    }
+
+    char buffer[INET6_ADDRSTRLEN] = {0};
+    if (result->ai_family == AF_INET) {
+        auto* addr = reinterpret_cast<struct sockaddr_in*>(result->ai_addr);
+        inet_ntop(AF_INET, &addr->sin_addr, buffer, sizeof(buffer));
+    } else if (result->ai_family == AF_INET6) {
+        auto* addr = reinterpret_cast<struct sockaddr_in6*>(result->ai_addr);
+        inet_ntop(AF_INET6, &addr->sin6_addr, buffer, sizeof(buffer));
+    }
+    freeaddrinfo(result);
+    return buffer;
+}
+
+std::string HostResolverCache::resolve(const std::string& host) {
+    // Numeric literals need no cache entry
+    struct in_addr v4;
+    struct in6_addr v6;
+    if (inet_pton(AF_INET, host.c_str(), &v4) == 1 ||
+        inet_pton(AF_INET6, host.c_str(), &v6) == 1) {
+        return host;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::shared_lock<std::shared_mutex> lock(cacheMutex);
+        auto it = cache.find(host);
+        if (it != cache.end() && now < it->second.expiry) {
+            return it->second.address;
+        }
+    }
+
+    {
+        // Stale entry: hand out the old address immediately and let the
+        // refresher update it off the hot path
+        std::unique_lock<std::shared_mutex> lock(cacheMutex);
+        auto it = cache.find(host);
+        if (it != cache.end()) {
+            if (!it->second.refreshInFlight) {
+                it->second.refreshInFlight = true;
+                refreshQueue.push(host);
+            }
+            return it->second.address;
+        }
+    }
+
+    // First contact: nothing to serve stale, resolve here and now
+    std::string address = resolveNow(host);
+    if (!address.empty()) {
+        std::unique_lock<std::shared_mutex> lock(cacheMutex);
+        cache[host] = Entry{address, now + kEntryTtl, false};
+    }
+    return address;
+}
+
+struct curl_slist* HostResolverCache::resolveListFor(const std::string& host,
+                                                     uint16_t port) {
+    std::string address = resolve(host);
+    if (address.empty()) {
+        return nullptr;
+    }
+    std::string entry = host + ":" + std::to_string(port) + ":" + address;
+    return curl_slist_append(nullptr, entry.c_str());
+}
+
+void HostResolverCache::refresherLoop() {
+    std::string host;
+    while (refreshQueue.pop(host)) {
+        std::string address = resolveNow(host);
+        std::unique_lock<std::shared_mutex> lock(cacheMutex);
+        auto it = cache.find(host);
+        if (it == cache.end()) {
+            continue;
+        }
+        it->second.refreshInFlight = false;
+        if (!address.empty()) {
+            it->second.address = address;
+            it->second.expiry = std::chrono::steady_clock::now() + kEntryTtl;
+        }
+        // Resolution failure keeps serving the stale address: a DNS
+        // hiccup must not take down hosts we already know
+    }
+}
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,66 @@
+#pragma once
+#include "ThreadSafeQueue.hpp"
+#include <chrono>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <curl/curl.h>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Shared hostname cache for the download engine and the orchestrator's
+// HTTP client. Both used to resolve synchronously inside
+// curl_easy_perform, so a slow DNS server stalled voice commands for
+// the full resolver timeout. Here the hot path is a shared-lock map
+// read: a fresh entry is returned directly, a stale entry is returned
+// as-is while a background thread refreshes it (stale-while-refresh),
+// and only a never-seen host blocks on a real lookup. Callers feed the
+// cached address to curl via CURLOPT_RESOLVE so curl skips its own
+// resolver entirely.
+class HostResolverCache {
+public:
+    // getaddrinfo does not expose record TTLs, so entries age out on a
+    // fixed clock; refreshes are invisible to callers either way
+    static constexpr std::chrono::seconds kEntryTtl{60};
+
+    static HostResolverCache& instance();
+
+    ~HostResolverCache();
+
+    HostResolverCache(const HostResolverCache&) = delete;
+    HostResolverCache& operator=(const HostResolverCache&) = delete;
+
+    // Returns the cached address for host (numeric literals pass
+    // through untouched), or "" when the host has never resolved.
+    // Blocks only on first contact with a host.
+    std::string resolve(const std::string& host);
+
+    // "host:port:address" entry for CURLOPT_RESOLVE, or nullptr when
+    // the host is unknown (curl then resolves by itself). The caller
+    // owns the list and frees it after the transfer finishes.
+    struct curl_slist* resolveListFor(const std::string& host, uint16_t port);
+
+private:
+    struct Entry {
+        std::string address;
+        std::chrono::steady_clock::time_point expiry;
+        bool refreshInFlight = false;
+    };
+
+    HostResolverCache();
+
+    // Blocking getaddrinfo; returns "" on failure
+    static std::string resolveNow(const std::string& host);
+
+    void refresherLoop();
+
+    mutable std::shared_mutex cacheMutex;
+    std::unordered_map<std::string, Entry> cache;
+    ThreadSafeQueue<std::string> refreshQueue;
+    std::thread refresher;
+};
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -2,10 +2,192 @@
 #include <fstream>
 #include <filesystem>
 #include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <openssl/evp.h>
 
 namespace TinyMCP {
 namespace Utils {
 
+namespace {
+
+// Sink for range requests: writes each chunk at a fixed file offset so
+// parallel segments stitch into the preallocated output without seeking
+struct SegmentSink {
+    int fd;
+    off_t offset;
+};
+
+size_t WriteAtCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    auto* sink = static_cast<SegmentSink*>(userp);
+    size_t total_size = size * nmemb;
+    const char* data = static_cast<const char*>(contents);
+    size_t written = 0;
+    while (written < total_size) {
+        ssize_t n = pwrite(sink->fd, data + written, total_size - written,
+                           sink->offset + static_cast<off_t>(written));
+        if (n <= 0) return 0;
+        written += static_cast<size_t>(n);
+    }
+    sink->offset += static_cast<off_t>(total_size);
+    return total_size;
+}
+
+size_t DiscardCallback(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+// Output file for downloadFile: preallocates the full size once curl
+// has seen Content-Length (contiguous extents, no mid-download ENOSPC
+// surprises) and optionally writes through O_DIRECT with a 1MB aligned
+// staging buffer, keeping multi-GB artifacts out of the page cache.
+class FileSink {
+public:
+    static constexpr size_t kAlignment = 4096;
+    static constexpr size_t kStagingSize = 1 << 20;
+
+    ~FileSink() {
+        if (digest_) EVP_MD_CTX_free(digest_);
+        if (staging_) std::free(staging_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    // Fold the payload into a SHA-256 as it streams through; the hash
+    // is finalized in finish(), so verification costs no second read.
+    void enableChecksum() {
+        digest_ = EVP_MD_CTX_new();
+        if (digest_ && EVP_DigestInit_ex(digest_, EVP_sha256(), nullptr) != 1) {
+            EVP_MD_CTX_free(digest_);
+            digest_ = nullptr;
+        }
+    }
+
+    const std::string& sha256Hex() const { return sha256_hex_; }
+
+    bool open(const std::string& path, CURL* handle, bool direct_io) {
+        handle_ = handle;
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        if (direct_io) {
+            fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            if (fd_ >= 0) {
+                direct_ = true;
+                staging_ = static_cast<char*>(std::aligned_alloc(kAlignment, kStagingSize));
+                if (!staging_) direct_ = false;
+            }
+            // EINVAL etc.: filesystem refuses O_DIRECT, fall back
+        }
+        if (fd_ < 0) {
+            fd_ = ::open(path.c_str(), flags, 0644);
+        }
+        return fd_ >= 0;
+    }
+
+    // Resume path: keep the existing prefix and append the tail after
+    // it. O_DIRECT is skipped here — the resume offset is rarely
+    // block-aligned.
+    bool openForAppend(const std::string& path, CURL* handle) {
+        handle_ = handle;
+        fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND, 0644);
+        if (fd_ < 0) return false;
+        off_t end = lseek(fd_, 0, SEEK_END);
+        base_ = end < 0 ? 0 : end;
+        return true;
+    }
+
+    bool write(const char* data, size_t len) {
+        preallocateOnce();
+        total_ += len;
+        if (digest_) {
+            EVP_DigestUpdate(digest_, data, len);
+        }
+        if (!direct_ || !staging_) {
+            return writeAll(data, len);
+        }
+        while (len > 0) {
+            size_t room = kStagingSize - staged_;
+            size_t take = len < room ? len : room;
+            std::memcpy(staging_ + staged_, data, take);
+            staged_ += take;
+            data += take;
+            len -= take;
+            if (staged_ == kStagingSize) {
+                if (!writeAll(staging_, kStagingSize)) return false;
+                staged_ = 0;
+            }
+        }
+        return true;
+    }
+
+    // Flush the unaligned tail (with O_DIRECT dropped, since direct
+    // writes must be block-sized) and trim any preallocated excess.
+    bool finish() {
+        if (direct_ && staged_ > 0) {
+            int flags = fcntl(fd_, F_GETFL);
+            if (flags >= 0) fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+            if (!writeAll(staging_, staged_)) return false;
+            staged_ = 0;
+        }
+        if (digest_) {
+            unsigned char hash[EVP_MAX_MD_SIZE];
+            unsigned int hash_len = 0;
+            if (EVP_DigestFinal_ex(digest_, hash, &hash_len) == 1) {
+                static const char hex[] = "0123456789abcdef";
+                sha256_hex_.reserve(hash_len * 2);
+                for (unsigned int i = 0; i < hash_len; ++i) {
+                    sha256_hex_.push_back(hex[hash[i] >> 4]);
+                    sha256_hex_.push_back(hex[hash[i] & 0xf]);
+                }
+            }
+        }
+        return ftruncate(fd_, base_ + static_cast<off_t>(total_)) == 0;
+    }
+
+private:
+    void preallocateOnce() {
+        if (preallocated_) return;
+        preallocated_ = true;
+        // Headers are parsed before the first write callback, so the
+        // length is available from the easy handle here.
+        curl_off_t length = -1;
+        if (handle_ &&
+            curl_easy_getinfo(handle_, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK &&
+            length > 0) {
+            // base_ is 0 except when appending to a resumed download
+            if (fallocate(fd_, 0, base_, static_cast<off_t>(length)) != 0) {
+                // Not fatal: fall back to growing the file as we write
+            }
+        }
+    }
+
+    bool writeAll(const char* data, size_t len) {
+        while (len > 0) {
+            ssize_t n = ::write(fd_, data, len);
+            if (n <= 0) return false;
+            data += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    int fd_ = -1;
+    CURL* handle_ = nullptr;
+    off_t base_ = 0;   // bytes already on disk when appending
+    bool direct_ = false;
+    bool preallocated_ = false;
+    char* staging_ = nullptr;
+    size_t staged_ = 0;
+    size_t total_ = 0;
+    EVP_MD_CTX* digest_ = nullptr;
+    std::string sha256_hex_;
+};
+
+} // namespace
+
 HttpClient::HttpClient() {
     curl_global_init(CURL_GLOBAL_DEFAULT);
     curl_handle_ = curl_easy_init();
@@ -21,9 +203,11 @@ HttpClient::~HttpClient() {
 size_t HttpClient::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     if (!userp) return 0;
 
-    std::ofstream* file = static_cast<std::ofstream*>(userp);
+    auto* sink = static_cast<FileSink*>(userp);
     size_t total_size = size * nmemb;
-    file->write(static_cast<char*>(contents), total_size);
+    if (!sink->write(static_cast<const char*>(contents), total_size)) {
+        return 0;
+    }
     return total_size;
 }
 
@@ -36,11 +220,28 @@ int HttpClient::ProgressCallback(void* clientp, curl_off_t dltotal, curl_off_t d
     }
 
     if (client->progress_callback_ && dltotal > 0) {
+        const double percent = (double)dlnow / dltotal * 100.0;
+        const bool complete = (dlnow == dltotal);
+
+        // Coalesce: curl calls this on every data event, but the
+        // consumer only needs a visible change or a heartbeat
+        const auto now = std::chrono::steady_clock::now();
+        if (!complete &&
+            percent - client->last_emit_percent_ < client->progress_min_percent_delta_ &&
+            now - client->last_emit_time_ < client->progress_min_interval_) {
+            return 0;
+        }
+
         DownloadProgress progress;
         progress.total_bytes = static_cast<size_t>(dltotal);
         progress.downloaded_bytes = static_cast<size_t>(dlnow);
-        progress.progress_percent = (double)dlnow / dltotal * 100.0;
-        progress.is_complete = (dlnow == dltotal);
+        progress.progress_percent = percent;
+        progress.is_complete = complete;
+        progress.delta_bytes = static_cast<size_t>(dlnow) - client->last_emit_bytes_;
+
+        client->last_emit_percent_ = percent;
+        client->last_emit_bytes_ = static_cast<size_t>(dlnow);
+        client->last_emit_time_ = now;
 
         client->progress_callback_(progress);
     }
@@ -48,31 +249,199 @@ int HttpClient::ProgressCallback(void* clientp, curl_off_t dltotal, curl_off_t d
     return 0; // Continue
 }
 
+void HttpClient::resetProgressWindow() {
+    last_emit_percent_ = -1.0;
+    last_emit_bytes_ = 0;
+    last_emit_time_ = std::chrono::steady_clock::time_point{};
+}
+
 bool HttpClient::downloadFile(const std::string& url, const std::string& output_path) {
     if (!curl_handle_) return false;
 
     current_output_path_ = output_path;
     abort_requested_ = false;
+    resetProgressWindow();
 
-    std::ofstream file(output_path, std::ios::binary);
-    if (!file.is_open()) return false;
+    FileSink sink;
+    if (!sink.open(output_path, curl_handle_, direct_io_)) return false;
+    last_sha256_.clear();
+    if (checksum_enabled_) sink.enableChecksum();
 
     curl_easy_setopt(curl_handle_, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl_handle_, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &file);
-    curl_easy_setopt(curl_handle_, CURLOPT_PROGRESSFUNCTION, ProgressCallback);
-    curl_easy_setopt(curl_handle_, CURLOPT_PROGRESSDATA, this);
+    curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &sink);
+    // XFERINFO, not the legacy PROGRESSFUNCTION: the callback takes
+    // curl_off_t and the old option passes doubles, which fed it garbage
+    curl_easy_setopt(curl_handle_, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+    curl_easy_setopt(curl_handle_, CURLOPT_XFERINFODATA, this);
     curl_easy_setopt(curl_handle_, CURLOPT_NOPROGRESS, 0L);
     curl_easy_setopt(curl_handle_, CURLOPT_FOLLOWLOCATION, 1L);
 
     CURLcode res = curl_easy_perform(curl_handle_);
-    file.close();
 
-    if (res != CURLE_OK || abort_requested_) {
+    if (res != CURLE_OK || abort_requested_ || !sink.finish()) {
         std::filesystem::remove(output_path);
         return false;
     }
 
+    last_sha256_ = sink.sha256Hex();
+    if (progress_callback_ && (last_emit_percent_ < 100.0 || !last_sha256_.empty())) {
+        // Guaranteed completion notification: curl does not always fire
+        // a final progress event, and coalescing must never swallow the
+        // terminal update. Carries the in-flight checksum when enabled
+        // (the checksum is only known here, after the transfer).
+        DownloadProgress progress;
+        curl_off_t length = 0;
+        curl_easy_getinfo(curl_handle_, CURLINFO_SIZE_DOWNLOAD_T, &length);
+        progress.total_bytes = static_cast<size_t>(length);
+        progress.downloaded_bytes = progress.total_bytes;
+        progress.progress_percent = 100.0;
+        progress.is_complete = true;
+        progress.delta_bytes = progress.total_bytes - last_emit_bytes_;
+        progress.sha256_hex = last_sha256_;
+        last_emit_percent_ = 100.0;
+        last_emit_bytes_ = progress.total_bytes;
+        progress_callback_(progress);
+    }
+    return true;
+}
+
+bool HttpClient::downloadChunk(const std::string& url, const std::string& output_path,
+                               size_t start_byte, size_t chunk_size) {
+    if (!curl_handle_ || chunk_size == 0) return false;
+
+    int fd = open(output_path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    // The chunk bounds are known up front: preallocate its range so
+    // parallel chunk writers don't interleave extent allocations
+    if (fallocate(fd, 0, static_cast<off_t>(start_byte),
+                  static_cast<off_t>(chunk_size)) != 0) {
+        // Not fatal: the pwrite path grows the file as before
+    }
+
+    SegmentSink sink{fd, static_cast<off_t>(start_byte)};
+    std::string range = std::to_string(start_byte) + "-" +
+                        std::to_string(start_byte + chunk_size - 1);
+
+    curl_easy_setopt(curl_handle_, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl_handle_, CURLOPT_RANGE, range.c_str());
+    curl_easy_setopt(curl_handle_, CURLOPT_WRITEFUNCTION, WriteAtCallback);
+    curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &sink);
+    curl_easy_setopt(curl_handle_, CURLOPT_FOLLOWLOCATION, 1L);
+
+    CURLcode res = curl_easy_perform(curl_handle_);
+    curl_easy_setopt(curl_handle_, CURLOPT_RANGE, nullptr);
+    close(fd);
+
+    return res == CURLE_OK;
+}
+
+long long HttpClient::probeContentLength(const std::string& url, bool& accepts_ranges) {
+    accepts_ranges = false;
+    CURL* probe = curl_easy_init();
+    if (!probe) return -1;
+
+    curl_easy_setopt(probe, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(probe, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(probe, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(probe, CURLOPT_WRITEFUNCTION, DiscardCallback);
+
+    long long length = -1;
+    if (curl_easy_perform(probe) == CURLE_OK) {
+        curl_off_t content_length = -1;
+        curl_easy_getinfo(probe, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length);
+        length = static_cast<long long>(content_length);
+
+        // Cheap range support check: ask for the first byte and see if the
+        // server honours it with 206
+        curl_easy_setopt(probe, CURLOPT_RANGE, "0-0");
+        if (curl_easy_perform(probe) == CURLE_OK) {
+            long code = 0;
+            curl_easy_getinfo(probe, CURLINFO_RESPONSE_CODE, &code);
+            accepts_ranges = (code == 206);
+        }
+    }
+
+    curl_easy_cleanup(probe);
+    return length;
+}
+
+bool HttpClient::downloadSegmented(const std::string& url, const std::string& output_path,
+                                   size_t num_segments) {
+    current_output_path_ = output_path;
+    abort_requested_ = false;
+    resetProgressWindow();
+
+    bool accepts_ranges = false;
+    long long length = probeContentLength(url, accepts_ranges);
+    if (length <= 0 || !accepts_ranges || num_segments < 2) {
+        return downloadFile(url, output_path);
+    }
+
+    int fd = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    // fallocate reserves real extents (ftruncate only sets a sparse
+    // size), so segment writers don't race extent allocation
+    if (fallocate(fd, 0, 0, static_cast<off_t>(length)) != 0 &&
+        ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t segment_size = static_cast<size_t>(length) / num_segments;
+    std::atomic<bool> failed{false};
+    std::atomic<size_t> downloaded{0};
+    std::vector<std::thread> workers;
+    workers.reserve(num_segments);
+
+    for (size_t i = 0; i < num_segments; ++i) {
+        size_t start = i * segment_size;
+        size_t end = (i + 1 == num_segments) ? static_cast<size_t>(length) - 1
+                                             : start + segment_size - 1;
+
+        workers.emplace_back([&, start, end]() {
+            CURL* handle = curl_easy_init();
+            if (!handle) {
+                failed = true;
+                return;
+            }
+
+            SegmentSink sink{fd, static_cast<off_t>(start)};
+            std::string range = std::to_string(start) + "-" + std::to_string(end);
+
+            curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(handle, CURLOPT_RANGE, range.c_str());
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteAtCallback);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, &sink);
+            curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+
+            if (curl_easy_perform(handle) != CURLE_OK) {
+                failed = true;
+            } else {
+                size_t done = downloaded.fetch_add(end - start + 1) + (end - start + 1);
+                if (progress_callback_) {
+                    DownloadProgress progress;
+                    progress.total_bytes = static_cast<size_t>(length);
+                    progress.downloaded_bytes = done;
+                    progress.progress_percent = (double)done / length * 100.0;
+                    progress.is_complete = (done == static_cast<size_t>(length));
+                    progress_callback_(progress);
+                }
+            }
+            curl_easy_cleanup(handle);
+        });
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    close(fd);
+
+    if (failed || abort_requested_) {
+        std::filesystem::remove(output_path);
+        return false;
+    }
     return true;
 }
 
@@ -81,24 +450,34 @@ bool HttpClient::resumeDownload(const std::string& url, const std::string& outpu
         return downloadFile(url, output_path);
     }
 
-    size_t existing_size = std::filesystem::file_size(output_path);
+    curl_off_t existing_size =
+        static_cast<curl_off_t>(std::filesystem::file_size(output_path));
 
-    std::ofstream file(output_path, std::ios::binary | std::ios::app);
-    if (!file.is_open()) return false;
+    // WriteCallback casts WRITEDATA to a FileSink, so the resumed tail
+    // has to stream through one as well
+    FileSink sink;
+    if (!sink.openForAppend(output_path, curl_handle_)) return false;
 
     curl_easy_setopt(curl_handle_, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl_handle_, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &file);
-    curl_easy_setopt(curl_handle_, CURLOPT_RESUME_FROM, existing_size);
+    curl_easy_setopt(curl_handle_, CURLOPT_WRITEDATA, &sink);
+    // The _LARGE variant takes curl_off_t; the plain one reads a long
+    // off the varargs, so a size_t argument is misread and offsets past
+    // 2GB would not fit anyway
+    curl_easy_setopt(curl_handle_, CURLOPT_RESUME_FROM_LARGE, existing_size);
 
     CURLcode res = curl_easy_perform(curl_handle_);
-    file.close();
+    curl_easy_setopt(curl_handle_, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(0));
 
-    return res == CURLE_OK;
+    return res == CURLE_OK && sink.finish();
 }
 
-void HttpClient::setProgressCallback(std::function<void(const DownloadProgress&)> callback) {
+void HttpClient::setProgressCallback(std::function<void(const DownloadProgress&)> callback,
+                                     double min_percent_delta,
+                                     std::chrono::milliseconds min_interval) {
     progress_callback_ = callback;
+    progress_min_percent_delta_ = min_percent_delta;
+    progress_min_interval_ = min_interval;
 }
 
 void HttpClient::abort() {
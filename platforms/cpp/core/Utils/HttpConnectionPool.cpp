@@ -0,0 +1,74 @@
+#include "HttpConnectionPool.hpp"
+
+namespace TinyMCP {
+namespace Utils {
+
+HttpConnectionPool::~HttpConnectionPool() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, handles] : idle_) {
+        for (PooledHandle& pooled : handles) {
+            curl_easy_cleanup(pooled.handle);
+        }
+    }
+}
+
+std::string HttpConnectionPool::makeKey(const std::string& host, uint16_t port) {
+    return host + ":" + std::to_string(port);
+}
+
+CURL* HttpConnectionPool::acquire(const std::string& host, uint16_t port) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reapIdleLocked();
+
+        auto it = idle_.find(makeKey(host, port));
+        if (it != idle_.end() && !it->second.empty()) {
+            CURL* handle = it->second.back().handle;
+            it->second.pop_back();
+            return handle;
+        }
+    }
+
+    CURL* handle = curl_easy_init();
+    if (handle) {
+        // Keep the connection open across transfers on this handle
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, 30L);
+    }
+    return handle;
+}
+
+void HttpConnectionPool::release(const std::string& host, uint16_t port, CURL* handle) {
+    if (!handle) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& handles = idle_[makeKey(host, port)];
+    if (handles.size() >= kMaxIdlePerEndpoint) {
+        curl_easy_cleanup(handle);
+        return;
+    }
+    handles.push_back({handle, std::chrono::steady_clock::now()});
+}
+
+void HttpConnectionPool::discard(CURL* handle) {
+    if (handle) {
+        curl_easy_cleanup(handle);
+    }
+}
+
+void HttpConnectionPool::reapIdleLocked() {
+    auto now = std::chrono::steady_clock::now();
+    for (auto& [key, handles] : idle_) {
+        for (auto it = handles.begin(); it != handles.end();) {
+            if (now - it->lastUsed > kIdleTimeout) {
+                curl_easy_cleanup(it->handle);
+                it = handles.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+} // namespace Utils
+} // namespace TinyMCP
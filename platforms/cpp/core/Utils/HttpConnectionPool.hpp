@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <curl/curl.h>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Pool of keep-alive curl easy handles keyed by host:port. Reusing the
+// handle reuses its TCP (and TLS) connection, so a routed command to a
+// warm module service costs one write/read instead of a fresh handshake.
+// Idle handles are reaped after kIdleTimeout.
+class HttpConnectionPool {
+public:
+    HttpConnectionPool() = default;
+    ~HttpConnectionPool();
+
+    // Non-copyable
+    HttpConnectionPool(const HttpConnectionPool&) = delete;
+    HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+    // Checks out a handle for host:port; creates one if the pool is empty.
+    // The handle keeps its connection cache across checkouts.
+    CURL* acquire(const std::string& host, uint16_t port);
+
+    // Returns a handle after a successful exchange; drop unhealthy handles
+    // with discard() instead so a broken connection is not reused.
+    void release(const std::string& host, uint16_t port, CURL* handle);
+    void discard(CURL* handle);
+
+private:
+    static constexpr std::chrono::seconds kIdleTimeout{60};
+    static constexpr size_t kMaxIdlePerEndpoint = 4;
+
+    struct PooledHandle {
+        CURL* handle;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<PooledHandle>> idle_;
+
+    static std::string makeKey(const std::string& host, uint16_t port);
+    void reapIdleLocked();
+};
+
+} // namespace Utils
+} // namespace TinyMCP
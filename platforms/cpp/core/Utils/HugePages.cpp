@@ -0,0 +1,115 @@
+#include "HugePages.hpp"
+
+#include <sstream>
+
+#include <sys/mman.h>
+
+namespace TinyMCP {
+namespace Utils {
+
+HugePages& HugePages::instance() {
+    static HugePages pages;
+    return pages;
+}
+
+void HugePages::setEnabled(const std::string& subsystem, bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_[subsystem] = enabled;
+}
+
+bool HugePages::enabledLocked(const std::string& subsystem) const {
+    auto it = enabled_.find(subsystem);
+    return it == enabled_.end() || it->second;
+}
+
+void HugePages::recordLocked(const std::string& subsystem, Backing backing) {
+    Tally& tally = tallies_[subsystem];
+    switch (backing) {
+    case Backing::HugeTlb: tally.hugetlb++; break;
+    case Backing::Advised: tally.advised++; break;
+    case Backing::None: tally.none++; break;
+    }
+}
+
+HugePages::Backing HugePages::adviseMapping(const std::string& subsystem,
+                                            void* addr, size_t length) {
+    Backing backing = Backing::None;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabledLocked(subsystem)) {
+            recordLocked(subsystem, backing);
+            return backing;
+        }
+    }
+#ifdef MADV_HUGEPAGE
+    if (addr && length > 0 && madvise(addr, length, MADV_HUGEPAGE) == 0) {
+        backing = Backing::Advised;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mutex_);
+    recordLocked(subsystem, backing);
+    return backing;
+}
+
+void* HugePages::mapAnonymous(const std::string& subsystem, size_t length,
+                              Backing& backing) {
+    backing = Backing::None;
+    bool wantHuge;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wantHuge = enabledLocked(subsystem);
+    }
+
+    void* addr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (wantHuge && length % kHugePageSize == 0) {
+        addr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED) {
+            backing = Backing::HugeTlb;
+        }
+    }
+#endif
+    if (addr == MAP_FAILED) {
+        // No hugetlb pool (the common case): plain anonymous mapping,
+        // with THP asked to assemble huge pages behind it
+        addr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            return nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        if (wantHuge && madvise(addr, length, MADV_HUGEPAGE) == 0) {
+            backing = Backing::Advised;
+        }
+#endif
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    recordLocked(subsystem, backing);
+    return addr;
+}
+
+void HugePages::unmapAnonymous(void* addr, size_t length) {
+    if (addr) {
+        munmap(addr, length);
+    }
+}
+
+std::string HugePages::report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    out << "huge pages:";
+    if (tallies_.empty()) {
+        out << " (no large mappings)";
+    }
+    for (const auto& [subsystem, tally] : tallies_) {
+        out << " " << subsystem << "=" << tally.hugetlb << " hugetlb/"
+            << tally.advised << " advised/" << tally.none << " plain";
+    }
+    out << "\n";
+    return out.str();
+}
+
+} // namespace Utils
+} // namespace TinyMCP
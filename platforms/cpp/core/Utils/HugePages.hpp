@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Huge-page backing for the large long-lived mappings (mapped session
+// store, replay ring) and for big arena blocks. Each 2 MB huge page
+// replaces 512 TLB entries, which shows up in perf on the x86
+// deployment where those mappings are walked constantly.
+//
+// Two mechanisms, tried in order of strength: explicit MAP_HUGETLB for
+// anonymous blocks (needs a preallocated hugetlb pool, so it usually
+// fails on unconfigured boxes and always on the Pi), and
+// madvise(MADV_HUGEPAGE) asking transparent huge pages for an existing
+// mapping. Both degrade silently to normal pages; the outcome of every
+// attempt is recorded per subsystem and report() renders the tally, so
+// "did the store actually get huge pages" is answerable from the
+// shutdown stats instead of /proc spelunking.
+class HugePages {
+public:
+    enum class Backing : uint8_t {
+        None,     // normal 4K pages
+        Advised,  // MADV_HUGEPAGE accepted; THP decides
+        HugeTlb,  // explicit hugetlb pages
+    };
+
+    static constexpr size_t kHugePageSize = 2u << 20;
+
+    static HugePages& instance();
+
+    // Per-subsystem opt-out (everything starts enabled); a disabled
+    // subsystem's mappings go through untouched and tally as None
+    void setEnabled(const std::string& subsystem, bool enabled);
+
+    // Ask THP to back an existing long-lived mapping. Safe on any
+    // mapping; file-backed ones are refused by older kernels and just
+    // tally as None.
+    Backing adviseMapping(const std::string& subsystem, void* addr, size_t length);
+
+    // Anonymous read-write block for arena use: MAP_HUGETLB first, then
+    // a THP-advised plain mapping. length must be a kHugePageSize
+    // multiple (MAP_HUGETLB requires it). Returns nullptr only when
+    // even the plain mapping fails; release with unmapAnonymous().
+    void* mapAnonymous(const std::string& subsystem, size_t length, Backing& backing);
+    static void unmapAnonymous(void* addr, size_t length);
+
+    // One line per subsystem: how many mappings got which backing
+    std::string report();
+
+private:
+    HugePages() = default;
+
+    struct Tally {
+        uint64_t hugetlb = 0;
+        uint64_t advised = 0;
+        uint64_t none = 0;
+    };
+
+    bool enabledLocked(const std::string& subsystem) const;
+    void recordLocked(const std::string& subsystem, Backing backing);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, bool> enabled_;
+    std::map<std::string, Tally> tallies_;
+};
+
+} // namespace Utils
+} // namespace TinyMCP
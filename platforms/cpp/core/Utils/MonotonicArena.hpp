@@ -0,0 +1,118 @@
+#pragma once
+#include "HugePages.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Monotonic bump allocator for request-scoped data. Allocations are a
+// pointer increment into the current block; nothing is freed
+// individually — reset() (or destruction) releases everything at once.
+// A parsed command whose strings are interned here costs one block
+// allocation instead of one heap allocation per string.
+//
+// Blocks of a huge page (2 MB) or more come from HugePages-backed
+// anonymous mappings, so an arena sized for bulk work pays one TLB
+// entry per block instead of 512; smaller blocks stay on the heap.
+class MonotonicArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 4096;
+
+    explicit MonotonicArena(size_t blockSize = kDefaultBlockSize)
+        : blockSize(blockSize) {}
+
+    // Non-copyable; interned views point into the blocks
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        for (Block& block : blocks) {
+            releaseBlock(block);
+        }
+    }
+
+    // Returns blockSize-aligned-or-smaller storage; oversized requests
+    // get their own dedicated block.
+    char* allocate(size_t bytes) {
+        if (bytes == 0) return nullptr;
+        if (used + bytes > currentCapacity) {
+            grow(bytes);
+        }
+        char* out = blocks.back().data + used;
+        used += bytes;
+        return out;
+    }
+
+    // Copies the text into the arena and returns a view of the copy,
+    // valid until reset() or destruction.
+    std::string_view intern(std::string_view text) {
+        if (text.empty()) return {};
+        char* storage = allocate(text.size());
+        std::memcpy(storage, text.data(), text.size());
+        return {storage, text.size()};
+    }
+
+    // Drops every allocation but keeps the first block for reuse.
+    void reset() {
+        while (blocks.size() > 1) {
+            releaseBlock(blocks.back());
+            blocks.pop_back();
+        }
+        if (!blocks.empty()) {
+            currentCapacity = blocks.front().capacity;
+        }
+        used = 0;
+    }
+
+private:
+    struct Block {
+        char* data = nullptr;
+        size_t capacity = 0;
+        bool mapped = false;  // huge-backed anonymous mapping, not heap
+    };
+
+    void grow(size_t atLeast) {
+        size_t capacity = atLeast > blockSize ? atLeast : blockSize;
+        Block block;
+        if (capacity >= HugePages::kHugePageSize) {
+            // Round up to whole huge pages; the slack is usable arena
+            // space, not waste
+            const size_t rounded =
+                (capacity + HugePages::kHugePageSize - 1) /
+                HugePages::kHugePageSize * HugePages::kHugePageSize;
+            HugePages::Backing backing;
+            char* mapped = static_cast<char*>(
+                HugePages::instance().mapAnonymous("arena", rounded, backing));
+            if (mapped) {
+                block = {mapped, rounded, true};
+            }
+        }
+        if (!block.data) {
+            block = {new char[capacity], capacity, false};
+        }
+        blocks.push_back(block);
+        currentCapacity = block.capacity;
+        used = 0;
+    }
+
+    static void releaseBlock(Block& block) {
+        if (block.mapped) {
+            HugePages::unmapAnonymous(block.data, block.capacity);
+        } else {
+            delete[] block.data;
+        }
+        block.data = nullptr;
+    }
+
+    size_t blockSize;
+    size_t currentCapacity = 0;
+    size_t used = 0;
+    std::vector<Block> blocks;
+};
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -5,13 +5,62 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace TinyMCP {
 namespace Utils {
 
-SessionPersistence::SessionPersistence(const std::string& sessions_dir) 
+namespace {
+
+// On-disk index record. Fixed size so the index can be mmapped and
+// walked without any parsing; later records for the same session_id
+// supersede earlier ones (append-only, latest wins).
+struct IndexRecord {
+    char session_id[16];   // NUL-padded hex id
+    char status[12];       // NUL-padded: active/paused/completed/failed/removed
+    uint64_t downloaded_bytes;
+    uint64_t total_bytes;
+};
+static_assert(sizeof(IndexRecord) == 48, "IndexRecord layout changed");
+
+IndexRecord makeRecord(const std::string& session_id, const std::string& status,
+                       size_t downloaded_bytes, size_t total_bytes) {
+    IndexRecord rec{};
+    std::strncpy(rec.session_id, session_id.c_str(), sizeof(rec.session_id) - 1);
+    std::strncpy(rec.status, status.c_str(), sizeof(rec.status) - 1);
+    rec.downloaded_bytes = downloaded_bytes;
+    rec.total_bytes = total_bytes;
+    return rec;
+}
+
+} // namespace
+
+SessionPersistence::SessionPersistence(const std::string& sessions_dir)
     : sessions_dir_(sessions_dir) {
     std::filesystem::create_directories(sessions_dir_);
+    loadIndex();
+    gc_thread_ = std::thread(&SessionPersistence::gcLoop, this);
+}
+
+SessionPersistence::~SessionPersistence() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gc_stop_ = true;
+    }
+    gc_cv_.notify_all();
+    if (gc_thread_.joinable()) {
+        gc_thread_.join();
+    }
+    if (index_fd_ >= 0) {
+        ::close(index_fd_);
+        index_fd_ = -1;
+    }
 }
 
 std::string SessionPersistence::generateSessionId() const {
@@ -27,12 +76,13 @@ std::string SessionPersistence::generateSessionId() const {
 }
 
 std::string SessionPersistence::createSession(const std::string& url, const std::string& output_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::string session_id = generateSessionId();
 
     DownloadSession session;
     session.session_id = session_id;
     session.url = url;
-    session.output_path = output_path.empty() ? 
+    session.output_path = output_path.empty() ?
         std::filesystem::path(url).filename().string() : output_path;
     session.status = "active";
 
@@ -42,18 +92,25 @@ std::string SessionPersistence::createSession(const std::string& url, const std:
     session.last_modified_timestamp = timestamp;
 
     active_sessions_[session_id] = session;
-    saveSession(session);
+    saveSessionUnlocked(session);
 
     return session_id;
 }
 
 bool SessionPersistence::saveSession(const DownloadSession& session) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return saveSessionUnlocked(session);
+}
+
+bool SessionPersistence::saveSessionUnlocked(const DownloadSession& session) {
     try {
         Json::Value json = sessionToJson(session);
         std::ofstream file(getSessionFilePath(session.session_id));
         Json::StreamWriterBuilder builder;
         std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
         writer->write(json, &file);
+        appendIndexRecord(session.session_id, session.status,
+                          session.downloaded_bytes, session.total_bytes);
         return true;
     } catch (...) {
         return false;
@@ -61,6 +118,7 @@ bool SessionPersistence::saveSession(const DownloadSession& session) {
 }
 
 bool SessionPersistence::loadSession(const std::string& session_id, DownloadSession& session) {
+    std::lock_guard<std::mutex> lock(mutex_);
     try {
         std::ifstream file(getSessionFilePath(session_id));
         if (!file.is_open()) return false;
@@ -84,6 +142,10 @@ std::string SessionPersistence::getSessionFilePath(const std::string& session_id
     return sessions_dir_ + "/" + session_id + ".json";
 }
 
+std::string SessionPersistence::getIndexFilePath() const {
+    return sessions_dir_ + "/sessions.idx";
+}
+
 Json::Value SessionPersistence::sessionToJson(const DownloadSession& session) const {
     Json::Value json;
     json["session_id"] = session.session_id;
@@ -117,13 +179,204 @@ bool SessionPersistence::sessionExists(const std::string& session_id) const {
 }
 
 void SessionPersistence::updateSessionProgress(const std::string& session_id, size_t downloaded_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto it = active_sessions_.find(session_id);
     if (it != active_sessions_.end()) {
         it->second.downloaded_bytes = downloaded_bytes;
         auto now = std::chrono::system_clock::now();
-        it->second.last_modified_timestamp = 
+        it->second.last_modified_timestamp =
+            std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+        saveSessionUnlocked(it->second);
+    }
+}
+
+void SessionPersistence::markSessionComplete(const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = active_sessions_.find(session_id);
+    if (it != active_sessions_.end()) {
+        it->second.status = "completed";
+        it->second.is_complete = true;
+        auto now = std::chrono::system_clock::now();
+        it->second.last_modified_timestamp =
+            std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+        saveSessionUnlocked(it->second);
+    }
+}
+
+void SessionPersistence::markSessionFailed(const std::string& session_id, const std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = active_sessions_.find(session_id);
+    if (it != active_sessions_.end()) {
+        it->second.status = "failed: " + error;
+        auto now = std::chrono::system_clock::now();
+        it->second.last_modified_timestamp =
             std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-        saveSession(it->second);
+        saveSessionUnlocked(it->second);
+    }
+}
+
+std::vector<std::string> SessionPersistence::listActiveSessions() const {
+    // Answered from the in-memory index built off sessions.idx — no
+    // directory walk, no JSON parsing. O(sessions), trivially cheap
+    // even with thousands of historical sessions on disk.
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> ids;
+    for (const auto& [id, entry] : index_) {
+        if (entry.status == "active" || entry.status == "paused") {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+bool SessionPersistence::removeSession(const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_sessions_.erase(session_id);
+    if (index_.erase(session_id) > 0) {
+        appendIndexRecord(session_id, "removed", 0, 0);
+    }
+    std::error_code ec;
+    return std::filesystem::remove(getSessionFilePath(session_id), ec);
+}
+
+void SessionPersistence::loadIndex() {
+    const std::string path = getIndexFilePath();
+
+    // Open (creating if absent) in append mode once; every mutation is a
+    // single O_APPEND write of one record from then on.
+    index_fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (index_fd_ < 0) return;
+
+    struct stat st{};
+    if (::fstat(index_fd_, &st) != 0 || st.st_size == 0) return;
+
+    size_t usable = static_cast<size_t>(st.st_size) / sizeof(IndexRecord) * sizeof(IndexRecord);
+    if (usable == 0) return;
+
+    void* mapped = ::mmap(nullptr, usable, PROT_READ, MAP_PRIVATE, index_fd_, 0);
+    if (mapped == MAP_FAILED) return;
+
+    // Fold the log: later records supersede earlier ones
+    const auto* records = static_cast<const IndexRecord*>(mapped);
+    size_t count = usable / sizeof(IndexRecord);
+    for (size_t i = 0; i < count; ++i) {
+        std::string id(records[i].session_id,
+                       ::strnlen(records[i].session_id, sizeof(records[i].session_id)));
+        std::string status(records[i].status,
+                           ::strnlen(records[i].status, sizeof(records[i].status)));
+        if (id.empty()) continue;
+        if (status == "removed") {
+            index_.erase(id);
+        } else {
+            index_[id] = {status, records[i].downloaded_bytes, records[i].total_bytes};
+        }
+    }
+    index_records_ = count;
+    ::munmap(mapped, usable);
+
+    compactIndexIfNeeded();
+}
+
+void SessionPersistence::appendIndexRecord(const std::string& session_id, const std::string& status,
+                                           size_t downloaded_bytes, size_t total_bytes) {
+    // markSessionFailed embeds the error text in status; the index only
+    // needs the category
+    std::string brief = status.compare(0, 6, "failed") == 0 ? "failed" : status;
+    if (status != "removed") {
+        index_[session_id] = {brief, downloaded_bytes, total_bytes};
+    }
+    if (index_fd_ < 0) return;
+
+    IndexRecord rec = makeRecord(session_id, brief, downloaded_bytes, total_bytes);
+    if (::write(index_fd_, &rec, sizeof(rec)) == static_cast<ssize_t>(sizeof(rec))) {
+        ++index_records_;
+    }
+    // Compaction is deliberately not triggered here: the GC thread
+    // rewrites the log off the mutation path
+}
+
+void SessionPersistence::compactIndexIfNeeded() {
+    // Rewrite the log once superseded records dominate it; keeps the
+    // startup fold proportional to live sessions, not total history
+    if (index_fd_ < 0 || index_records_ <= 4 * index_.size() + 64) return;
+
+    const std::string path = getIndexFilePath();
+    const std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return;
+
+    bool ok = true;
+    for (const auto& [id, entry] : index_) {
+        IndexRecord rec = makeRecord(id, entry.status, entry.downloaded_bytes, entry.total_bytes);
+        if (::write(fd, &rec, sizeof(rec)) != static_cast<ssize_t>(sizeof(rec))) {
+            ok = false;
+            break;
+        }
+    }
+    ::close(fd);
+
+    if (!ok) {
+        ::unlink(tmp.c_str());
+        return;
+    }
+    if (::rename(tmp.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        return;
+    }
+    ::close(index_fd_);
+    index_fd_ = ::open(path.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+    index_records_ = index_.size();
+}
+
+void SessionPersistence::gcLoop() {
+#ifdef SCHED_IDLE
+    // Idle scheduling: the sweep only gets cycles nothing else wants,
+    // so compaction never competes with command traffic
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!gc_stop_) {
+        gc_cv_.wait_for(lock, kGcInterval, [this] { return gc_stop_; });
+        if (gc_stop_) break;
+        compactIndexIfNeeded();
+        sweepTerminalSessions();
+    }
+}
+
+void SessionPersistence::sweepTerminalSessions() {
+    // Delete session files whose outcome is settled and old: completed
+    // and failed sessions past retention, plus orphans a crash left
+    // behind after their index record was dropped. Live and paused
+    // sessions are never touched.
+    std::error_code ec;
+    std::filesystem::directory_iterator it(sessions_dir_, ec);
+    if (ec) return;
+
+    const auto fs_now = std::filesystem::file_time_type::clock::now();
+    for (const auto& entry : it) {
+        if (entry.path().extension() != ".json") continue;
+        const std::string id = entry.path().stem().string();
+
+        auto indexed = index_.find(id);
+        if (indexed == index_.end()) {
+            std::filesystem::remove(entry.path(), ec);
+            continue;
+        }
+        if (indexed->second.status != "completed" && indexed->second.status != "failed") {
+            continue;
+        }
+
+        auto mtime = std::filesystem::last_write_time(entry.path(), ec);
+        if (ec) continue;
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(fs_now - mtime).count();
+        if (age < kTerminalRetentionSeconds) continue;
+
+        std::filesystem::remove(entry.path(), ec);
+        active_sessions_.erase(id);
+        index_.erase(id);
+        appendIndexRecord(id, "removed", 0, 0);
     }
 }
 
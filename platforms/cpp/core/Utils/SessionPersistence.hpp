@@ -1,5 +1,9 @@
 #pragma once
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <json/json.h>
 
@@ -23,8 +27,34 @@ private:
     std::string sessions_dir_;
     std::unordered_map<std::string, DownloadSession> active_sessions_;
 
+    // Compact resume index: one fixed-size binary record appended per
+    // mutation, mmapped and folded (latest record wins) at startup.
+    // listActiveSessions answers from this map without opening or
+    // parsing any per-session JSON file.
+    struct IndexEntry {
+        std::string status;
+        size_t downloaded_bytes = 0;
+        size_t total_bytes = 0;
+    };
+    std::unordered_map<std::string, IndexEntry> index_;
+    int index_fd_ = -1;
+    size_t index_records_ = 0; // records on disk, including superseded
+
+    // Background GC: compacts the index into a fresh generation and
+    // sweeps terminal sessions' JSON files once they age out, so disk
+    // usage stays bounded and the startup fold stays proportional to
+    // live data. Runs under SCHED_IDLE so it only gets cycles command
+    // traffic is not using.
+    static constexpr std::chrono::minutes kGcInterval{5};
+    static constexpr int64_t kTerminalRetentionSeconds = 7 * 24 * 3600;
+    mutable std::mutex mutex_;
+    std::condition_variable gc_cv_;
+    std::thread gc_thread_;
+    bool gc_stop_ = false;
+
 public:
     SessionPersistence(const std::string& sessions_dir = "sessions");
+    ~SessionPersistence();
 
     std::string createSession(const std::string& url, const std::string& output_path = "");
     bool saveSession(const DownloadSession& session);
@@ -40,8 +70,22 @@ public:
 private:
     std::string generateSessionId() const;
     std::string getSessionFilePath(const std::string& session_id) const;
+    std::string getIndexFilePath() const;
     Json::Value sessionToJson(const DownloadSession& session) const;
     DownloadSession sessionFromJson(const Json::Value& json) const;
+
+    bool saveSessionUnlocked(const DownloadSession& session);
+
+    // Index maintenance
+    void loadIndex();
+    void appendIndexRecord(const std::string& session_id, const std::string& status,
+                           size_t downloaded_bytes, size_t total_bytes);
+    void compactIndexIfNeeded();
+
+    // Background GC: gcLoop runs on gc_thread_; the sweep expects
+    // mutex_ held
+    void gcLoop();
+    void sweepTerminalSessions();
 };
 
 } // namespace Utils
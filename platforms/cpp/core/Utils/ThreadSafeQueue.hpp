@@ -1,14 +1,27 @@
 #pragma once
+#include <array>
+#include <deque>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <memory>
 #include <atomic>
+#include <thread>
+#include <vector>
 
 namespace TinyMCP {
 namespace Utils {
 
-template<typename T>
+// Queue policy tags. MutexQueuePolicy keeps the original unbounded
+// mutex+condvar queue; LockFreeQueuePolicy selects a bounded lock-free
+// MPMC ring buffer for hot producer/consumer pairs (MQTT reader vs
+// JobWorker threads) where the mutex shows up in perf.
+struct MutexQueuePolicy {};
+struct LockFreeQueuePolicy {
+    static constexpr size_t kDefaultCapacity = 1024; // must be a power of two
+};
+
+template<typename T, typename Policy = MutexQueuePolicy>
 class ThreadSafeQueue {
 private:
     mutable std::mutex mtx_;
@@ -26,8 +39,15 @@ public:
     void push(T item) {
         std::lock_guard<std::mutex> lock(mtx_);
         if (!shutdown_) {
+            const bool wasEmpty = queue_.empty();
             queue_.push(std::move(item));
-            condition_.notify_one();
+            // Wakeup coalescing: only the empty -> non-empty transition
+            // needs a signal. A burst of pushes onto a non-empty queue
+            // raises no further wakeups; consumers chain the next signal
+            // themselves when they leave items behind.
+            if (wasEmpty) {
+                condition_.notify_one();
+            }
         }
     }
 
@@ -41,9 +61,41 @@ public:
 
         item = std::move(queue_.front());
         queue_.pop();
+        // Pushes coalesce their wakeups, so pass the signal on while
+        // work remains for another consumer
+        if (!queue_.empty()) {
+            condition_.notify_one();
+        }
         return true;
     }
 
+    // Drains up to max items under a single lock acquisition; blocks
+    // until at least one item is available (or shutdown, returning 0).
+    // Burst consumers pay one wakeup and one lock per batch instead of
+    // per item.
+    size_t popBatch(std::vector<T>& items, size_t max) {
+        if (max == 0) {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(mtx_);
+        condition_.wait(lock, [this] { return !queue_.empty() || shutdown_; });
+
+        if (shutdown_ && queue_.empty()) {
+            return 0;
+        }
+
+        size_t count = 0;
+        while (count < max && !queue_.empty()) {
+            items.push_back(std::move(queue_.front()));
+            queue_.pop();
+            ++count;
+        }
+        if (!queue_.empty()) {
+            condition_.notify_one();
+        }
+        return count;
+    }
+
     bool tryPop(T& item) {
         std::lock_guard<std::mutex> lock(mtx_);
         if (queue_.empty()) {
@@ -75,6 +127,140 @@ public:
     }
 };
 
+// Bounded lock-free MPMC ring buffer (Vyukov-style sequence counters).
+// Same push/pop/tryPop/requestShutdown surface as the mutex variant so
+// callers switch by policy only. push spins when the ring is full and
+// pop spins briefly before yielding, trading bounded capacity for the
+// absence of a shared mutex on every hand-off.
+template<typename T>
+class ThreadSafeQueue<T, LockFreeQueuePolicy> {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    std::vector<Cell> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+    std::atomic<bool> shutdown_{false};
+
+    bool tryPush(T& item) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    cell.item = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    explicit ThreadSafeQueue(size_t capacity = LockFreeQueuePolicy::kDefaultCapacity)
+        : cells_(capacity), mask_(capacity - 1) {
+        // Capacity must be a power of two for the index mask to work
+        for (size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+    ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
+
+    void push(T item) {
+        while (!shutdown_.load(std::memory_order_relaxed)) {
+            if (tryPush(item)) {
+                return;
+            }
+            std::this_thread::yield(); // ring full, wait for a consumer
+        }
+    }
+
+    bool pop(T& item) {
+        for (;;) {
+            if (tryPop(item)) {
+                return true;
+            }
+            if (shutdown_.load(std::memory_order_acquire)) {
+                // Drain anything published before shutdown
+                return tryPop(item);
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Policy-parity batch drain: blocks for the first item like pop,
+    // then takes whatever else is immediately available up to max
+    size_t popBatch(std::vector<T>& items, size_t max) {
+        if (max == 0) {
+            return 0;
+        }
+        T item;
+        if (!pop(item)) {
+            return 0;
+        }
+        items.push_back(std::move(item));
+        size_t count = 1;
+        while (count < max && tryPop(item)) {
+            items.push_back(std::move(item));
+            ++count;
+        }
+        return count;
+    }
+
+    bool tryPop(T& item) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    item = std::move(cell.item);
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // empty
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool empty() const {
+        return dequeuePos_.load(std::memory_order_acquire) >=
+               enqueuePos_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        size_t tail = dequeuePos_.load(std::memory_order_acquire);
+        size_t head = enqueuePos_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    void requestShutdown() {
+        shutdown_.store(true, std::memory_order_release);
+    }
+
+    bool isShutdown() const {
+        return shutdown_.load();
+    }
+};
+
 // Priority queue variant for message prioritization
 template<typename T>
 struct PrioritizedItem {
@@ -86,45 +272,127 @@ struct PrioritizedItem {
     }
 };
 
+// Sharded multilevel queue replacing the single mutex+binary-heap
+// design, whose one lock capped throughput under many producers and
+// consumers. Producers hash (per thread) to one of kShards shards, each
+// a small array of FIFO deques indexed by priority class under its own
+// mutex, so concurrent pushes rarely touch the same lock and push/pop
+// are O(1) instead of O(log n). Consumers scan classes high to low and
+// shards round-robin from a rotating cursor: ordering across shards is
+// approximate, but within a shard and priority class strict FIFO is
+// kept — the trade the message path wants at several 100k msgs/s.
 template<typename T>
 class ThreadSafePriorityQueue {
 private:
-    mutable std::mutex mtx_;
-    std::priority_queue<PrioritizedItem<T>> queue_;
+    static constexpr size_t kShards = 8;
+    // Priorities clamp into this many classes; lower number = higher
+    // priority, matching the old heap's ordering
+    static constexpr size_t kPriorityClasses = 4;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::array<std::deque<T>, kPriorityClasses> levels;
+        std::atomic<size_t> count{0}; // cheap emptiness probe for scans
+    };
+
+    std::array<Shard, kShards> shards_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> popCursor_{0};
+    std::mutex wakeupMutex_;
     std::condition_variable condition_;
     std::atomic<bool> shutdown_{false};
 
+    static size_t producerShard() {
+        // Sticky per-producer shard: a producer's items stay FIFO
+        // within their priority class
+        static thread_local const size_t shard =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) % kShards;
+        return shard;
+    }
+
+    static size_t classFor(int priority) {
+        if (priority < 0) return 0;
+        const size_t cls = static_cast<size_t>(priority);
+        return cls < kPriorityClasses ? cls : kPriorityClasses - 1;
+    }
+
+    bool tryPopInternal(T& item) {
+        const size_t start = popCursor_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t cls = 0; cls < kPriorityClasses; ++cls) {
+            for (size_t i = 0; i < kShards; ++i) {
+                Shard& shard = shards_[(start + i) % kShards];
+                if (shard.count.load(std::memory_order_acquire) == 0) {
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                std::deque<T>& level = shard.levels[cls];
+                if (level.empty()) {
+                    continue;
+                }
+                item = std::move(level.front());
+                level.pop_front();
+                shard.count.fetch_sub(1, std::memory_order_release);
+                pending_.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
 public:
     void push(T item, int priority = 1) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (!shutdown_) {
-            queue_.push({priority, std::move(item)});
+        if (shutdown_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        Shard& shard = shards_[producerShard()];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.levels[classFor(priority)].push_back(std::move(item));
+            shard.count.fetch_add(1, std::memory_order_release);
+        }
+        // Coalesced wakeup, same scheme as ThreadSafeQueue: signal on
+        // the empty transition, consumers chain while work remains. The
+        // publish happens under the wakeup mutex so it cannot land
+        // inside a sleeping consumer's predicate-check window — an
+        // unordered 0 -> 1 bump there would be the last notify ever.
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> lock(wakeupMutex_);
+            wasEmpty = pending_.fetch_add(1, std::memory_order_release) == 0;
+        }
+        if (wasEmpty) {
             condition_.notify_one();
         }
     }
 
     bool pop(T& item) {
-        std::unique_lock<std::mutex> lock(mtx_);
-        condition_.wait(lock, [this] { return !queue_.empty() || shutdown_; });
-
-        if (shutdown_ && queue_.empty()) {
-            return false;
+        for (;;) {
+            if (tryPopInternal(item)) {
+                if (pending_.load(std::memory_order_acquire) > 0) {
+                    condition_.notify_one();
+                }
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(wakeupMutex_);
+            condition_.wait(lock, [this] {
+                return pending_.load(std::memory_order_acquire) > 0 ||
+                       shutdown_.load(std::memory_order_acquire);
+            });
+            if (shutdown_.load(std::memory_order_acquire) &&
+                pending_.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
         }
-
-        item = std::move(queue_.top().item);
-        queue_.pop();
-        return true;
     }
 
     void requestShutdown() {
-        std::lock_guard<std::mutex> lock(mtx_);
-        shutdown_ = true;
+        shutdown_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(wakeupMutex_);
         condition_.notify_all();
     }
 
     bool empty() const {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return queue_.empty();
+        return pending_.load(std::memory_order_acquire) == 0;
     }
 };
 
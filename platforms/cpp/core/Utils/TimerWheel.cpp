@@ -0,0 +1,198 @@
+#include "TimerWheel.hpp"
+
+#include <iostream>
+
+namespace TinyMCP {
+namespace Utils {
+
+TimerWheel::TimerWheel() {
+    running_ = true;
+    worker_ = std::thread(&TimerWheel::workerLoop, this);
+}
+
+TimerWheel::~TimerWheel() {
+    stop();
+}
+
+TimerWheel& TimerWheel::instance() {
+    static TimerWheel wheel;
+    return wheel;
+}
+
+uint64_t TimerWheel::ticksFor(std::chrono::milliseconds duration) {
+    // Round up so a timer never fires early; minimum one tick
+    const auto ticks =
+        (duration.count() + kTick.count() - 1) / kTick.count();
+    return ticks < 1 ? 1 : static_cast<uint64_t>(ticks);
+}
+
+TimerWheel::TimerId TimerWheel::scheduleEvery(std::chrono::milliseconds interval,
+                                              Callback callback) {
+    const uint64_t ticks = ticksFor(interval);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scheduleLocked(ticks, ticks, std::move(callback));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(std::chrono::milliseconds delay,
+                                              Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scheduleLocked(ticksFor(delay), 0, std::move(callback));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleLocked(uint64_t firstDelayTicks,
+                                               uint64_t intervalTicks,
+                                               Callback callback) {
+    Timer timer;
+    timer.id = nextId_++;
+    timer.expiryTick = currentTick_ + firstDelayTicks;
+    timer.intervalTicks = intervalTicks;
+    timer.callback = std::move(callback);
+
+    armed_.insert(timer.id);
+    const TimerId id = timer.id;
+    placeLocked(std::move(timer));
+    return id;
+}
+
+void TimerWheel::placeLocked(Timer&& timer) {
+    // A deadline at or before the current tick (possible after a late
+    // cascade) fires on the next tick rather than waiting a full lap
+    if (timer.expiryTick <= currentTick_) {
+        timer.expiryTick = currentTick_ + 1;
+    }
+    const uint64_t delta = timer.expiryTick - currentTick_;
+
+    size_t level = kLevels - 1;
+    for (size_t l = 0; l < kLevels; ++l) {
+        if (delta < (uint64_t{1} << ((l + 1) * kWheelBits))) {
+            level = l;
+            break;
+        }
+    }
+
+    // Beyond the outermost span, park at the farthest reachable tick;
+    // cascading re-places the timer with its true expiry
+    uint64_t indexTick = timer.expiryTick;
+    if (level == kLevels - 1 &&
+        delta >= (uint64_t{1} << (kLevels * kWheelBits))) {
+        indexTick = currentTick_ + (uint64_t{1} << (kLevels * kWheelBits)) - 1;
+    }
+
+    const size_t slot =
+        (indexTick >> (level * kWheelBits)) & (kSlots - 1);
+    wheel_[level][slot].push_back(std::move(timer));
+}
+
+void TimerWheel::cascadeLocked(size_t level, size_t slot) {
+    Slot pending = std::move(wheel_[level][slot]);
+    wheel_[level][slot].clear();
+    for (Timer& timer : pending) {
+        if (armed_.count(timer.id) == 0) {
+            continue; // cancelled while parked
+        }
+        placeLocked(std::move(timer));
+    }
+}
+
+void TimerWheel::tick() {
+    std::vector<Timer> due;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++currentTick_;
+
+        // On wrap of an inner wheel, pull the next outer slot down so
+        // its timers land in their final inner positions
+        if ((currentTick_ & (kSlots - 1)) == 0) {
+            const size_t slot1 = (currentTick_ >> kWheelBits) & (kSlots - 1);
+            cascadeLocked(1, slot1);
+            if (slot1 == 0) {
+                cascadeLocked(2, (currentTick_ >> (2 * kWheelBits)) & (kSlots - 1));
+            }
+        }
+
+        Slot& current = wheel_[0][currentTick_ & (kSlots - 1)];
+        for (Timer& timer : current) {
+            if (armed_.count(timer.id) == 0) {
+                continue;
+            }
+            if (timer.intervalTicks == 0) {
+                armed_.erase(timer.id);
+            }
+            due.push_back(std::move(timer));
+        }
+        current.clear();
+        firing_ = !due.empty();
+    }
+
+    // Callbacks run outside the lock so they may schedule and cancel
+    // freely; cancel() blocks on firing_ until the batch finishes
+    for (Timer& timer : due) {
+        try {
+            timer.callback();
+        } catch (const std::exception& e) {
+            std::cerr << "TimerWheel: callback threw: " << e.what() << std::endl;
+        }
+    }
+
+    if (firing_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Timer& timer : due) {
+            // Re-arm periodic timers unless cancelled mid-callback
+            if (timer.intervalTicks != 0 && armed_.count(timer.id) != 0) {
+                timer.expiryTick = currentTick_ + timer.intervalTicks;
+                placeLocked(std::move(timer));
+            }
+        }
+        firing_ = false;
+        cv_.notify_all();
+    }
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const bool wasArmed = armed_.erase(id) != 0;
+
+    // Do not return while a batch possibly containing this callback is
+    // mid-flight, so callers may tear down captured state immediately
+    // afterwards. The wheel thread itself must not wait on its own batch.
+    if (std::this_thread::get_id() != worker_.get_id()) {
+        cv_.wait(lock, [this] { return !firing_; });
+    }
+    return wasArmed;
+}
+
+void TimerWheel::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void TimerWheel::workerLoop() {
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t tickCount = 0;
+
+    while (true) {
+        ++tickCount;
+        const auto deadline = start + tickCount * kTick;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_until(lock, deadline, [this] { return !running_; });
+            if (!running_) {
+                return;
+            }
+        }
+        tick();
+    }
+}
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace TinyMCP {
+namespace Utils {
+
+// Hierarchical timing wheel shared by every subsystem that needs a
+// periodic or deferred callback (health sweeps, session expiry, ...).
+// One worker thread advances the wheel at a fixed kTick; insert, cancel
+// and each tick are O(1) in the number of armed timers, so thousands of
+// per-session expiry timers cost no more than one. Replaces the
+// one-thread-per-feature timer loops the subsystems used to spawn.
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    // Wheel resolution; callbacks fire on the next tick boundary at or
+    // after their deadline
+    static constexpr std::chrono::milliseconds kTick{100};
+
+    TimerWheel();
+    ~TimerWheel();
+
+    // Non-copyable
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Process-wide wheel shared by all subsystems
+    static TimerWheel& instance();
+
+    // Fires callback every interval until cancelled. The callback runs
+    // on the wheel thread; keep it short or hand off to a worker.
+    TimerId scheduleEvery(std::chrono::milliseconds interval, Callback callback);
+
+    // Fires callback once after delay
+    TimerId scheduleAfter(std::chrono::milliseconds delay, Callback callback);
+
+    // Disarms a timer. On return the callback is neither running nor
+    // going to run again (unless cancel is called from the callback
+    // itself, which only guarantees no further firings), so it is safe
+    // to destroy the objects the callback captured.
+    bool cancel(TimerId id);
+
+    // Stops the wheel thread; pending timers are dropped
+    void stop();
+
+private:
+    // Three levels of 256 slots: level 0 spans 25.6 s at 100 ms ticks,
+    // level 1 ~1.8 h, level 2 ~19 d. Farther deadlines park in the
+    // outermost level and re-cascade.
+    static constexpr size_t kWheelBits = 8;
+    static constexpr size_t kSlots = size_t{1} << kWheelBits;
+    static constexpr size_t kLevels = 3;
+
+    struct Timer {
+        TimerId id = 0;
+        uint64_t expiryTick = 0;    // absolute tick number
+        uint64_t intervalTicks = 0; // 0 = one-shot
+        Callback callback;
+    };
+
+    using Slot = std::vector<Timer>;
+
+    std::array<std::array<Slot, kSlots>, kLevels> wheel_;
+    uint64_t currentTick_ = 0;
+    TimerId nextId_ = 1;
+
+    // Armed timer ids; cancel() erases here and fire/cascade drops
+    // anything no longer present, so stale entries never run
+    std::unordered_set<TimerId> armed_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    bool running_ = false;
+    bool firing_ = false; // a callback batch is executing outside mutex_
+
+    TimerId scheduleLocked(uint64_t firstDelayTicks, uint64_t intervalTicks,
+                           Callback callback);
+    void placeLocked(Timer&& timer);
+    void cascadeLocked(size_t level, size_t slot);
+    void tick();
+    void workerLoop();
+
+    static uint64_t ticksFor(std::chrono::milliseconds duration);
+};
+
+} // namespace Utils
+} // namespace TinyMCP
@@ -0,0 +1,113 @@
+#include "WarmStateSnapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace WebGrab {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4E534757; // "WGSN"
+constexpr uint32_t kVersion = 1;
+// A registry beyond these bounds indicates a corrupt file, not a
+// plausible deployment
+constexpr uint32_t kMaxServices = 4096;
+constexpr uint32_t kMaxStringBytes = 4096;
+constexpr uint32_t kMaxCapabilities = 256;
+
+void putU32(std::ofstream& out, uint32_t v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void putI64(std::ofstream& out, int64_t v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void putString(std::ofstream& out, const std::string& s) {
+    putU32(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool getU32(std::ifstream& in, uint32_t& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(v)));
+}
+
+bool getI64(std::ifstream& in, int64_t& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(v)));
+}
+
+bool getString(std::ifstream& in, std::string& s) {
+    uint32_t len;
+    if (!getU32(in, len) || len > kMaxStringBytes) return false;
+    s.resize(len);
+    return static_cast<bool>(in.read(s.data(), len));
+}
+
+} // namespace
+
+bool WarmStateSnapshot::save(const std::vector<SnapshotServiceEntry>& services) const {
+    const std::string tmpPath = path_ + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        putU32(out, kMagic);
+        putU32(out, kVersion);
+        putU32(out, static_cast<uint32_t>(services.size()));
+        for (const SnapshotServiceEntry& svc : services) {
+            putString(out, svc.name);
+            putString(out, svc.host);
+            putU32(out, svc.port);
+            putI64(out, svc.lastSeenTicks);
+            putU32(out, static_cast<uint32_t>(svc.capabilities.size()));
+            for (const std::string& cap : svc.capabilities) {
+                putString(out, cap);
+            }
+        }
+        if (!out) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    // Atomic publish: a crash mid-write never clobbers the last good
+    // snapshot
+    if (std::rename(tmpPath.c_str(), path_.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool WarmStateSnapshot::load(std::vector<SnapshotServiceEntry>& out) const {
+    std::ifstream in(path_, std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic, version, count;
+    if (!getU32(in, magic) || magic != kMagic) return false;
+    if (!getU32(in, version) || version != kVersion) return false;
+    if (!getU32(in, count) || count > kMaxServices) return false;
+
+    std::vector<SnapshotServiceEntry> services;
+    services.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        SnapshotServiceEntry svc;
+        uint32_t port, capCount;
+        if (!getString(in, svc.name) || !getString(in, svc.host) ||
+            !getU32(in, port) || port > UINT16_MAX ||
+            !getI64(in, svc.lastSeenTicks) ||
+            !getU32(in, capCount) || capCount > kMaxCapabilities) {
+            return false;
+        }
+        svc.port = static_cast<uint16_t>(port);
+        svc.capabilities.resize(capCount);
+        for (uint32_t c = 0; c < capCount; c++) {
+            if (!getString(in, svc.capabilities[c])) return false;
+        }
+        services.push_back(std::move(svc));
+    }
+
+    out = std::move(services);
+    return true;
+}
+
+} // namespace WebGrab
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WebGrab {
+
+/**
+ * @brief One persisted service registry entry
+ *
+ * Plain data only: capabilities are stored verbatim, so replaying an
+ * entry through registerService() rebuilds the intent routing table and
+ * the NLP intern ids exactly as live registration would.
+ */
+struct SnapshotServiceEntry {
+    std::string name;
+    std::string host;
+    uint16_t port = 0;
+    std::vector<std::string> capabilities;
+    int64_t lastSeenTicks = 0;
+};
+
+/**
+ * @brief Binary warm-state snapshot of the orchestrator registry
+ *
+ * After a crash the registry used to rebuild empty and commands stayed
+ * unroutable until modules re-registered, up to 30s. The orchestrator
+ * now persists the registry periodically; start() loads it back and
+ * re-registers every entry as stale-until-probed, so routing resumes
+ * immediately and the health sweep catches up asynchronously.
+ *
+ * save() writes a temp file and renames it into place, so a crash
+ * mid-write leaves the previous snapshot intact; load() rejects any
+ * truncated or mismatched file rather than restoring garbage.
+ */
+class WarmStateSnapshot {
+public:
+    explicit WarmStateSnapshot(std::string path) : path_(std::move(path)) {}
+
+    bool save(const std::vector<SnapshotServiceEntry>& services) const;
+
+    // Returns false (leaving out untouched) when the file is missing,
+    // truncated, or from a different format version
+    bool load(std::vector<SnapshotServiceEntry>& out) const;
+
+private:
+    std::string path_;
+};
+
+} // namespace WebGrab
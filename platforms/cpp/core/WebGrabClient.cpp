@@ -13,10 +13,21 @@ bool WebGrabClient::connect() {
     if (!socket_->connect()) return false;
     writer_ = std::make_unique<FlatBuffersRequestWriter>(socket_);
     reader_ = std::make_unique<FlatBuffersResponseReader>(socket_);
+    pendingDownloads_ = 0;
     return true;
 }
 
+bool WebGrabClient::isConnected() const {
+    return socket_ && socket_->isConnected();
+}
+
+bool WebGrabClient::ensureConnected() {
+    if (isConnected()) return true;
+    return connect();
+}
+
 bool WebGrabClient::executeDownload(const std::string& url, uint32_t& sessionId) {
+    if (!ensureConnected()) return false;
     DownloadRequest req{url};
     if (!writer_->send(req)) return false;
     DownloadResponse resp;
@@ -29,6 +40,7 @@ bool WebGrabClient::executeDownload(const std::string& url, uint32_t& sessionId)
 }
 
 bool WebGrabClient::executeStatus(uint32_t sessionId, std::string& status) {
+    if (!ensureConnected()) return false;
     DownloadStatusRequest req{sessionId};
     if (!writer_->send(req)) return false;
     StatusResponse resp;
@@ -41,6 +53,7 @@ bool WebGrabClient::executeStatus(uint32_t sessionId, std::string& status) {
 }
 
 bool WebGrabClient::executeAbort(uint32_t sessionId) {
+    if (!ensureConnected()) return false;
     DownloadAbortRequest req{sessionId};
     if (!writer_->send(req)) return false;
     // Assume success, no specific response
@@ -51,4 +64,39 @@ bool WebGrabClient::executeAbort(uint32_t sessionId) {
 bool WebGrabClient::executeQuit() {
     ShutdownRequest req;
     return writer_->send(req);
+}
+
+bool WebGrabClient::submitDownload(const std::string& url) {
+    if (!ensureConnected()) return false;
+    DownloadRequest req{url};
+    if (!writer_->send(req)) return false;
+    pendingDownloads_++;
+    return true;
+}
+
+bool WebGrabClient::collectDownload(uint32_t& sessionId) {
+    if (pendingDownloads_ == 0) return false;
+    DownloadResponse resp;
+    if (!reader_->recv(resp)) return false;
+    pendingDownloads_--;
+    sessionId = resp.sessionId;
+    return true;
+}
+
+bool WebGrabClient::executeDownloadBatch(const std::vector<std::string>& urls,
+                                         std::vector<uint32_t>& sessionIds) {
+    // All requests go out before the first response is read, so the
+    // batch costs one round trip instead of one per URL
+    for (const auto& url : urls) {
+        if (!submitDownload(url)) return false;
+    }
+
+    sessionIds.clear();
+    sessionIds.reserve(urls.size());
+    while (pendingDownloads_ > 0) {
+        uint32_t sessionId;
+        if (!collectDownload(sessionId)) return false;
+        sessionIds.push_back(sessionId);
+    }
+    return true;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 class IRequestWriter;
 class IResponseReader;
@@ -10,14 +12,37 @@ private:
     std::unique_ptr<IRequestWriter> writer_;
     std::unique_ptr<IResponseReader> reader_;
     std::shared_ptr<class TcpSocket> socket_;
+    // Download requests sent but not yet matched with a response
+    size_t pendingDownloads_ = 0;
+
+    // Reconnects (and rebuilds writer/reader) if the session dropped
+    bool ensureConnected();
 
 public:
     WebGrabClient(const std::string& host, uint16_t port);
     ~WebGrabClient();
 
     bool connect();
+    bool isConnected() const;
+
     bool executeDownload(const std::string& url, uint32_t& sessionId);
     bool executeStatus(uint32_t sessionId, std::string& status);
     bool executeAbort(uint32_t sessionId);
     bool executeQuit();
+
+    // Pipelined mode: queue any number of download requests on the open
+    // session, then drain the responses. The server answers in order on
+    // the connection, so collectDownload returns the sessionId of the
+    // oldest unanswered submission.
+    bool submitDownload(const std::string& url);
+    bool collectDownload(uint32_t& sessionId);
+    size_t pendingDownloads() const { return pendingDownloads_; }
+
+    // Convenience wrapper: pipeline all URLs, then collect all session
+    // ids. Server side, a batch lands in AsyncDownloadEngine as one
+    // submission wave, where same-host transfers multiplex as HTTP/2
+    // streams on a shared connection — the nightly artifact sync should
+    // use this rather than looping executeDownload.
+    bool executeDownloadBatch(const std::vector<std::string>& urls,
+                              std::vector<uint32_t>& sessionIds);
 };
\ No newline at end of file
@@ -1,7 +1,27 @@
+#include "WebGrabDll.h"
 #include "WebGrabClient.h"
 #include <memory>
 #include <cstring>
 
+namespace {
+
+// Copies a status string into the caller's arena and records its offset.
+// Returns false (leaving the result marked WG_NO_STATUS) when the
+// remaining arena space cannot hold it NUL-terminated.
+bool placeStatus(const std::string& status, char* arena, size_t arena_size,
+                 size_t& arena_used, wg_result& result) {
+    result.status_offset = WG_NO_STATUS;
+    if (!arena || arena_used + status.size() + 1 > arena_size) {
+        return false;
+    }
+    std::memcpy(arena + arena_used, status.c_str(), status.size() + 1);
+    result.status_offset = static_cast<uint32_t>(arena_used);
+    arena_used += status.size() + 1;
+    return true;
+}
+
+} // namespace
+
 // C API for shared library
 extern "C" {
 
@@ -58,4 +78,65 @@ void wg_shutdown(void* client_handle) {
     client->executeQuit();
 }
 
+size_t wg_execute_batch(void* client_handle, const wg_request* requests,
+                        size_t count, wg_result* results, char* arena,
+                        size_t arena_size) {
+    if (!client_handle || !requests || !results) return 0;
+    auto client = static_cast<WebGrabClient*>(client_handle);
+
+    size_t succeeded = 0;
+    size_t arena_used = 0;
+    size_t i = 0;
+    while (i < count) {
+        results[i] = wg_result{false, 0, WG_NO_STATUS};
+
+        if (requests[i].op == WG_OP_DOWNLOAD) {
+            // Pipeline the whole run of consecutive downloads: submit
+            // them back to back, then collect the in-order responses
+            size_t runEnd = i;
+            while (runEnd < count && requests[runEnd].op == WG_OP_DOWNLOAD) {
+                results[runEnd] = wg_result{false, 0, WG_NO_STATUS};
+                ++runEnd;
+            }
+            size_t submitted = 0;
+            for (size_t j = i; j < runEnd; ++j) {
+                if (!requests[j].url || !client->submitDownload(requests[j].url)) {
+                    // Responses match submissions in order, so the rest
+                    // of the run stays unsubmitted and reports failure
+                    break;
+                }
+                ++submitted;
+            }
+            for (size_t j = i; j < i + submitted; ++j) {
+                uint32_t sessionId = 0;
+                if (client->collectDownload(sessionId)) {
+                    results[j].ok = true;
+                    results[j].session_id = sessionId;
+                    ++succeeded;
+                }
+            }
+            i = runEnd;
+            continue;
+        }
+
+        if (requests[i].op == WG_OP_STATUS) {
+            std::string status;
+            if (client->executeStatus(requests[i].session_id, status) &&
+                placeStatus(status, arena, arena_size, arena_used, results[i])) {
+                results[i].ok = true;
+                results[i].session_id = requests[i].session_id;
+                ++succeeded;
+            }
+        } else if (requests[i].op == WG_OP_ABORT) {
+            if (client->executeAbort(requests[i].session_id)) {
+                results[i].ok = true;
+                results[i].session_id = requests[i].session_id;
+                ++succeeded;
+            }
+        }
+        ++i;
+    }
+    return succeeded;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * C ABI for the WebGrab client shared library. Hosts (the Windows DLL
+ * consumer and the webgrab-linux-host hot-reload harness) include this
+ * header; everything here is plain C so the struct layouts match across
+ * compilers and module boundaries.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-call surface */
+void* wg_create_client(const char* server_host, uint16_t server_port);
+void wg_destroy_client(void* client_handle);
+bool wg_download(void* client_handle, const char* url, uint32_t* out_session_id);
+bool wg_get_status(void* client_handle, uint32_t session_id, char* out_status,
+                   size_t status_buf_size);
+bool wg_abort(void* client_handle, uint32_t session_id);
+void wg_shutdown(void* client_handle);
+
+/*
+ * Batch surface. One call submits an array of requests; results land in
+ * the caller's array and status strings in the caller's arena, so a
+ * tight host loop pays one boundary crossing for the whole batch and no
+ * allocation crosses the module boundary in either direction.
+ *
+ * Consecutive download requests are pipelined on the wire (see
+ * WebGrabClient::submitDownload), so a batch of N downloads is one
+ * submission wave, not N round trips.
+ */
+
+enum wg_op {
+    WG_OP_DOWNLOAD = 0, /* url in; session_id out */
+    WG_OP_STATUS = 1,   /* session_id in; status string out via arena */
+    WG_OP_ABORT = 2     /* session_id in */
+};
+
+/* status_offset value meaning "no status string for this result" */
+#define WG_NO_STATUS UINT32_MAX
+
+typedef struct wg_request {
+    uint8_t op; /* one of wg_op */
+    uint32_t session_id;
+    const char* url;
+} wg_request;
+
+typedef struct wg_result {
+    bool ok;
+    uint32_t session_id;
+    /* Offset of the NUL-terminated status string inside the caller's
+     * arena, or WG_NO_STATUS. A status that did not fit the remaining
+     * arena space reports ok = false with WG_NO_STATUS. */
+    uint32_t status_offset;
+} wg_result;
+
+/* Executes count requests in order, filling results[0..count). Returns
+ * the number of requests that succeeded. A null handle processes
+ * nothing and returns 0. */
+size_t wg_execute_batch(void* client_handle, const wg_request* requests,
+                        size_t count, wg_result* results, char* arena,
+                        size_t arena_size);
+
+#ifdef __cplusplus
+}
+#endif
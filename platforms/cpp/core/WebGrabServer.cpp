@@ -1,7 +1,12 @@
 #include "WebGrabServer.h"
+#include "BufferPool.h"
+#include "ClientSendQueue.h"
+#include "IJob.h"
 #include "MessageQueueProcessor.h"
 #include "JobWorker.h"
+#include "NumaPlacement.h"
 #include "TcpListener.h"
+#include "ThreadHeartbeat.h"
 #include "TcpSocket.h"
 #include "FlatBuffersRequestReader.h"
 #include "FlatBuffersResponseWriter.h"
@@ -9,7 +14,13 @@
 
 WebGrabServer::WebGrabServer(uint16_t port, const std::string& workingDir)
     : processor_(std::make_unique<MessageQueueProcessor>(workingDir)),
-      job_worker_(std::make_unique<JobWorker>(4)), // 4 threads
+      // 4 threads, pinned: core 0 reserved for interactive jobs, bulk
+      // downloads on the rest at nice 10
+      job_worker_(std::make_unique<JobWorker>(
+          4, JobWorker::SchedulingPolicy{/*pinToCores=*/true,
+                                         /*reserveInteractiveCore=*/true,
+                                         /*bulkNice=*/10,
+                                         /*bindMemoryToNode=*/true})),
       listener_(std::make_unique<TcpListener>(port)),
       running_(false) {}
 
@@ -34,8 +45,16 @@ void WebGrabServer::stop() {
 }
 
 void WebGrabServer::acceptLoop() {
+    ThreadHeartbeat::Registration heartbeat(
+        ThreadHeartbeat::instance().registerThread("accept"));
     while (running_) {
-        auto client_socket = listener_->accept();
+        heartbeat.counter().beat();
+        std::unique_ptr<TcpSocket> client_socket;
+        {
+            // accept() blocks until a connection; parked, not stalled
+            ThreadHeartbeat::WaitScope parked(heartbeat.counter());
+            client_socket = listener_->accept();
+        }
         if (client_socket) {
             worker_threads_.emplace_back(&WebGrabServer::handleClient, this, std::move(client_socket));
         }
@@ -43,13 +62,33 @@ void WebGrabServer::acceptLoop() {
 }
 
 void WebGrabServer::handleClient(std::unique_ptr<TcpSocket> client_socket) {
-    auto writer = std::make_unique<FlatBuffersResponseWriter>(std::move(client_socket));
+    // On NUMA boxes, fault this connection's state (writer, send queue,
+    // pooled receive slabs) onto the node this handler thread runs on,
+    // instead of wherever the accept thread happened to allocate
+    NumaPlacement::preferLocalNode();
+
+    // The writer shares the socket rather than owning it, so the receive
+    // loop below can keep reading from the same connection
+    std::shared_ptr<TcpSocket> socket = std::move(client_socket);
+    auto writer = std::make_unique<FlatBuffersResponseWriter>(socket);
+    // Responses drain through the per-connection queue's flusher, so a
+    // slow consumer backs up its own queue instead of the job workers
+    auto send_queue = std::make_shared<ClientSendQueue>(socket);
+    writer->enableAsyncSend(send_queue);
 
-    while (writer->isConnected()) {
-        std::vector<uint8_t> buffer;
-        if (!client_socket->receive(buffer)) break;
+    while (socket->isConnected()) {
+        // Pooled slab from this thread's free list; after the first few
+        // messages, steady-state ingestion allocates nothing for buffers
+        std::vector<uint8_t> buffer = BufferPool::acquire(BufferPool::kDefaultReceiveSize);
+        if (!socket->receive(buffer)) {
+            BufferPool::release(std::move(buffer));
+            break;
+        }
 
-        auto reader = std::make_unique<FlatBuffersRequestReader>(buffer.data(), buffer.size());
+        auto reader = std::make_unique<FlatBuffersRequestReader>();
+        // The slab moves into the reader, which recycles it on
+        // destruction; a malformed message just drops
+        if (!reader->adoptMessage(std::move(buffer))) continue;
 
         if (reader->getType() == RequestType::Shutdown) {
             // Handle shutdown
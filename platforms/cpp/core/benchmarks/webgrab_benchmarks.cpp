@@ -0,0 +1,86 @@
+// Microbenchmarks for the WebGrab core hot paths. Built as the
+// webgrab-bench target when google-benchmark is available; run per
+// release so regressions are caught before they reach the Pi.
+#include <benchmark/benchmark.h>
+
+#include "ContextManager.h"
+#include "CoreOrchestrator.h"
+#include "FlatBuffersRequestReader.h"
+#include "Utils/ThreadSafeQueue.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const char* kSampleCommands[] = {
+    "play some jazz music by miles davis",
+    "turn the volume up to 80",
+    "switch audio output to bluetooth speakers",
+    "open the terminal and run htop",
+    "set gpio pin 17 high",
+    "what is the traffic like on the route home",
+};
+
+void BM_ParseCommand(benchmark::State& state) {
+    WebGrab::NLPProcessor nlp;
+    size_t index = 0;
+    for (auto _ : state) {
+        WebGrab::IntentResult result =
+            nlp.parseCommand(kSampleCommands[index % std::size(kSampleCommands)]);
+        benchmark::DoNotOptimize(result);
+        ++index;
+    }
+}
+BENCHMARK(BM_ParseCommand);
+
+void BM_RequestReaderNext(benchmark::State& state) {
+    FlatBuffersRequestReader reader;
+    RequestEnvelope envelope;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.next(envelope));
+    }
+}
+BENCHMARK(BM_RequestReaderNext);
+
+void BM_ThreadSafeQueueMutex(benchmark::State& state) {
+    TinyMCP::Utils::ThreadSafeQueue<int> queue;
+    for (auto _ : state) {
+        queue.push(42);
+        int value = 0;
+        queue.tryPop(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ThreadSafeQueueMutex)->Threads(1)->Threads(4);
+
+void BM_ThreadSafeQueueLockFree(benchmark::State& state) {
+    static TinyMCP::Utils::ThreadSafeQueue<int, TinyMCP::Utils::LockFreeQueuePolicy>
+        queue(4096);
+    for (auto _ : state) {
+        queue.push(42);
+        int value = 0;
+        queue.tryPop(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ThreadSafeQueueLockFree)->Threads(1)->Threads(4);
+
+void BM_AddCommandToHistory(benchmark::State& state) {
+    std::string dataDir = "/tmp/webgrab-bench-ctx";
+    WebGrab::ContextManager manager(
+        std::make_unique<WebGrab::MappedContextPersistence>(dataDir));
+    std::string sessionId = manager.createSession("bench-user", "text");
+
+    for (auto _ : state) {
+        manager.addCommandToHistory(sessionId, "play some jazz", "Music command processed");
+    }
+
+    manager.deleteSession(sessionId);
+    std::remove((dataDir + "/sessions.bin").c_str());
+}
+BENCHMARK(BM_AddCommandToHistory);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -4,13 +4,15 @@
 #include <sstream>
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
+    if (argc != 3 && !(argc == 2 && std::string(argv[1]).rfind("unix:", 0) == 0)) {
         std::cerr << "Usage: " << argv[0] << " <host> <port>" << std::endl;
+        std::cerr << "       " << argv[0] << " unix:<socket-path>" << std::endl;
         return 1;
     }
 
     std::string host = argv[1];
-    uint16_t port = static_cast<uint16_t>(std::stoi(argv[2]));
+    // The port is unused for unix-domain addresses
+    uint16_t port = (argc == 3) ? static_cast<uint16_t>(std::stoi(argv[2])) : 0;
 
     WebGrabClient client(host, port);
     if (!client.connect()) {
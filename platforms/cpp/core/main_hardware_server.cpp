@@ -1,3 +1,4 @@
+#include "ConfigService.h"
 #include "HardwareControlServer.h"
 #include <iostream>
 #include <signal.h>
@@ -17,12 +18,20 @@ int main(int argc, char* argv[]) {
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
 
+    // One parse of $WEBGRAB_CONFIG (or defaults) shared with the other
+    // entry points; SIGHUP re-parses it in place
+    ConfigService::instance().initialize();
+    ConfigService::instance().installReloadOnSighup();
+    auto cfg = ConfigService::instance().snapshot();
+
     try {
         // Create and start the hardware control server
-        WebGrab::HardwareControlServer server;
+        WebGrab::HardwareControlServer server(cfg->hardwarePort, cfg->mqttHost,
+                                              cfg->mqttPort, cfg->metricsPort);
 
         std::cout << "Hardware Control Server starting..." << std::endl;
-        std::cout << "GPIO control available via TCP connections on port 8081" << std::endl;
+        std::cout << "GPIO control available via TCP connections on port "
+                  << cfg->hardwarePort << std::endl;
         std::cout << "Example commands:" << std::endl;
         std::cout << "  Configure pin 17 as output: {\"pin\":17,\"direction\":\"output\"}" << std::endl;
         std::cout << "  Set pin 17 high: {\"pin\":17,\"value\":1}" << std::endl;
@@ -1,6 +1,7 @@
 #include "HotReloadManager.h"
 #include <dlfcn.h>
 #include <iostream>
+#include <poll.h>
 #include <thread>
 #include <chrono>
 
@@ -16,20 +17,33 @@ int main() {
         return 1;
     }
 
-    // Load function pointers
-    auto createClient = (wg_create_client_t)dlsym(hrm.getDllHandle(), "wg_create_client");
-    auto download = (wg_download_t)dlsym(hrm.getDllHandle(), "wg_download");
-    if (!createClient || !download) {
-        std::cerr << "Failed to load functions: " << dlerror() << "\n";
-        return 1;
+    // Pin the initial generation while creating the client
+    void* client = nullptr;
+    {
+        auto lib = hrm.acquire();
+        auto createClient = (wg_create_client_t)dlsym(lib.get(), "wg_create_client");
+        if (!createClient) {
+            std::cerr << "Failed to load functions: " << dlerror() << "\n";
+            return 1;
+        }
+        client = createClient("localhost", 8080);
     }
 
-    void* client = createClient("localhost", 8080);
-
+    // Block on the inotify watch fd so reloads fire as soon as the
+    // library is rewritten, with no syscalls while idle; fall back to
+    // the old stat() polling when the watch can't be established.
+    bool watching = hrm.startWatching();
     std::thread reloadThread([&]() {
         while (true) {
-            hrm.reloadIfChanged();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (watching) {
+                struct pollfd pfd = {hrm.watchFd(), POLLIN, 0};
+                if (poll(&pfd, 1, -1) > 0 && (pfd.revents & POLLIN)) {
+                    hrm.processWatchEvents();
+                }
+            } else {
+                hrm.reloadIfChanged();
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+            }
         }
     });
 
@@ -38,7 +52,11 @@ int main() {
         if (command.rfind("download ", 0) == 0) {
             std::string url = command.substr(9);
             uint32_t sessionId;
-            if (download(client, url.c_str(), &sessionId)) {
+            // Acquire the current generation per command: a reload in
+            // between swaps the mapping without interrupting this call
+            auto lib = hrm.acquire();
+            auto download = (wg_download_t)dlsym(lib.get(), "wg_download");
+            if (download && download(client, url.c_str(), &sessionId)) {
                 std::cout << "Download started, ID: " << sessionId << "\n";
             }
         }
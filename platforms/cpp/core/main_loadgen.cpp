@@ -0,0 +1,174 @@
+#include "WebGrabClient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Load generator for the FlatBuffers TCP protocol: opens N concurrent
+// connections, replays a configurable download/status mix at a target
+// aggregate rate, and reports achieved throughput plus latency
+// percentiles. The benchmark suite covers isolated components; this is
+// the system-level counterpart for capacity-testing webgrab-server
+// before a deploy.
+
+namespace {
+
+struct WorkerStats {
+    // One latency sample (nanoseconds) per completed request
+    std::vector<uint64_t> latenciesNs;
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+};
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void RunWorker(const std::string& host, uint16_t port, const std::string& url,
+               std::chrono::nanoseconds interval, int statusPct,
+               std::chrono::steady_clock::time_point deadline,
+               std::atomic<bool>& abort, WorkerStats& stats) {
+    WebGrabClient client(host, port);
+    if (!client.connect()) {
+        std::cerr << "loadgen: connect failed" << std::endl;
+        abort.store(true);
+        return;
+    }
+
+    // Cheap deterministic mix: the request index modulo 100 against the
+    // status percentage; no RNG state on the send path
+    uint64_t requestIndex = 0;
+    uint32_t lastSessionId = 0;
+    auto nextSend = std::chrono::steady_clock::now();
+
+    while (!abort.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextSend);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        nextSend += interval;
+
+        const bool sendStatus =
+            lastSessionId != 0 &&
+            static_cast<int>(requestIndex % 100) < statusPct;
+        requestIndex++;
+
+        const uint64_t start = NowNs();
+        bool ok;
+        if (sendStatus) {
+            std::string status;
+            ok = client.executeStatus(lastSessionId, status);
+        } else {
+            uint32_t sessionId = 0;
+            ok = client.executeDownload(url, sessionId);
+            if (ok) {
+                lastSessionId = sessionId;
+            }
+        }
+        const uint64_t end = NowNs();
+
+        stats.sent++;
+        if (ok) {
+            stats.latenciesNs.push_back(end - start);
+        } else {
+            stats.failed++;
+            if (!client.isConnected() && !client.connect()) {
+                std::cerr << "loadgen: connection lost" << std::endl;
+                break;
+            }
+        }
+    }
+}
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    const size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <host> <port> [connections=4] [rate_rps=100]"
+                     " [duration_s=10] [status_pct=50] [url=http://localhost/]"
+                  << std::endl;
+        std::cerr << "  status_pct: share of requests that are StatusRequest;"
+                     " the rest are DownloadRequest" << std::endl;
+        return 1;
+    }
+
+    const std::string host = argv[1];
+    const uint16_t port = static_cast<uint16_t>(std::stoi(argv[2]));
+    const int connections = (argc > 3) ? std::stoi(argv[3]) : 4;
+    const int rateRps = (argc > 4) ? std::stoi(argv[4]) : 100;
+    const int durationS = (argc > 5) ? std::stoi(argv[5]) : 10;
+    const int statusPct = (argc > 6) ? std::stoi(argv[6]) : 50;
+    const std::string url = (argc > 7) ? argv[7] : "http://localhost/";
+
+    if (connections < 1 || rateRps < 1 || durationS < 1 ||
+        statusPct < 0 || statusPct > 100) {
+        std::cerr << "loadgen: invalid parameters" << std::endl;
+        return 1;
+    }
+
+    // The aggregate rate is split evenly across connections; each worker
+    // paces itself with an absolute-deadline clock so a slow request
+    // does not permanently lower the offered rate
+    const auto interval = std::chrono::nanoseconds(
+        static_cast<uint64_t>(1e9) * static_cast<uint64_t>(connections) /
+        static_cast<uint64_t>(rateRps));
+
+    std::cout << "loadgen: " << connections << " connections, "
+              << rateRps << " req/s target (" << statusPct << "% status), "
+              << durationS << "s against " << host << ":" << port << std::endl;
+
+    std::vector<WorkerStats> stats(static_cast<size_t>(connections));
+    std::atomic<bool> abort{false};
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::seconds(durationS);
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(connections));
+    for (int i = 0; i < connections; i++) {
+        workers.emplace_back(RunWorker, host, port, url, interval, statusPct,
+                             deadline, std::ref(abort),
+                             std::ref(stats[static_cast<size_t>(i)]));
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double elapsedS =
+        std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+
+    // Merge and report
+    std::vector<uint64_t> latencies;
+    uint64_t sent = 0, failed = 0;
+    for (const WorkerStats& s : stats) {
+        sent += s.sent;
+        failed += s.failed;
+        latencies.insert(latencies.end(), s.latenciesNs.begin(), s.latenciesNs.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "sent:       " << sent << " (" << failed << " failed)\n";
+    std::cout << "throughput: " << static_cast<uint64_t>(static_cast<double>(latencies.size()) / elapsedS)
+              << " req/s achieved over " << elapsedS << "s\n";
+    if (!latencies.empty()) {
+        std::cout << "latency us: p50=" << Percentile(latencies, 0.50) / 1000
+                  << " p90=" << Percentile(latencies, 0.90) / 1000
+                  << " p99=" << Percentile(latencies, 0.99) / 1000
+                  << " max=" << latencies.back() / 1000 << "\n";
+    }
+
+    return (failed > 0 || abort.load()) ? 1 : 0;
+}
@@ -1,3 +1,4 @@
+#include "ConfigService.h"
 #include "CoreOrchestrator.h"
 
 // Standard library includes
@@ -18,26 +19,51 @@ void signalHandler(int signal) {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <port> <working_dir>" << std::endl;
+    if (argc != 1 && argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " [<port|unix:socket-path> <working_dir>]" << std::endl;
         std::cerr << "Example: " << argv[0] << " 8080 /tmp/webgrab" << std::endl;
+        std::cerr << "Example: " << argv[0] << " unix:/run/webgrab.sock /tmp/webgrab" << std::endl;
+        std::cerr << "Without arguments, $WEBGRAB_CONFIG (or defaults) supplies both" << std::endl;
         return 1;
     }
 
-    // Parse command line arguments
-    uint16_t port;
-    try {
-        port = static_cast<uint16_t>(std::stoi(argv[1]));
-    } catch (const std::exception& e) {
-        std::cerr << "Invalid port number: " << argv[1] << std::endl;
-        return 1;
+    // Parse once into the shared snapshot; argv (when given) overrides
+    // the file, and a "unix:" address selects an AF_UNIX listener for
+    // same-host modules. SIGHUP re-parses the file in place.
+    ConfigService::instance().initialize();
+    if (argc == 3) {
+        std::string address = argv[1];
+        uint16_t argPort = 0;
+        if (address.rfind("unix:", 0) != 0) {
+            try {
+                argPort = static_cast<uint16_t>(std::stoi(address));
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid port number: " << argv[1] << std::endl;
+                return 1;
+            }
+            address.clear();
+        }
+        std::string dir = argv[2];
+        ConfigService::instance().applyOverride([address, argPort, dir](ConfigSnapshot& cfg) {
+            cfg.listenAddress = address;
+            if (argPort != 0) cfg.orchestratorPort = argPort;
+            cfg.workingDir = dir;
+        });
     }
+    ConfigService::instance().installReloadOnSighup();
 
-    std::string workingDir = argv[2];
+    auto cfg = ConfigService::instance().snapshot();
+    const uint16_t port = cfg->listenAddress.empty() ? cfg->orchestratorPort : 0;
+    const std::string listenAddress = cfg->listenAddress;
+    const std::string workingDir = cfg->workingDir;
 
     std::cout << "AI-SERVIS Core Orchestrator" << std::endl;
     std::cout << "============================" << std::endl;
-    std::cout << "Port: " << port << std::endl;
+    if (!listenAddress.empty()) {
+        std::cout << "Listen Address: " << listenAddress << std::endl;
+    } else {
+        std::cout << "Port: " << port << std::endl;
+    }
     std::cout << "Working Directory: " << workingDir << std::endl;
     std::cout << std::endl;
 
@@ -47,7 +73,7 @@ int main(int argc, char* argv[]) {
 
     try {
         // Create orchestrator
-        g_orchestrator = std::make_unique<CoreOrchestrator>(port, workingDir);
+        g_orchestrator = std::make_unique<CoreOrchestrator>(port, workingDir, listenAddress);
 
         // Register some example services
         std::vector<std::string> audioCapabilities = {"audio", "music", "voice", "streaming"};
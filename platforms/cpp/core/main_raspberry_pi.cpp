@@ -1,6 +1,8 @@
+#include "ConfigService.h"
 #include "CoreOrchestrator.h"
 #include "UIAdapter.h"
 #include "HardwareControlServer.h"
+#include "StartupStages.h"
 #include <iostream>
 #include <signal.h>
 #include <unistd.h>
@@ -42,65 +44,67 @@ int main(int argc, char* argv[]) {
     std::cout << "  AI-SERVIS Universal - Raspberry Pi" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
-    
-    // Initialize Core Orchestrator
-    std::cout << "Initializing Core Orchestrator..." << std::endl;
-    g_orchestrator = std::make_unique<CoreOrchestrator>(8080);
-    
-    if (!g_orchestrator->start()) {
+
+    // One parse of $WEBGRAB_CONFIG (or defaults) shared by every stage
+    // below; SIGHUP re-parses it in place
+    ConfigService::instance().initialize();
+    ConfigService::instance().installReloadOnSighup();
+    auto cfg = ConfigService::instance().snapshot();
+
+    // Staged startup: the orchestrator's TCP listener comes up blocking
+    // so the process accepts commands immediately after a watchdog
+    // restart; the slow, independent subsystems initialize concurrently
+    // behind it. Each stage logs its wall time.
+    StartupStages stages([](const std::string& name, std::chrono::milliseconds ms, bool ok) {
+        std::cout << (ok ? "✓ " : "✗ ") << name << " (" << ms.count() << " ms)" << std::endl;
+    });
+
+    if (!stages.runBlocking("Core Orchestrator on port " +
+                                std::to_string(cfg->orchestratorPort),
+                            [&cfg] {
+            g_orchestrator = std::make_unique<CoreOrchestrator>(cfg->orchestratorPort);
+            return g_orchestrator->start();
+        })) {
         std::cerr << "Failed to start Core Orchestrator" << std::endl;
         return 1;
     }
-    std::cout << "✓ Core Orchestrator started on port 8080" << std::endl;
-    
-    // Initialize Hardware Control Server
-    std::cout << "Initializing Hardware Control Server..." << std::endl;
-    g_hardwareServer = std::make_unique<HardwareControlServer>(8081, "localhost", 1883);
-    
-    if (!g_hardwareServer->Start()) {
-        std::cerr << "Warning: Hardware Control Server failed to start (GPIO may not be available)" << std::endl;
-    } else {
-        std::cout << "✓ Hardware Control Server started on port 8081" << std::endl;
-    }
-    
-    // Initialize UI Manager
-    std::cout << "Initializing UI Manager..." << std::endl;
-    g_uiManager = std::make_unique<UIManager>(g_orchestrator.get());
-    
-    // Register UI Adapters
-    auto voiceAdapter = std::make_unique<VoiceUIAdapter>();
-    if (g_uiManager->registerAdapter(std::move(voiceAdapter))) {
-        std::cout << "✓ Voice UI Adapter registered" << std::endl;
-    }
-    
-    auto textAdapter = std::make_unique<TextUIAdapter>();
-    if (g_uiManager->registerAdapter(std::move(textAdapter))) {
-        std::cout << "✓ Text UI Adapter registered" << std::endl;
-    }
-    
-    auto webAdapter = std::make_unique<WebUIAdapter>(8082);
-    if (g_uiManager->registerAdapter(std::move(webAdapter))) {
-        std::cout << "✓ Web UI Adapter registered on port 8082" << std::endl;
-    }
-    
-    auto mobileAdapter = std::make_unique<MobileUIAdapter>();
-    if (g_uiManager->registerAdapter(std::move(mobileAdapter))) {
-        std::cout << "✓ Mobile UI Adapter registered" << std::endl;
-    }
-    
-    // Start all UI adapters
-    if (!g_uiManager->startAll()) {
-        std::cerr << "Warning: Some UI adapters failed to start" << std::endl;
-    }
-    
+    std::cout << "Accepting commands; remaining subsystems starting in background" << std::endl;
+
+    stages.runDeferred("Hardware Control Server on port " +
+                           std::to_string(cfg->hardwarePort),
+                       [&cfg] {
+        g_hardwareServer = std::make_unique<HardwareControlServer>(
+            cfg->hardwarePort, cfg->mqttHost, cfg->mqttPort, cfg->metricsPort);
+        if (!g_hardwareServer->Start()) {
+            std::cerr << "Warning: Hardware Control Server failed to start (GPIO may not be available)" << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    stages.runDeferred("UI adapters (voice/text/web/mobile)", [&cfg] {
+        g_uiManager = std::make_unique<UIManager>(g_orchestrator.get());
+        g_uiManager->registerAdapter(std::make_unique<VoiceUIAdapter>());
+        g_uiManager->registerAdapter(std::make_unique<TextUIAdapter>());
+        g_uiManager->registerAdapter(std::make_unique<WebUIAdapter>(cfg->webUiPort));
+        g_uiManager->registerAdapter(std::make_unique<MobileUIAdapter>());
+        if (!g_uiManager->startAll()) {
+            std::cerr << "Warning: Some UI adapters failed to start" << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    const bool allUp = stages.waitAll();
+
     std::cout << std::endl;
     std::cout << "========================================" << std::endl;
-    std::cout << "  System Ready!" << std::endl;
+    std::cout << (allUp ? "  System Ready!" : "  System Ready (degraded)") << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Services:" << std::endl;
-    std::cout << "  - Core Orchestrator:  http://localhost:8080" << std::endl;
-    std::cout << "  - Hardware Server:    http://localhost:8081" << std::endl;
-    std::cout << "  - Web UI:             http://localhost:8082" << std::endl;
+    std::cout << "  - Core Orchestrator:  http://localhost:" << cfg->orchestratorPort << std::endl;
+    std::cout << "  - Hardware Server:    http://localhost:" << cfg->hardwarePort << std::endl;
+    std::cout << "  - Web UI:             http://localhost:" << cfg->webUiPort << std::endl;
     std::cout << std::endl;
     std::cout << "Press Ctrl+C to stop" << std::endl;
     std::cout << std::endl;
@@ -0,0 +1,81 @@
+#include "FlatBuffersRequestReader.h"
+#include "IJob.h"
+#include "IResponseWriter.h"
+#include "MessageQueueProcessor.h"
+#include "ReplayLog.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Replay has no client to answer; responses go to stdout so the
+// reproduced sequence can be eyeballed against the incident
+class ConsoleResponseWriter : public IResponseWriter {
+public:
+    bool write(const DownloadResponse& resp) override {
+        std::cout << "  -> session " << resp.sessionId << " accepted" << std::endl;
+        return true;
+    }
+    bool write(const StatusResponse& resp) override {
+        std::cout << "  -> session " << resp.sessionId << ": " << resp.status << std::endl;
+        return true;
+    }
+    bool write(const ErrorResponse& resp) override {
+        std::cout << "  -> error: " << resp.error << std::endl;
+        return true;
+    }
+    bool flush() override { return true; }
+    void close() override {}
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <replay-log> <working_dir> [messages_per_second]" << std::endl;
+        std::cerr << "Feeds a request ring log captured by the server back through" << std::endl;
+        std::cerr << "MessageQueueProcessor; 0 or omitted rate replays full speed" << std::endl;
+        return 1;
+    }
+
+    std::string logPath = argv[1];
+    std::string workingDir = argv[2];
+    double rate = argc == 4 ? std::stod(argv[3]) : 0.0;
+
+    // Capacity only matters for appends; opening an existing log keeps
+    // the header it was written with
+    auto log = ReplayLog::open(logPath, 16 * 1024 * 1024);
+    if (!log) {
+        std::cerr << "Failed to open replay log: " << logPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Replaying " << log->recordCount() << " envelopes from "
+              << logPath << (rate > 0 ? " at " + std::to_string(rate) + " msg/s" : "")
+              << std::endl;
+
+    MessageQueueProcessor processor(workingDir);
+    ConsoleResponseWriter writer;
+    const auto delay = rate > 0
+        ? std::chrono::duration<double>(1.0 / rate)
+        : std::chrono::duration<double>(0);
+
+    size_t replayed = 0;
+    log->forEach([&](const void* data, size_t size) {
+        auto reader = std::make_unique<FlatBuffersRequestReader>();
+        if (!reader->loadMessage(data, size)) {
+            std::cerr << "Skipping corrupt record " << replayed << std::endl;
+            return;
+        }
+        processor.processMessage(std::move(reader), &writer);
+        replayed++;
+        if (delay.count() > 0) std::this_thread::sleep_for(delay);
+    });
+
+    std::cout << "Replayed " << replayed << " envelopes" << std::endl;
+    return 0;
+}
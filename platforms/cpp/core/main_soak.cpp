@@ -0,0 +1,330 @@
+#include "WebGrabServer.h"
+#include "HardwareControlServer.h"
+#include "TcpSocket.h"
+#include "WebGrabClient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+// End-to-end soak driver: runs webgrab-server (and, when asked, the
+// hardware control server) in this process and drives a mixed
+// download/status/GPIO workload for hours, sampling per-window latency
+// percentiles and the process RSS. The loadgen tool answers "how much
+// can it take"; this answers "does it degrade" — slow leaks and
+// percentile creep that only show up after days in the field fail the
+// run here instead. Queue-depth drift surfaces as overload rejections
+// through the per-class admission limits, so the failure-rate bound
+// stands in for a direct depth probe.
+//
+// GPIO traffic needs a real gpiochip; on a workstation, load the
+// kernel's gpio-sim module (or run on a bench Pi) and pass a gpio
+// port. With gpio_port=0 the hardware server is not started and the
+// soak covers the download pipeline alone.
+
+namespace {
+
+struct WorkerBucket {
+    // Drained by the window sampler; workers only ever append
+    std::mutex mutex;
+    std::vector<uint64_t> latenciesNs;
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+};
+
+struct WindowReport {
+    long rssKb = 0;
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+    uint64_t p50Us = 0;
+    uint64_t p99Us = 0;
+};
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+long RssKb() {
+    std::ifstream statm("/proc/self/statm");
+    long sizePages = 0;
+    long residentPages = 0;
+    statm >> sizePages >> residentPages;
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    const size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+void RunMixWorker(uint16_t port, const std::string& url,
+                  std::chrono::nanoseconds interval, int statusPct,
+                  std::atomic<bool>& stop, WorkerBucket& bucket) {
+    WebGrabClient client("127.0.0.1", port);
+    if (!client.connect()) {
+        std::cerr << "soak: connect failed" << std::endl;
+        return;
+    }
+
+    // Same deterministic mix as the loadgen: request index modulo 100
+    // against the status percentage, no RNG on the send path
+    uint64_t requestIndex = 0;
+    uint32_t lastSessionId = 0;
+    auto nextSend = std::chrono::steady_clock::now();
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextSend);
+        nextSend += interval;
+
+        const bool sendStatus =
+            lastSessionId != 0 &&
+            static_cast<int>(requestIndex % 100) < statusPct;
+        requestIndex++;
+
+        const uint64_t start = NowNs();
+        bool ok;
+        if (sendStatus) {
+            std::string status;
+            ok = client.executeStatus(lastSessionId, status);
+        } else {
+            uint32_t sessionId = 0;
+            ok = client.executeDownload(url, sessionId);
+            if (ok) {
+                lastSessionId = sessionId;
+            }
+        }
+        const uint64_t end = NowNs();
+
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.sent++;
+        if (ok) {
+            bucket.latenciesNs.push_back(end - start);
+        } else {
+            bucket.failed++;
+        }
+
+        if (!ok && !client.isConnected() && !client.connect()) {
+            // Connection lost mid-soak is itself a failure mode worth
+            // surfacing; back off instead of spinning on connect
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void RunGpioWorker(uint16_t gpioPort, std::chrono::nanoseconds interval,
+                   std::atomic<bool>& stop, WorkerBucket& bucket) {
+    TcpSocket sock("127.0.0.1", gpioPort);
+    if (!sock.connect()) {
+        std::cerr << "soak: gpio connect failed" << std::endl;
+        return;
+    }
+
+    // Alternate write/read actuation on one pin: the write path
+    // exercises the kernel request, the read path the shadow mirror
+    uint64_t requestIndex = 0;
+    auto nextSend = std::chrono::steady_clock::now();
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextSend);
+        nextSend += interval;
+
+        const bool write = (requestIndex % 2) == 0;
+        const int value = static_cast<int>((requestIndex / 2) % 2);
+        requestIndex++;
+
+        std::string request = write
+            ? std::string(R"({"pin": 17, "direction": "output", "value": )") +
+                  std::to_string(value) + "}"
+            : std::string(R"({"pin": 17, "direction": "input"})");
+
+        const uint64_t start = NowNs();
+        std::vector<uint8_t> response;
+        bool ok = sock.send(request.c_str(), request.size()) &&
+                  sock.receive(response) && !response.empty();
+        const uint64_t end = NowNs();
+
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.sent++;
+        if (ok) {
+            bucket.latenciesNs.push_back(end - start);
+        } else {
+            bucket.failed++;
+        }
+    }
+}
+
+WindowReport DrainWindow(std::vector<WorkerBucket>& buckets) {
+    WindowReport report;
+    std::vector<uint64_t> latencies;
+    for (WorkerBucket& bucket : buckets) {
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        report.sent += bucket.sent;
+        report.failed += bucket.failed;
+        latencies.insert(latencies.end(), bucket.latenciesNs.begin(),
+                         bucket.latenciesNs.end());
+        bucket.latenciesNs.clear();
+        bucket.sent = 0;
+        bucket.failed = 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    report.p50Us = Percentile(latencies, 0.50) / 1000;
+    report.p99Us = Percentile(latencies, 0.99) / 1000;
+    report.rssKb = RssKb();
+    return report;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <working_dir> [duration_s=3600] [window_s=60]"
+                     " [connections=4] [rate_rps=100] [status_pct=50]"
+                     " [gpio_port=0] [max_rss_growth_pct=10]"
+                     " [max_p99_drift_x=3] [max_fail_pct=1]"
+                  << std::endl;
+        std::cerr << "  gpio_port: also start the hardware control server"
+                     " there and drive GPIO traffic (needs a gpiochip;"
+                     " use gpio-sim off-target)" << std::endl;
+        return 1;
+    }
+
+    const std::string workingDir = argv[1];
+    const int durationS = (argc > 2) ? std::stoi(argv[2]) : 3600;
+    const int windowS = (argc > 3) ? std::stoi(argv[3]) : 60;
+    const int connections = (argc > 4) ? std::stoi(argv[4]) : 4;
+    const int rateRps = (argc > 5) ? std::stoi(argv[5]) : 100;
+    const int statusPct = (argc > 6) ? std::stoi(argv[6]) : 50;
+    const uint16_t gpioPort = (argc > 7) ? static_cast<uint16_t>(std::stoi(argv[7])) : 0;
+    const double maxRssGrowthPct = (argc > 8) ? std::stod(argv[8]) : 10.0;
+    const double maxP99DriftX = (argc > 9) ? std::stod(argv[9]) : 3.0;
+    const double maxFailPct = (argc > 10) ? std::stod(argv[10]) : 1.0;
+
+    if (durationS < 2 * windowS || windowS < 1 || connections < 1 || rateRps < 1 ||
+        statusPct < 0 || statusPct > 100) {
+        std::cerr << "soak: invalid parameters (need at least two windows)" << std::endl;
+        return 1;
+    }
+
+    const uint16_t serverPort = 18080;
+    WebGrabServer server(serverPort, workingDir);
+    if (!server.start()) {
+        std::cerr << "soak: server failed to start" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<WebGrab::HardwareControlServer> hardware;
+    if (gpioPort != 0) {
+        hardware = std::make_unique<WebGrab::HardwareControlServer>(
+            gpioPort, "localhost", 1883);
+        if (!hardware->Start()) {
+            std::cerr << "soak: hardware server failed to start"
+                         " (no gpiochip? load gpio-sim or run on target)" << std::endl;
+            server.stop();
+            return 1;
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    const auto interval = std::chrono::nanoseconds(
+        static_cast<uint64_t>(1e9) * static_cast<uint64_t>(connections) /
+        static_cast<uint64_t>(rateRps));
+
+    std::cout << "soak: " << connections << " connections, " << rateRps
+              << " req/s (" << statusPct << "% status)"
+              << (gpioPort ? ", gpio on " : "") << (gpioPort ? std::to_string(gpioPort) : "")
+              << ", " << durationS << "s in " << windowS << "s windows" << std::endl;
+
+    const size_t workerCount = static_cast<size_t>(connections) + (gpioPort ? 1 : 0);
+    std::vector<WorkerBucket> buckets(workerCount);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (int i = 0; i < connections; i++) {
+        workers.emplace_back(RunMixWorker, serverPort, "http://localhost/",
+                             interval, statusPct, std::ref(stop),
+                             std::ref(buckets[static_cast<size_t>(i)]));
+    }
+    if (gpioPort != 0) {
+        // GPIO actuation at a tenth of the download rate, matching the
+        // field mix of commands to transfers
+        workers.emplace_back(RunGpioWorker, gpioPort, interval * 10,
+                             std::ref(stop), std::ref(buckets.back()));
+    }
+
+    std::vector<WindowReport> reports;
+    std::cout << "window  rss_kb     sent   failed   p50_us   p99_us" << std::endl;
+    const auto soakEnd = std::chrono::steady_clock::now() + std::chrono::seconds(durationS);
+    while (std::chrono::steady_clock::now() < soakEnd) {
+        std::this_thread::sleep_for(std::chrono::seconds(windowS));
+        reports.push_back(DrainWindow(buckets));
+        const WindowReport& w = reports.back();
+        printf("%6zu  %6ld  %7lu  %7lu  %7lu  %7lu\n", reports.size() - 1,
+               w.rssKb, static_cast<unsigned long>(w.sent),
+               static_cast<unsigned long>(w.failed),
+               static_cast<unsigned long>(w.p50Us),
+               static_cast<unsigned long>(w.p99Us));
+        fflush(stdout);
+    }
+
+    stop.store(true);
+    for (auto& w : workers) {
+        w.join();
+    }
+    if (hardware) {
+        hardware->Stop();
+    }
+    server.stop();
+
+    // Window 0 absorbs cold caches and lazy allocations; the baseline
+    // is the second window so warmup growth does not count as a leak
+    const WindowReport& base = reports[reports.size() > 2 ? 1 : 0];
+    const WindowReport& last = reports.back();
+    bool pass = true;
+
+    const double rssGrowthPct = base.rssKb > 0
+        ? 100.0 * static_cast<double>(last.rssKb - base.rssKb) /
+              static_cast<double>(base.rssKb)
+        : 0.0;
+    if (rssGrowthPct > maxRssGrowthPct) {
+        std::cerr << "FAIL rss: " << base.rssKb << " -> " << last.rssKb
+                  << " kB (" << rssGrowthPct << "% > " << maxRssGrowthPct
+                  << "%)" << std::endl;
+        pass = false;
+    }
+
+    if (base.p99Us > 0 &&
+        static_cast<double>(last.p99Us) >
+            maxP99DriftX * static_cast<double>(base.p99Us)) {
+        std::cerr << "FAIL p99 drift: " << base.p99Us << " -> " << last.p99Us
+                  << " us (> " << maxP99DriftX << "x)" << std::endl;
+        pass = false;
+    }
+
+    for (size_t i = 0; i < reports.size(); ++i) {
+        const WindowReport& w = reports[i];
+        if (w.sent > 0 &&
+            100.0 * static_cast<double>(w.failed) / static_cast<double>(w.sent) >
+                maxFailPct) {
+            std::cerr << "FAIL window " << i << ": " << w.failed << "/" << w.sent
+                      << " failed (> " << maxFailPct << "%)" << std::endl;
+            pass = false;
+        }
+    }
+
+    std::cout << (pass ? "soak: PASS" : "soak: FAIL") << " over "
+              << reports.size() << " windows" << std::endl;
+    return pass ? 0 : 1;
+}
@@ -66,6 +66,12 @@ struct MQTTMessageBuilder;
 struct ErrorResponse;
 struct ErrorResponseBuilder;
 
+struct StatsRequest;
+struct StatsRequestBuilder;
+
+struct StatsResponse;
+struct StatsResponseBuilder;
+
 struct Message;
 struct MessageBuilder;
 
@@ -82,11 +88,12 @@ enum Request : uint8_t {
   Request_GPIOSetRequest = 6,
   Request_GPIOGetRequest = 7,
   Request_GPIOStatusRequest = 8,
+  Request_StatsRequest = 9,
   Request_MIN = Request_NONE,
-  Request_MAX = Request_GPIOStatusRequest
+  Request_MAX = Request_StatsRequest
 };
 
-inline const Request (&EnumValuesRequest())[9] {
+inline const Request (&EnumValuesRequest())[10] {
   static const Request values[] = {
     Request_NONE,
     Request_DownloadRequest,
@@ -96,13 +103,14 @@ inline const Request (&EnumValuesRequest())[9] {
     Request_GPIOConfigureRequest,
     Request_GPIOSetRequest,
     Request_GPIOGetRequest,
-    Request_GPIOStatusRequest
+    Request_GPIOStatusRequest,
+    Request_StatsRequest
   };
   return values;
 }
 
 inline const char * const *EnumNamesRequest() {
-  static const char * const names[10] = {
+  static const char * const names[11] = {
     "NONE",
     "DownloadRequest",
     "DownloadStatusRequest",
@@ -112,13 +120,14 @@ inline const char * const *EnumNamesRequest() {
     "GPIOSetRequest",
     "GPIOGetRequest",
     "GPIOStatusRequest",
+    "StatsRequest",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameRequest(Request e) {
-  if (::flatbuffers::IsOutRange(e, Request_NONE, Request_GPIOStatusRequest)) return "";
+  if (::flatbuffers::IsOutRange(e, Request_NONE, Request_StatsRequest)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesRequest()[index];
 }
@@ -159,6 +168,10 @@ template<> struct RequestTraits<webgrab::GPIOStatusRequest> {
   static const Request enum_value = Request_GPIOStatusRequest;
 };
 
+template<> struct RequestTraits<webgrab::StatsRequest> {
+  static const Request enum_value = Request_StatsRequest;
+};
+
 bool VerifyRequest(::flatbuffers::Verifier &verifier, const void *obj, Request type);
 bool VerifyRequestVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<uint8_t> *types);
 
@@ -171,11 +184,12 @@ enum Response : uint8_t {
   Response_GPIOSetResponse = 5,
   Response_GPIOGetResponse = 6,
   Response_GPIOStatusResponse = 7,
+  Response_StatsResponse = 8,
   Response_MIN = Response_NONE,
-  Response_MAX = Response_GPIOStatusResponse
+  Response_MAX = Response_StatsResponse
 };
 
-inline const Response (&EnumValuesResponse())[8] {
+inline const Response (&EnumValuesResponse())[9] {
   static const Response values[] = {
     Response_NONE,
     Response_DownloadResponse,
@@ -184,13 +198,14 @@ inline const Response (&EnumValuesResponse())[8] {
     Response_GPIOConfigureResponse,
     Response_GPIOSetResponse,
     Response_GPIOGetResponse,
-    Response_GPIOStatusResponse
+    Response_GPIOStatusResponse,
+    Response_StatsResponse
   };
   return values;
 }
 
 inline const char * const *EnumNamesResponse() {
-  static const char * const names[9] = {
+  static const char * const names[10] = {
     "NONE",
     "DownloadResponse",
     "DownloadStatusResponse",
@@ -199,13 +214,14 @@ inline const char * const *EnumNamesResponse() {
     "GPIOSetResponse",
     "GPIOGetResponse",
     "GPIOStatusResponse",
+    "StatsResponse",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameResponse(Response e) {
-  if (::flatbuffers::IsOutRange(e, Response_NONE, Response_GPIOStatusResponse)) return "";
+  if (::flatbuffers::IsOutRange(e, Response_NONE, Response_StatsResponse)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesResponse()[index];
 }
@@ -242,21 +258,30 @@ template<> struct ResponseTraits<webgrab::GPIOStatusResponse> {
   static const Response enum_value = Response_GPIOStatusResponse;
 };
 
+template<> struct ResponseTraits<webgrab::StatsResponse> {
+  static const Response enum_value = Response_StatsResponse;
+};
+
 bool VerifyResponse(::flatbuffers::Verifier &verifier, const void *obj, Response type);
 bool VerifyResponseVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<uint8_t> *types);
 
 struct DownloadRequest FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef DownloadRequestBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_URL = 4
+    VT_URL = 4,
+    VT_PRIORITY = 6
   };
   const ::flatbuffers::String *url() const {
     return GetPointer<const ::flatbuffers::String *>(VT_URL);
   }
+  int8_t priority() const {
+    return GetField<int8_t>(VT_PRIORITY, 0);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_URL) &&
            verifier.VerifyString(url()) &&
+           VerifyField<int8_t>(verifier, VT_PRIORITY, 1) &&
            verifier.EndTable();
   }
 };
@@ -268,6 +293,9 @@ struct DownloadRequestBuilder {
   void add_url(::flatbuffers::Offset<::flatbuffers::String> url) {
     fbb_.AddOffset(DownloadRequest::VT_URL, url);
   }
+  void add_priority(int8_t priority) {
+    fbb_.AddElement<int8_t>(DownloadRequest::VT_PRIORITY, priority, 0);
+  }
   explicit DownloadRequestBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -281,19 +309,23 @@ struct DownloadRequestBuilder {
 
 inline ::flatbuffers::Offset<DownloadRequest> CreateDownloadRequest(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    ::flatbuffers::Offset<::flatbuffers::String> url = 0) {
+    ::flatbuffers::Offset<::flatbuffers::String> url = 0,
+    int8_t priority = 0) {
   DownloadRequestBuilder builder_(_fbb);
   builder_.add_url(url);
+  builder_.add_priority(priority);
   return builder_.Finish();
 }
 
 inline ::flatbuffers::Offset<DownloadRequest> CreateDownloadRequestDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    const char *url = nullptr) {
+    const char *url = nullptr,
+    int8_t priority = 0) {
   auto url__ = url ? _fbb.CreateString(url) : 0;
   return webgrab::CreateDownloadRequest(
       _fbb,
-      url__);
+      url__,
+      priority);
 }
 
 struct DownloadResponse FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
@@ -381,15 +413,35 @@ inline ::flatbuffers::Offset<DownloadStatusRequest> CreateDownloadStatusRequest(
 struct DownloadStatusResponse FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef DownloadStatusResponseBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_STATUS = 4
+    VT_STATUS = 4,
+    VT_SESSIONID = 6,
+    VT_SEQ = 8,
+    VT_QUEUEDMS = 10,
+    VT_EXECMS = 12
   };
   const ::flatbuffers::String *status() const {
     return GetPointer<const ::flatbuffers::String *>(VT_STATUS);
   }
+  uint32_t sessionId() const {
+    return GetField<uint32_t>(VT_SESSIONID, 0);
+  }
+  uint64_t seq() const {
+    return GetField<uint64_t>(VT_SEQ, 0);
+  }
+  uint32_t queuedMs() const {
+    return GetField<uint32_t>(VT_QUEUEDMS, 0);
+  }
+  uint32_t execMs() const {
+    return GetField<uint32_t>(VT_EXECMS, 0);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_STATUS) &&
            verifier.VerifyString(status()) &&
+           VerifyField<uint32_t>(verifier, VT_SESSIONID, 4) &&
+           VerifyField<uint64_t>(verifier, VT_SEQ, 8) &&
+           VerifyField<uint32_t>(verifier, VT_QUEUEDMS, 4) &&
+           VerifyField<uint32_t>(verifier, VT_EXECMS, 4) &&
            verifier.EndTable();
   }
 };
@@ -401,6 +453,18 @@ struct DownloadStatusResponseBuilder {
   void add_status(::flatbuffers::Offset<::flatbuffers::String> status) {
     fbb_.AddOffset(DownloadStatusResponse::VT_STATUS, status);
   }
+  void add_sessionId(uint32_t sessionId) {
+    fbb_.AddElement<uint32_t>(DownloadStatusResponse::VT_SESSIONID, sessionId, 0);
+  }
+  void add_seq(uint64_t seq) {
+    fbb_.AddElement<uint64_t>(DownloadStatusResponse::VT_SEQ, seq, 0);
+  }
+  void add_queuedMs(uint32_t queuedMs) {
+    fbb_.AddElement<uint32_t>(DownloadStatusResponse::VT_QUEUEDMS, queuedMs, 0);
+  }
+  void add_execMs(uint32_t execMs) {
+    fbb_.AddElement<uint32_t>(DownloadStatusResponse::VT_EXECMS, execMs, 0);
+  }
   explicit DownloadStatusResponseBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -414,19 +478,35 @@ struct DownloadStatusResponseBuilder {
 
 inline ::flatbuffers::Offset<DownloadStatusResponse> CreateDownloadStatusResponse(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    ::flatbuffers::Offset<::flatbuffers::String> status = 0) {
+    ::flatbuffers::Offset<::flatbuffers::String> status = 0,
+    uint32_t sessionId = 0,
+    uint64_t seq = 0,
+    uint32_t queuedMs = 0,
+    uint32_t execMs = 0) {
   DownloadStatusResponseBuilder builder_(_fbb);
+  builder_.add_seq(seq);
+  builder_.add_execMs(execMs);
+  builder_.add_queuedMs(queuedMs);
+  builder_.add_sessionId(sessionId);
   builder_.add_status(status);
   return builder_.Finish();
 }
 
 inline ::flatbuffers::Offset<DownloadStatusResponse> CreateDownloadStatusResponseDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    const char *status = nullptr) {
+    const char *status = nullptr,
+    uint32_t sessionId = 0,
+    uint64_t seq = 0,
+    uint32_t queuedMs = 0,
+    uint32_t execMs = 0) {
   auto status__ = status ? _fbb.CreateString(status) : 0;
   return webgrab::CreateDownloadStatusResponse(
       _fbb,
-      status__);
+      status__,
+      sessionId,
+      seq,
+      queuedMs,
+      execMs);
 }
 
 struct DownloadAbortRequest FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
@@ -1113,6 +1193,86 @@ inline ::flatbuffers::Offset<ErrorResponse> CreateErrorResponseDirect(
       error__);
 }
 
+struct StatsRequest FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef StatsRequestBuilder Builder;
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           verifier.EndTable();
+  }
+};
+
+struct StatsRequestBuilder {
+  typedef StatsRequest Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  explicit StatsRequestBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<StatsRequest> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<StatsRequest>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<StatsRequest> CreateStatsRequest(
+    ::flatbuffers::FlatBufferBuilder &_fbb) {
+  StatsRequestBuilder builder_(_fbb);
+  return builder_.Finish();
+}
+
+struct StatsResponse FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef StatsResponseBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_STATS = 4
+  };
+  const ::flatbuffers::String *stats() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_STATS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_STATS) &&
+           verifier.VerifyString(stats()) &&
+           verifier.EndTable();
+  }
+};
+
+struct StatsResponseBuilder {
+  typedef StatsResponse Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_stats(::flatbuffers::Offset<::flatbuffers::String> stats) {
+    fbb_.AddOffset(StatsResponse::VT_STATS, stats);
+  }
+  explicit StatsResponseBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<StatsResponse> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<StatsResponse>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<StatsResponse> CreateStatsResponse(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::String> stats = 0) {
+  StatsResponseBuilder builder_(_fbb);
+  builder_.add_stats(stats);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<StatsResponse> CreateStatsResponseDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const char *stats = nullptr) {
+  auto stats__ = stats ? _fbb.CreateString(stats) : 0;
+  return webgrab::CreateStatsResponse(
+      _fbb,
+      stats__);
+}
+
 struct Message FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef MessageBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -1152,6 +1312,9 @@ struct Message FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const webgrab::GPIOStatusRequest *request_as_GPIOStatusRequest() const {
     return request_type() == webgrab::Request_GPIOStatusRequest ? static_cast<const webgrab::GPIOStatusRequest *>(request()) : nullptr;
   }
+  const webgrab::StatsRequest *request_as_StatsRequest() const {
+    return request_type() == webgrab::Request_StatsRequest ? static_cast<const webgrab::StatsRequest *>(request()) : nullptr;
+  }
   webgrab::Response response_type() const {
     return static_cast<webgrab::Response>(GetField<uint8_t>(VT_RESPONSE_TYPE, 0));
   }
@@ -1180,6 +1343,9 @@ struct Message FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const webgrab::GPIOStatusResponse *response_as_GPIOStatusResponse() const {
     return response_type() == webgrab::Response_GPIOStatusResponse ? static_cast<const webgrab::GPIOStatusResponse *>(response()) : nullptr;
   }
+  const webgrab::StatsResponse *response_as_StatsResponse() const {
+    return response_type() == webgrab::Response_StatsResponse ? static_cast<const webgrab::StatsResponse *>(response()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_REQUEST_TYPE, 1) &&
@@ -1224,6 +1390,10 @@ template<> inline const webgrab::GPIOStatusRequest *Message::request_as<webgrab:
   return request_as_GPIOStatusRequest();
 }
 
+template<> inline const webgrab::StatsRequest *Message::request_as<webgrab::StatsRequest>() const {
+  return request_as_StatsRequest();
+}
+
 template<> inline const webgrab::DownloadResponse *Message::response_as<webgrab::DownloadResponse>() const {
   return response_as_DownloadResponse();
 }
@@ -1252,6 +1422,10 @@ template<> inline const webgrab::GPIOStatusResponse *Message::response_as<webgra
   return response_as_GPIOStatusResponse();
 }
 
+template<> inline const webgrab::StatsResponse *Message::response_as<webgrab::StatsResponse>() const {
+  return response_as_StatsResponse();
+}
+
 struct MessageBuilder {
   typedef Message Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -1434,6 +1608,10 @@ inline bool VerifyRequest(::flatbuffers::Verifier &verifier, const void *obj, Re
       auto ptr = reinterpret_cast<const webgrab::GPIOStatusRequest *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Request_StatsRequest: {
+      auto ptr = reinterpret_cast<const webgrab::StatsRequest *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }
@@ -1483,6 +1661,10 @@ inline bool VerifyResponse(::flatbuffers::Verifier &verifier, const void *obj, R
       auto ptr = reinterpret_cast<const webgrab::GPIOStatusResponse *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Response_StatsResponse: {
+      auto ptr = reinterpret_cast<const webgrab::StatsResponse *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }